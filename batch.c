@@ -0,0 +1,303 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions of the batch mode (see "batch.h"),
+  which processes many description files in one process, on a pool
+  of worker threads.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "batch.h"
+
+#define BATCH_DEPTH 8 /* Deepest nesting of lists of inputs. */
+
+typedef struct {
+    char *path;             /* Description file. */
+    double parse;           /* Time taken to parse it. */
+    double gen;             /* Time taken to generate its model. */
+    int err;                /* Set if it failed. */
+} __batch_file_t;           /* File of the batch. */
+
+typedef struct {
+    __batch_file_t *f;      /* Files, in order. */
+    int n;                  /* Number of files. */
+    int max;                /* Allocated number of files. */
+    int next;               /* Next file to be taken by a worker. */
+    pthread_mutex_t lock;   /* Guards next. */
+    pthread_mutex_t run;    /* Held while a model is generated from the
+                               global runtime system. */
+} __batch_t;                /* Batch of description files. */
+
+/* Add the inputs named by the input in (see htree_batch()) to b. */
+static int __batch_input(__batch_t *b, const char *in, int depth);
+
+/* Thread body: process the files of the batch, until none is left. */
+static void *__batch_worker(void *arg);
+
+
+static double __batch_elapsed(struct timespec *t0, struct timespec *t1) {
+    return (t1->tv_sec - t0->tv_sec) + (t1->tv_nsec - t0->tv_nsec)*1e-9;
+}
+
+static int __batch_add(__batch_t *b, const char *path) {
+    __batch_file_t *f;
+    int n;
+
+    if (b->n == b->max) {
+        n = b->max ? 2*b->max : 64;
+        if (!(f = (__batch_file_t *) realloc(b->f,
+                                             sizeof(__batch_file_t)*n)))
+            return -1;
+        b->f = f;
+        b->max = n;
+    }
+    f = &b->f[b->n];
+    memset(f, 0, sizeof(__batch_file_t));
+    if (!(f->path = strdup(path)))
+        return -1;
+    b->n++;
+    return 0;
+}
+
+static int __batch_cmp(const void *a, const void *b) {
+    return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+/* Add the .des files of the directory dir, in order of name. */
+static int __batch_dir(__batch_t *b, const char *dir) {
+    struct dirent *e;
+    char **v = NULL, **w, *s;
+    int i, n = 0, max = 0, err = 0;
+    size_t k;
+    DIR *d;
+
+    if (!(d = opendir(dir))) {
+        fprintf(stderr, "[ cannot open %s ]\n", dir);
+        return -1;
+    }
+    while (!err && (e = readdir(d))) {
+        k = strlen(e->d_name);
+        if ((k < 5) || strcmp(e->d_name + k - 4, ".des"))
+            continue;
+        if (n == max) {
+            max = max ? 2*max : 64;
+            if (!(w = (char **) realloc(v, sizeof(char *)*max))) {
+                err = -1;
+                break;
+            }
+            v = w;
+        }
+        if (!(s = (char *) malloc(strlen(dir) + k + 2))) {
+            err = -1;
+            break;
+        }
+        sprintf(s, "%s/%s", dir, e->d_name);
+        v[n++] = s;
+    }
+    closedir(d);
+    qsort(v, n, sizeof(char *), __batch_cmp);
+    for (i = 0; i < n; i++) {
+        if (!err)
+            err = __batch_add(b, v[i]);
+        free(v[i]);
+    }
+    free(v);
+    return err;
+}
+
+/* Add the inputs listed in the file list, one per line ('#' starts a
+   comment). */
+static int __batch_list(__batch_t *b, const char *list, int depth) {
+    char line[4096], *c, *e;
+    int err = 0;
+    FILE *f;
+
+    if (!(f = fopen(list, "r"))) {
+        fprintf(stderr, "[ cannot open %s ]\n", list);
+        return -1;
+    }
+    while (!err && fgets(line, sizeof(line), f)) {
+        if ((c = strchr(line, '#')))
+            *c = '\0';
+        for (c = line; (*c == ' ') || (*c == '\t'); c++);
+        for (e = c + strlen(c); (e > c) && strchr(" \t\r\n", e[-1]); e--);
+        *e = '\0';
+        if (*c)
+            err = __batch_input(b, c, depth + 1);
+    }
+    fclose(f);
+    return err;
+}
+
+int __batch_input(__batch_t *b, const char *in, int depth) {
+    struct stat st;
+
+    if (depth > BATCH_DEPTH) {
+        fprintf(stderr, "[ lists nested too deeply in %s ]\n", in);
+        return -1;
+    }
+    if (in[0] == '@')
+        return __batch_list(b, in + 1, depth);
+    if (!stat(in, &st) && S_ISDIR(st.st_mode))
+        return __batch_dir(b, in);
+
+    /* A file which cannot be read fails on its own. */
+    return __batch_add(b, in);
+}
+
+void *__batch_worker(void *arg) {
+    __batch_t *b = (__batch_t *) arg;
+    struct timespec t0, t1, t2;
+    __batch_file_t *f;
+    htree_parse_t p;
+    char *base, *s;
+    int i, err;
+
+    while (1) {
+        pthread_mutex_lock(&b->lock);
+        i = b->next++;
+        pthread_mutex_unlock(&b->lock);
+        if (i >= b->n)
+            break;
+        f = &b->f[i];
+
+        /* The models are written as for a single file: the name of
+           the description, up to its extension. */
+        if (!(base = (char *) malloc(strlen(f->path) + 2))) {
+            f->err = 1;
+            continue;
+        }
+        strcpy(base, f->path);
+        if ((s = strrchr(base, '.')) && !strchr(s, '/'))
+            s[1] = '\0';
+        else
+            strcat(base, ".");
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        err = htree_parse(&p, f->path);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        f->parse = __batch_elapsed(&t0, &t1);
+        if (!err && (!p.rt.htree || p.rt.node_sum || (p.rt.nleaves < 1))) {
+            fprintf(stderr, "[ %s is not a complete tree ]\n", f->path);
+            err = 1;
+        }
+
+        /* The tree of a file which failed is released all the same. */
+        pthread_mutex_lock(&b->run);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        fname = base;
+        __htree_rt = p.rt;
+        if (!err) {
+            printf("%s:\n", f->path);
+            err = generate();
+            fflush(stdout);
+        } else
+            htree_final();
+        memset(&__htree_rt, 0, sizeof(struct __htree_rt_s));
+        fname = NULL;
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+        pthread_mutex_unlock(&b->run);
+        f->gen = __batch_elapsed(&t1, &t2);
+        f->err = err ? 1 : 0;
+        final_lex(&p);
+        free(base);
+    }
+    return NULL;
+}
+
+/* For a description of the following function, see "batch.h". */
+int htree_batch(char **in, int n, int nworkers) {
+    struct timespec t0, t1;
+    double tp = 0.0, tg = 0.0, tw;
+    pthread_t *tid = NULL;
+    int *started = NULL;
+    __batch_t b;
+    int i, slow = -1, failed = 0;
+
+    memset(&b, 0, sizeof(__batch_t));
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_mutex_init(&b.run, NULL);
+    for (i = 0; i < n; i++)
+        if (__batch_input(&b, in[i], 0) < 0) {
+            failed = -1;
+            goto done;
+        }
+    if (!b.n) {
+        printf("No description files.\n");
+        failed = -1;
+        goto done;
+    }
+    if (nworkers < 1)
+        nworkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nworkers > b.n)
+        nworkers = b.n;
+    if (nworkers < 1)
+        nworkers = 1;
+    tid = (pthread_t *) malloc(sizeof(pthread_t)*nworkers);
+    started = (int *) calloc(nworkers, sizeof(int));
+    if (!tid || !started) {
+        failed = -1;
+        goto done;
+    }
+
+    /* A worker which cannot be started leaves its share to the
+       others; the calling thread works if none can. */
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0; i < nworkers; i++)
+        started[i] = !pthread_create(&tid[i], NULL, __batch_worker, &b);
+    for (i = 0; (i < nworkers) && !started[i]; i++);
+    if (i == nworkers)
+        __batch_worker(&b);
+    for (i = 0; i < nworkers; i++)
+        if (started[i])
+            pthread_join(tid[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    tw = __batch_elapsed(&t0, &t1);
+
+    for (i = 0; i < b.n; i++) {
+        tp += b.f[i].parse;
+        tg += b.f[i].gen;
+        failed += b.f[i].err;
+        if ((slow < 0) || (b.f[i].parse + b.f[i].gen >
+                           b.f[slow].parse + b.f[slow].gen))
+            slow = i;
+    }
+    printf("Batch: %d files, %d failed, %d worker%s.\n", b.n, failed,
+           nworkers, (nworkers > 1) ? "s" : "");
+    if (failed)
+        for (i = 0; i < b.n; i++)
+            if (b.f[i].err)
+                printf("  failed: %s\n", b.f[i].path);
+    printf("Batch time: %.3fs (%.1f files/s); parse %.3fs, generate "
+           "%.3fs in total; slowest %s (%.3fs).\n", tw,
+           (tw > 0.0) ? b.n/tw : 0.0, tp, tg, b.f[slow].path,
+           b.f[slow].parse + b.f[slow].gen);
+
+ done:
+    for (i = 0; i < b.n; i++)
+        free(b.f[i].path);
+    free(b.f);
+    free(tid);
+    free(started);
+    pthread_mutex_destroy(&b.lock);
+    pthread_mutex_destroy(&b.run);
+    return failed;
+}
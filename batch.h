@@ -0,0 +1,48 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes of the batch mode, in
+  which one process handles many description files, on a pool of
+  worker threads. The functions are defined in "batch.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_BATCH_H
+#define __PEPA_BATCH_H
+
+#include "pepa.h"
+
+/* Every worker takes the next file of the batch, and parses it into a
+   parse context of its own (see htree_parse()), so that files are
+   read, lexed and parsed concurrently, sharing the cache of included
+   files. Generation and analysis are NOT concurrent: they work on the
+   global runtime system and flags, which are not reentrant, so the
+   model of a parsed file is generated and analysed under one lock,
+   one file at a time, by the worker which parsed it, while the others
+   go on parsing. A batch is therefore only faster than one process
+   per file by as much as parsing takes of the whole. A file which
+   cannot be read, does not describe a complete tree, or whose files
+   cannot be written or analyses fail (see generate()), is reported
+   and counted as failed; the others are processed as if they had
+   been given one per process. */
+
+/* Process the inputs in[0..n-1] on nworkers worker threads (all
+   processors if nworkers < 1). An input is a description file (or a
+   precompiled tree), a directory, whose .des files are taken in
+   order of name, or @list, a file which lists inputs one per line.
+   The models are written into files (as with -o), and a summary of
+   the timings is displayed at the end. Returns the number of files
+   which failed, or -1 if the inputs cannot be read. */
+extern int htree_batch(char **in, int n, int nworkers);
+
+#endif /* __PEPA_BATCH_H */
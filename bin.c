@@ -0,0 +1,430 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which write and load precompiled
+  tree files (see "bin.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bin.h"
+
+typedef struct {
+    char *map;                  /* Mapping of the file. */
+    size_t size;                /* Size of the mapping. */
+    __htree_node_t *nodes;      /* Nodes of the tree. */
+    __htree_child_t *children;  /* Child list entries of the nodes. */
+} __bin_image_t;                /* Loaded precompiled tree. */
+
+typedef struct {
+    const char **key;           /* Open addressing table of names. */
+    int64_t *off;               /* Offset of every name of the table. */
+    int size;                   /* Size of the table. */
+    const char **order;         /* Names, in the order of their offsets. */
+    int n;                      /* Number of names. */
+    int64_t len;                /* Length of the names. */
+} __bin_names_t;                /* Names of the tree being written. */
+
+
+/* Hash a name by its address: the names of a tree are interned. */
+static unsigned int __bin_hash(const char *s, int size) {
+    return (unsigned int) (((size_t) s >> 3)*2654435761u) & (size - 1);
+}
+
+/* Offset of the name s among the names being written; s is added if
+   it is new. Returns -1 if out of memory. */
+static int64_t __bin_name(__bin_names_t *t, const char *s) {
+    const char **k, **o;
+    int64_t *f;
+    unsigned int h;
+    int i, size;
+
+    if (2*(t->n + 1) > t->size) {
+        size = t->size ? 2*t->size : 1024;
+        k = (const char **) calloc(size, sizeof(const char *));
+        f = (int64_t *) malloc(sizeof(int64_t)*size);
+        o = (const char **) realloc(t->order, sizeof(const char *)*size/2);
+        if (!k || !f || !o) {
+            free(k);
+            free(f);
+            if (o)
+                t->order = o;
+            return -1;
+        }
+        for (i = 0; i < t->size; i++)
+            if (t->key[i]) {
+                for (h = __bin_hash(t->key[i], size); k[h];
+                     h = (h + 1) & (size - 1))
+                    ;
+                k[h] = t->key[i];
+                f[h] = t->off[i];
+            }
+        free(t->key);
+        free(t->off);
+        t->key = k;
+        t->off = f;
+        t->order = o;
+        t->size = size;
+    }
+    for (h = __bin_hash(s, t->size); t->key[h]; h = (h + 1) & (t->size - 1))
+        if (t->key[h] == s)
+            return t->off[h];
+    t->key[h] = s;
+    t->off[h] = t->len;
+    t->order[t->n++] = s;
+    t->len += strlen(s) + 1;
+    return t->off[h];
+}
+
+/* For a description of the following function, see "bin.h". */
+int bin_is_tree(const char *fname) {
+    char magic[8];
+    FILE *f;
+    int r;
+
+    if (!(f = fopen(fname, "r")))
+        return 0;
+    r = (fread(magic, 1, 8, f) == 8) && !memcmp(magic, BIN_MAGIC, 8);
+    fclose(f);
+    return r;
+}
+
+int bin_load(struct __htree_rt_s *rt, const char *fname) {
+    __bin_image_t *img = NULL;
+    __htree_node_t *n, **sstab = NULL;
+    __htree_child_t *c;
+    __htree_rate_t *rates = NULL;
+    bin_header_t *h;
+    bin_node_t *b;
+    bin_rate_t *r;
+    struct stat st;
+    int32_t *leaf;
+    int *lists;
+    char *map, *names;
+    int64_t nnames, k;
+    int fd, i, j;
+
+    if ((fd = open(fname, O_RDONLY)) < 0)
+        return -1;
+    if (fstat(fd, &st) || (st.st_size < (off_t) sizeof(bin_header_t))) {
+        close(fd);
+        return -1;
+    }
+
+    /* The mapping is private, so that the lists can be changed as if
+       they were allocated. */
+    map = (char *) mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return -1;
+    h = (bin_header_t *) map;
+    if (memcmp(h->magic, BIN_MAGIC, 8) || (h->version != BIN_VERSION) ||
+        (h->order != BIN_ORDER) || (h->node_size != sizeof(bin_node_t)) ||
+        (h->size != (uint64_t) st.st_size) || (h->nnodes < 1) ||
+        (h->nleaves < 1) || (h->nodes < sizeof(bin_header_t)) ||
+        (h->nodes + (uint64_t) h->nnodes*sizeof(bin_node_t) > h->leaves) ||
+        (h->leaves + (uint64_t) h->nleaves*sizeof(int32_t) > h->lists) ||
+        (h->lists + h->nlists*sizeof(int32_t) > h->rates) ||
+        (h->nrates < 0) ||
+        (h->rates + (uint64_t) h->nrates*sizeof(bin_rate_t) > h->names) ||
+        (h->names >= h->size) || map[h->size - 1])
+        goto fail;
+    b = (bin_node_t *) (map + h->nodes);
+    leaf = (int32_t *) (map + h->leaves);
+    lists = (int *) (map + h->lists);
+    r = (bin_rate_t *) (map + h->rates);
+    names = map + h->names;
+    nnames = h->size - h->names;
+
+    if (!(img = (__bin_image_t *) calloc(1, sizeof(__bin_image_t))) ||
+        !(img->nodes = (__htree_node_t *)
+          malloc(sizeof(__htree_node_t)*h->nnodes)) ||
+        !(img->children = (__htree_child_t *)
+          malloc(sizeof(__htree_child_t)*h->nnodes)) ||
+        !(sstab = (__htree_node_t **)
+          malloc(sizeof(__htree_node_t *)*h->nleaves)) ||
+        (h->nrates && !(rates = (__htree_rate_t *)
+                        malloc(sizeof(__htree_rate_t)*h->nrates))))
+        goto fail;
+
+    /* Turn the offsets into pointers, checking them on the way: the
+       parent of a node comes before it, and its children are the
+       consecutive nodes which have it as parent. */
+    for (i = 0; i < h->nnodes; i++, b++) {
+        n = &img->nodes[i];
+        if ((b->name < -1) || (b->name >= nnames) ||
+            (b->rname < -1) || (b->rname >= nnames) ||
+            (b->mtype <= UNKNOWN) || (b->mtype >= NSKEL) ||
+            (b->ptype < UNKNOWN) || (b->ptype >= NSKEL) ||
+            (b->stype < UNKNOWN) || (b->stype >= NSKEL) ||
+            (i ? ((b->parent < 0) || (b->parent >= i))
+             : (b->parent != -1)) ||
+            (b->nchr < 0) || ((b->mtype == TASK) && b->nchr) ||
+            (b->nchr && ((b->child <= i) ||
+                         (b->child > h->nnodes - b->nchr))))
+            goto fail;
+        for (j = 0; j < 3; j++)
+            if ((b->n[j] < 0) || ((b->list[j] < 0) ? (b->list[j] != -1) ||
+                                  b->n[j] : (b->list[j] + b->n[j] >
+                                             (int64_t) h->nlists)))
+                goto fail;
+        for (j = 0; j < b->nchr; j++)
+            if (((bin_node_t *) (map + h->nodes))[b->child + j].parent != i)
+                goto fail;
+        n->name = (b->name < 0) ? "unknown" : names + b->name;
+        n->rate = b->rate;
+        n->rname = (b->rname < 0) ? NULL : names + b->rname;
+        n->nchr = n->nchx = b->nchr;
+        n->index = b->index;
+        n->rank = b->rank;
+        n->p = i ? &img->nodes[b->parent] : NULL;
+        n->mtype = (__htree_comp_t) b->mtype;
+        n->ptype = (__htree_comp_t) b->ptype;
+        n->stype = (__htree_comp_t) b->stype;
+        n->sol.n = b->n[0];
+        n->sol.l = (b->list[0] < 0) ? NULL : lists + b->list[0];
+        n->sil.n = b->n[1];
+        n->sil.l = (b->list[1] < 0) ? NULL : lists + b->list[1];
+        n->temp.n = b->n[2];
+        n->temp.l = (b->list[2] < 0) ? NULL : lists + b->list[2];
+        n->clist = NULL;
+        n->ref = NULL;
+        for (j = 0; j < b->nchr; j++) {
+            c = &img->children[b->child + j];
+            c->child = &img->nodes[b->child + j];
+            c->next = &img->children[b->child + (j + 1) % b->nchr];
+            c->prev = &img->children[b->child +
+                                     (j + b->nchr - 1) % b->nchr];
+        }
+        if (b->nchr)
+            n->clist = &img->children[b->child];
+    }
+    for (k = 0; k < (int64_t) h->nlists; k++)
+        if ((lists[k] < SOURCE_MEM) || (lists[k] >= h->nleaves))
+            goto fail;
+    for (i = 0; i < h->nleaves; i++) {
+        if ((leaf[i] < 0) || (leaf[i] >= h->nnodes) ||
+            (img->nodes[leaf[i]].mtype != TASK) ||
+            (img->nodes[leaf[i]].index != i))
+            goto fail;
+        sstab[i] = &img->nodes[leaf[i]];
+    }
+    for (i = 0; i < h->nrates; i++, r++) {
+        if ((r->name < 0) || (r->name >= nnames) ||
+            (r->expr < -1) || (r->expr >= nnames))
+            goto fail;
+        rates[i].name = names + r->name;
+        rates[i].expr = (r->expr < 0) ? NULL : names + r->expr;
+        rates[i].val = r->val;
+    }
+
+    img->map = map;
+    img->size = st.st_size;
+    memset(rt, 0, sizeof(struct __htree_rt_s));
+    rt->htree = img->nodes;
+    rt->sstab = sstab;
+    rt->nnodes = h->nnodes;
+    rt->nleaves = h->nleaves;
+    rt->rates = rates;
+    rt->nrates = rt->maxrates = h->nrates;
+    rt->image = img;
+    return 0;
+
+ fail:
+    if (img) {
+        free(img->nodes);
+        free(img->children);
+        free(img);
+    }
+    free(sstab);
+    free(rates);
+    munmap(map, st.st_size);
+    return -1;
+}
+
+void bin_release(struct __htree_rt_s *rt) {
+    __bin_image_t *img = (__bin_image_t *) rt->image;
+
+    if (!img)
+        return;
+    free(img->nodes);
+    free(img->children);
+    munmap(img->map, img->size);
+    free(img);
+    rt->image = NULL;
+    rt->htree = NULL;
+}
+
+int htree_write_binary(void) {
+    struct __htree_rt_s *rt = &__htree_rt;
+    __bin_names_t t;
+    __htree_node_t **q = NULL, *n;
+    __htree_plist_t *l[3];
+    __htree_child_t *c;
+    int32_t *up = NULL, *leaf = NULL;
+    bin_header_t h;
+    bin_node_t b;
+    bin_rate_t r;
+    char *path = NULL, *tmp = NULL;
+    static const char pad[8] = { 0 };
+    FILE *f = NULL;
+    int i, j, k, tail, err = -1;
+
+    if (!rt->htree || !rt->sstab)
+        return -1;
+    memset(&t, 0, sizeof(__bin_names_t));
+    memset(&h, 0, sizeof(bin_header_t));
+    path = (char *) malloc(strlen(fname) + 8);
+    tmp = (char *) malloc(strlen(fname) + 32);
+    q = (__htree_node_t **) malloc(sizeof(__htree_node_t *)*rt->nnodes);
+    up = (int32_t *) malloc(sizeof(int32_t)*rt->nnodes);
+    leaf = (int32_t *) malloc(sizeof(int32_t)*rt->nleaves);
+    if (!path || !tmp || !q || !up || !leaf)
+        goto done;
+    memset(leaf, 0xff, sizeof(int32_t)*rt->nleaves);
+    sprintf(path, "%shtree", fname);
+    sprintf(tmp, "%shtree.%d", fname, (int) getpid());
+    if (!(f = fopen(tmp, "w"))) {
+        perror("Could not create precompiled tree");
+        goto done;
+    }
+
+    /* The header is written once the sizes are known. */
+    memcpy(h.magic, BIN_MAGIC, 8);
+    h.version = BIN_VERSION;
+    h.order = BIN_ORDER;
+    h.node_size = sizeof(bin_node_t);
+    h.nnodes = rt->nnodes;
+    h.nleaves = rt->nleaves;
+    h.nodes = sizeof(bin_header_t);
+    if (fwrite(&h, sizeof(bin_header_t), 1, f) != 1)
+        goto done;
+
+    /* Write the nodes breadth first, numbering the lists and names. */
+    q[0] = rt->htree;
+    up[0] = -1;
+    for (i = 0, tail = 1; i < tail; i++) {
+        n = q[i];
+        memset(&b, 0, sizeof(bin_node_t));
+        b.name = b.rname = -1;
+        if (n->mtype == TASK) {
+            if ((n->index < 0) || (n->index >= rt->nleaves) ||
+                ((b.name = __bin_name(&t, n->name)) < 0) ||
+                (n->rname && ((b.rname = __bin_name(&t, n->rname)) < 0)))
+                goto done;
+            b.rate = n->rate;
+            leaf[n->index] = i;
+        }
+        l[0] = &n->sol;
+        l[1] = &n->sil;
+        l[2] = &n->temp;
+        for (k = 0; k < 3; k++) {
+            b.list[k] = l[k]->l ? (int64_t) h.nlists : -1;
+            b.n[k] = l[k]->l ? l[k]->n : 0;
+            h.nlists += b.n[k];
+        }
+        b.nchr = n->nchr;
+        b.child = tail;
+        b.parent = up[i];
+        b.index = n->index;
+        b.rank = i ? n->rank : 0;
+        b.mtype = n->mtype;
+        b.ptype = n->ptype;
+        b.stype = n->stype;
+        for (j = 0, c = n->clist; j < n->nchr; j++, c = c->next) {
+            if (tail == rt->nnodes)
+                goto done;
+            up[tail] = i;
+            q[tail++] = c->child;
+        }
+        if (fwrite(&b, sizeof(bin_node_t), 1, f) != 1)
+            goto done;
+    }
+    if (tail != rt->nnodes)
+        goto done;
+
+    h.leaves = h.nodes + (uint64_t) h.nnodes*sizeof(bin_node_t);
+    if (fwrite(leaf, sizeof(int32_t), h.nleaves, f) != (size_t) h.nleaves)
+        goto done;
+    h.lists = (h.leaves + (uint64_t) h.nleaves*sizeof(int32_t) + 7)/8*8;
+    if (fwrite(pad, 1, h.lists - h.leaves - h.nleaves*sizeof(int32_t), f) !=
+        h.lists - h.leaves - h.nleaves*sizeof(int32_t))
+        goto done;
+    for (i = 0; i < tail; i++) {
+        l[0] = &q[i]->sol;
+        l[1] = &q[i]->sil;
+        l[2] = &q[i]->temp;
+        for (k = 0; k < 3; k++)
+            if (l[k]->l && l[k]->n &&
+                (fwrite(l[k]->l, sizeof(int), l[k]->n, f) != (size_t) l[k]->n))
+                goto done;
+    }
+
+    h.rates = (h.lists + h.nlists*sizeof(int32_t) + 7)/8*8;
+    if (fwrite(pad, 1, h.rates - h.lists - h.nlists*sizeof(int32_t), f) !=
+        h.rates - h.lists - h.nlists*sizeof(int32_t))
+        goto done;
+    h.nrates = rt->nrates;
+    for (i = 0; i < rt->nrates; i++) {
+        r.val = rt->rates[i].val;
+        r.expr = -1;
+        if (((r.name = __bin_name(&t, rt->rates[i].name)) < 0) ||
+            (rt->rates[i].expr &&
+             ((r.expr = __bin_name(&t, rt->rates[i].expr)) < 0)) ||
+            (fwrite(&r, sizeof(bin_rate_t), 1, f) != 1))
+            goto done;
+    }
+
+    /* The names end with a null byte, even if there are none. */
+    h.names = h.rates + (uint64_t) h.nrates*sizeof(bin_rate_t);
+    for (i = 0; i < t.n; i++)
+        if (fwrite(t.order[i], 1, strlen(t.order[i]) + 1, f) !=
+            strlen(t.order[i]) + 1)
+            goto done;
+    if (fwrite(pad, 1, 1, f) != 1)
+        goto done;
+    h.size = h.names + t.len + 1;
+    if (fseek(f, 0, SEEK_SET) ||
+        (fwrite(&h, sizeof(bin_header_t), 1, f) != 1))
+        goto done;
+    if (fclose(f)) {
+        f = NULL;
+        goto done;
+    }
+    f = NULL;
+    err = rename(tmp, path) ? -1 : 0;
+
+ done:
+    if (f)
+        fclose(f);
+    if (err && tmp) {
+        fprintf(stderr, "[ cannot write %s ]\n", path ? path : "tree");
+        unlink(tmp);
+    }
+    free(t.key);
+    free(t.off);
+    free(t.order);
+    free(path);
+    free(tmp);
+    free(q);
+    free(up);
+    free(leaf);
+    return err;
+}
@@ -0,0 +1,98 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the layout of the precompiled tree files, which
+  keep a committed skeleton hierarchy tree with its source and sink
+  lists, and the function prototypes which write and load them. The
+  functions are defined in "bin.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_BIN_H
+#define __PEPA_BIN_H
+
+#include <stdint.h>
+#include "pepa.h"
+
+#define BIN_MAGIC "HTREEBIN" /* First bytes of a precompiled tree. */
+#define BIN_VERSION 2        /* Version of the layout. */
+#define BIN_ORDER 0x01020304 /* Tells the byte order of the writer. */
+
+/* A precompiled tree is a header followed by flat arrays, which refer
+   to each other by offsets instead of pointers: the nodes, in
+   breadth-first order (so that the children of a node are
+   consecutive), the node of every leaf index, the source, sink and
+   temporary index lists of all the nodes, the named rates, and the
+   task names and rate expressions, every distinct name once. The
+   file is only read on the machine which wrote it (the byte order
+   and the sizes are checked). */
+typedef struct {
+    char magic[8];          /* BIN_MAGIC. */
+    uint32_t version;       /* BIN_VERSION. */
+    uint32_t order;         /* BIN_ORDER. */
+    uint32_t node_size;     /* Size of a node record. */
+    int32_t nnodes;         /* Number of nodes. */
+    int32_t nleaves;        /* Number of leaf nodes. */
+    int32_t nrates;         /* Number of named rates. */
+    uint64_t nodes;         /* Offset of the nodes. */
+    uint64_t leaves;        /* Offset of the leaf table. */
+    uint64_t lists;         /* Offset of the index lists. */
+    uint64_t nlists;        /* Number of indices in the lists. */
+    uint64_t rates;         /* Offset of the named rates. */
+    uint64_t names;         /* Offset of the names. */
+    uint64_t size;          /* Size of the file. */
+} bin_header_t;             /* Header of a precompiled tree. */
+
+typedef struct {
+    double rate;            /* Task rate. */
+    int64_t name;           /* Offset of the name, or -1. */
+    int64_t rname;          /* Offset of the symbolic rate, or -1. */
+    int64_t list[3];        /* First index of the source, sink and
+                               temporary lists, or -1 for none. */
+    int32_t n[3];           /* Lengths of the lists. */
+    int32_t nchr;           /* Number of children. */
+    int32_t child;          /* First child. */
+    int32_t parent;         /* Parent, or -1 for the root. */
+    int32_t index;          /* Node index in the hierarchy tree. */
+    int32_t rank;           /* Sibling rank. */
+    int32_t mtype;          /* Skeleton type. */
+    int32_t ptype;          /* Predecessor skeleton type. */
+    int32_t stype;          /* Successor skeleton type. */
+    int32_t pad;            /* Unused. */
+} bin_node_t;               /* Node of a precompiled tree. */
+
+typedef struct {
+    double val;             /* Value. */
+    int64_t name;           /* Offset of the name. */
+    int64_t expr;           /* Offset of the expression, or -1. */
+} bin_rate_t;               /* Named rate of a precompiled tree. */
+
+/* Check whether the file fname is a precompiled tree. */
+extern int bin_is_tree(const char *fname);
+
+/* Load the precompiled tree fname into rt, committed. The file is
+   mapped: the names and index lists of the nodes point into it, and
+   only the nodes themselves are allocated, in one block (and the
+   table of named rates). Returns -1
+   if the file is not a valid precompiled tree. */
+extern int bin_load(struct __htree_rt_s *rt, const char *fname);
+
+/* Release a tree which was loaded by bin_load(). */
+extern void bin_release(struct __htree_rt_s *rt);
+
+/* Write the committed skeleton hierarchy tree into the precompiled
+   tree file (.htree). The file is written under another name and
+   renamed, so that readers never see it partly written. */
+extern int htree_write_binary(void);
+
+#endif /* __PEPA_BIN_H */
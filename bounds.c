@@ -0,0 +1,167 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which bound and estimate the
+  throughput of every subtree of a skeleton hierarchy tree in a
+  single pass over the tree (see "bounds.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "bounds.h"
+
+/* Summarise the subtree n into b[k], and its subtrees after it.
+   Returns the position which follows the subtree, or -1. */
+static int __bounds_subtree(__htree_node_t *n, int depth, int *leaf,
+                            bounds_t *b, int k);
+
+
+/* Mean value analysis of a closed cyclic network of the n stages
+   summarised in s[], with one job for every leaf-node. A stage of c
+   leaf-nodes with throughput x is a station of c servers of rate x/c,
+   approximated (Seidmann) by a single server of rate x followed by a
+   delay of (c - 1)/x. q[] is work space for the mean queue lengths.
+   Returns the throughput. */
+static double __bounds_mva(bounds_t **s, double *q, int n) {
+    double sum, y = 0.0;
+    int i, p, pop = 0;
+
+    for (i = 0; i < n; i++) {
+        q[i] = 0.0;
+        pop += s[i]->size;
+    }
+    for (p = 1; p <= pop; p++) {
+        for (sum = 0.0, i = 0; i < n; i++)
+            sum += (q[i] + s[i]->size)/s[i]->estimate;
+        y = p/sum;
+        for (i = 0; i < n; i++)
+            q[i] = y*(1.0 + q[i])/s[i]->estimate;
+    }
+    return y;
+}
+
+int __bounds_subtree(__htree_node_t *n, int depth, int *leaf,
+                     bounds_t *b, int k) {
+    __htree_child_t *c;
+    bounds_t *r = &b[k++], **s = NULL;
+    double *q = NULL;
+    int i, j, bn = -1;
+
+    r->node = n;
+    r->depth = depth;
+    if (n->mtype == TASK) {
+        r->bound = r->estimate = n->rate;
+        r->size = 1;
+        r->bottleneck = (*leaf)++;
+        return k;
+    }
+    if ((n->mtype == PIPE) &&
+        (!(s = (bounds_t **) malloc(sizeof(bounds_t *)*n->nchr)) ||
+         !(q = (double *) malloc(sizeof(double)*n->nchr)))) {
+        free(s);
+        return -1;
+    }
+    r->size = 0;
+    r->bound = r->estimate = (n->mtype == FARM) ? 0.0 : HUGE_VAL;
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        j = k;
+        if ((k = __bounds_subtree(c->child, depth + 1, leaf, b, k)) < 0) {
+            free(s);
+            free(q);
+            return -1;
+        }
+        r->size += b[j].size;
+        if (n->mtype == FARM) {
+            r->bound += b[j].bound;
+            r->estimate += b[j].estimate;
+        } else if (n->mtype == PIPE)
+            s[i] = &b[j];
+        else if (b[j].estimate < r->estimate)
+            r->estimate = b[j].estimate;
+
+        /* The slowest child limits a pipe and a deal; in a farm, it
+           is the branch where extra capacity helps the least. */
+        if ((bn < 0) || (b[j].bound < b[bn].bound))
+            bn = j;
+        c = c->next;
+    }
+    if (bn < 0) {
+        free(s);
+        free(q);
+        return -1;
+    }
+    r->bottleneck = b[bn].bottleneck;
+    if (n->mtype == PIPE) {
+        r->bound = b[bn].bound;
+        r->estimate = __bounds_mva(s, q, i);
+    } else if (n->mtype == DEAL) {
+        r->bound = i*b[bn].bound;
+        r->estimate *= i;
+    }
+    free(s);
+    free(q);
+    return k;
+}
+
+/* For a description of the following function, see "bounds.h". */
+int bounds_compute(__htree_node_t *n, int first, bounds_t *b) {
+    int leaf = first;
+
+    return __bounds_subtree(n, 0, &leaf, b, 0);
+}
+
+int htree_bounds(void) {
+    static const char *skel[] = { "?", "pipe", "deal", "farm", "task" };
+    struct timespec t0, t1;
+    bounds_t *b;
+    char temp[64];
+    int i, n;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(b = (bounds_t *) malloc(sizeof(bounds_t)*__htree_rt.nnodes)))
+        return -1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    n = bounds_compute(__htree_rt.htree, 0, b);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (n < 0) {
+        fprintf(report_file, "Could not bound the tree.\n");
+        free(b);
+        return -1;
+    }
+    fprintf(report_file, "Bounds: %d subtrees in %.1f us.\n", n,
+            ((t1.tv_sec - t0.tv_sec)*1e9 + (t1.tv_nsec - t0.tv_nsec))/1e3);
+    fprintf(report_file, "%-24s %12s %12s  %s\n", "Subtree", "Bound",
+            "Estimate", "Bottleneck");
+    for (i = 0; i < n; i++) {
+        if (b[i].node->mtype == TASK)
+            snprintf(temp, sizeof(temp), "%*s%.40s", 2*b[i].depth, "",
+                     b[i].node->name);
+        else
+            snprintf(temp, sizeof(temp), "%*s%s(%d)", 2*b[i].depth, "",
+                     skel[b[i].node->mtype], b[i].node->nchr);
+        fprintf(report_file, "%-24s %12f %12f  t_%d %s\n", temp, b[i].bound,
+                b[i].estimate, b[i].bottleneck,
+                __htree_rt.sstab[b[i].bottleneck]->name);
+    }
+    fprintf(report_file, "Throughput bound: %f\n", b[0].bound);
+    fprintf(report_file, "Throughput estimate: %f\n", b[0].estimate);
+    free(b);
+    return 0;
+}
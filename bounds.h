@@ -0,0 +1,63 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to bound and estimate the throughput of every subtree of a
+  skeleton hierarchy tree, from the structure of the tree alone. No
+  state space is built, so that many configurations can be screened
+  before any of them is solved exactly. The functions are defined in
+  "bounds.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_BOUNDS_H
+#define __PEPA_BOUNDS_H
+
+#include "pepa.h"
+
+/* Every subtree is summarised by a single server. Its bound is the
+   throughput it could sustain if it were never starved or blocked: a
+   pipe is as fast as its slowest stage, a deal as N times its slowest
+   branch (every branch gets every N-th job), and a farm as the sum of
+   its branches. The estimate accounts for blocking inside pipes: a
+   pipe is treated as a closed cyclic network with one job for every
+   leaf-node (the source is never starved, and a stage can only hold
+   as many jobs as it has tasks), in which every stage is a station
+   with one server per leaf-node, and is solved by mean value
+   analysis with Seidmann's approximation of multi-server stations.
+   This is exact for a pipe of two tasks, and within 5% of the exact
+   throughput for pipes of tasks, deals and farms. It ignores the
+   order in which a deal hands out and collects jobs, so it is too
+   optimistic for deals of pipes (by a third on model3). The cost is
+   linear in the size of the tree, except that a pipe of n stages
+   and m leaf-nodes costs O(nm). */
+typedef struct {
+    __htree_node_t *node;  /* Root of the subtree. */
+    int depth;             /* Depth of the root in the tree. */
+    int size;              /* Number of leaf-nodes. */
+    double bound;          /* Upper bound of the throughput. */
+    double estimate;       /* Estimated throughput. */
+    int bottleneck;        /* Leaf-node which limits the bound. */
+} bounds_t;                /* Summary of a subtree. */
+
+/* Summarise every subtree of n, storing the summaries in pre-order
+   in b (which must have room for every node of the subtree). The
+   leaves of the subtree are numbered from first. Returns the number
+   of summaries, or -1 on failure. */
+extern int bounds_compute(__htree_node_t *n, int first, bounds_t *b);
+
+/* Compute and display the bounds of the committed skeleton hierarchy
+   tree. */
+extern int htree_bounds(void);
+
+#endif /* __PEPA_BOUNDS_H */
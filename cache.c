@@ -0,0 +1,544 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions of the cache of generated models
+  (see "cache.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "cache.h"
+
+#define CACHE_FNV_BASIS 14695981039346656037UL
+#define CACHE_FNV_PRIME 1099511628211UL
+#define CACHE_NFILES 6 /* Most files of an entry: the report, and the
+                          files generated. */
+
+typedef struct {
+    char *name;       /* Name of the entry. */
+    time_t used;      /* Time at which it was last used. */
+    off_t size;       /* Size of its files. */
+} __cache_use_t;      /* Entry, as seen by the eviction. */
+
+static char *__cache_dir = NULL;   /* Directory of the cache. */
+static off_t __cache_size = 0;     /* Size of the cache. */
+static off_t __cache_total = -1;   /* Size of the entries, as last
+                                      scanned and inserted since (-1
+                                      until scanned). */
+
+/* Append the canonical form of the subtree n to the key. */
+static int __cache_node(cache_t *c, __htree_node_t *n);
+
+/* Scan the cache, evict the entries least recently used until it is
+   within its size, and remove the entries left half-written. Sets the
+   size of the entries which are left. */
+static void __cache_evict(void);
+
+/* Check whether the entry name, being written (tmp.PID.*) or removed
+   (del.PID.*), was left by a process PID which is gone. */
+static int __cache_orphan(const char *name);
+
+
+/* Map the file fd, of *n bytes, read only. An empty file needs no
+   mapping. */
+static char *__cache_map(int fd, size_t *n) {
+    static char empty[1];
+    struct stat st;
+    char *p;
+
+    if (fstat(fd, &st))
+        return NULL;
+    if (!(*n = st.st_size))
+        return empty;
+    p = (char *) mmap(NULL, *n, PROT_READ, MAP_PRIVATE, fd, 0);
+    return (p == MAP_FAILED) ? NULL : p;
+}
+
+static void __cache_unmap(char *p, size_t n) {
+    if (p && n)
+        munmap(p, n);
+}
+
+static int __cache_put(cache_t *c, const void *p, size_t n) {
+    char *k;
+    size_t m;
+
+    if (c->len + n > c->max) {
+        for (m = c->max ? c->max : 1024; m < c->len + n; m *= 2)
+            ;
+        if (!(k = (char *) realloc(c->key, m)))
+            return -1;
+        c->key = k;
+        c->max = m;
+    }
+    memcpy(c->key + c->len, p, n);
+    c->len += n;
+    return 0;
+}
+
+/* A string is put with its terminator, and NULL as a single byte 1,
+   which no string starts with. */
+static int __cache_str(cache_t *c, const char *s) {
+    static const char none = 1;
+
+    return s ? __cache_put(c, s, strlen(s) + 1) : __cache_put(c, &none, 1);
+}
+
+static int __cache_int(cache_t *c, int v) {
+    return __cache_put(c, &v, sizeof(int));
+}
+
+/* The content of the file path is put with its length, and a file
+   which cannot be read as a single byte 1. */
+static int __cache_file(cache_t *c, const char *path) {
+    static const char none = 1;
+    size_t n;
+    char *p;
+    int fd, err;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return __cache_put(c, &none, 1);
+    if (!(p = __cache_map(fd, &n))) {
+        close(fd);
+        return __cache_put(c, &none, 1);
+    }
+    err = __cache_put(c, &n, sizeof(size_t)) || __cache_put(c, p, n);
+    __cache_unmap(p, n);
+    close(fd);
+    return err ? -1 : 0;
+}
+
+int __cache_node(cache_t *c, __htree_node_t *n) {
+    __htree_child_t *ch;
+    int i;
+
+    if (__cache_int(c, n->mtype) || __cache_int(c, n->nchr) ||
+        __cache_put(c, &n->rate, sizeof(double)) ||
+        __cache_str(c, (n->mtype == TASK) ? n->name : NULL) ||
+        __cache_str(c, n->rname))
+        return -1;
+    ch = n->clist;
+    for (i = 0; ch && (i < n->nchr); i++) {
+        if (__cache_node(c, ch->child) < 0)
+            return -1;
+        ch = ch->next;
+    }
+    return 0;
+}
+
+/* The key of the committed tree, generated as the flags request. */
+static int __cache_key(cache_t *c) {
+    int flags[] = {
+        CACHE_VERSION, graph, latex, output, solve, symmetry, lump,
+        fluid, simulate, measures, passage, bounds, decompose, compose,
+        sensitivity, budget, compaction, storage,
+        simulate ? nthreads : 0 /* Replications are shared out. */
+    };
+    int i;
+
+    /* A sweep given as @file is keyed by the points in the file. */
+    if (__cache_put(c, flags, sizeof(flags)) ||
+        __cache_str(c, transient) || __cache_str(c, sweep) ||
+        (sweep && (sweep[0] == '@') && __cache_file(c, sweep + 1)) ||
+        __cache_str(c, store) || __cache_str(c, fname) ||
+        __cache_int(c, __htree_rt.nrates))
+        return -1;
+    for (i = 0; i < __htree_rt.nrates; i++)
+        if (__cache_str(c, __htree_rt.rates[i].name) ||
+            __cache_str(c, __htree_rt.rates[i].expr) ||
+            __cache_put(c, &__htree_rt.rates[i].val, sizeof(double)))
+            return -1;
+    return __cache_node(c, __htree_rt.htree);
+}
+
+/* Extensions of the files which the flags generate; the report comes
+   first. Returns their number. */
+static int __cache_files(const char **ext) {
+    int n = 0;
+
+    ext[n++] = "out";
+    if (output)
+        ext[n++] = "pepa";
+    if (latex)
+        ext[n++] = "tex";
+    if (graph)
+        ext[n++] = "dot";
+    if (measures)
+        ext[n++] = "csv";
+    if (budget)
+        ext[n++] = "opt.des";
+    return n;
+}
+
+/* Write the n bytes of data into the file path, through a temporary
+   file which is renamed into place. */
+static int __cache_write(const char *path, const char *data, size_t n) {
+    char *tmp;
+    ssize_t w;
+    size_t k;
+    int fd, err = 0;
+
+    if (!(tmp = (char *) malloc(strlen(path) + 16)))
+        return -1;
+    sprintf(tmp, "%s.%d", path, (int) getpid());
+    if ((fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        free(tmp);
+        return -1;
+    }
+    for (k = 0; !err && (k < n); k += w)
+        if ((w = write(fd, data + k, n - k)) <= 0)
+            err = -1;
+    if (close(fd) || err || rename(tmp, path)) {
+        unlink(tmp);
+        err = -1;
+    }
+    free(tmp);
+    return err;
+}
+
+/* Copy the file from into the file to. */
+static int __cache_copy(const char *from, const char *to) {
+    size_t n;
+    char *p;
+    int fd, err;
+
+    if ((fd = open(from, O_RDONLY)) < 0)
+        return -1;
+    if (!(p = __cache_map(fd, &n))) {
+        close(fd);
+        return -1;
+    }
+    err = __cache_write(to, p, n);
+    __cache_unmap(p, n);
+    close(fd);
+    return err;
+}
+
+/* Display the report of the entry directory dir. */
+static void __cache_echo(const char *dir) {
+    char path[4096];
+    size_t n;
+    char *p;
+    int fd;
+
+    snprintf(path, sizeof(path), "%s/out", dir);
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return;
+    if ((p = __cache_map(fd, &n))) {
+        fwrite(p, 1, n, report_file);
+        fflush(report_file);
+        __cache_unmap(p, n);
+    }
+    close(fd);
+}
+
+/* Size of the files of the entry directory dir, which is removed
+   with them if drop is set. */
+static off_t __cache_scan(const char *dir, int drop) {
+    char path[4096];
+    struct stat st;
+    struct dirent *e;
+    off_t size = 0;
+    DIR *d;
+
+    if (!(d = opendir(dir)))
+        return 0;
+    while ((e = readdir(d))) {
+        if (e->d_name[0] == '.')
+            continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (!stat(path, &st))
+            size += st.st_size;
+        if (drop)
+            unlink(path);
+    }
+    closedir(d);
+    if (drop)
+        rmdir(dir);
+    return size;
+}
+
+static int __cache_cmp_use(const void *a, const void *b) {
+    time_t x = ((const __cache_use_t *) a)->used;
+    time_t y = ((const __cache_use_t *) b)->used;
+
+    return (x > y) - (x < y);
+}
+
+static int __cache_orphan(const char *name) {
+    char *end;
+    long pid;
+
+    pid = strtol(name + 4, &end, 10);
+    if ((end == name + 4) || (*end != '.') || (pid <= 0))
+        return 0;
+    return (kill((pid_t) pid, 0) < 0) && (errno == ESRCH);
+}
+
+void __cache_evict(void) {
+    __cache_use_t *u = NULL, *v;
+    char path[4096], del[4096];
+    struct dirent *e;
+    struct stat st;
+    off_t total = 0;
+    int i, n = 0, max = 0;
+    DIR *d;
+
+    if (!(d = opendir(__cache_dir)))
+        return;
+    while ((e = readdir(d))) {
+        snprintf(path, sizeof(path), "%s/%s", __cache_dir, e->d_name);
+        if ((e->d_name[0] == '.') || stat(path, &st) ||
+            !S_ISDIR(st.st_mode))
+            continue;
+
+        /* The entries being written are left alone, however long they
+           take, unless the process which writes them is gone. */
+        if (!strncmp(e->d_name, "tmp.", 4) ||
+            !strncmp(e->d_name, "del.", 4)) {
+            if (__cache_orphan(e->d_name))
+                __cache_scan(path, 1);
+            continue;
+        }
+        if (n == max) {
+            max = max ? 2*max : 64;
+            if (!(v = (__cache_use_t *) realloc(u, sizeof(__cache_use_t)*
+                                                max)))
+                break;
+            u = v;
+        }
+        if (!(u[n].name = strdup(e->d_name)))
+            break;
+        u[n].used = st.st_mtime;
+        total += (u[n].size = __cache_scan(path, 0));
+        n++;
+    }
+    closedir(d);
+    __cache_total = total;
+
+    /* An entry is renamed out of the way before it is removed, so that
+       it cannot be found half removed. Another process may have
+       evicted it already. */
+    if (total > __cache_size) {
+        qsort(u, n, sizeof(__cache_use_t), __cache_cmp_use);
+        for (i = 0; (i < n) && (total > __cache_size); i++) {
+            snprintf(path, sizeof(path), "%s/%s", __cache_dir, u[i].name);
+            snprintf(del, sizeof(del), "%s/del.%d.%s", __cache_dir,
+                     (int) getpid(), u[i].name);
+            if (!rename(path, del))
+                __cache_scan(del, 1);
+            total -= u[i].size;
+        }
+        __cache_total = total;
+    }
+    for (i = 0; i < n; i++)
+        free(u[i].name);
+    free(u);
+}
+
+static void __cache_free(cache_t *c) {
+    free(c->key);
+    free(c->path);
+    free(c->tmp);
+    memset(c, 0, sizeof(cache_t));
+}
+
+/* Put the stream of the reports back, after the report was written
+   into the entry, and display it. */
+static void __cache_restore(cache_t *c) {
+    if (!c->saved)
+        return;
+    fclose(report_file);
+    report_file = c->saved;
+    c->saved = NULL;
+    __cache_echo(c->tmp);
+}
+
+/* For a description of the following function, see "cache.h". */
+int cache_open(const char *spec) {
+    char *s, *e;
+    double size = (double) CACHE_SIZE;
+
+    free(__cache_dir);
+    if (!(__cache_dir = strdup(spec)))
+        return -1;
+    if ((s = strrchr(__cache_dir, ':')) && (s[1] >= '0') && (s[1] <= '9')) {
+        size = strtod(s + 1, &e);
+        switch (*e) {
+        case 'k':
+            size *= 1024.0;
+            e++;
+            break;
+        case 'M':
+            size *= 1048576.0;
+            e++;
+            break;
+        case 'G':
+            size *= 1073741824.0;
+            e++;
+            break;
+        }
+        if (*e || (size < 1.0)) {
+            fprintf(stderr, "[ invalid cache size in %s ]\n", spec);
+            free(__cache_dir);
+            __cache_dir = NULL;
+            return -1;
+        }
+        *s = '\0';
+    }
+    __cache_size = (off_t) size;
+    if ((mkdir(__cache_dir, 0777) && (errno != EEXIST)) ||
+        access(__cache_dir, W_OK | X_OK)) {
+        fprintf(stderr, "[ cannot use %s as a cache ]\n", __cache_dir);
+        free(__cache_dir);
+        __cache_dir = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+int cache_lookup(cache_t *c) {
+    const char *ext[CACHE_NFILES];
+    char path[4096], *p[CACHE_NFILES];
+    size_t len[CACHE_NFILES];
+    int fd[CACHE_NFILES], i, k, n, hit = 0;
+    unsigned long h = CACHE_FNV_BASIS;
+    size_t j;
+
+    memset(c, 0, sizeof(cache_t));
+    if (!__cache_dir || !__htree_rt.htree)
+        return -1;
+    if (__cache_key(c) < 0) {
+        __cache_free(c);
+        return -1;
+    }
+    for (j = 0; j < c->len; j++)
+        h = (h ^ (unsigned char) c->key[j])*CACHE_FNV_PRIME;
+    if (!(c->path = (char *) malloc(strlen(__cache_dir) + 24))) {
+        __cache_free(c);
+        return -1;
+    }
+    sprintf(c->path, "%s/%016lx", __cache_dir, h);
+
+    /* All the files of the entry are opened and mapped before any is
+       used, and the key is checked exactly. */
+    n = __cache_files(ext);
+    snprintf(path, sizeof(path), "%s/key", c->path);
+    if ((k = open(path, O_RDONLY)) >= 0) {
+        if ((p[0] = __cache_map(k, &len[0])))
+            hit = (len[0] == c->len) && !memcmp(p[0], c->key, c->len);
+        __cache_unmap(p[0], len[0]);
+        close(k);
+    }
+    for (i = 0; i < n; i++) {
+        p[i] = NULL;
+        fd[i] = -1;
+    }
+    for (i = 0; hit && (i < n); i++) {
+        snprintf(path, sizeof(path), "%s/%s", c->path, ext[i]);
+        if (((fd[i] = open(path, O_RDONLY)) < 0) ||
+            !(p[i] = __cache_map(fd[i], &len[i])))
+            hit = 0;
+    }
+    if (hit) {
+        fwrite(p[0], 1, len[0], report_file);
+        fflush(report_file);
+        for (i = 1; i < n; i++) {
+            snprintf(path, sizeof(path), "%s%s", fname, ext[i]);
+            if (__cache_write(path, p[i], len[i]) < 0)
+                fprintf(stderr, "[ cannot write %s ]\n", path);
+        }
+        utimensat(AT_FDCWD, c->path, NULL, 0);
+    }
+    for (i = 0; i < n; i++) {
+        if (p[i])
+            __cache_unmap(p[i], len[i]);
+        if (fd[i] >= 0)
+            close(fd[i]);
+    }
+    if (hit) {
+        __cache_free(c);
+        return 1;
+    }
+
+    /* The entry is written into a directory of its own, starting with
+       the key, and the report which follows. */
+    if (!(c->tmp = (char *) malloc(strlen(__cache_dir) + 32))) {
+        __cache_free(c);
+        return -1;
+    }
+    sprintf(c->tmp, "%s/tmp.%d.XXXXXX", __cache_dir, (int) getpid());
+    if (!mkdtemp(c->tmp)) {
+        __cache_free(c);
+        return -1;
+    }
+    snprintf(path, sizeof(path), "%s/key", c->tmp);
+    if (__cache_write(path, c->key, c->len) < 0)
+        goto fail;
+    snprintf(path, sizeof(path), "%s/out", c->tmp);
+    fflush(report_file);
+    c->saved = report_file;
+    if (!(report_file = fopen(path, "w"))) {
+        report_file = c->saved;
+        c->saved = NULL;
+        goto fail;
+    }
+    return 0;
+
+ fail:
+    __cache_scan(c->tmp, 1);
+    __cache_free(c);
+    return -1;
+}
+
+int cache_insert(cache_t *c) {
+    const char *ext[CACHE_NFILES];
+    char from[4096], to[4096];
+    int i, n, err = 0;
+
+    __cache_restore(c);
+    n = __cache_files(ext);
+    for (i = 1; !err && (i < n); i++) {
+        snprintf(from, sizeof(from), "%s%s", fname, ext[i]);
+        snprintf(to, sizeof(to), "%s/%s", c->tmp, ext[i]);
+        err = __cache_copy(from, to);
+    }
+
+    /* If another process has completed the same entry meanwhile, its
+       entry is kept. The cache is scanned again only once it seems to
+       have grown beyond its size (other processes may share it). */
+    if (err || rename(c->tmp, c->path))
+        __cache_scan(c->tmp, 1);
+    else if (__cache_total >= 0)
+        __cache_total += __cache_scan(c->path, 0);
+    __cache_free(c);
+    if ((__cache_total < 0) || (__cache_total > __cache_size))
+        __cache_evict();
+    return err;
+}
+
+void cache_abandon(cache_t *c) {
+    __cache_restore(c);
+    __cache_scan(c->tmp, 1);
+    __cache_free(c);
+}
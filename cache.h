@@ -0,0 +1,101 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes of the cache of
+  generated models, a directory in which the files generated from a
+  tree, and the report of its analyses, are kept, so that a tree which
+  was processed before with the same options is not processed again.
+  The functions are defined in "cache.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_CACHE_H
+#define __PEPA_CACHE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "pepa.h"
+
+/* Version of what is generated, which is part of every key: it is to
+   be raised whenever a change to the tool alters the models, the
+   files or the reports which it generates, so that the entries of the
+   earlier versions are no longer used. */
+#define CACHE_VERSION 1
+
+#define CACHE_SIZE (256L << 20) /* Default size of the cache (bytes). */
+
+/* An entry of the cache is keyed by the committed tree (its nodes,
+   task names and rates, and the named rates, whatever description
+   they came from), the options which alter what is generated (with
+   the points of a sweep read from a file), the name of the
+   description (which the files and reports mention) and
+   CACHE_VERSION. The key is hashed into the name of the entry, a
+   directory which holds the key itself, so that a hit is checked
+   exactly, the report displayed by the analyses, and the files
+   generated: the .pepa, .tex, .dot, .csv and opt.des files, as the
+   options request. The reports include the sizes of the state spaces
+   derived, and the solutions found.
+
+   An entry is written into a directory of its own, which is renamed
+   into place once complete: concurrent processes (or the workers of
+   a batch) which share the cache never see half an entry, and the
+   first of them to complete an entry keeps it. A hit is served from
+   the mapped files of the entry, which are all opened first, so that
+   an entry evicted meanwhile is a miss and not half a hit. The files
+   are copied out rather than linked, as the model generators write
+   their files in place, which would alter an entry which shared
+   them. Entries are evicted, least recently used first, when the
+   cache grows beyond its size: the cache is scanned when the first
+   entry is inserted, and then only when the entries inserted since
+   take it beyond its size. An entry being written (or removed) is
+   named after the process which does it, and is only removed by an
+   eviction once that process is gone, however long it takes: the
+   processes which share a cache must run on the same machine.
+
+   The report of a miss is written into the entry through report_file
+   (see "pepa.h"), which the analyses write to, and not through the
+   standard output, which other threads may be writing to. */
+
+typedef struct {
+    char *key;        /* Key of the entry. */
+    size_t len;       /* Length of the key. */
+    size_t max;       /* Allocated length of the key. */
+    char *path;       /* Directory of the entry. */
+    char *tmp;        /* Directory in which it is written. */
+    FILE *saved;      /* Stream of the reports, while the report
+                         is written into the entry. */
+} cache_t;            /* Entry of the cache, looked up or written. */
+
+/* Set the cache to the directory spec, given as DIR or DIR:SIZE,
+   where SIZE is in bytes, or in kB, MB or GB with a suffix k, M or
+   G (CACHE_SIZE if none). The directory is created if need be.
+   Returns -1 if it cannot be used. */
+extern int cache_open(const char *spec);
+
+/* Look up the committed tree of the runtime system, generated as the
+   flags request. On a hit, the report is displayed and the files are
+   written, as they were when the entry was written, and 1 is
+   returned. On a miss, the report which follows is written into the
+   entry as well as displayed, until cache_insert() or
+   cache_abandon(), and 0 is returned. Returns -1 if the cache cannot
+   be used. */
+extern int cache_lookup(cache_t *c);
+
+/* Complete the entry c, from the files which were generated, and
+   evict the entries least recently used if the cache is too large. */
+extern int cache_insert(cache_t *c);
+
+/* Drop the entry c, which was not generated. */
+extern void cache_abandon(cache_t *c);
+
+#endif /* __PEPA_CACHE_H */
@@ -0,0 +1,309 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions of the parallel parser (see
+  "chunk.h"). Every thread scans a chunk of the mapped file for the
+  place where it can be cut, and then parses a piece of the file,
+  with a reentrant scanner and parser of its own, into statement
+  records; the tree is built from the records by the calling thread.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "chunk.h"
+
+typedef enum {
+    CODE = 0,     /* Between tokens. */
+    SLASH,        /* After a slash, which may start a comment. */
+    COMMENT,      /* In a comment. */
+    STAR,         /* In a comment, after a star which may end it. */
+    NAME,         /* In a task name. */
+    NSTATES       /* Number of states. */
+} __chunk_state_t; /* State of the scan for cuts. */
+
+typedef enum {
+    OTHER = 0,    /* Any other character. */
+    QUOTE,        /* Double quote. */
+    DIVIDE,       /* Slash. */
+    TIMES,        /* Star. */
+    SEMI,         /* Semicolon. */
+    BRACE,        /* Opening brace. */
+    EQUAL,        /* Equals sign. */
+    NCLASSES      /* Number of classes. */
+} __chunk_class_t; /* Class of a character. */
+
+/* Next state of the scan, for every state and class of character.
+   The states follow the start conditions of the scanner (see
+   "lexer.l"): a cut may be made after a semicolon which is read in
+   the CODE or SLASH state, unless the file has blocks, whose
+   statements follow each other, or named rates, which the statements
+   which follow refer to (see "parser.y"): a brace or an equals sign
+   read in these states makes the file parsed sequentially. */
+static const __chunk_state_t __chunk_next[NSTATES][NCLASSES] = {
+    /* OTHER    QUOTE    DIVIDE   TIMES    SEMI     BRACE    EQUAL */
+    { CODE,    NAME,    SLASH,   CODE,    CODE,    CODE,    CODE },    /* CODE */
+    { CODE,    NAME,    SLASH,   COMMENT, CODE,    CODE,    CODE },    /* SLASH */
+    { COMMENT, COMMENT, COMMENT, STAR,    COMMENT, COMMENT, COMMENT }, /* COMMENT */
+    { COMMENT, COMMENT, CODE,    STAR,    COMMENT, COMMENT, COMMENT }, /* STAR */
+    { NAME,    CODE,    NAME,    NAME,    NAME,    NAME,    NAME }     /* NAME */
+};
+
+typedef struct {
+    const char *text;       /* Mapped file. */
+    size_t size;            /* Size of the file. */
+    size_t from, to;        /* Range of bytes. */
+    __chunk_state_t end[NSTATES]; /* State at the end of the chunk,
+                                     for every starting state. */
+    size_t cut[NSTATES];    /* Offset following the first semicolon,
+                               for every starting state (0 if none). */
+    int cutlines[NSTATES];  /* Newlines before it. */
+    int lines;              /* Newlines in the chunk. */
+    int whole[NSTATES];     /* Set if the file is to be parsed
+                               sequentially, for every starting
+                               state. */
+    int started;            /* Set if a thread was started. */
+} __chunk_scan_t;           /* Chunk to scan for a cut. */
+
+typedef struct {
+    htree_parse_t p;        /* Parse of the piece. */
+    int fd;                 /* Description file. */
+    long off;               /* Offset of the piece. */
+    size_t len;             /* Length of the piece. */
+    int line;               /* Newlines before the piece. */
+    int err;                /* Result of the parse. */
+    int started;            /* Set if a thread was started. */
+} __chunk_part_t;           /* Piece of the file to parse. */
+
+/* Thread body: find the cut and end state of a chunk. */
+static void *__chunk_scanner(void *arg);
+
+/* Thread body: parse a piece of the file into statement records. */
+static void *__chunk_parser(void *arg);
+
+
+static __chunk_class_t __chunk_class(char c) {
+    switch (c) {
+    case '"':
+        return QUOTE;
+    case '/':
+        return DIVIDE;
+    case '*':
+        return TIMES;
+    case ';':
+        return SEMI;
+    case '{':
+        return BRACE;
+    case '=':
+        return EQUAL;
+    default:
+        return OTHER;
+    }
+}
+
+void *__chunk_scanner(void *arg) {
+    __chunk_scan_t *c = (__chunk_scan_t *) arg;
+    __chunk_state_t st[NSTATES];
+    __chunk_class_t k;
+    size_t j;
+    int i, incl;
+
+    for (i = 0; i < NSTATES; i++) {
+        st[i] = (__chunk_state_t) i;
+        c->cut[i] = 0;
+        c->cutlines[i] = 0;
+        c->whole[i] = 0;
+    }
+    c->lines = 0;
+    for (j = c->from; j < c->to; j++) {
+        /* A run of other characters moves every state as one of them
+           does, so that the states are only followed at the few
+           characters which matter. The newlines are counted, so that
+           the pieces are parsed from their line of the file. */
+        /* An include may bring named rates, which the pieces after it
+           would not see. A run holds it if the keyword starts in it,
+           even if it ends in the next chunk. */
+        incl = 0;
+        if ((k = __chunk_class(c->text[j])) == OTHER) {
+            for (;;) {
+                c->lines += (c->text[j] == '\n');
+                incl |= (c->text[j] == 'i') && (j + 7 <= c->size) &&
+                    !strncmp(c->text + j, "include", 7);
+                if ((j + 1 >= c->to) ||
+                    (__chunk_class(c->text[j + 1]) != OTHER))
+                    break;
+                j++;
+            }
+        }
+        for (i = 0; i < NSTATES; i++) {
+            if ((k == SEMI) && (st[i] <= SLASH) && !c->cut[i]) {
+                c->cut[i] = j + 1;
+                c->cutlines[i] = c->lines;
+            }
+            if (((k == BRACE) || (k == EQUAL) || incl) && (st[i] <= SLASH))
+                c->whole[i] = 1;
+            st[i] = __chunk_next[st[i]][k];
+        }
+    }
+    for (i = 0; i < NSTATES; i++)
+        c->end[i] = st[i];
+    return NULL;
+}
+
+void *__chunk_parser(void *arg) {
+    __chunk_part_t *a = (__chunk_part_t *) arg;
+
+    a->p.record = 1;
+    if (!a->len)
+        return NULL;
+    if (init_lex_range(&a->p, a->fd, a->off, a->len) < 0) {
+        a->err = -1;
+        return NULL;
+    }
+    a->p.line += a->line;
+    a->err = htree_parse_scan(&a->p);
+    return NULL;
+}
+
+/* For a description of the following function, see "chunk.h". */
+int chunk_count(size_t size, int nthreads) {
+    size_t n;
+
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    n = size/CHUNK_MIN;
+    if (n > (size_t) nthreads)
+        n = nthreads;
+    return (n < 1) ? 1 : (int) n;
+}
+
+int chunk_parse(htree_parse_t *p, char *fname, int nthreads) {
+    __chunk_scan_t *c = NULL;
+    __chunk_part_t *a = NULL;
+    __chunk_state_t s;
+    pthread_t *tid = NULL;
+    size_t *cut = NULL;
+    struct stat st;
+    char *text;
+    int fd, n, m, i, j, b, l, err = 0;
+
+    if ((fd = open(fname, O_RDONLY)) < 0) {
+        fprintf(stderr, "[ cannot open %s ]\n", fname);
+        return -1;
+    }
+    if (fstat(fd, &st) ||
+        ((text = (char *) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+                               fd, 0)) == MAP_FAILED)) {
+        fprintf(stderr, "[ cannot map %s ]\n", fname);
+        close(fd);
+        return -1;
+    }
+    n = chunk_count(st.st_size, nthreads);
+    c = (__chunk_scan_t *) calloc(n, sizeof(__chunk_scan_t));
+    a = (__chunk_part_t *) calloc(n, sizeof(__chunk_part_t));
+    tid = (pthread_t *) malloc(sizeof(pthread_t)*n);
+    cut = (size_t *) malloc(sizeof(size_t)*(n + 1));
+    if (!c || !a || !tid || !cut) {
+        err = -1;
+        goto done;
+    }
+
+    /* Scan the chunks for cuts. A chunk whose thread cannot be started
+       is scanned by the calling thread. */
+    madvise(text, st.st_size, MADV_SEQUENTIAL);
+    for (i = 0; i < n; i++) {
+        c[i].text = text;
+        c[i].size = (size_t) st.st_size;
+        c[i].from = (size_t) st.st_size*i/n;
+        c[i].to = (size_t) st.st_size*(i + 1)/n;
+        if (!(c[i].started =
+              !pthread_create(&tid[i], NULL, __chunk_scanner, &c[i])))
+            __chunk_scanner(&c[i]);
+    }
+    for (i = 0; i < n; i++)
+        if (c[i].started)
+            pthread_join(tid[i], NULL);
+
+    /* Chain the states from the start of the file, which is scanned
+       from the CODE state. A chunk without a semicolon outside
+       comments and names is not cut, and joins its predecessor. */
+    cut[0] = 0;
+    for (i = 0, m = 1, s = CODE, b = 0, l = 0; i < n; i++) {
+        if (i && c[i].cut[s]) {
+            a[m].line = l + c[i].cutlines[s];
+            cut[m++] = c[i].cut[s];
+        }
+        b |= c[i].whole[s];
+        s = c[i].end[s];
+        l += c[i].lines;
+    }
+    cut[m] = st.st_size;
+    if (b) {
+        if (init_lex(p, fname) < 0)
+            err = -1;
+        else
+            err = htree_parse_scan(p);
+        goto done;
+    }
+
+    /* Parse the pieces between the cuts. */
+    for (j = 0; j < m; j++) {
+        a[j].p.fname = fname;
+        a[j].fd = fd;
+        a[j].off = (long) cut[j];
+        a[j].len = cut[j + 1] - cut[j];
+        if (!(a[j].started =
+              !pthread_create(&tid[j], NULL, __chunk_parser, &a[j])))
+            __chunk_parser(&a[j]);
+    }
+    for (j = 0; j < m; j++)
+        if (a[j].started)
+            pthread_join(tid[j], NULL);
+
+    /* Build the tree from the records, in order. The statements of a
+       piece which could not be parsed are built up to the error, and
+       the remaining pieces are dropped, as a sequential parse would
+       stop there. The first error is the result. The names are copied
+       into the tree, as the pieces are released. */
+    for (j = 0; j < m; j++) {
+        for (i = 0; i < a[j].p.nstmts; i++)
+            if ((htree_stmt(&p->rt, &a[j].p.stmts[i]) < 0) && !err)
+                err = 1;
+        if (a[j].err) {
+            if (a[j].err < 0)
+                fprintf(stderr, "[ cannot map %s ]\n", fname);
+            if (!err)
+                err = a[j].err;
+            break;
+        }
+    }
+    for (j = 0; j < m; j++) {
+        final_lex(&a[j].p);
+        htree_names_free(&a[j].p.rt);
+    }
+
+ done:
+    munmap(text, st.st_size);
+    close(fd);
+    free(c);
+    free(a);
+    free(tid);
+    free(cut);
+    return err;
+}
@@ -0,0 +1,57 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes of the parallel parser,
+  which splits a large description file into chunks of statements
+  that are parsed on several threads. The functions are defined in
+  "chunk.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_CHUNK_H
+#define __PEPA_CHUNK_H
+
+#include <stddef.h>
+#include "pepa.h"
+
+/* Smallest chunk worth a thread of its own (bytes). */
+#ifndef CHUNK_MIN
+#define CHUNK_MIN (8 << 20)
+#endif
+
+/* The statements of a description end with a semicolon, and do not
+   nest: a pattern is followed by its children, which it counts. A
+   file can therefore be cut after any semicolon which is neither in a
+   comment nor in a task name, and the pieces parsed independently.
+   The file is split into chunks of equal size, and every chunk is
+   scanned on a thread of its own for its first semicolon; as the
+   thread cannot know whether the chunk starts in a comment or a name,
+   it follows every starting state at once, and the states are chained
+   from the start of the file afterwards. The threads count the
+   newlines as they scan, so that every piece is lexed from its line
+   of the file, and errors are reported on the lines of the file. The
+   pieces between the cuts are then lexed and parsed in parallel, into
+   statement records, from which the tree is built in order. A file
+   with blocks of statements (definitions and repetitions), named
+   rates or included files (which may define named rates) is parsed
+   sequentially, as its statements refer to each other. */
+
+/* Number of chunks in which a file of size bytes is parsed with
+   nthreads threads (all processors if nthreads < 1). */
+extern int chunk_count(size_t size, int nthreads);
+
+/* Parse the description file fname into the tree of p in parallel,
+   on nthreads threads. Returns as htree_parse() (see "pepa.h"). */
+extern int chunk_parse(htree_parse_t *p, char *fname, int nthreads);
+
+#endif /* __PEPA_CHUNK_H */
@@ -0,0 +1,361 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which solve a skeleton hierarchy
+  tree compositionally, by replacing every subtree with a
+  flow-equivalent server (see "comp.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "comp.h"
+
+#define COMP_FNV_BASIS 14695981039346656037UL
+#define COMP_FNV_PRIME 1099511628211UL
+
+static int __comp_cmp_int(const void *a, const void *b) {
+    return *(const int *) a - *(const int *) b;
+}
+
+static unsigned long __comp_mix(unsigned long h, unsigned long v) {
+    int i;
+
+    for (i = 0; i < 8; i++, v >>= 8)
+        h = (h ^ (v & 0xff))*COMP_FNV_PRIME;
+    return h;
+}
+
+/* Hash of the structure of the subtree n (FNV-1a), consistent with
+   __htree_same_subtree(). */
+static unsigned long __comp_hash(__htree_node_t *n) {
+    __htree_child_t *c;
+    unsigned long h = COMP_FNV_BASIS, v;
+    int i;
+
+    h = __comp_mix(h, n->mtype);
+    h = __comp_mix(h, n->nchr);
+    if (n->mtype == TASK) {
+        memcpy(&v, &n->rate, sizeof(v));
+        return __comp_mix(h, v);
+    }
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        h = __comp_mix(h, __comp_hash(c->child));
+        c = c->next;
+    }
+    return h;
+}
+
+/* Number of servers which stand for the subtree n: one per task, the
+   sum over the branches of a farm, and the narrowest stage of a
+   pipe. A deal hands out jobs in a fixed order, which any-server
+   farms would ignore; it is served by a single server instead,
+   which errs on the pessimistic side. */
+static int __comp_width(__htree_node_t *n) {
+    __htree_child_t *c;
+    int i, k, w = 0;
+
+    if ((n->mtype == TASK) || (n->mtype == DEAL))
+        return 1;
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        k = __comp_width(c->child);
+        if (n->mtype == FARM)
+            w += k;
+        else if ((w == 0) || (k < w))
+            w = k;
+        c = c->next;
+    }
+    return w;
+}
+
+/* Replace every peer p of the steps of l by the span[p] servers
+   which follow it. */
+static int __comp_expand(__ctmc_leaf_t *l, int *span) {
+    __htree_plist_t *p;
+    int *t, i, j, k, n;
+
+    for (i = 0; i < l->nsteps; i++) {
+        p = &l->steps[i].peers;
+        for (n = j = 0; j < p->n; j++)
+            n += span[p->l[j]];
+        if (n == p->n)
+            continue;
+        if (!(t = (int *) malloc(sizeof(int)*n)))
+            return -1;
+        for (n = j = 0; j < p->n; j++)
+            for (k = 0; k < span[p->l[j]]; k++)
+                t[n++] = p->l[j] + k;
+        free(p->l);
+        p->l = t;
+        p->n = n;
+    }
+    return 0;
+}
+
+/* Build a server of the flow-equivalent of the leaf-nodes lo..hi-1,
+   which are all numbered k through map: a task of the given rate
+   which receives from any of their mapped senders and delivers to
+   any of their mapped receivers. */
+static int __comp_server(comp_t *c, int lo, int hi, int k, double rate,
+                         __ctmc_leaf_t *l) {
+    static const __ctmc_act_t act[] = { ACT_IN, ACT_COMP, ACT_OUT };
+    __ctmc_step_t *s, *t;
+    int a, i, j, p;
+
+    l->rate = rate;
+    l->nsteps = 0;
+    if (!(l->steps = (__ctmc_step_t *) calloc(3, sizeof(__ctmc_step_t))))
+        return -1;
+    for (a = 0; a < 3; a++) {
+        s = &l->steps[l->nsteps];
+        s->act = act[a];
+        for (i = lo; i < hi; i++)
+            for (j = 0; (act[a] != ACT_COMP) &&
+                     (j < c->leaf[i].nsteps); j++) {
+                t = &c->leaf[i].steps[j];
+                if (t->act != act[a])
+                    continue;
+                for (p = 0; p < t->peers.n; p++) {
+                    if ((c->map[t->peers.l[p]] < 0) ||
+                        (c->map[t->peers.l[p]] == k))
+                        continue;
+                    if (!(s->peers.l = (int *)
+                          realloc(s->peers.l,
+                                  sizeof(int)*(s->peers.n + 1))))
+                        return -1;
+                    s->peers.l[s->peers.n++] = c->map[t->peers.l[p]];
+                }
+            }
+        if ((act[a] != ACT_COMP) && (s->peers.n == 0))
+            continue;
+
+        /* Sorted without duplicates, as in ctmc_leaf_copy(). */
+        qsort(s->peers.l, s->peers.n, sizeof(int), __comp_cmp_int);
+        for (i = j = 0; j < s->peers.n; j++)
+            if ((j == 0) || (s->peers.l[j] != s->peers.l[j - 1]))
+                s->peers.l[i++] = s->peers.l[j];
+        s->peers.n = i;
+        l->nsteps++;
+    }
+    return 0;
+}
+
+/* Solve the subtree n, whose children have throughputs x[] in
+   isolation. A child of width w is served by w identical servers,
+   which form a symmetric group. */
+static double __comp_level(comp_t *c, __htree_node_t *n, double *x) {
+    __htree_child_t *ch;
+    __ctmc_leaf_t *leaf = NULL;
+    __ctmc_group_t *group = NULL, *g;
+    ctmc_t *m;
+    double y = -1.0;
+    int *first, *count, *base, *span = NULL, i, j, k, e = 0;
+    int nl = 0, ng = 0;
+
+    if (!(first = (int *) malloc(sizeof(int)*3*n->nchr)))
+        return -1.0;
+    count = first + n->nchr;
+    base = count + n->nchr;
+    ch = n->clist;
+    for (i = 0; i < n->nchr; i++) {
+        __htree_leaf_range(ch->child, &first[i], &count[i]);
+        base[i] = nl;
+        nl += (count[i] == 1) ? 1 : __comp_width(ch->child);
+        for (j = first[i]; j < first[i] + count[i]; j++)
+            c->map[j] = base[i];
+        ch = ch->next;
+    }
+    if (!(leaf = (__ctmc_leaf_t *) calloc(nl, sizeof(__ctmc_leaf_t))) ||
+        !(group = (__ctmc_group_t *)
+          calloc(n->nchr, sizeof(__ctmc_group_t))) ||
+        !(span = (int *) malloc(sizeof(int)*nl)))
+        e = 1;
+    for (i = 0; !e && (i < n->nchr); i++) {
+        k = ((i < n->nchr - 1) ? base[i + 1] : nl) - base[i];
+        span[base[i]] = k;
+        for (j = 1; j < k; j++)
+            span[base[i] + j] = 1;
+        if (count[i] == 1) {
+            e = ctmc_leaf_copy(&c->leaf[first[i]], &leaf[base[i]],
+                               c->map, 1.0) < 0;
+            continue;
+        }
+        for (j = 0; !e && (j < k); j++)
+            e = __comp_server(c, first[i], first[i] + count[i], base[i],
+                              x[i]/k, &leaf[base[i] + j]) < 0;
+        if (!e && (k > 1)) {
+            g = &group[ng++];
+            g->size = 1;
+            g->nbranch = k;
+            if (!(g->first = (int *) malloc(sizeof(int)*k)))
+                e = 1;
+            for (j = 0; !e && (j < k); j++)
+                g->first[j] = base[i] + j;
+        }
+    }
+    for (i = 0; !e && (i < nl); i++)
+        e = __comp_expand(&leaf[i], span) < 0;
+    for (i = 0; i < n->nchr; i++)
+        for (j = first[i]; j < first[i] + count[i]; j++)
+            c->map[j] = -1;
+    free(first);
+    free(span);
+    if (e) {
+        for (i = 0; leaf && (i < nl); i++)
+            ctmc_leaf_free(&leaf[i]);
+        for (i = 0; i < ng; i++)
+            free(group[i].first);
+        free(leaf);
+        free(group);
+        return -1.0;
+    }
+
+    if ((m = ctmc_derive_groups(leaf, nl, group, ng)) &&
+        (ctmc_solve(m, CTMC_TOLERANCE, CTMC_MAXITER) >= 0)) {
+        /* Jobs leave the subtree at the tasks which no longer deliver
+           to anyone. */
+        for (y = 0.0, i = 0; i < nl; i++) {
+            for (j = 0; (j < m->leaf[i].nsteps) &&
+                     (m->leaf[i].steps[j].act != ACT_OUT); j++)
+                ;
+            if (j == m->leaf[i].nsteps)
+                y += ctmc_throughput(m, i);
+        }
+        c->sumstates += m->nstates;
+        if (m->nstates > c->maxstates)
+            c->maxstates = m->nstates;
+        c->nsolved++;
+    }
+    ctmc_destroy(m);
+    return y;
+}
+
+/* For a description of the following function, see "comp.h". */
+comp_t *comp_create(__ctmc_leaf_t *leaf, int nleaves, int nnodes) {
+    comp_t *c;
+    int i;
+
+    if (!(c = (comp_t *) calloc(1, sizeof(comp_t))))
+        return NULL;
+    c->leaf = leaf;
+    for (c->size = 16; c->size < 2*nnodes; c->size *= 2)
+        ;
+    if (!(c->map = (int *) malloc(sizeof(int)*nleaves)) ||
+        !(c->cache = (comp_entry_t *)
+          calloc(c->size, sizeof(comp_entry_t)))) {
+        comp_destroy(c);
+        return NULL;
+    }
+    for (i = 0; i < nleaves; i++)
+        c->map[i] = -1;
+    return c;
+}
+
+double comp_solve(comp_t *c, __htree_node_t *n) {
+    __htree_child_t *ch;
+    comp_entry_t *e;
+    unsigned long h;
+    double *x, y;
+    int i;
+
+    if (n->mtype == TASK)
+        return n->rate;
+    h = __comp_hash(n);
+    for (i = h & (c->size - 1); c->cache[i].node;
+         i = (i + 1) & (c->size - 1))
+        if ((c->cache[i].hash == h) &&
+            __htree_same_subtree(c->cache[i].node, n)) {
+            c->nhits++;
+            return c->cache[i].x;
+        }
+
+    if (!(x = (double *) malloc(sizeof(double)*n->nchr)))
+        return -1.0;
+    ch = n->clist;
+    for (i = 0; ch && (i < n->nchr); i++) {
+        if ((x[i] = comp_solve(c, ch->child)) < 0.0) {
+            free(x);
+            return -1.0;
+        }
+        ch = ch->next;
+    }
+    y = __comp_level(c, n, x);
+    free(x);
+
+    /* The children may have taken the slot in the meantime. */
+    if (y >= 0.0) {
+        for (i = h & (c->size - 1); c->cache[i].node;
+             i = (i + 1) & (c->size - 1))
+            ;
+        e = &c->cache[i];
+        e->hash = h;
+        e->node = n;
+        e->x = y;
+    }
+    return y;
+}
+
+void comp_destroy(comp_t *c) {
+    if (!c)
+        return;
+    free(c->map);
+    free(c->cache);
+    free(c);
+}
+
+int htree_compose(void) {
+    __ctmc_leaf_t *leaf;
+    struct timespec t0, t1;
+    comp_t *c;
+    double x = -1.0;
+    int i;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(leaf = (__ctmc_leaf_t *)
+          calloc(__htree_rt.nleaves, sizeof(__ctmc_leaf_t))))
+        return -1;
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        if (ctmc_leaf_def(__htree_rt.sstab[i], &leaf[i]) < 0) {
+            fprintf(report_file, "Cannot derive process for task %d.\n", i);
+            goto done;
+        }
+    if (!(c = comp_create(leaf, __htree_rt.nleaves, __htree_rt.nnodes)))
+        goto done;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    x = comp_solve(c, __htree_rt.htree);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (x < 0.0)
+        fprintf(report_file, "Compositional solve failed.\n");
+    else {
+        fprintf(report_file,
+                "Compositional solve: %d subtrees solved, %d cached, %ld "
+                "states in all (largest %d), %.3fs.\n", c->nsolved, c->nhits,
+                c->sumstates, c->maxstates,
+                (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9);
+        fprintf(report_file, "Compositional throughput: %f\n", x);
+    }
+    comp_destroy(c);
+
+ done:
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        ctmc_leaf_free(&leaf[i]);
+    free(leaf);
+    return (x < 0.0) ? -1 : 0;
+}
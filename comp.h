@@ -0,0 +1,80 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to solve a skeleton hierarchy tree compositionally: every
+  subtree is solved in isolation and replaced by a flow-equivalent
+  server in its parent, so that the cost grows with the sum of the
+  state spaces of the subtrees instead of their product. The
+  functions are defined in "comp.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_COMP_H
+#define __PEPA_COMP_H
+
+#include "ctmc.h"
+
+/* A subtree is solved bottom-up. Its children are solved first; a
+   child with a single leaf-node keeps its sequential component, and
+   any other child is replaced by a flow-equivalent server: w
+   identical tasks which share the throughput of the child in
+   isolation, and which receive from (and deliver to) any of the
+   tasks its leaf-nodes receive from (and deliver to). The width w is
+   the number of jobs the child serves at once (the branches of a
+   farm, the narrowest stage of a pipe, and one for a deal, whose
+   order would otherwise be lost), and the w servers are aggregated
+   as a symmetric group. The subtree is then solved exactly, with its
+   moves to the rest of the tree dropped as if it were the whole
+   tree. Solved subtrees are cached by a hash of their structure, so
+   that identical branches (the xdeal of model2) are solved once.
+
+   The approximation is exact for farms of tasks and for trees of
+   depth one. Otherwise, it ignores how jobs queue inside a child and
+   in which order a deal hands them out. Against the exact solution,
+   it is within 1% on model3, model5 and model6, and 6-7% too
+   pessimistic on the pipes of deals of model1 and model4. */
+typedef struct {
+    unsigned long hash;    /* Hash of the structure of the subtree. */
+    __htree_node_t *node;  /* Its first occurrence. */
+    double x;              /* Its throughput in isolation. */
+} comp_entry_t;            /* Solved subtree. */
+
+typedef struct {
+    __ctmc_leaf_t *leaf;   /* Sequential components of the tree. */
+    int *map;              /* Work space for numbering leaf-nodes. */
+    int size;              /* Size of the cache (a power of 2). */
+    comp_entry_t *cache;   /* Open addressing cache of subtrees. */
+    int nsolved;           /* Number of subtrees solved. */
+    int nhits;             /* Number of subtrees found in the cache. */
+    long sumstates;        /* Total number of states solved. */
+    int maxstates;         /* Size of the largest subtree solved. */
+} comp_t;                  /* Compositional solver. */
+
+/* Prepare the compositional solution of a tree of nnodes nodes, whose
+   leaf-nodes are described by the nleaves sequential components in
+   leaf (these are not taken over). Returns NULL on failure. */
+extern comp_t *comp_create(__ctmc_leaf_t *leaf, int nleaves, int nnodes);
+
+/* Throughput of the subtree n in isolation, or a negative value on
+   failure. */
+extern double comp_solve(comp_t *c, __htree_node_t *n);
+
+/* Deallocate the compositional solver. */
+extern void comp_destroy(comp_t *c);
+
+/* Solve the committed skeleton hierarchy tree compositionally, and
+   display its throughput. */
+extern int htree_compose(void);
+
+#endif /* __PEPA_COMP_H */
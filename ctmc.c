@@ -0,0 +1,1525 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which derive the continuous time
+  Markov chain (CTMC) underlying the PEPA model of a committed
+  skeleton hierarchy tree. The sequential components are built
+  directly from the source-sink lookup table, following the same
+  source-sink pattern combinations that are used when the PEPA
+  process definitions are written out (see "pepa.c"). The tangible
+  states of the model are then explored in breadth first order.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ctmc.h"
+#include "lump.h"
+#include "reward.h"
+#include "transient.h"
+#include "passage.h"
+#include "sens.h"
+#include "store.h"
+#include "mdd.h"
+
+/* Append a step to the sequential component of a leaf-node. */
+static int __ctmc_step(__ctmc_leaf_t *l, __ctmc_act_t act,
+                       int *peers, int n);
+
+/* Find groups of identical sibling subtrees under farms. */
+static int __ctmc_find_groups(ctmc_t *m, __htree_node_t *n);
+
+/* Bring a state vector into its canonical form by sorting the
+   branches of every symmetric group. */
+static void __ctmc_canon(ctmc_t *m, __ctmc_lstate_t *v);
+
+/* Resolve all the instantaneous moves enabled in the vector found
+   at depth d of the work space. The tangible states that are reached
+   are accumulated as outcomes, along with their probabilities. */
+static int __ctmc_settle(ctmc_t *m, int d, double p);
+
+/* Find the state in the state table, or insert it if it is new. */
+static int __ctmc_lookup(ctmc_t *m, __ctmc_lstate_t *v);
+
+/* Generate all the transitions out of state s. */
+static int __ctmc_explore(ctmc_t *m, int s);
+
+/* Find all the tangible states of m, from the outcomes of its start
+   (left in m->outv), keeping them in the diagram m->mdd. */
+static int __ctmc_reach(ctmc_t *m);
+
+/* Allocate the work space of m and explore its tangible states,
+   starting with every task at its first step. */
+static int __ctmc_build(ctmc_t *m);
+
+
+static int __ctmc_cmp_int(const void *a, const void *b) {
+    return *(const int *) a - *(const int *) b;
+}
+
+int __ctmc_step(__ctmc_leaf_t *l, __ctmc_act_t act, int *peers, int n) {
+    __ctmc_step_t *s;
+
+    if (!(s = (__ctmc_step_t *)
+          realloc(l->steps, sizeof(__ctmc_step_t)*(l->nsteps + 1))))
+        return -1;
+    l->steps = s;
+    s += l->nsteps++;
+    s->act = act;
+    s->peers.n = n;
+    s->peers.l = NULL;
+    if (n > 0) {
+        if (!(s->peers.l = (int *) malloc(sizeof(int)*n)))
+            return -1;
+        memcpy(s->peers.l, peers, sizeof(int)*n);
+
+        /* The order of the candidates does not matter; keeping them
+           sorted allows binary search while matching partners. */
+        qsort(s->peers.l, n, sizeof(int), __ctmc_cmp_int);
+    }
+    return 0;
+}
+
+/* For a description of the following function, see "ctmc.h". The
+   cases below correspond one to one with those used by
+   __htree_task_def() when the process definitions are written. */
+int ctmc_leaf_def(__htree_node_t *node, __ctmc_leaf_t *l) {
+    __htree_plist_t *so = &node->sol, *si = &node->sil;
+    int i, n, e = 0;
+
+    l->nsteps = 0;
+    l->steps = NULL;
+    l->rate = node->rate;
+    if ((so->n > 0) && (si->n > 0))
+        n = lcm(so->n, si->n);
+    else
+        n = so->n + si->n;
+
+    switch (pattern_matrix[node->ptype][node->stype]) {
+    case 1:
+    case 2:
+        for (i = 0; !e && i < n; i++) {
+            e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+            e |= __ctmc_step(l, ACT_OUT, &si->l[i % si->n], 1);
+        }
+        break;
+    case 4:
+    case 8:
+        for (i = 0; !e && i < n; i++) {
+            e |= __ctmc_step(l, ACT_IN, &so->l[i % so->n], 1);
+            e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+        }
+        break;
+    case 5:
+    case 6:
+    case 9:
+    case 10:
+        for (i = 0; !e && i < n; i++) {
+            e |= __ctmc_step(l, ACT_IN, &so->l[i % so->n], 1);
+            e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+            e |= __ctmc_step(l, ACT_OUT, &si->l[i % si->n], 1);
+        }
+        break;
+    case 3:
+        e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+        e |= __ctmc_step(l, ACT_OUT, si->l, si->n);
+        break;
+    case 12:
+        e |= __ctmc_step(l, ACT_IN, so->l, so->n);
+        e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+        break;
+    case 7:
+    case 11:
+        for (i = 0; !e && i < so->n; i++) {
+            e |= __ctmc_step(l, ACT_IN, &so->l[i], 1);
+            e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+            e |= __ctmc_step(l, ACT_OUT, si->l, si->n);
+        }
+        break;
+    case 13:
+    case 14:
+        for (i = 0; !e && i < si->n; i++) {
+            e |= __ctmc_step(l, ACT_IN, so->l, so->n);
+            e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+            e |= __ctmc_step(l, ACT_OUT, &si->l[i], 1);
+        }
+        break;
+    case 15:
+        e |= __ctmc_step(l, ACT_IN, so->l, so->n);
+        e |= __ctmc_step(l, ACT_COMP, NULL, 0);
+        e |= __ctmc_step(l, ACT_OUT, si->l, si->n);
+        break;
+    default:
+        return -1;
+    }
+    return e ? -1 : 0;
+}
+
+/* Check that exchanging branch 0 and branch b of a group maps every
+   sequential component onto the component at the exchanged position,
+   with partners exchanged accordingly. */
+static int __ctmc_check_swap(ctmc_t *m, __ctmc_group_t *g, int b,
+                             int *sigma) {
+    __ctmc_leaf_t *x, *y;
+    int i, j, k, p, ok = 1;
+
+    for (i = 0; i < m->nleaves; i++)
+        sigma[i] = i;
+    for (i = 0; i < g->size; i++) {
+        sigma[g->first[0] + i] = g->first[b] + i;
+        sigma[g->first[b] + i] = g->first[0] + i;
+    }
+    for (i = 0; ok && i < m->nleaves; i++) {
+        x = &m->leaf[i];
+        y = &m->leaf[sigma[i]];
+        if ((x->nsteps != y->nsteps) || (x->rate != y->rate))
+            ok = 0;
+        for (j = 0; ok && j < x->nsteps; j++) {
+            if ((x->steps[j].act != y->steps[j].act) ||
+                (x->steps[j].peers.n != y->steps[j].peers.n)) {
+                ok = 0;
+                break;
+            }
+            for (k = 0; k < x->steps[j].peers.n; k++) {
+                p = sigma[x->steps[j].peers.l[k]];
+                if (!bsearch(&p, y->steps[j].peers.l, y->steps[j].peers.n,
+                             sizeof(int), __ctmc_cmp_int)) {
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+/* Groups are collected in post-order, so that inner groups are
+   always brought into canonical form before the groups that contain
+   them. Only farms are considered: the round-robin order of a deal
+   distinguishes its branches. */
+int __ctmc_find_groups(ctmc_t *m, __htree_node_t *n) {
+    __htree_child_t *c, **cl;
+    __ctmc_group_t *g;
+    int i, j, k, f, *sigma;
+
+    if (n->mtype == TASK)
+        return 0;
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        if (__ctmc_find_groups(m, c->child) < 0)
+            return -1;
+        c = c->next;
+    }
+    if ((n->mtype != FARM) || (n->nchr < 2))
+        return 0;
+
+    if (!(cl = (__htree_child_t **)
+          calloc(n->nchr, sizeof(__htree_child_t *))))
+        return -1;
+    if (!(sigma = (int *) malloc(sizeof(int)*m->nleaves))) {
+        free(cl);
+        return -1;
+    }
+    c = n->clist;
+    for (i = 0; i < n->nchr; i++) {
+        cl[i] = c;
+        c = c->next;
+    }
+    for (i = 0; i < n->nchr; i++) {
+        if (!cl[i])
+            continue;
+        if (!(g = (__ctmc_group_t *)
+              realloc(m->group, sizeof(__ctmc_group_t)*(m->ngroups + 1))))
+            break;
+        m->group = g;
+        g += m->ngroups;
+        g->nbranch = 0;
+        if (!(g->first = (int *) malloc(sizeof(int)*n->nchr)))
+            break;
+        __htree_leaf_range(cl[i]->child, &g->first[0], &g->size);
+        g->nbranch = 1;
+        for (j = i + 1; j < n->nchr; j++) {
+            if (!cl[j] || !__htree_same_subtree(cl[i]->child, cl[j]->child))
+                continue;
+            __htree_leaf_range(cl[j]->child, &f, &k);
+            g->first[g->nbranch] = f;
+            if (__ctmc_check_swap(m, g, g->nbranch, sigma)) {
+                g->nbranch++;
+                cl[j] = NULL;
+            }
+        }
+        cl[i] = NULL;
+        if (g->nbranch > 1)
+            m->ngroups++;
+        else
+            free(g->first);
+    }
+    free(sigma);
+    free(cl);
+    return (i < n->nchr) ? -1 : 0;
+}
+
+/* Merge sort the branches of a group, using the contents of the
+   branch vectors as keys. */
+static void __ctmc_sort_branches(__ctmc_lstate_t *v, __ctmc_group_t *g,
+                                 int *idx, int *tmp) {
+    int w, lo, mid, hi, i, j, k;
+    size_t len = sizeof(__ctmc_lstate_t)*g->size;
+
+    for (w = 1; w < g->nbranch; w *= 2) {
+        for (lo = 0; lo < g->nbranch - w; lo += 2*w) {
+            mid = lo + w;
+            hi = (mid + w < g->nbranch) ? mid + w : g->nbranch;
+            i = lo;
+            j = mid;
+            k = lo;
+            while (i < mid && j < hi)
+                if (memcmp(v + g->first[idx[j]],
+                           v + g->first[idx[i]], len) < 0)
+                    tmp[k++] = idx[j++];
+                else
+                    tmp[k++] = idx[i++];
+            while (i < mid) tmp[k++] = idx[i++];
+            while (j < hi) tmp[k++] = idx[j++];
+            memcpy(idx + lo, tmp + lo, sizeof(int)*(hi - lo));
+        }
+    }
+}
+
+void __ctmc_canon(ctmc_t *m, __ctmc_lstate_t *v) {
+    __ctmc_group_t *g;
+    __ctmc_lstate_t *t = m->tmpv;
+    int i, j, k, *idx = m->perm, *tmp = m->perm + m->nleaves;
+
+    for (i = 0; i < m->ngroups; i++) {
+        g = &m->group[i];
+        if (g->size == 1) {
+            /* Single task branches: count the components in every
+               local state and write them back in order. */
+            for (j = 0; j < g->nbranch; j++)
+                t[j] = v[g->first[j]];
+            for (j = 1; j < g->nbranch; j++) {
+                __ctmc_lstate_t x = t[j];
+                for (k = j - 1; k >= 0 && t[k] > x; k--)
+                    t[k + 1] = t[k];
+                t[k + 1] = x;
+            }
+            for (j = 0; j < g->nbranch; j++)
+                v[g->first[j]] = t[j];
+        } else {
+            for (j = 0; j < g->nbranch; j++)
+                idx[j] = j;
+            __ctmc_sort_branches(v, g, idx, tmp);
+            for (j = 0; j < g->nbranch; j++)
+                memcpy(t + j*g->size, v + g->first[idx[j]],
+                       sizeof(__ctmc_lstate_t)*g->size);
+            for (j = 0; j < g->nbranch; j++)
+                memcpy(v + g->first[j], t + j*g->size,
+                       sizeof(__ctmc_lstate_t)*g->size);
+        }
+    }
+}
+
+/* Push the moves that are enabled in vector v on the move stack. A
+   move from task i to task k is enabled when task i is ready to send
+   to k, and task k is ready to receive from i. */
+static int __ctmc_moves(ctmc_t *m, __ctmc_lstate_t *v) {
+    __ctmc_step_t *s, *r;
+    int i, j, k, n = 0, *t;
+
+    for (i = 0; i < m->nleaves; i++) {
+        s = &m->leaf[i].steps[v[i]];
+        if (s->act != ACT_OUT)
+            continue;
+        for (j = 0; j < s->peers.n; j++) {
+            k = s->peers.l[j];
+            r = &m->leaf[k].steps[v[k]];
+            if ((r->act != ACT_IN) ||
+                !bsearch(&i, r->peers.l, r->peers.n,
+                         sizeof(int), __ctmc_cmp_int))
+                continue;
+            if (m->mtop + 2 > m->mmax) {
+                if (!(t = (int *) realloc(m->mv, sizeof(int)*2*m->mmax)))
+                    return -1;
+                m->mv = t;
+                m->mmax *= 2;
+            }
+            m->mv[m->mtop++] = i;
+            m->mv[m->mtop++] = k;
+            n++;
+        }
+    }
+    return n;
+}
+
+static int __ctmc_outcome(ctmc_t *m, __ctmc_lstate_t *v, double p) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves;
+    __ctmc_lstate_t *t;
+    double *q;
+    int i, *z;
+
+    if (m->ngroups)
+        __ctmc_canon(m, v);
+    for (i = 0; i < m->nout; i++)
+        if ((m->outt[i] == m->tag) &&
+            !memcmp(m->outv + i*m->nleaves, v, len)) {
+            m->outp[i] += p;
+            return 0;
+        }
+    if (m->nout == m->maxout) {
+        if (!(t = (__ctmc_lstate_t *) realloc(m->outv, 2*m->maxout*len)))
+            return -1;
+        m->outv = t;
+        if (!(q = (double *) realloc(m->outp, sizeof(double)*2*m->maxout)))
+            return -1;
+        m->outp = q;
+        if (!(z = (int *) realloc(m->outt, sizeof(int)*2*m->maxout)))
+            return -1;
+        m->outt = z;
+        m->maxout *= 2;
+    }
+    memcpy(m->outv + m->nout*m->nleaves, v, len);
+    m->outt[m->nout] = m->tag;
+    m->outp[m->nout++] = p;
+    return 0;
+}
+
+/* Check if a task takes its jobs from the outside (no receive). */
+static int __ctmc_is_source(ctmc_t *m, int i) {
+    int k;
+
+    for (k = 0; k < m->leaf[i].nsteps; k++)
+        if (m->leaf[i].steps[k].act == ACT_IN)
+            return 0;
+    return 1;
+}
+
+/* A sink task never sends: its jobs leave the workflow. */
+static int __ctmc_is_sink(ctmc_t *m, int i) {
+    int k;
+
+    for (k = 0; k < m->leaf[i].nsteps; k++)
+        if (m->leaf[i].steps[k].act == ACT_OUT)
+            return 0;
+    return 1;
+}
+
+/* When several moves are enabled at once (for instance, when a farm
+   has more than one idle worker), each of them is chosen with equal
+   probability, as the partners are all passive. A tagged job follows
+   the moves of the task holding it. */
+int __ctmc_settle(ctmc_t *m, int d, double p) {
+    __ctmc_lstate_t *v = m->stack + d*m->nleaves, *w;
+    int base = m->mtop, tag = m->tag, i, j, k, x, y;
+
+    if ((k = __ctmc_moves(m, v)) < 0)
+        return -1;
+    if (k == 0)
+        return __ctmc_outcome(m, v, p);
+    if (d + 1 >= m->maxdepth) {
+        fprintf(report_file, "Instantaneous moves do not terminate.\n");
+        return -1;
+    }
+    w = v + m->nleaves;
+    for (i = 0; i < k; i++) {
+        memcpy(w, v, sizeof(__ctmc_lstate_t)*m->nleaves);
+        x = m->mv[base + 2*i];
+        y = m->mv[base + 2*i + 1];
+        if (m->mflow && ((j = ctmc_move_index(m, x, y)) >= 0))
+            m->mflow[j] += m->mweight*p/k;
+        w[x] = (w[x] + 1) % m->leaf[x].nsteps;
+        w[y] = (w[y] + 1) % m->leaf[y].nsteps;
+
+        /* A source starts a new job as soon as it sends one. */
+        if (tag == x)
+            m->tag = y;
+        else if ((tag == CTMC_ARMED) && __ctmc_is_source(m, x))
+            m->tag = x;
+        if (__ctmc_settle(m, d + 1, p/k) < 0)
+            return -1;
+        m->tag = tag;
+    }
+    m->mtop = base;
+    return 0;
+}
+
+/* FNV-1a hash of a state vector. */
+static unsigned int __ctmc_hash(__ctmc_lstate_t *v, int n) {
+    unsigned char *b = (unsigned char *) v;
+    unsigned int h = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(__ctmc_lstate_t)*n; i++) {
+        h ^= b[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* 64-bit FNV-1a fingerprint of a state vector, for hash compaction. */
+static unsigned long long __ctmc_fingerprint(__ctmc_lstate_t *v, int n) {
+    unsigned char *b = (unsigned char *) v;
+    unsigned long long f = 14695981039346656037ull;
+    size_t i;
+
+    for (i = 0; i < sizeof(__ctmc_lstate_t)*n; i++) {
+        f ^= b[i];
+        f *= 1099511628211ull;
+    }
+    return f;
+}
+
+/* Slot of a fingerprint in a hash table of the given size. */
+#define __ctmc_fpslot(f,size) ((unsigned int) ((f) ^ ((f) >> 32)) & ((size) - 1))
+
+static int __ctmc_rehash(ctmc_t *m, int size) {
+    unsigned long long *f = NULL;
+    unsigned int h;
+    int i, *t;
+
+    if (!(t = (int *) store_alloc(sizeof(int)*size)) ||
+        (m->compact && !(f = (unsigned long long *)
+                         store_alloc(sizeof(unsigned long long)*size)))) {
+        store_free(t);
+        return -1;
+    }
+    store_advise(t, sizeof(int)*size, STORE_RANDOM);
+    for (i = 0; i < size; i++)
+        t[i] = -1;
+    if (m->compact) {
+        /* The states are gone: move the fingerprints instead. */
+        for (i = 0; i < m->hsize; i++) {
+            if (m->hash[i] < 0)
+                continue;
+            h = __ctmc_fpslot(m->fp[i], size);
+            while (t[h] >= 0)
+                h = (h + 1) & (size - 1);
+            t[h] = m->hash[i];
+            f[h] = m->fp[i];
+        }
+        store_free(m->fp);
+        m->fp = f;
+    } else
+        for (i = 0; i < m->nstates; i++) {
+            h = __ctmc_hash(ctmc_state(m, i), m->nleaves) & (size - 1);
+            while (t[h] >= 0)
+                h = (h + 1) & (size - 1);
+            t[h] = i;
+        }
+    store_free(m->hash);
+    m->hash = t;
+    m->hsize = size;
+    return 0;
+}
+
+int __ctmc_lookup(ctmc_t *m, __ctmc_lstate_t *v) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves;
+    unsigned long long f = 0;
+    __ctmc_lstate_t *t;
+    unsigned int h;
+
+    /* In a diagram, the states are all known by then. */
+    if (m->mdd)
+        return (int) mdd_index(m->mdd, v);
+    if (m->compact) {
+        /* States with the same fingerprint are taken to be the same:
+           if they are not, one of them is omitted. */
+        f = __ctmc_fingerprint(v, m->nleaves);
+        h = __ctmc_fpslot(f, m->hsize);
+        while (m->hash[h] >= 0) {
+            if (m->fp[h] == f)
+                return m->hash[h];
+            h = (h + 1) & (m->hsize - 1);
+        }
+    } else {
+        h = __ctmc_hash(v, m->nleaves) & (m->hsize - 1);
+        while (m->hash[h] >= 0) {
+            if (!memcmp(ctmc_state(m, m->hash[h]), v, len))
+                return m->hash[h];
+            h = (h + 1) & (m->hsize - 1);
+        }
+    }
+
+    /* This is a new state. */
+    if (m->limit && (m->nstates >= m->limit))
+        return -1;
+    if (m->nstates - m->sbase == m->maxstates) {
+        if (!(t = (__ctmc_lstate_t *)
+              store_realloc(m->state, 2*m->maxstates*len)))
+            return -1;
+        m->state = t;
+        m->maxstates *= 2;
+    }
+    memcpy(ctmc_state(m, m->nstates), v, len);
+    if (m->compact)
+        m->fp[h] = f;
+    m->hash[h] = m->nstates++;
+    if (2*m->nstates > m->hsize)
+        if (__ctmc_rehash(m, 2*m->hsize) < 0)
+            return -1;
+    return m->nstates - 1;
+}
+
+/* In symmetry reduction mode, firing a task in a branch which is
+   identical to the branch before it leads to the same canonical
+   state as firing the task in the earlier branch. Such tasks are
+   skipped, and the first task of every run of identical branches is
+   fired on their behalf. Returns the number of tasks represented by
+   task i, or zero if it should be skipped. */
+static int __ctmc_multiplicity(ctmc_t *m, __ctmc_lstate_t *v, int i) {
+    __ctmc_group_t *g;
+    size_t len;
+    int j, b, r, x = 1;
+
+    for (j = 0; j < m->ngroups; j++) {
+        g = &m->group[j];
+        len = sizeof(__ctmc_lstate_t)*g->size;
+        if ((i < g->first[0]) ||
+            (i >= g->first[g->nbranch - 1] + g->size))
+            continue;
+        for (b = 0; b < g->nbranch; b++)
+            if ((i >= g->first[b]) && (i < g->first[b] + g->size))
+                break;
+        if (b == g->nbranch)
+            continue;
+        if ((b > 0) && !memcmp(v + g->first[b - 1], v + g->first[b], len))
+            return 0;
+        for (r = 1; b + r < g->nbranch; r++)
+            if (memcmp(v + g->first[b], v + g->first[b + r], len))
+                break;
+        x *= r;
+    }
+    return x;
+}
+
+int __ctmc_explore(ctmc_t *m, int s) {
+    __ctmc_lstate_t *v = m->stack;
+    double *y;
+    int i, j, k, t, x, *z;
+
+    for (i = 0; i < m->nleaves; i++) {
+        if (m->leaf[i].steps[ctmc_state(m, s)[i]].act != ACT_COMP)
+            continue;
+        memcpy(v, ctmc_state(m, s), sizeof(__ctmc_lstate_t)*m->nleaves);
+        if (!(x = m->ngroups ? __ctmc_multiplicity(m, v, i) : 1))
+            continue;
+        v[i] = (v[i] + 1) % m->leaf[i].nsteps;
+        m->nout = 0;
+        if (__ctmc_settle(m, 0, 1.0) < 0)
+            return -1;
+        for (j = 0; j < m->nout; j++) {
+            if ((t = __ctmc_lookup(m, m->outv + j*m->nleaves)) < 0)
+                return -1;
+            if (t == s)
+                continue; /* Self-loops do not affect the solution. */
+            for (k = m->row[s]; k < m->ntrans; k++)
+                if (m->col[k] == t)
+                    break;
+            if (k == m->ntrans) {
+                if (m->ntrans == m->maxtrans) {
+                    if (!(z = (int *) store_realloc(m->col, sizeof(int)*
+                                                    2*m->maxtrans)))
+                        return -1;
+                    m->col = z;
+                    if (!(y = (double *)
+                          store_realloc(m->val,
+                                        sizeof(double)*2*m->maxtrans)))
+                        return -1;
+                    m->val = y;
+                    m->maxtrans *= 2;
+                }
+                m->col[k] = t;
+                m->val[k] = 0.0;
+                m->ntrans++;
+            }
+            m->val[k] += x*m->leaf[i].rate*m->outp[j];
+            m->out[s] += x*m->leaf[i].rate*m->outp[j];
+        }
+    }
+    return 0;
+}
+
+/* Derive the CTMC with the visited states stored as kind says: 0
+   (explicitly), CTMC_HASH or CTMC_MDD. */
+static ctmc_t *__ctmc_derive(__htree_node_t *root, __htree_node_t **sstab,
+                             int nleaves, int symmetric, int kind) {
+    ctmc_t *m;
+    int i, *size;
+
+    if (!(m = (ctmc_t *) calloc(1, sizeof(ctmc_t))))
+        return NULL;
+    m->nleaves = nleaves;
+    m->compact = (kind == CTMC_HASH);
+    if (!(m->leaf = (__ctmc_leaf_t *) calloc(nleaves, sizeof(__ctmc_leaf_t))))
+        goto fail;
+    for (i = 0; i < nleaves; i++)
+        if (ctmc_leaf_def(sstab[i], &m->leaf[i]) < 0) {
+            fprintf(report_file, "Cannot derive process for task %d.\n", i);
+            goto fail;
+        }
+    if (kind == CTMC_MDD) {
+        /* A level for every task, of its steps. */
+        if (!(size = (int *) malloc(sizeof(int)*nleaves)))
+            goto fail;
+        for (i = 0; i < nleaves; i++)
+            size[i] = m->leaf[i].nsteps;
+        m->mdd = mdd_new(nleaves, size);
+        free(size);
+        if (!m->mdd)
+            goto fail;
+    }
+    if ((symmetric && (__ctmc_find_groups(m, root) < 0)) ||
+        (__ctmc_build(m) < 0))
+        goto fail;
+    return m;
+
+ fail:
+    ctmc_destroy(m);
+    return NULL;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+ctmc_t *ctmc_derive(__htree_node_t *root, __htree_node_t **sstab,
+                    int nleaves, int symmetric) {
+    return __ctmc_derive(root, sstab, nleaves, symmetric, 0);
+}
+
+ctmc_t *ctmc_derive_compact(__htree_node_t *root, __htree_node_t **sstab,
+                            int nleaves, int symmetric) {
+    return __ctmc_derive(root, sstab, nleaves, symmetric, CTMC_HASH);
+}
+
+ctmc_t *ctmc_derive_mdd(__htree_node_t *root, __htree_node_t **sstab,
+                        int nleaves, int symmetric) {
+    return __ctmc_derive(root, sstab, nleaves, symmetric, CTMC_MDD);
+}
+
+double ctmc_explicit_bytes(ctmc_t *m) {
+    double v = 1024.0, h = 1024.0;
+
+    /* Both tables start with 1024 entries, and double: the state
+       table once it is full, the hash table once it is half full. */
+    while (v < m->nstates)
+        v *= 2.0;
+    while (h < 2.0*m->nstates)
+        h *= 2.0;
+    return sizeof(__ctmc_lstate_t)*m->nleaves*v + sizeof(int)*h;
+}
+
+double ctmc_omission(ctmc_t *m) {
+    double n = m->nstates;
+
+    /* Birthday bound: any two of the n states may share a
+       fingerprint, with probability 2^-64. */
+    return m->compact ? n*(n - 1.0)/2.0/18446744073709551616.0 : 0.0;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+ctmc_t *ctmc_derive_leaves(__ctmc_leaf_t *leaf, int nleaves) {
+    return ctmc_derive_groups(leaf, nleaves, NULL, 0);
+}
+
+ctmc_t *ctmc_derive_groups(__ctmc_leaf_t *leaf, int nleaves,
+                           __ctmc_group_t *group, int ngroups) {
+    return ctmc_derive_bounded(leaf, nleaves, group, ngroups, 0);
+}
+
+ctmc_t *ctmc_derive_bounded(__ctmc_leaf_t *leaf, int nleaves,
+                            __ctmc_group_t *group, int ngroups, int limit) {
+    ctmc_t *m;
+
+    if (!(m = (ctmc_t *) calloc(1, sizeof(ctmc_t)))) {
+        for (; nleaves > 0; nleaves--)
+            ctmc_leaf_free(&leaf[nleaves - 1]);
+        free(leaf);
+        for (; ngroups > 0; ngroups--)
+            free(group[ngroups - 1].first);
+        free(group);
+        return NULL;
+    }
+    m->nleaves = nleaves;
+    m->leaf = leaf;
+    m->ngroups = ngroups;
+    m->group = group;
+    m->limit = limit;
+    if (__ctmc_build(m) < 0) {
+        ctmc_destroy(m);
+        return NULL;
+    }
+    return m;
+}
+
+/* Number of tasks in the vectors being sorted. */
+static int __ctmc_nsort;
+
+/* Lexicographic order of the state vectors (that of a diagram). */
+static int __ctmc_cmp_vector(const void *a, const void *b) {
+    const __ctmc_lstate_t *v = (const __ctmc_lstate_t *) a;
+    const __ctmc_lstate_t *w = (const __ctmc_lstate_t *) b;
+    int i;
+
+    for (i = 0; i < __ctmc_nsort; i++)
+        if (v[i] != w[i])
+            return (int) v[i] - (int) w[i];
+    return 0;
+}
+
+/* Sort the n state vectors v, and keep one of every run of equal
+   vectors, unless it is already a state of the diagram. Returns the
+   number of vectors kept. */
+static int __ctmc_fresh(ctmc_t *m, __ctmc_lstate_t *v, int n) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves;
+    int i, k = 0;
+
+    __ctmc_nsort = m->nleaves;
+    qsort(v, n, len, __ctmc_cmp_vector);
+    for (i = 0; i < n; i++) {
+        if ((k > 0) && !memcmp(v + (k - 1)*m->nleaves, v + i*m->nleaves,
+                               len))
+            continue;
+        if (mdd_index(m->mdd, v + i*m->nleaves) >= 0)
+            continue;
+        if (k < i)
+            memcpy(v + k*m->nleaves, v + i*m->nleaves, len);
+        k++;
+    }
+    return k;
+}
+
+/* The states are found breadth first, a layer at a time: the new
+   states reached from a layer make the next one, which is added to
+   the diagram at once. The successors are found as in
+   __ctmc_explore(), without the transitions. */
+int __ctmc_reach(ctmc_t *m) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves, b;
+    __ctmc_lstate_t *front, *next = NULL, *v, *t;
+    int i, k, nf, nn, maxf, maxn = 1024, ret = -1;
+
+    maxf = m->nout ? m->nout : 1;
+    if (!(front = (__ctmc_lstate_t *) malloc(len*maxf)) ||
+        !(next = (__ctmc_lstate_t *) malloc(len*maxn)))
+        goto done;
+    memcpy(front, m->outv, len*m->nout);
+    nf = __ctmc_fresh(m, front, m->nout);
+    while (nf > 0) {
+        if (mdd_add(m->mdd, front, nf) < 0)
+            goto done;
+        if ((b = mdd_bytes(m->mdd) + len*(maxf + maxn)) > m->bytes)
+            m->bytes = b;
+        for (nn = 0, k = 0; k < nf; k++)
+            for (i = 0; i < m->nleaves; i++) {
+                v = front + k*m->nleaves;
+                if (m->leaf[i].steps[v[i]].act != ACT_COMP)
+                    continue;
+                memcpy(m->stack, v, len);
+                if (m->ngroups && !__ctmc_multiplicity(m, m->stack, i))
+                    continue;
+                m->stack[i] = (m->stack[i] + 1) % m->leaf[i].nsteps;
+                m->nout = 0;
+                if (__ctmc_settle(m, 0, 1.0) < 0)
+                    goto done;
+                if (nn + m->nout > maxn) {
+                    /* Drop the states seen before, and grow the layer
+                       if it is still more than half full. */
+                    nn = __ctmc_fresh(m, next, nn);
+                    if (2*(nn + m->nout) > maxn) {
+                        while (2*(nn + m->nout) > maxn)
+                            maxn *= 2;
+                        if (!(t = (__ctmc_lstate_t *)
+                              realloc(next, len*maxn)))
+                            goto done;
+                        next = t;
+                    }
+                }
+                memcpy(next + nn*m->nleaves, m->outv, len*m->nout);
+                nn += m->nout;
+            }
+        nf = __ctmc_fresh(m, next, nn);
+        t = front;
+        front = next;
+        next = t;
+        k = maxf;
+        maxf = maxn;
+        maxn = k;
+    }
+    m->nstates = (int) m->mdd->card[m->mdd->root];
+    mdd_seal(m->mdd);
+    ret = 0;
+
+ done:
+    free(front);
+    free(next);
+    return ret;
+}
+
+/* Keep the most memory taken so far by the visited states: their
+   vectors, the hash table with its fingerprints, the diagram, and
+   the rewards (cap of them) kept when the vectors are not. */
+static void __ctmc_account(ctmc_t *m, int cap) {
+    size_t b = sizeof(__ctmc_lstate_t)*m->nleaves*m->maxstates +
+        sizeof(int)*m->hsize;
+
+    if (m->compact)
+        b += sizeof(unsigned long long)*m->hsize;
+    if (m->mdd)
+        b += mdd_bytes(m->mdd);
+    if (!ctmc_has_vectors(m))
+        b += sizeof(double)*cap;
+    if (b > m->bytes)
+        m->bytes = b;
+}
+
+int __ctmc_build(ctmc_t *m) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves;
+    __ctmc_lstate_t *v;
+    double *y;
+    int i, s, cap, *z, nleaves = m->nleaves;
+
+    /* Work space for resolving moves and for canonical forms. With a
+       diagram, only the vector of the state explored is kept. */
+    m->tag = CTMC_NOTAG;
+    m->maxdepth = nleaves + 2;
+    m->mmax = 4*nleaves;
+    m->maxout = 16;
+    m->maxstates = m->mdd ? 1 : 1024;
+    m->maxtrans = 4096;
+    if (!(m->stack = (__ctmc_lstate_t *)
+          malloc(sizeof(__ctmc_lstate_t)*m->maxdepth*nleaves)) ||
+        !(m->mv = (int *) malloc(sizeof(int)*m->mmax)) ||
+        !(m->perm = (int *) malloc(sizeof(int)*2*nleaves)) ||
+        !(m->tmpv = (__ctmc_lstate_t *)
+          malloc(sizeof(__ctmc_lstate_t)*nleaves)) ||
+        !(m->outv = (__ctmc_lstate_t *)
+          malloc(sizeof(__ctmc_lstate_t)*m->maxout*nleaves)) ||
+        !(m->outp = (double *) malloc(sizeof(double)*m->maxout)) ||
+        !(m->outt = (int *) malloc(sizeof(int)*m->maxout)) ||
+        !(m->state = (__ctmc_lstate_t *)
+          store_alloc(sizeof(__ctmc_lstate_t)*m->maxstates*nleaves)) ||
+        !(m->col = (int *) store_alloc(sizeof(int)*m->maxtrans)) ||
+        !(m->val = (double *) store_alloc(sizeof(double)*m->maxtrans)) ||
+        (!m->mdd && (__ctmc_rehash(m, 1024) < 0)))
+        return -1;
+
+    /* Every task starts at its first step. */
+    memset(m->stack, 0, sizeof(__ctmc_lstate_t)*nleaves);
+    if (__ctmc_settle(m, 0, 1.0) < 0)
+        return -1;
+    if (m->mdd) {
+        /* The states are all found first, and numbered by their rank
+           in the diagram: the start of the model is not kept. */
+        if (__ctmc_reach(m) < 0)
+            return -1;
+    } else {
+        if (!(m->init = (double *) calloc(m->nout, sizeof(double))))
+            return -1;
+        for (i = 0; i < m->nout; i++) {
+            if ((s = __ctmc_lookup(m, m->outv + i*nleaves)) < 0)
+                return -1;
+            m->init[s] += m->outp[i];
+        }
+        m->ninit = m->nstates;
+    }
+
+    /* Breadth first exploration of the tangible states (in the order
+       of their ranks, with a diagram). */
+    for (s = 0, cap = 0; s < m->nstates; s++) {
+        if (cap < m->nstates) {
+            /* The state table has grown; keep up with it. */
+            cap = m->compact ? 2*m->nstates :
+                m->mdd ? m->nstates : m->maxstates;
+            if (!(z = (int *) store_realloc(m->row,
+                                            sizeof(int)*(cap + 1))))
+                return -1;
+            m->row = z;
+            if (!(y = (double *) store_realloc(m->out, sizeof(double)*cap)))
+                return -1;
+            m->out = y;
+            if (!ctmc_has_vectors(m)) {
+                if (!(y = (double *)
+                      store_realloc(m->sinkrate, sizeof(double)*cap)))
+                    return -1;
+                m->sinkrate = y;
+            }
+        }
+        if (m->mdd) {
+            mdd_vector(m->mdd, s, m->state);
+            m->sbase = s;
+        }
+        m->row[s] = m->ntrans;
+        m->out[s] = 0.0;
+        if (!ctmc_has_vectors(m))
+            for (v = ctmc_state(m, s), m->sinkrate[s] = 0.0, i = 0;
+                 i < nleaves; i++)
+                if (__ctmc_is_sink(m, i) &&
+                    (m->leaf[i].steps[v[i]].act == ACT_COMP))
+                    m->sinkrate[s] += m->leaf[i].rate;
+        if (__ctmc_explore(m, s) < 0)
+            return -1;
+        __ctmc_account(m, cap);
+        if (m->compact && (s + 1 - m->sbase >= m->nstates - s - 1)) {
+            /* Explored states are not needed any more: drop them
+               once they take as much room as the others. */
+            memmove(m->state, ctmc_state(m, s + 1),
+                    len*(m->nstates - s - 1));
+            m->sbase = s + 1;
+        }
+    }
+    m->row[m->nstates] = m->ntrans;
+    if (!ctmc_has_vectors(m)) {
+        /* Only the generator and the rewards are kept (the sizes of
+           the tables are, for the record), and the diagram. */
+        store_free(m->state);
+        store_free(m->hash);
+        store_free(m->fp);
+        m->state = NULL;
+        m->hash = NULL;
+        m->fp = NULL;
+        return 0;
+    }
+
+    /* The hash table is only needed to find states from now on. */
+    store_advise(m->hash, sizeof(int)*m->hsize, STORE_DONE);
+    return 0;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+int ctmc_transpose(ctmc_t *m, int **trow, int **tcol, double **tval) {
+    int i, k, *r, *c;
+    double *v;
+
+    r = (int *) store_alloc(sizeof(int)*(m->nstates + 1));
+    c = (int *) store_alloc(sizeof(int)*(m->ntrans + 1));
+    v = (double *) store_alloc(sizeof(double)*(m->ntrans + 1));
+    if (!r || !c || !v) {
+        store_free(r);
+        store_free(c);
+        store_free(v);
+        return -1;
+    }
+    memset(r, 0, sizeof(int)*(m->nstates + 1));
+    for (k = 0; k < m->ntrans; k++)
+        r[m->col[k] + 1]++;
+    for (i = 0; i < m->nstates; i++)
+        r[i + 1] += r[i];
+    for (i = 0; i < m->nstates; i++)
+        for (k = m->row[i]; k < m->row[i + 1]; k++) {
+            c[r[m->col[k]]] = i;
+            v[r[m->col[k]]++] = m->val[k];
+        }
+    for (i = m->nstates; i > 0; i--)
+        r[i] = r[i - 1];
+    r[0] = 0;
+    *trow = r;
+    *tcol = c;
+    *tval = v;
+    return 0;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+int ctmc_solve(ctmc_t *m, double tol, int maxiter) {
+    int i, k, it, *trow, *tcol;
+    double *tval, x, s, d;
+
+    if (!m->pi &&
+        !(m->pi = (double *) store_alloc(sizeof(double)*m->nstates)))
+        return -1;
+    /* Gauss-Seidel sweeps over the incoming transitions, which are
+       streamed in order (as are the exit rates). */
+    if (ctmc_transpose(m, &trow, &tcol, &tval) < 0)
+        return -1;
+    store_advise(trow, sizeof(int)*(m->nstates + 1), STORE_SEQUENTIAL);
+    store_advise(tcol, sizeof(int)*m->ntrans, STORE_SEQUENTIAL);
+    store_advise(tval, sizeof(double)*m->ntrans, STORE_SEQUENTIAL);
+    store_advise(m->out, sizeof(double)*m->nstates, STORE_SEQUENTIAL);
+    if (!m->ckpt || !m->ckpt->iter)
+        for (i = 0; i < m->nstates; i++)
+            m->pi[i] = 1.0/m->nstates;
+    for (it = 1; it <= maxiter; it++) {
+        d = 0.0;
+        s = 0.0;
+        for (i = 0; i < m->nstates; i++) {
+            if (m->out[i] == 0.0) {
+                s += m->pi[i];
+                continue; /* Absorbing state. */
+            }
+            for (x = 0.0, k = trow[i]; k < trow[i + 1]; k++)
+                x += m->pi[tcol[k]]*tval[k];
+            x /= m->out[i];
+            if (fabs(x - m->pi[i]) > d)
+                d = fabs(x - m->pi[i]);
+            m->pi[i] = x;
+            s += x;
+        }
+        for (i = 0; i < m->nstates; i++)
+            m->pi[i] /= s;
+        if (m->ckpt) {
+            m->ckpt->iter++;
+            if ((m->ckpt->done = (d/s < tol)) || !(it % CTMC_CHECKPOINT))
+                store_sync(m->ckpt);
+        }
+        if (d/s < tol)
+            break;
+    }
+    store_free(trow);
+    store_free(tcol);
+    store_free(tval);
+    return (it > maxiter) ? -1 : it;
+}
+
+/* Hash of the transitions of the chain (FNV-1a), which identifies it
+   across runs. */
+static unsigned int __ctmc_signature(ctmc_t *m) {
+    unsigned int h = 2166136261u;
+    int i;
+
+    for (i = 0; i <= m->nstates; i++)
+        h = (h ^ (unsigned int) m->row[i])*16777619u;
+    for (i = 0; i < m->ntrans; i++)
+        h = (h ^ (unsigned int) m->col[i])*16777619u;
+    return h;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+int ctmc_resume(ctmc_t *m, const char *name) {
+    __ctmc_ckpt_t *c;
+    unsigned int sig;
+    int found;
+
+    if (!(c = (__ctmc_ckpt_t *)
+          store_map(name, sizeof(__ctmc_ckpt_t) +
+                    sizeof(double)*m->nstates, &found)))
+        return -1;
+    sig = __ctmc_signature(m);
+    if (!found || (c->magic != CTMC_MAGIC) ||
+        (c->nstates != m->nstates) || (c->ntrans != m->ntrans) ||
+        (c->sig != sig)) {
+        /* Another chain, or none: start afresh. */
+        c->magic = CTMC_MAGIC;
+        c->nstates = m->nstates;
+        c->ntrans = m->ntrans;
+        c->sig = sig;
+        c->iter = 0;
+        c->done = 0;
+    }
+    store_free(m->pi);
+    m->pi = (double *) (c + 1);
+    m->ckpt = c;
+    return c->iter;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+static int __ctmc_cmp_pair(const void *a, const void *b) {
+    const int *x = (const int *) a, *y = (const int *) b;
+
+    return (x[0] != y[0]) ? x[0] - y[0] : x[1] - y[1];
+}
+
+/* For a description of the following function, see "ctmc.h". A move
+   from i to k exists if i sends to k at some step, and k receives
+   from i at some step. */
+int ctmc_moves(ctmc_t *m) {
+    __ctmc_step_t *s, *r;
+    int i, j, k, a, b, n = 0, max = 16, *t;
+
+    free(m->moves);
+    if (!(m->moves = (int *) malloc(sizeof(int)*2*max)))
+        return -1;
+    for (i = 0; i < m->nleaves; i++)
+        for (a = 0; a < m->leaf[i].nsteps; a++) {
+            s = &m->leaf[i].steps[a];
+            if (s->act != ACT_OUT)
+                continue;
+            for (j = 0; j < s->peers.n; j++) {
+                if ((k = s->peers.l[j]) < 0)
+                    continue;
+                for (b = 0; b < m->leaf[k].nsteps; b++) {
+                    r = &m->leaf[k].steps[b];
+                    if ((r->act == ACT_IN) &&
+                        bsearch(&i, r->peers.l, r->peers.n,
+                                sizeof(int), __ctmc_cmp_int))
+                        break;
+                }
+                if (b == m->leaf[k].nsteps)
+                    continue;
+                if (n == max) {
+                    if (!(t = (int *) realloc(m->moves,
+                                              sizeof(int)*4*max)))
+                        return -1;
+                    m->moves = t;
+                    max *= 2;
+                }
+                m->moves[2*n] = i;
+                m->moves[2*n + 1] = k;
+                n++;
+            }
+        }
+    qsort(m->moves, n, 2*sizeof(int), __ctmc_cmp_pair);
+    for (a = 0, b = 0; b < n; b++)
+        if (!a || __ctmc_cmp_pair(m->moves + 2*(a - 1), m->moves + 2*b)) {
+            m->moves[2*a] = m->moves[2*b];
+            m->moves[2*a + 1] = m->moves[2*b + 1];
+            a++;
+        }
+    return m->nmoves = a;
+}
+
+int ctmc_move_index(ctmc_t *m, int i, int k) {
+    int key[2], *p;
+
+    key[0] = i;
+    key[1] = k;
+    if (!m->moves ||
+        !(p = (int *) bsearch(key, m->moves, m->nmoves, 2*sizeof(int),
+                              __ctmc_cmp_pair)))
+        return -1;
+    return (p - m->moves)/2;
+}
+
+ctmc_t *ctmc_worker(ctmc_t *m) {
+    ctmc_t *w;
+    int n = m->nleaves;
+
+    if (!(w = (ctmc_t *) malloc(sizeof(ctmc_t))))
+        return NULL;
+    memcpy(w, m, sizeof(ctmc_t));
+    w->mtop = 0;
+    w->mflow = NULL;
+    if (!(w->stack = (__ctmc_lstate_t *)
+          malloc(sizeof(__ctmc_lstate_t)*w->maxdepth*n)) ||
+        !(w->mv = (int *) malloc(sizeof(int)*w->mmax)) ||
+        !(w->perm = (int *) malloc(sizeof(int)*2*n)) ||
+        !(w->tmpv = (__ctmc_lstate_t *) malloc(sizeof(__ctmc_lstate_t)*n)) ||
+        !(w->outv = (__ctmc_lstate_t *)
+          malloc(sizeof(__ctmc_lstate_t)*w->maxout*n)) ||
+        !(w->outp = (double *) malloc(sizeof(double)*w->maxout)) ||
+        !(w->outt = (int *) malloc(sizeof(int)*w->maxout))) {
+        ctmc_worker_free(w);
+        return NULL;
+    }
+    return w;
+}
+
+void ctmc_worker_free(ctmc_t *w) {
+    if (!w)
+        return;
+    free(w->stack);
+    free(w->mv);
+    free(w->perm);
+    free(w->tmpv);
+    free(w->outv);
+    free(w->outp);
+    free(w->outt);
+    free(w);
+}
+
+/* For a description of the following function, see "ctmc.h". Under
+   symmetry reduction, only the first of a run of identical branches
+   fires, on behalf of all of them (as in __ctmc_explore()). */
+int ctmc_fire(ctmc_t *m, int s, int leaf, double w) {
+    __ctmc_lstate_t *v = m->stack;
+    int x;
+
+    m->nout = 0;
+    m->mtop = 0;
+    memcpy(v, ctmc_state(m, s), sizeof(__ctmc_lstate_t)*m->nleaves);
+    if (m->leaf[leaf].steps[v[leaf]].act != ACT_COMP)
+        return 0;
+    if (!(x = m->ngroups ? __ctmc_multiplicity(m, v, leaf) : 1))
+        return 0;
+    v[leaf] = (v[leaf] + 1) % m->leaf[leaf].nsteps;
+    m->mweight = x*w;
+    return __ctmc_settle(m, 0, 1.0);
+}
+
+/* For a description of the following function, see "ctmc.h". Every
+   task is fired again in every state, as in __ctmc_explore(). */
+int ctmc_terms(ctmc_t *m, int **trans, int **leaf, double **coef) {
+    int s, i, j, k, t, n = 0, max = m->ntrans, *tr, *lf, *z;
+    double *cf, *y;
+
+    tr = (int *) malloc(sizeof(int)*max);
+    lf = (int *) malloc(sizeof(int)*max);
+    cf = (double *) malloc(sizeof(double)*max);
+    if (!tr || !lf || !cf)
+        goto fail;
+    for (s = 0; s < m->nstates; s++)
+        for (i = 0; i < m->nleaves; i++) {
+            if (ctmc_fire(m, s, i, 1.0) < 0)
+                goto fail;
+            for (j = 0; j < m->nout; j++) {
+                if (((t = ctmc_find(m, m->outv + j*m->nleaves)) < 0) ||
+                    (t == s))
+                    continue;
+                for (k = m->row[s]; (k < m->row[s + 1]) &&
+                         (m->col[k] != t); k++)
+                    ;
+                if (k == m->row[s + 1])
+                    goto fail;
+                if (n && (tr[n - 1] == k) && (lf[n - 1] == i)) {
+                    cf[n - 1] += m->mweight*m->outp[j];
+                    continue;
+                }
+                if (n == max) {
+                    max *= 2;
+                    if (!(z = (int *) realloc(tr, sizeof(int)*max)))
+                        goto fail;
+                    tr = z;
+                    if (!(z = (int *) realloc(lf, sizeof(int)*max)))
+                        goto fail;
+                    lf = z;
+                    if (!(y = (double *) realloc(cf, sizeof(double)*max)))
+                        goto fail;
+                    cf = y;
+                }
+                tr[n] = k;
+                lf[n] = i;
+                cf[n++] = m->mweight*m->outp[j];
+            }
+        }
+    *trans = tr;
+    *leaf = lf;
+    *coef = cf;
+    return n;
+
+ fail:
+    free(tr);
+    free(lf);
+    free(cf);
+    return -1;
+}
+
+int ctmc_find(ctmc_t *m, __ctmc_lstate_t *v) {
+    size_t len = sizeof(__ctmc_lstate_t)*m->nleaves;
+    unsigned int h;
+
+    h = __ctmc_hash(v, m->nleaves) & (m->hsize - 1);
+    while (m->hash[h] >= 0) {
+        if (!memcmp(ctmc_state(m, m->hash[h]), v, len))
+            return m->hash[h];
+        h = (h + 1) & (m->hsize - 1);
+    }
+    return -1;
+}
+
+double ctmc_throughput(ctmc_t *m, int leaf) {
+    __ctmc_leaf_t *l = &m->leaf[leaf];
+    double x = 0.0;
+    int s;
+
+    if (!m->pi)
+        return 0.0;
+    for (s = 0; s < m->nstates; s++)
+        if (l->steps[ctmc_state(m, s)[leaf]].act == ACT_COMP)
+            x += m->pi[s];
+    return x*l->rate;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+int ctmc_leaf_copy(__ctmc_leaf_t *l, __ctmc_leaf_t *c, int *map,
+                   double f) {
+    __ctmc_step_t *s, *t;
+    int i, j, k;
+
+    c->rate = l->rate*f;
+    c->nsteps = 0;
+    if (!(c->steps = (__ctmc_step_t *)
+          malloc(sizeof(__ctmc_step_t)*l->nsteps)))
+        return -1;
+    for (k = 0; k < l->nsteps; k++) {
+        t = &l->steps[k];
+        for (j = 0; (j < t->peers.n) && (map[t->peers.l[j]] < 0); j++)
+            ;
+        if ((t->act != ACT_COMP) && (j == t->peers.n))
+            continue;
+        s = &c->steps[c->nsteps++];
+        s->act = t->act;
+        s->peers.n = 0;
+        s->peers.l = NULL;
+        if ((t->peers.n > 0) &&
+            !(s->peers.l = (int *) malloc(sizeof(int)*t->peers.n)))
+            return -1;
+
+        /* Peers which are renumbered alike are merged; the list is
+           kept sorted for the binary search. */
+        for (j = 0; j < t->peers.n; j++)
+            if (map[t->peers.l[j]] >= 0)
+                s->peers.l[s->peers.n++] = map[t->peers.l[j]];
+        qsort(s->peers.l, s->peers.n, sizeof(int), __ctmc_cmp_int);
+        for (i = j = 0; j < s->peers.n; j++)
+            if ((j == 0) || (s->peers.l[j] != s->peers.l[j - 1]))
+                s->peers.l[i++] = s->peers.l[j];
+        s->peers.n = i;
+    }
+    return 0;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+void ctmc_leaf_free(__ctmc_leaf_t *l) {
+    int j;
+
+    for (j = 0; j < l->nsteps; j++)
+        free(l->steps[j].peers.l);
+    free(l->steps);
+    l->steps = NULL;
+    l->nsteps = 0;
+}
+
+/* For a description of the following function, see "ctmc.h". */
+void ctmc_destroy(ctmc_t *m) {
+    int i;
+
+    if (!m)
+        return;
+    if (m->leaf)
+        for (i = 0; i < m->nleaves; i++)
+            ctmc_leaf_free(&m->leaf[i]);
+    for (i = 0; i < m->ngroups; i++)
+        free(m->group[i].first);
+    free(m->group);
+    free(m->leaf);
+    store_free(m->state);
+    store_free(m->hash);
+    store_free(m->fp);
+    mdd_destroy(m->mdd);
+    store_free(m->sinkrate);
+    store_free(m->row);
+    store_free(m->col);
+    store_free(m->val);
+    store_free(m->out);
+    store_free(m->pi); /* Inside the checkpoint, if there is one. */
+    free(m->init);
+    free(m->block);
+    free(m->stack);
+    free(m->mv);
+    free(m->perm);
+    free(m->tmpv);
+    free(m->outv);
+    free(m->outp);
+    free(m->outt);
+    free(m->moves);
+    free(m);
+}
+
+/* For a description of the following function, see "ctmc.h". The
+   workflow throughput is the rate at which jobs leave the sink tasks
+   of the tree, i.e. those which deliver to SINK_MEM. */
+int htree_solve(void) {
+    ctmc_t *m, *q;
+    unsigned int *label = NULL;
+    char name[256], *base;
+    size_t now, peak;
+    double x = 0.0, e;
+    int i, s, it = -1;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(m = ((compaction == CTMC_HASH) ? ctmc_derive_compact :
+               (compaction == CTMC_MDD) ? ctmc_derive_mdd : ctmc_derive)
+          (__htree_rt.htree, __htree_rt.sstab, __htree_rt.nleaves,
+           symmetry))) {
+        fprintf(report_file, "Could not derive the CTMC.\n");
+        return -1;
+    }
+    fprintf(report_file, "CTMC: %d states, %d transitions", m->nstates,
+            m->ntrans);
+    if (m->ngroups)
+        fprintf(report_file, " (%d symmetric group%s)", m->ngroups,
+                (m->ngroups > 1) ? "s" : "");
+    fprintf(report_file, ".\n");
+    if (m->compact)
+        fprintf(report_file,
+                "Hash compaction: omission probability at most %.3g.\n",
+                ctmc_omission(m));
+    if (!ctmc_has_vectors(m)) {
+        e = ctmc_explicit_bytes(m);
+        fprintf(report_file, "State storage: %.0f bytes at most, against "
+                "%.0f with the state vectors (%.1f%% %s).\n",
+                (double) m->bytes, e, fabs(100.0*(e - m->bytes)/e),
+                (m->bytes <= e) ? "saved" : "more");
+        if (lump)
+            fprintf(report_file, "Lumping needs the states: not lumped.\n");
+        lump = 0;
+    }
+    if (store_dir() && !lump) {
+        /* The solution is named after the description file. */
+        base = strrchr(fname, '/') ? strrchr(fname, '/') + 1 : fname;
+        sprintf(name, "%.240spi", base);
+        if ((s = ctmc_resume(m, name)) > 0)
+            fprintf(report_file,
+                    "Resuming the steady state from %s/%s, after %d "
+                    "iterations.\n", store_dir(), name, s);
+    }
+    if (lump) {
+        /* For ordinary lumping, states which contribute differently
+           to the workflow throughput must be kept apart. */
+        if ((lump == LUMP_ORDINARY) &&
+            (label = (unsigned int *)
+             calloc(m->nstates, sizeof(unsigned int))))
+            for (s = 0; s < m->nstates; s++)
+                for (i = 0; i < m->nleaves; i++)
+                    if ((__htree_rt.sstab[i]->stype == UNKNOWN) &&
+                        (m->leaf[i].steps[m->state[s*m->nleaves + i]].act
+                         == ACT_COMP))
+                        label[s] = label[s]*31 + i + 1;
+        if ((q = ctmc_lump(m, lump, label))) {
+            fprintf(report_file,
+                    "Lumped: %d states into %d blocks (%.2fx smaller).\n",
+                    m->nstates, q->nstates, (double) m->nstates/q->nstates);
+            if ((it = ctmc_solve(q, CTMC_TOLERANCE, CTMC_MAXITER)) >= 0)
+                ctmc_unlump(m, q);
+            ctmc_destroy(q);
+        } else
+            fprintf(report_file, "Could not lump the CTMC.\n");
+        free(label);
+    } else
+        it = ctmc_solve(m, CTMC_TOLERANCE, CTMC_MAXITER);
+    if (it < 0)
+        fprintf(report_file, "Steady state did not converge.\n");
+    else
+        fprintf(report_file, "Steady state: %d iterations.\n", it);
+    if (store_dir()) {
+        store_usage(&now, &peak);
+        fprintf(report_file, "Out-of-core: %.1f MB mapped in %s at most.\n",
+                peak/1048576.0, store_dir());
+    }
+    if (!ctmc_has_vectors(m)) {
+        /* Only the rewards of the states are left. */
+        for (s = 0; m->pi && (s < m->nstates); s++)
+            x += m->pi[s]*m->sinkrate[s];
+        fprintf(report_file, "Throughput: %f\n", x);
+        if (measures || transient || passage || sensitivity)
+            fprintf(report_file,
+                    "Measures need the states: not computed with %s.\n",
+                    m->compact ? "hash compaction" : "a decision diagram");
+        ctmc_destroy(m);
+        return (it < 0) ? -1 : 0;
+    }
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        if (__htree_rt.sstab[i]->stype == UNKNOWN)
+            x += ctmc_throughput(m, i);
+    fprintf(report_file, "Throughput: %f\n", x);
+    if (measures && (it >= 0))
+        htree_write_measures(m);
+    if (transient && (it >= 0))
+        htree_transient(m, transient);
+    if (passage && (it >= 0))
+        htree_passage(m);
+    if (sensitivity && (it >= 0))
+        htree_sensitivity(m);
+    ctmc_destroy(m);
+    return (it < 0) ? -1 : 0;
+}
@@ -0,0 +1,273 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to derive the continuous time Markov chain (CTMC) underlying
+  the PEPA model of a committed skeleton hierarchy tree, and to
+  solve it numerically. The functions are defined in "ctmc.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_CTMC_H
+#define __PEPA_CTMC_H
+
+#include <stdio.h>
+#include "pepa.h"
+
+#define CTMC_TOLERANCE 1e-10 /* Convergence criterion for solvers. */
+#define CTMC_MAXITER 100000  /* Max. iterations for solvers. */
+#define CTMC_CHECKPOINT 100   /* Iterations between checkpoints. */
+#define CTMC_MAGIC 0x70693031u /* Tag of a resumable solution. */
+#define CTMC_NOTAG -1        /* No job is tagged. */
+#define CTMC_ARMED -2        /* Tag the next job started at a source. */
+#define CTMC_HASH 1          /* Visited states by hash compaction. */
+#define CTMC_MDD 2           /* Visited states in a decision diagram. */
+
+/* Every leaf-node of the tree is a sequential PEPA component that
+   cycles through a fixed list of steps. A step enables a single
+   activity: either the timed (comp_i, r), or one of the passive
+   moves. Because both partners of a move are passive, moves are
+   treated as instantaneous; they fire as soon as both the sender
+   and the receiver are ready. */
+typedef enum {
+    ACT_COMP = 0, /* Timed computation comp_i. */
+    ACT_IN,       /* Receive move_j_i from one of the peers. */
+    ACT_OUT       /* Send move_i_k to one of the peers. */
+} __ctmc_act_t;
+
+typedef struct {
+    __ctmc_act_t act;      /* Activity enabled at this step. */
+    __htree_plist_t peers; /* Candidate partners of a move. */
+} __ctmc_step_t;           /* Local state of a leaf-node. */
+
+typedef struct {
+    int nsteps;            /* Number of local states. */
+    __ctmc_step_t *steps;  /* Local states in cyclic order. */
+    double rate;           /* Rate of the comp_i activity. */
+} __ctmc_leaf_t;           /* Sequential component of a task. */
+
+/* Structurally identical sibling subtrees of a farm are
+   interchangeable: permuting them maps the model onto itself. In
+   symmetry reduction mode, each such group is kept as a multiset of
+   branch states (sorted branches), so that the number of states
+   grows with the number of combinations of local states and not
+   with their ordered tuples. */
+typedef struct {
+    int size;              /* Number of leaves in every branch. */
+    int nbranch;           /* Number of identical branches. */
+    int *first;            /* Index of the first leaf of a branch. */
+} __ctmc_group_t;          /* Group of symmetric branches. */
+
+typedef unsigned short __ctmc_lstate_t; /* Local state of a leaf. */
+
+/* A solution which can be resumed is kept in a file of the store
+   (see "store.h"): this header, followed by the probabilities. */
+typedef struct {
+    unsigned int magic;     /* CTMC_MAGIC. */
+    int nstates;            /* Size of the chain, */
+    int ntrans;
+    unsigned int sig;       /* and a hash of its transitions. */
+    int iter;               /* Iterations done so far. */
+    int done;               /* Set once converged. */
+} __ctmc_ckpt_t;            /* Checkpoint of a solution. */
+
+typedef struct {
+    int nleaves;            /* Number of sequential components. */
+    __ctmc_leaf_t *leaf;    /* Components, indexed as in sstab. */
+    int ngroups;            /* Number of symmetric groups. */
+    __ctmc_group_t *group;  /* Groups, innermost first. */
+
+    int nstates;            /* Number of tangible states. */
+    int limit;              /* Most states derived (0: no limit). */
+    int maxstates;          /* Allocated number of states. */
+    __ctmc_lstate_t *state; /* State vectors (nstates x nleaves). */
+    int hsize;              /* Size of the state hash table. */
+    int *hash;              /* Open addressing state hash table. */
+    int compact;            /* Hash compaction (see below)? */
+    unsigned long long *fp; /* Fingerprints of the hash table slots. */
+    int sbase;              /* First state whose vector is kept. */
+    struct mdd_s *mdd;      /* Diagram of the states (see below). */
+    size_t bytes;           /* Most memory taken by visited states. */
+    double *sinkrate;       /* Rate of the computing sink tasks. */
+
+    int ntrans;             /* Number of transitions. */
+    int maxtrans;           /* Allocated number of transitions. */
+    int *row;               /* Transitions of state i are found */
+    int *col;               /* at row[i]..row[i+1]-1 as target */
+    double *val;            /* state col[] with rate val[]. */
+    double *out;            /* Total exit rate from every state. */
+    double *pi;             /* Steady state probabilities. */
+    __ctmc_ckpt_t *ckpt;    /* Their checkpoint, if they are kept. */
+    int ninit;              /* The model starts in states 0..ninit-1 */
+    double *init;           /* with these probabilities. */
+    int nblocks;            /* Number of blocks after lumping. */
+    int *block;             /* Block of every state (see "lump.h"). */
+
+    int maxdepth;           /* Max. chain of instantaneous moves. */
+    __ctmc_lstate_t *stack; /* Work space for resolving moves. */
+    int *mv;                /* Stack of enabled moves. */
+    int mtop, mmax;         /* Top and size of the move stack. */
+    int *perm;              /* Work space for sorting branches. */
+    __ctmc_lstate_t *tmpv;  /* Work space for canonical forms. */
+    int nout, maxout;       /* Outcomes of resolving moves: */
+    __ctmc_lstate_t *outv;  /* tangible state vectors, and */
+    double *outp;           /* their probabilities. */
+    int tag;                /* Task holding the tagged job, and the */
+    int *outt;              /* task holding it in every outcome. */
+
+    int nmoves;             /* Number of distinct moves. */
+    int *moves;             /* Sorted (sender, receiver) pairs. */
+    double *mflow;          /* Flow of every move while replaying */
+    double mweight;         /* transitions, and the current weight. */
+} ctmc_t;                   /* Derived CTMC. */
+
+/* Vector of the state s. */
+#define ctmc_state(m,s) ((m)->state + ((s) - (m)->sbase)*(m)->nleaves)
+
+/* Does the chain keep the vectors of its states? */
+#define ctmc_has_vectors(m) (!(m)->compact && !(m)->mdd)
+
+/* Build the sequential component of a leaf-node from its source and
+   sink lists. Returns -1 if the pattern combination is not valid. */
+extern int ctmc_leaf_def(__htree_node_t *node, __ctmc_leaf_t *l);
+
+/* Copy the sequential component l into c, with its rate scaled by f
+   and its peers renumbered through map. The moves with peers which
+   are not mapped (-1) are dropped, so that the copy never waits for
+   them. Returns -1 if memory is exhausted. */
+extern int ctmc_leaf_copy(__ctmc_leaf_t *l, __ctmc_leaf_t *c, int *map,
+                          double f);
+
+/* Deallocate the steps of a sequential component. */
+extern void ctmc_leaf_free(__ctmc_leaf_t *l);
+
+/* Derive the CTMC from the source-sink lookup table of a committed
+   skeleton hierarchy tree. If symmetric is non-zero, identical
+   sibling subtrees of farms are aggregated. Returns NULL if the
+   model could not be derived. */
+extern ctmc_t *ctmc_derive(__htree_node_t *root, __htree_node_t **sstab,
+                           int nleaves, int symmetric);
+
+/* As above, with hash compaction: the visited states are only known
+   by a 64-bit fingerprint, and the vectors of the states are dropped
+   once they have been explored, so that a state costs 24 to 48 bytes
+   of table (fingerprints and indices, at most half full) and 8 bytes
+   of reward, instead of 2 bytes per task and 8 to 16 bytes of table
+   (the frontier of the exploration aside). Two states with the
+   same fingerprint are taken to be the same, omitting one of them
+   (see ctmc_omission()). Since the vectors are gone, the chain only
+   keeps, for the throughput, the rate at which jobs leave its sink
+   tasks in every state (sinkrate): ctmc_fire(), ctmc_find(),
+   ctmc_throughput() and the functions built on them do not apply. */
+extern ctmc_t *ctmc_derive_compact(__htree_node_t *root,
+                                   __htree_node_t **sstab, int nleaves,
+                                   int symmetric);
+
+/* As above, with the visited states kept in a decision diagram (see
+   "mdd.h"), which is kept in m->mdd: the states are found first, a
+   layer of the breadth first search at a time, keeping the vectors
+   of the last two layers only, and then numbered by their rank in
+   the diagram, and the transitions derived in that order. As with
+   hash compaction, the chain only keeps sinkrate for the throughput
+   (and not the start of the model: ninit is zero), but no state is
+   omitted. Since the states are not in breadth first order, the
+   steady state may take many more iterations. */
+extern ctmc_t *ctmc_derive_mdd(__htree_node_t *root,
+                               __htree_node_t **sstab, int nleaves,
+                               int symmetric);
+
+/* Upper bound of the probability that hash compaction omitted a
+   state (zero for a chain derived without it). */
+extern double ctmc_omission(ctmc_t *m);
+
+/* Bytes which the vectors of the states of m, and their hash table,
+   take when they are kept explicitly (as by ctmc_derive()): they are
+   to be compared with m->bytes, the most taken by the visited states
+   of m while it was derived. */
+extern double ctmc_explicit_bytes(ctmc_t *m);
+
+/* Derive the CTMC of an arbitrary set of sequential components (for
+   instance, part of a tree), without symmetry reduction. The array
+   of components is taken over by the CTMC, even on failure. */
+extern ctmc_t *ctmc_derive_leaves(__ctmc_leaf_t *leaf, int nleaves);
+
+/* As above, with the given groups of symmetric branches (innermost
+   first), which are taken over as well. */
+extern ctmc_t *ctmc_derive_groups(__ctmc_leaf_t *leaf, int nleaves,
+                                  __ctmc_group_t *group, int ngroups);
+
+/* As above, giving up (NULL) once more than limit states are found,
+   so that the cost of a chain too large to be of use is bounded. */
+extern ctmc_t *ctmc_derive_bounded(__ctmc_leaf_t *leaf, int nleaves,
+                                   __ctmc_group_t *group, int ngroups,
+                                   int limit);
+
+/* Solve for the steady state probabilities using Gauss-Seidel
+   iterations. Returns the number of iterations, or -1 if the
+   solution did not converge. */
+extern int ctmc_solve(ctmc_t *m, double tol, int maxiter);
+
+/* Keep the steady state probabilities in the file name of the open
+   store (see "store.h"), so that ctmc_solve() checkpoints them every
+   CTMC_CHECKPOINT iterations and resumes from them in a later run on
+   the same chain. Returns the number of iterations already done, or
+   -1 if there is no store. */
+extern int ctmc_resume(ctmc_t *m, const char *name);
+
+/* Build the incoming transitions of every state, i.e. the transpose
+   of the transition table, in the same compressed row format. The
+   arrays are allocated with store_alloc() (see "store.h"). */
+extern int ctmc_transpose(ctmc_t *m, int **trow, int **tcol,
+                          double **tval);
+
+/* List the moves of the model (the pairs of tasks which can
+   synchronise) in m->moves. Returns the number of moves. */
+extern int ctmc_moves(ctmc_t *m);
+
+/* Index of the move from task i to task k, or -1 if there is none. */
+extern int ctmc_move_index(ctmc_t *m, int i, int k);
+
+/* Make a copy of the CTMC which shares the states and transitions,
+   but has its own work space, so that several threads can replay
+   transitions at once. */
+extern ctmc_t *ctmc_worker(ctmc_t *m);
+
+/* Deallocate a copy made by ctmc_worker(). */
+extern void ctmc_worker_free(ctmc_t *w);
+
+/* Replay the completion of comp_i in state s, adding w times the
+   probability of every move that follows to m->mflow. The tangible
+   states that are reached are left in m->outv, m->outp, along with
+   the task holding the tagged job (m->outt) if m->tag is set. */
+extern int ctmc_fire(ctmc_t *m, int s, int leaf, double w);
+
+/* Find a state without inserting it. Returns -1 if it is not found. */
+extern int ctmc_find(ctmc_t *m, __ctmc_lstate_t *v);
+
+/* Record how the rates of the transitions depend on the rates of the
+   tasks: transition trans[k] has the term coef[k] times the rate of
+   leaf[k], the coefficients being fixed by the structure. The arrays
+   are allocated. Returns the number of terms, or -1 on failure. */
+extern int ctmc_terms(ctmc_t *m, int **trans, int **leaf, double **coef);
+
+/* Throughput of comp_i (where i is the leaf index) at steady state. */
+extern double ctmc_throughput(ctmc_t *m, int leaf);
+
+/* Deallocate the CTMC and everything that belongs to it. */
+extern void ctmc_destroy(ctmc_t *m);
+
+/* Derive and solve the CTMC for the committed skeleton hierarchy
+   tree, and display a summary of the results. */
+extern int htree_solve(void);
+
+#endif /* __PEPA_CTMC_H */
@@ -0,0 +1,360 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which approximate the throughput
+  of a pipeline by decomposition into subsystems around its tasks
+  (see "decomp.h"). Every subsystem is derived from copies of the
+  sequential components of its leaf-nodes and solved exactly.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "decomp.h"
+
+/* Derive and solve the subsystem of cut k, and record its throughput
+   and the share of time its cut task is blocked. */
+static int __decomp_subsystem(decomp_t *d, int k);
+
+
+/* Check if a step moves jobs across the boundary of the leaf-nodes
+   lo..hi-1. */
+static int __decomp_external(__ctmc_step_t *s, int lo, int hi) {
+    return (s->act != ACT_COMP) && (s->peers.n > 0) &&
+        ((s->peers.l[0] < lo) || (s->peers.l[0] >= hi));
+}
+
+/* Share of time the leaf-node k of m waits to deliver. */
+static double __decomp_blocked(ctmc_t *m, int k) {
+    double y = 0.0;
+    int s;
+
+    for (s = 0; s < m->nstates; s++)
+        if (m->leaf[k].steps[m->state[s*m->nleaves + k]].act == ACT_OUT)
+            y += m->pi[s];
+    return y;
+}
+
+/* Collect the farms of identical branches among the stages lo..hi,
+   numbered through map, as groups of symmetric branches. Returns the
+   number of groups, or -1 (and none) if memory is exhausted. */
+static int __decomp_groups(decomp_t *d, int lo, int hi,
+                           __ctmc_group_t **group) {
+    __htree_child_t *c;
+    __htree_node_t *n;
+    __ctmc_group_t *g;
+    int i, j, f, ng = 0;
+
+    *group = NULL;
+    for (i = lo; i <= hi; i++) {
+        n = d->stage[i];
+        if ((n->mtype != FARM) || (n->nchr < 2))
+            continue;
+        for (c = n->clist->next, j = 1; j < n->nchr; j++, c = c->next)
+            if (!__htree_same_subtree(n->clist->child, c->child))
+                break;
+        if (j < n->nchr)
+            continue;
+        if (!(g = (__ctmc_group_t *)
+              realloc(*group, sizeof(__ctmc_group_t)*(ng + 1))))
+            goto fail;
+        *group = g;
+        g += ng;
+        if (!(g->first = (int *) malloc(sizeof(int)*n->nchr)))
+            goto fail;
+        ng++;
+        g->nbranch = n->nchr;
+        for (c = n->clist, j = 0; j < n->nchr; j++, c = c->next) {
+            __htree_leaf_range(c->child, &f, &g->size);
+            g->first[j] = d->map[f];
+        }
+    }
+    return ng;
+
+ fail:
+    for (i = 0; i < ng; i++)
+        free((*group)[i].first);
+    free(*group);
+    *group = NULL;
+    return -1;
+}
+
+int __decomp_subsystem(decomp_t *d, int k) {
+    __ctmc_group_t *group = NULL;
+    __ctmc_leaf_t *leaf;
+    ctmc_t *m = NULL;
+    double f;
+    int lo, hi, n = 0, ng = 0, j, s, e = 0;
+
+    /* From the cut before to the cut after (or the ends of the pipe):
+       only the tasks of these two cuts are pseudo-stages. */
+    lo = (k > 0) ? d->cut[k - 1] : 0;
+    hi = (k < d->nsubs - 1) ? d->cut[k + 1] : d->nstages - 1;
+    for (j = d->first[lo]; j < d->first[hi] + d->count[hi]; j++)
+        d->map[j] = n++;
+    if (!(leaf = (__ctmc_leaf_t *) calloc(n, sizeof(__ctmc_leaf_t))))
+        e = 1;
+    for (j = d->first[lo]; !e && (j < d->first[hi] + d->count[hi]); j++) {
+        f = 1.0;
+        if ((k > 0) && (j == d->first[lo]))
+            f = d->a[k]/d->leaf[j].rate;
+        else if ((k < d->nsubs - 1) && (j == d->first[hi]))
+            f = d->b[k]/d->leaf[j].rate;
+        e = ctmc_leaf_copy(&d->leaf[j], &leaf[d->map[j]], d->map, f) < 0;
+    }
+    if (!e && ((ng = __decomp_groups(d, lo, hi, &group)) < 0))
+        e = 1;
+    if (e) {
+        for (j = 0; leaf && (j < n); j++)
+            ctmc_leaf_free(&leaf[j]);
+        free(leaf);
+    } else
+        m = ctmc_derive_bounded(leaf, n, group, ng, DECOMP_MAXSTATES);
+    if (m) {
+        if (m->nstates > d->maxstates)
+            d->maxstates = m->nstates;
+        d->work += m->nstates;
+    }
+    if (!m || (d->work > DECOMP_MAXSWEEP) ||
+        (ctmc_solve(m, CTMC_TOLERANCE, CTMC_MAXITER) < 0))
+        e = 1;
+
+    if (!e) {
+        /* Jobs leave at the tasks of the last stage which deliver
+           outside it (to the pseudo-stage, or to SINK_MEM). */
+        for (d->x[k] = 0.0, j = d->first[hi];
+             j < d->first[hi] + d->count[hi]; j++) {
+            for (s = 0; s < d->leaf[j].nsteps; s++)
+                if ((d->leaf[j].steps[s].act == ACT_OUT) &&
+                    !__decomp_external(&d->leaf[j].steps[s], d->first[hi],
+                                       d->first[hi] + d->count[hi]))
+                    break;
+            if (s == d->leaf[j].nsteps)
+                d->x[k] += ctmc_throughput(m, d->map[j]);
+        }
+        d->blocked[k] = (d->ncuts > 0) ?
+            __decomp_blocked(m, d->map[d->first[d->cut[k]]]) : 0.0;
+    }
+    ctmc_destroy(m);
+    for (j = d->first[lo]; j < d->first[hi] + d->count[hi]; j++)
+        d->map[j] = -1;
+    if (e)
+        d->failed = (d->work > DECOMP_MAXSWEEP) ? -1 : k;
+    return e ? -1 : 0;
+}
+
+/* For a description of the following function, see "decomp.h". */
+decomp_t *decomp_create(__htree_node_t *pipe, __ctmc_leaf_t *leaf,
+                        int nleaves) {
+    __htree_child_t *c;
+    decomp_t *d;
+    int i, n = pipe->nchr;
+
+    if ((pipe->mtype != PIPE) || (n < 2))
+        return NULL;
+    if (!(d = (decomp_t *) calloc(1, sizeof(decomp_t))))
+        return NULL;
+    d->nleaves = nleaves;
+    d->leaf = leaf;
+    d->nstages = n;
+    if (!(d->stage = (__htree_node_t **)
+          malloc(sizeof(__htree_node_t *)*n)) ||
+        !(d->first = (int *) malloc(sizeof(int)*n)) ||
+        !(d->count = (int *) malloc(sizeof(int)*n)) ||
+        !(d->cut = (int *) malloc(sizeof(int)*n)) ||
+        !(d->a = (double *) malloc(sizeof(double)*n)) ||
+        !(d->b = (double *) malloc(sizeof(double)*n)) ||
+        !(d->x = (double *) malloc(sizeof(double)*n)) ||
+        !(d->blocked = (double *) malloc(sizeof(double)*n)) ||
+        !(d->map = (int *) malloc(sizeof(int)*nleaves))) {
+        decomp_destroy(d);
+        return NULL;
+    }
+    for (i = 0; i < nleaves; i++)
+        d->map[i] = -1;
+    c = pipe->clist;
+    for (i = 0; i < n; i++) {
+        d->stage[i] = c->child;
+        __htree_leaf_range(c->child, &d->first[i], &d->count[i]);
+        c = c->next;
+    }
+
+    /* The pipe is cut at every task between its ends; without any,
+       it is solved whole. */
+    for (i = 1; i < n - 1; i++)
+        if (d->count[i] == 1)
+            d->cut[d->ncuts++] = i;
+    d->nsubs = (d->ncuts > 0) ? d->ncuts : 1;
+    d->failed = -1;
+    return d;
+}
+
+/* Adjust the rate of the receiver of subsystem i until its
+   throughput is y (flow conservation), by false position (Illinois
+   variant) once y is bracketed. If y cannot be reached, the closest
+   throughput is kept. */
+static int __decomp_match(decomp_t *d, int i, double y) {
+    double b0, b1, x0, x1, t;
+    int k, side = 0;
+
+    if (__decomp_subsystem(d, i) < 0)
+        return -1;
+    b0 = b1 = d->b[i];
+    x0 = x1 = d->x[i];
+    for (k = 0; (k < DECOMP_MAXITER) && ((x1 - y)*(x0 - y) > 0.0); k++) {
+        b0 = b1;
+        x0 = x1;
+        d->b[i] = b1 = (x0 < y) ? 2.0*b0 : b0/2.0;
+        if (__decomp_subsystem(d, i) < 0)
+            return -1;
+        x1 = d->x[i];
+        if (fabs(x1 - x0) <= DECOMP_TOLERANCE*DECOMP_TOLERANCE*x0)
+            return 0;
+    }
+    for (k = 0; (k < DECOMP_MAXITER) &&
+             (fabs(d->x[i] - y) > DECOMP_TOLERANCE*DECOMP_TOLERANCE*y); k++) {
+        d->b[i] = t = (x1 != x0) ? b0 + (b1 - b0)*(y - x0)/(x1 - x0) : b1;
+        if (__decomp_subsystem(d, i) < 0)
+            return -1;
+        if ((d->x[i] - y)*(x0 - y) > 0.0) {
+            b0 = t;
+            x0 = d->x[i];
+            if (side < 0)
+                x1 = y + (x1 - y)/2.0;
+            side = -1;
+        } else {
+            b1 = t;
+            x1 = d->x[i];
+            if (side > 0)
+                x0 = y + (x0 - y)/2.0;
+            side = 1;
+        }
+    }
+    return 0;
+}
+
+/* For a description of the following function, see "decomp.h". */
+int decomp_solve(decomp_t *d, double tol, int maxiter) {
+    double lo, hi;
+    int i, it, n = d->nsubs;
+
+    for (i = 0; i < n; i++) {
+        d->a[i] = (i > 0) ? d->leaf[d->first[d->cut[i - 1]]].rate : 0.0;
+        d->b[i] = (i < n - 1) ? d->leaf[d->first[d->cut[i + 1]]].rate : 0.0;
+    }
+    for (it = 1; it <= maxiter; it++) {
+        d->work = 0;
+        for (i = 0; i < n; i++) {
+            if (i > 0) {
+                if (d->blocked[i - 1] >= 1.0)
+                    return -1;
+                /* Damped, or deals of pipes oscillate. */
+                d->a[i] = (d->a[i] +
+                           d->x[i - 1]/(1.0 - d->blocked[i - 1]))/2.0;
+            }
+            if (__decomp_subsystem(d, i) < 0)
+                return -2;
+        }
+        for (lo = hi = d->x[0], i = 1; i < n; i++) {
+            if (d->x[i] < lo)
+                lo = d->x[i];
+            if (d->x[i] > hi)
+                hi = d->x[i];
+        }
+        if (hi - lo <= tol*hi)
+            return it;
+        for (i = n - 2; i >= 0; i--)
+            if (__decomp_match(d, i, d->x[i + 1]) < 0)
+                return -2;
+    }
+    return -1;
+}
+
+/* For a description of the following function, see "decomp.h". */
+double decomp_throughput(decomp_t *d) {
+    return d->x[d->nsubs - 1];
+}
+
+void decomp_destroy(decomp_t *d) {
+    if (!d)
+        return;
+    free(d->stage);
+    free(d->first);
+    free(d->count);
+    free(d->cut);
+    free(d->a);
+    free(d->b);
+    free(d->x);
+    free(d->blocked);
+    free(d->map);
+    free(d);
+}
+
+int htree_decompose(void) {
+    __ctmc_leaf_t *leaf;
+    struct timespec t0, t1;
+    decomp_t *d;
+    int i, it = -1;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if ((__htree_rt.htree->mtype != PIPE) || (__htree_rt.htree->nchr < 3)) {
+        fprintf(report_file,
+                "Decomposition needs a pipe of at least 3 stages.\n");
+        return -1;
+    }
+    if (!(leaf = (__ctmc_leaf_t *)
+          calloc(__htree_rt.nleaves, sizeof(__ctmc_leaf_t))))
+        return -1;
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        if (ctmc_leaf_def(__htree_rt.sstab[i], &leaf[i]) < 0) {
+            fprintf(report_file, "Cannot derive process for task %d.\n", i);
+            goto done;
+        }
+    if (!(d = decomp_create(__htree_rt.htree, leaf, __htree_rt.nleaves)))
+        goto done;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    it = decomp_solve(d, DECOMP_TOLERANCE, DECOMP_MAXITER);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if ((it == -2) && (d->failed >= 0))
+        fprintf(report_file, "Subsystem %d of the decomposition cannot "
+                "be solved within %d states.\n", d->failed + 1,
+                DECOMP_MAXSTATES);
+    else if (it == -2)
+        fprintf(report_file, "A sweep of the decomposition takes more "
+                "than %d states.\n", DECOMP_MAXSWEEP);
+    else if (it < 0)
+        fprintf(report_file, "Decomposition did not converge.\n");
+    else {
+        fprintf(report_file,
+                "Decomposition: %d stages, %d subsystem%s, %d sweep%s, "
+                "largest subsystem %d states, %.3fs.\n", d->nstages,
+                d->nsubs, (d->nsubs > 1) ? "s" : "", it,
+                (it > 1) ? "s" : "", d->maxstates,
+                (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9);
+        fprintf(report_file, "Decomposed throughput: %f\n",
+                decomp_throughput(d));
+    }
+    decomp_destroy(d);
+
+ done:
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        ctmc_leaf_free(&leaf[i]);
+    free(leaf);
+    return (it < 0) ? -1 : 0;
+}
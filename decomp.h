@@ -0,0 +1,105 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to approximate the throughput of a long pipeline by
+  decomposition, i.e. from small subsystems made of the stages
+  around every task, instead of the product state space of all the
+  stages. The functions are defined in "decomp.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_DECOMP_H
+#define __PEPA_DECOMP_H
+
+#include "ctmc.h"
+
+#define DECOMP_TOLERANCE 1e-6 /* Agreement of the subsystem flows. */
+#define DECOMP_MAXITER 200    /* Max. number of sweeps. */
+#define DECOMP_MAXSTATES 131072 /* Max. size of a subsystem. */
+#define DECOMP_MAXSWEEP 1048576 /* Max. states derived in a sweep. */
+
+/* Following Gershwin, the pipeline is cut at the stages between its
+   ends which are a single task, and every cut task is solved in a
+   subsystem which runs from the cut before it to the cut after it
+   (or to the ends of the pipe), and sees the rest of the pipeline
+   only through the tasks of these two cuts: the first, which never
+   waits for input, and the last, which never waits to deliver.
+   Everything in between keeps its own structure (farms are reduced
+   by symmetry), so that a deal still hands out its jobs in order and
+   a farm to whichever task is free: no group of tasks is merged into
+   a single one, which made earlier versions 7% too optimistic on
+   model4 and model6. A pipe without any cut is solved whole. Only
+   the rates of the pseudo-stages are adjusted. The first delivers
+   as fast as the task it stands for does when it is not blocked,
+
+       a[k] = x[k-1]/(1 - blocked[k-1])
+
+   where x[k] is the throughput of subsystem k and blocked[k] the
+   share of time its cut task waits to deliver; this update is
+   damped. The rate b[k] of the last is then chosen so that x[k]
+   equals x[k+1], i.e. so that jobs are conserved at every cut.
+   Forward and backward sweeps are repeated until all the throughputs
+   agree; a sweep costs time linear in the number of cuts.
+
+   A subsystem is derived only up to DECOMP_MAXSTATES states, and a
+   sweep up to DECOMP_MAXSWEEP, so that a pipe which does not cut into
+   small enough subsystems (as model2 and model3, whose stages are
+   deals of pipes) fails at once instead of running for minutes.
+   model1, model4, model5 and model6 fit in a single subsystem, and
+   are solved exactly. Against the exact solution, the decomposition
+   is within 1.2% on model7, which is cut at two tasks, and 2.4% on
+   a pipe of six tasks; on long pipes of tasks of equal rates it
+   is pessimistic, by 5% with eight tasks. "make check" checks these
+   gaps against the exact solution (see "examples/check.sh"). */
+typedef struct {
+    int nleaves;           /* Number of leaf-nodes of the tree. */
+    __ctmc_leaf_t *leaf;   /* Their sequential components. */
+    int nstages;           /* Number of stages of the pipe. */
+    __htree_node_t **stage; /* Subtree of every stage. */
+    int *first, *count;    /* Leaf-nodes of every stage. */
+    int ncuts;             /* Number of stages cut at, */
+    int *cut;              /* which are tasks. */
+    int nsubs;             /* Number of subsystems. */
+    double *a, *b;         /* Rates of the pseudo-stages. */
+    double *x;             /* Throughput of every subsystem. */
+    double *blocked;       /* Share of time cut tasks are blocked. */
+    int *map;              /* Work space for numbering leaf-nodes. */
+    int maxstates;         /* Size of the largest subsystem. */
+    int work;              /* States derived in the current sweep. */
+    int failed;            /* Subsystem which exceeded the caps. */
+} decomp_t;                /* Decomposition of a pipeline. */
+
+/* Prepare the decomposition of the pipe node, whose leaf-nodes are
+   described by the nleaves sequential components in leaf (these are
+   not taken over). Returns NULL on failure. */
+extern decomp_t *decomp_create(__htree_node_t *pipe, __ctmc_leaf_t *leaf,
+                               int nleaves);
+
+/* Iterate until the subsystem throughputs agree within tol. Returns
+   the number of sweeps, -1 if they did not converge, or -2 if a
+   subsystem could not be derived and solved within the caps (its
+   index is then left in failed, or -1 if the sweep was too costly). */
+extern int decomp_solve(decomp_t *d, double tol, int maxiter);
+
+/* Estimated throughput of the pipeline. */
+extern double decomp_throughput(decomp_t *d);
+
+/* Deallocate the decomposition. */
+extern void decomp_destroy(decomp_t *d);
+
+/* Approximate the throughput of the committed skeleton hierarchy tree
+   by decomposition of its top-level pipe, and display it. */
+extern int htree_decompose(void);
+
+#endif /* __PEPA_DECOMP_H */
@@ -0,0 +1,363 @@
+#!/bin/sh
+#*********************************************************************
+#
+#  THE ENHANCE PROJECT
+#  School of Informatics,
+#  University of Edinburgh,
+#  Edinburgh - EH9 3JZ
+#  United Kingdom
+#
+#  DESCRIPTION:
+#
+#  Checks the analyses of wflow2pepa on the examples against the
+#  outputs kept in examples/expected (see "make check"). Every mode is
+#  run on the examples it can solve in a few seconds, with the timings
+#  taken out of its report, and the report is compared line by line
+#  with the expected one: words must be equal, and numbers equal to
+#  within a relative tolerance of TOL (1e-4 by default), so that a
+#  change of compiler or mathematical library does not fail it. The
+#  approximations are also checked against the exact solution.
+#
+#  Usage: check.sh BINARY [-u]
+#
+#  With -u, the expected outputs are written instead of checked.
+#
+#  Written by: Gagarine Yaikhom
+#
+#*********************************************************************
+
+W=$1
+UPDATE=$2
+TOL=${TOL:-1e-4}
+DIR=`cd \`dirname $0\` && pwd`
+EXP=$DIR/expected
+FAILED=0
+CHECKED=0
+
+if [ -z "$W" ] || [ ! -x "$W" ]; then
+    echo "Usage: check.sh BINARY [-u]" >&2
+    exit 2
+fi
+W=`cd \`dirname $W\` && pwd`/`basename $W`
+
+# The examples are processed in a directory of their own, as the
+# models and the files of the analyses are written next to them.
+WORK=`mktemp -d ${TMPDIR:-/tmp}/check.XXXXXX` || exit 2
+trap 'rm -rf $WORK' 0 1 2 15
+cp $DIR/*.des $WORK
+cd $WORK
+[ -n "$UPDATE" ] && mkdir -p $EXP
+
+# Take the timings out of a report (and the timing column of the
+# storage comparison), which differ from run to run.
+filter() {
+    sed -e '/^Sweep time:/d' \
+        -e 's/ ([0-9]* events\/s)//' \
+        -e 's/ in [0-9.]* us\./ in N us./' \
+        -e 's/[0-9][0-9]*\.[0-9][0-9]*s\([ ,.)]\)/Ns\1/g' \
+        -e 's/[0-9][0-9]*\.[0-9][0-9]*s$/Ns/' \
+        -e '/^explicit /s/ *[0-9.]*$//' \
+        -e '/^hash compaction /s/ *[0-9.]*$//' \
+        -e '/^MDD /s/ *[0-9.]*$//'
+}
+
+# Compare the files $1 and $2, word by word, numbers to within TOL.
+compare() {
+    awk -v tol=$TOL -v ref=$2 '
+        function num(s) {
+            return s ~ /^[-+]?([0-9]+\.?[0-9]*|\.[0-9]+)([eE][-+]?[0-9]+)?%?,?$/
+        }
+        {
+            if ((getline e < ref) <= 0) { bad = "extra line " FNR; exit }
+            n = split($0, a); m = split(e, b)
+            if (n != m) { bad = "line " FNR; exit }
+            for (i = 1; i <= n; i++) {
+                if (a[i] == b[i])
+                    continue
+                if (!num(a[i]) || !num(b[i])) { bad = "line " FNR; exit }
+                x = a[i] + 0; y = b[i] + 0
+                d = x - y; if (d < 0) d = -d
+                s = (x < 0) ? -x : x; if (((y < 0) ? -y : y) > s) s = (y < 0) ? -y : y
+                if (d > tol * (s > 1 ? s : 1)) { bad = "line " FNR; exit }
+            }
+        }
+        END {
+            if (bad == "" && (getline e < ref) > 0)
+                bad = "missing line " (FNR + 1)
+            if (bad != "") { print bad; exit 1 }
+        }' $1
+}
+
+pass() {
+    CHECKED=`expr $CHECKED + 1`
+}
+
+fail() {
+    echo "FAIL: $*"
+    FAILED=`expr $FAILED + 1`
+    CHECKED=`expr $CHECKED + 1`
+}
+
+# Check (or write) the expected output $1 against the file $2.
+expect() {
+    if [ -n "$UPDATE" ]; then
+        cp $2 $EXP/$1
+        return
+    fi
+    if [ ! -f $EXP/$1 ]; then
+        fail "$1: no expected output"
+    elif where=`compare $2 $EXP/$1`; then
+        pass
+    else
+        fail "$1: differs from the expected output at $where"
+    fi
+}
+
+# Run the mode NAME, with the options FLAGS, on the examples given,
+# and check its report (and its .csv file, if any).
+mode() {
+    name=$1; flags=$2; shift 2
+    for m in "$@"; do
+        rm -f model$m.csv
+        if ! $W -j 2 -o $flags model$m.des > out.txt 2>&1; then
+            fail "model$m.$name: $W -o $flags failed"
+            continue
+        fi
+        filter < out.txt > model$m.$name
+        expect model$m.$name model$m.$name
+        [ -f model$m.csv ] && expect model$m.$name.csv model$m.csv
+    done
+}
+
+# First number of the line of the report $1 which starts with $2.
+value() {
+    sed -n "s/^$2 *//p" $1 | awk '{ print $1; exit }'
+}
+
+# Relative gap (in %) of $1 from the exact $2.
+gap() {
+    awk -v x=$1 -v y=$2 'BEGIN { d = (x - y) / y; printf "%.1f", (d < 0 ? -d : d) * 100 }'
+}
+
+echo "Checking the analyses of the examples:"
+mode s "-s" 1 3 4 5 6 7
+mode r "-r -s" 1 3 4 5 6
+mode e "-e -s" 1 4 5
+mode k "-k -s" 1 4 5
+mode f "-f" 1 2 3 4 5 6
+mode m "-m" 1 2 3 4 5 6
+mode t "-t -s" 1 4 5
+mode T "-T 1,2,5 -s" 1 4 5
+mode P "-P -s" 5
+mode b "-b" 1 2 3 4 5 6
+mode d "-d" 1 4 5 6 7
+mode c "-c" 1 2 3 4 5 6
+mode w "-w task=1:3:3" 1 5
+mode S "-S -s" 1 5
+mode O "-O 8" 1 3 4 5 6
+mode Oc "-O 8 -c" 1 3 4 5 6
+mode H "-H -s" 1 4 5
+mode M "-M -s" 1 4 5
+mode Y "-Y -s" 1 4 5
+mode D "-D . -s" 1 5
+
+# The decomposition (see "decomp.h") is to be within DECOMP_TARGET %
+# of the exact throughput. model3 does not cut into subsystems small
+# enough to be solved, and is to be refused at once.
+DECOMP_TARGET=3
+if [ -z "$UPDATE" ]; then
+    echo "Checking the decomposition against the exact solution:"
+    for m in 1 4 5 6 7; do
+        x=`value model$m.d "Decomposed throughput:"`
+        y=`value model$m.s "Throughput:"`
+        if [ -z "$x" ] || [ -z "$y" ]; then
+            fail "model$m: no throughput to compare"
+            continue
+        fi
+        g=`gap $x $y`
+        if awk -v g=$g -v l=$DECOMP_TARGET 'BEGIN { exit !(g <= l) }'; then
+            pass
+        else
+            fail "model$m: decomposition $g% from exact (at most $DECOMP_TARGET%)"
+        fi
+    done
+    if $W -d model3.des > out.txt 2>&1; then
+        fail "model3: decomposition not refused"
+    elif grep "cannot be solved within" out.txt > /dev/null; then
+        pass
+    else
+        fail "model3: decomposition failed without reaching its caps"
+    fi
+fi
+
+# Compare the runs of $1 and $2 (files of the same name, and reports),
+# which are to give exactly the same output.
+same() {
+    if ! cmp -s $1 $2; then
+        fail "$3: $1 and $2 differ"
+    else
+        pass
+    fi
+}
+
+# A file larger than two chunks (see "chunk.h") is parsed in pieces
+# on several threads: it is to give the same model, and report the
+# same line on error, as a parse on one thread. The comments and
+# names are full of semicolons and quotes, at which no piece may be
+# cut.
+if [ -z "$UPDATE" ]; then
+    echo "Checking the parallel parse against the sequential one:"
+    awk 'BEGIN {
+        n = 200; print "pipe(" n ");"
+        for (i = 0; i < n; i++) {
+            print "/*"
+            for (j = 0; j < 1400; j++)
+                print "   a; \"b; c\" d; \"e; f g h i j k l m n o p q r s t u v w x y z; 0123456789;"
+            print "*/"
+            printf "\ttask(\"s%d; x\", %d.0);\n", i, i % 7 + 1
+        }
+    }' > big.des
+    (cat big.des; echo 'task("extra", 1.0);') > bad.des
+    $W -j 1 -o big.des > big1.txt 2>&1; mv big.pepa big1.pepa
+    $W -j 4 -o big.des > big4.txt 2>&1
+    same big1.pepa big.pepa "parallel parse"
+    same big1.txt big4.txt "parallel parse"
+    $W -j 1 -o bad.des > bad1.txt 2>&1
+    $W -j 4 -o bad.des > bad4.txt 2>&1
+    grep -q "at line 280602" bad1.txt || fail "parallel parse: wrong line of error"
+    same bad1.txt bad4.txt "parallel parse"
+
+    # The named rates of an included file are seen by every piece.
+    printf 'rate r = 2.0;\nrate q = r * 3;\n' > rates.des
+    (echo 'include "rates.des";'; sed 's/task("s\([0-9]*\); x", [0-9.]*)/task("s\1", r)/' big.des) > incl.des
+    $W -j 1 -o incl.des > incl1.txt 2>&1; mv incl.pepa incl1.pepa
+    $W -j 4 -o incl.des > incl4.txt 2>&1
+    grep -q "^r = 2" incl1.pepa || fail "parallel parse: included rates not found"
+    same incl1.pepa incl.pepa "parallel parse with include"
+    same incl1.txt incl4.txt "parallel parse with include"
+    rm -f big.des bad.des big.pepa big1.pepa incl.des incl.pepa incl1.pepa rates.des
+fi
+
+# The subtrees and named rates defined in an included file are seen by
+# the including file, also when the file is included twice from
+# different directories: the model is to be the same as that of the
+# description with the definitions written in place, alone and in a
+# batch (see "include.h").
+if [ -z "$UPDATE" ]; then
+    echo "Checking the definitions of included files:"
+    mkdir sub
+    cat > lib.des <<EOF
+rate fast = 4.0;
+define stage(r) { pipe(2); task("in", r); task("out", fast); }
+EOF
+    cat > sub/part.des <<EOF
+include "../lib.des";
+define pair() { pipe(2); stage(1.0); stage(2.0); }
+EOF
+    cat > top.des <<EOF
+include "lib.des";
+include "sub/part.des";
+pipe(3); stage(3.0); pair(); task("end", fast * 2);
+EOF
+    cat > flat.des <<EOF
+rate fast = 4.0;
+define stage(r) { pipe(2); task("in", r); task("out", fast); }
+define pair() { pipe(2); stage(1.0); stage(2.0); }
+pipe(3); stage(3.0); pair(); task("end", fast * 2);
+EOF
+    cp top.des top2.des
+    $W -o flat.des > /dev/null 2>&1
+    if $W -o top.des > top.txt 2>&1; then
+        same top.pepa flat.pepa "included definitions"
+    else
+        fail "included definitions: `head -1 top.txt`"
+    fi
+    if $W -x -j 2 -o top2.des > top.txt 2>&1; then
+        same top2.pepa flat.pepa "included definitions in a batch"
+    else
+        fail "included definitions in a batch: `head -1 top.txt`"
+    fi
+    rm -rf sub lib.des top.des top2.des flat.des top.pepa top2.pepa \
+        flat.pepa top.txt
+fi
+
+# A precompiled tree (see "bin.h") is to give the same model, and
+# reports, as the description it was written from, and be written
+# again byte for byte when it is itself given as input. A tree with
+# named rates checks that their expressions are kept.
+if [ -z "$UPDATE" ]; then
+    echo "Checking the precompiled trees against the descriptions:"
+    printf 'rate r = 2.0;\nrate s = r * 1.5 + 1;\npipe(3);\n\ttask("a", r);\n\tfarm(3, "w", s);\n\ttask("b", 1.0);\n' > rates.des
+    for m in model1 model2 model3 model4 model5 model6 rates; do
+        flags=
+        [ $m = rates ] && flags=-s
+        $W -j 2 -o -B $flags $m.des > des.txt 2>&1
+        mv $m.pepa des.pepa; mv $m.htree des.htree; cp des.htree $m.htree
+        $W -j 2 -o -B $flags $m.htree > htree.txt 2>&1
+        same des.pepa $m.pepa "$m.htree"
+        same des.htree $m.htree "$m.htree"
+        same des.txt htree.txt "$m.htree"
+    done
+    rm -f des.* htree.txt rates.*
+fi
+
+# Run $W with the options $1 on the example model$2, from a clean
+# slate, into the report $3 (the timings taken out).
+run() {
+    rm -f model$2.pepa model$2.csv model$2.tex model$2.dot model$2.opt.des
+    $W -j 2 -o $1 model$2.des > out.txt 2>&1
+    filter < out.txt > $3
+}
+
+# Compare the report $3 and the files of model$2 with those of a run
+# without the cache (kept as cold.*), for the check $1.
+cold() {
+    same cold.txt $3 "$1"
+    for f in pepa csv tex dot opt.des; do
+        if [ -f cold.$f ]; then
+            same cold.$f model$2.$f "$1"
+        elif [ -f model$2.$f ]; then
+            fail "$1: model$2.$f written only with the cache"
+        fi
+    done
+}
+
+# Every mode is run without the cache, then on a miss, which fills
+# the cache, then on a hit, which is to add no entry: the reports and
+# the files are to be the same all three times. A sweep file whose
+# points are changed is to miss.
+if [ -z "$UPDATE" ]; then
+    echo "Checking the cache against runs without it:"
+    printf 'task\n1\n2\n' > points
+    for flags in "-s" "-t -s" "-g -l -s" "-b" "-c" "-O 8" "-w task=1:3:3" \
+                 "-w @points"; do
+        for m in 1 5; do
+            name="model$m.des $flags -C"
+            run "$flags" $m cold.txt
+            for f in pepa csv tex dot opt.des; do
+                rm -f cold.$f
+                [ -f model$m.$f ] && mv model$m.$f cold.$f
+            done
+            run "$flags -C cache" $m miss.txt
+            cold "$name (miss)" $m miss.txt
+            n=`ls cache | wc -l`
+            run "$flags -C cache" $m hit.txt
+            cold "$name (hit)" $m hit.txt
+            [ `ls cache | wc -l` = $n ] || fail "$name: no hit"
+        done
+    done
+    printf 'task\n1\n3\n' > points
+    run "-w @points" 5 cold.txt
+    n=`ls cache | wc -l`
+    run "-w @points -C cache" 5 miss.txt
+    same cold.txt miss.txt "model5.des -w @points -C (points changed)"
+    [ `ls cache | wc -l` -gt $n ] || fail "model5.des -w @points -C: no miss"
+    rm -rf cache cold.* miss.txt hit.txt points
+fi
+
+if [ -n "$UPDATE" ]; then
+    echo "Expected outputs written into $EXP."
+    exit 0
+fi
+echo "$CHECKED checks, $FAILED failed."
+[ $FAILED = 0 ]
@@ -0,0 +1,15 @@
+Bounds: 11 subtrees in N us.
+Subtree                         Bound     Estimate  Bottleneck
+pipe(5)                      1.000000     0.978593  t_0 task
+  task                       1.000000     1.000000  t_0 task
+  deal(3)                    6.000000     6.000000  t_1 task
+    task                     2.000000     2.000000  t_1 task
+    task                     2.000000     2.000000  t_2 task
+    task                     2.000000     2.000000  t_3 task
+  task                       2.000000     2.000000  t_4 task
+  deal(2)                    4.000000     4.000000  t_5 task
+    task                     2.000000     2.000000  t_5 task
+    task                     2.000000     2.000000  t_6 task
+  task                       2.000000     2.000000  t_7 task
+Throughput bound: 1.000000
+Throughput estimate: 0.978593
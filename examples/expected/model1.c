@@ -0,0 +1,2 @@
+Compositional solve: 3 subtrees solved, 0 cached, 332 states in all (largest 330), Ns.
+Compositional throughput: 0.881390
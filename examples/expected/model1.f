@@ -0,0 +1,22 @@
+Fluid: 8 types, 43 variables, 17 channels.
+Equilibrium: t = 153.32 after 226 steps.
+Activity               Components           Each          Total
+comp_0                          1       0.999950       0.999950
+comp_1                          1       0.333317       0.333317
+comp_2                          1       0.333317       0.333317
+comp_3                          1       0.333317       0.333317
+comp_4                          1       0.999950       0.999950
+comp_5                          1       0.499975       0.499975
+comp_6                          1       0.499975       0.499975
+comp_7                          1       0.999950       0.999950
+move_0_1                                               0.333317
+move_0_2                                               0.333317
+move_0_3                                               0.333317
+move_1_4                                               0.333317
+move_2_4                                               0.333317
+move_3_4                                               0.333317
+move_4_5                                               0.499975
+move_4_6                                               0.499975
+move_5_7                                               0.499975
+move_6_7                                               0.499975
+Throughput: 0.999950
@@ -0,0 +1,11 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 0.939701   0.004453     0.940248   0.001252
+t_1      task                 0.313242   0.001489     0.155885   0.001124
+t_2      task                 0.313233   0.001482     0.156070   0.001346
+t_3      task                 0.313235   0.001483     0.156583   0.001307
+t_4      task                 0.939719   0.004459     0.469457   0.002771
+t_5      task                 0.469862   0.002228     0.235186   0.001090
+t_6      task                 0.469869   0.002236     0.235393   0.001516
+t_7      task                 0.939721   0.004457     0.469157   0.002626
+Throughput: 0.939721 +/- 0.004457
@@ -0,0 +1,3 @@
+CTMC: 3138 states, 12732 transitions.
+Steady state: 11 iterations.
+Throughput: 0.939496
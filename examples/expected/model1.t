@@ -0,0 +1,4 @@
+CTMC: 3138 states, 12732 transitions.
+Steady state: 11 iterations.
+Throughput: 0.939496
+Measures: 8 tasks, 10 moves written to model1.csv.
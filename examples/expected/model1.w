@@ -0,0 +1,5 @@
+Sweep: 3 points, 3138 states, 12732 terms.
+        task     Throughput Iterations
+           1       0.646637          8
+           2       1.293273          8
+           3       1.939910          1
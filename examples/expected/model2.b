@@ -0,0 +1,34 @@
+Bounds: 30 subtrees in N us.
+Subtree                         Bound     Estimate  Bottleneck
+pipe(5)                      3.100000     3.073285  t_0 task
+  task                       3.100000     3.100000  t_0 task
+  deal(3)                    6.000000     5.536060  t_1 task
+    pipe(3)                  2.000000     1.845353  t_1 task
+      task                   2.000000     2.000000  t_1 task
+      deal(2)                6.000000     6.000000  t_2 task
+        task                 3.000000     3.000000  t_2 task
+        task                 3.000000     3.000000  t_3 task
+      task                   4.000000     4.000000  t_4 task
+    pipe(3)                  2.000000     1.845353  t_5 task
+      task                   2.000000     2.000000  t_5 task
+      deal(2)                6.000000     6.000000  t_6 task
+        task                 3.000000     3.000000  t_6 task
+        task                 3.000000     3.000000  t_7 task
+      task                   4.000000     4.000000  t_8 task
+    pipe(3)                  2.000000     1.845353  t_9 task
+      task                   2.000000     2.000000  t_9 task
+      deal(2)                6.000000     6.000000  t_10 task
+        task                 3.000000     3.000000  t_10 task
+        task                 3.000000     3.000000  t_11 task
+      task                   4.000000     4.000000  t_12 task
+  task                       9.000000     9.000000  t_13 task
+  deal(2)                   10.000000     7.252747  t_14 task
+    pipe(2)                  5.000000     3.626374  t_14 task
+      task                   5.000000     5.000000  t_14 task
+      task                   6.000000     6.000000  t_15 task
+    pipe(2)                  5.000000     3.626374  t_16 task
+      task                   5.000000     5.000000  t_16 task
+      task                   6.000000     6.000000  t_17 task
+  task                      11.000000    11.000000  t_18 task
+Throughput bound: 3.100000
+Throughput estimate: 3.073285
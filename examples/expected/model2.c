@@ -0,0 +1,2 @@
+Compositional solve: 6 subtrees solved, 3 cached, 352 states in all (largest 330), Ns.
+Compositional throughput: 2.435184
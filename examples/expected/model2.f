@@ -0,0 +1,47 @@
+Fluid: 19 types, 94 variables, 40 channels.
+Equilibrium: t = 37.6656 after 260 steps.
+Activity               Components           Each          Total
+comp_0                          1       3.099913       3.099913
+comp_1                          1       1.033304       1.033304
+comp_2                          1       0.516652       0.516652
+comp_3                          1       0.516652       0.516652
+comp_4                          1       1.033304       1.033304
+comp_5                          1       1.033304       1.033304
+comp_6                          1       0.516652       0.516652
+comp_7                          1       0.516652       0.516652
+comp_8                          1       1.033304       1.033304
+comp_9                          1       1.033304       1.033304
+comp_10                         1       0.516652       0.516652
+comp_11                         1       0.516652       0.516652
+comp_12                         1       1.033304       1.033304
+comp_13                         1       3.099913       3.099913
+comp_14                         1       1.549956       1.549956
+comp_15                         1       1.549956       1.549956
+comp_16                         1       1.549956       1.549956
+comp_17                         1       1.549956       1.549956
+comp_18                         1       3.099913       3.099913
+move_0_1                                               1.033304
+move_0_5                                               1.033304
+move_0_9                                               1.033304
+move_1_2                                               0.516652
+move_1_3                                               0.516652
+move_2_4                                               0.516652
+move_3_4                                               0.516652
+move_4_13                                              1.033304
+move_5_6                                               0.516652
+move_5_7                                               0.516652
+move_6_8                                               0.516652
+move_7_8                                               0.516652
+move_8_13                                              1.033304
+move_9_10                                              0.516652
+move_9_11                                              0.516652
+move_10_12                                             0.516652
+move_11_12                                             0.516652
+move_12_13                                             1.033304
+move_13_14                                             1.549956
+move_13_16                                             1.549956
+move_14_15                                             1.549956
+move_15_18                                             1.549956
+move_16_17                                             1.549956
+move_17_18                                             1.549956
+Throughput: 3.099913
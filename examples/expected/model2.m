@@ -0,0 +1,22 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 2.438660   0.010638     0.785649   0.003269
+t_1      task                 0.812911   0.003563     0.402643   0.002006
+t_2      task                 0.406455   0.001753     0.135617   0.002717
+t_3      task                 0.406438   0.001782     0.135529   0.001997
+t_4      task                 0.812866   0.003534     0.203204   0.001853
+t_5      task                 0.812902   0.003549     0.406669   0.002187
+t_6      task                 0.406446   0.001776     0.135830   0.001556
+t_7      task                 0.406446   0.001772     0.134722   0.001843
+t_8      task                 0.812857   0.003514     0.202295   0.001580
+t_9      task                 0.812884   0.003546     0.408041   0.002807
+t_10     task                 0.406446   0.001772     0.135418   0.001301
+t_11     task                 0.406429   0.001778     0.134436   0.001653
+t_12     task                 0.812848   0.003555     0.203908   0.001333
+t_13     task                 2.438625   0.010627     0.271232   0.002112
+t_14     task                 1.219330   0.005319     0.243212   0.001772
+t_15     task                 1.219339   0.005300     0.203112   0.001266
+t_16     task                 1.219312   0.005302     0.243056   0.001863
+t_17     task                 1.219312   0.005285     0.202472   0.001384
+t_18     task                 2.438633   0.010553     0.221592   0.001646
+Throughput: 2.438633 +/- 0.010553
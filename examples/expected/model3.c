@@ -0,0 +1,2 @@
+Compositional solve: 6 subtrees solved, 2 cached, 67 states in all (largest 42), Ns.
+Compositional throughput: 2.108388
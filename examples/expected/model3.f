@@ -0,0 +1,36 @@
+Fluid: 14 types, 62 variables, 22 channels.
+Equilibrium: t = 37.7377 after 270 steps.
+Activity               Components           Each          Total
+comp_0                          1       3.099913       3.099913
+comp_1                          1       1.549956       1.549956
+comp_2                          1       0.774978       0.774978
+comp_3                          1       0.774978       0.774978
+comp_4                          1       1.549956       1.549956
+comp_5                          1       1.549956       1.549956
+comp_6                          1       0.774978       0.774978
+comp_7                          1       0.774978       0.774978
+comp_8                          1       1.549956       1.549956
+comp_9                          1       1.549956       1.549956
+comp_10                         1       1.549956       1.549956
+comp_11                         1       1.549956       1.549956
+comp_12                         1       1.549956       1.549956
+comp_13                         1       3.099913       3.099913
+move_0_1                                               1.549956
+move_0_5                                               1.549956
+move_1_2                                               0.774978
+move_1_3                                               0.774978
+move_2_4                                               0.774978
+move_3_4                                               0.774978
+move_4_9                                               0.774978
+move_4_11                                              0.774978
+move_5_6                                               0.774978
+move_5_7                                               0.774978
+move_6_8                                               0.774978
+move_7_8                                               0.774978
+move_8_9                                               0.774978
+move_8_11                                              0.774978
+move_9_10                                              1.549956
+move_10_13                                             1.549956
+move_11_12                                             1.549956
+move_12_13                                             1.549956
+Throughput: 3.099913
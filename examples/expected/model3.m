@@ -0,0 +1,17 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 2.095875   0.005446     0.673490   0.002044
+t_1      task                 1.047914   0.002732     0.524844   0.002048
+t_2      task                 0.523940   0.001374     0.175066   0.001481
+t_3      task                 0.523947   0.001356     0.175127   0.001774
+t_4      task                 1.047887   0.002714     0.262188   0.001084
+t_5      task                 1.047907   0.002710     0.524928   0.003044
+t_6      task                 0.523954   0.001349     0.174307   0.001218
+t_7      task                 0.523967   0.001355     0.175162   0.001602
+t_8      task                 1.047901   0.002716     0.262375   0.001567
+t_9      task                 1.047887   0.002699     0.209531   0.000931
+t_10     task                 1.047874   0.002720     0.174769   0.001080
+t_11     task                 1.047881   0.002715     0.209367   0.001438
+t_12     task                 1.047894   0.002687     0.173989   0.000733
+t_13     task                 2.095768   0.005397     0.190613   0.000939
+Throughput: 2.095768 +/- 0.005397
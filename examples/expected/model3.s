@@ -0,0 +1,3 @@
+CTMC: 358578 states, 2427255 transitions.
+Steady state: 15 iterations.
+Throughput: 2.095148
@@ -0,0 +1,19 @@
+Bounds: 15 subtrees in N us.
+Subtree                         Bound     Estimate  Bottleneck
+pipe(5)                      1.000000     0.907538  t_0 task
+  task                       1.000000     1.000000  t_0 task
+  deal(3)                    9.000000     9.000000  t_1 task
+    task                     3.000000     3.000000  t_1 task
+    task                     3.000000     3.000000  t_2 task
+    task                     3.000000     3.000000  t_3 task
+  deal(2)                    4.000000     4.000000  t_4 task
+    task                     2.000000     2.000000  t_4 task
+    task                     2.000000     2.000000  t_5 task
+  deal(4)                   16.000000    16.000000  t_6 task
+    task                     4.000000     4.000000  t_6 task
+    task                     4.000000     4.000000  t_7 task
+    task                     4.000000     4.000000  t_8 task
+    task                     4.000000     4.000000  t_9 task
+  task                       1.000000     1.000000  t_10 task
+Throughput bound: 1.000000
+Throughput estimate: 0.907538
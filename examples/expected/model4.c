@@ -0,0 +1,2 @@
+Compositional solve: 4 subtrees solved, 0 cached, 828 states in all (largest 660), Ns.
+Compositional throughput: 0.811935
@@ -0,0 +1,4 @@
+CTMC: 95899 states, 510446 transitions.
+Lumped: 95899 states into 95899 blocks (1.00x smaller).
+Steady state: 6 iterations.
+Throughput: 0.871262
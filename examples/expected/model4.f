@@ -0,0 +1,36 @@
+Fluid: 11 types, 128 variables, 62 channels.
+Equilibrium: t = 141.842 after 327 steps.
+Activity               Components           Each          Total
+comp_0                          1       0.999975       0.999975
+comp_1                          1       0.333325       0.333325
+comp_2                          1       0.333325       0.333325
+comp_3                          1       0.333325       0.333325
+comp_4                          1       0.499988       0.499988
+comp_5                          1       0.499988       0.499988
+comp_6                          1       0.249994       0.249994
+comp_7                          1       0.249994       0.249994
+comp_8                          1       0.249994       0.249994
+comp_9                          1       0.249994       0.249994
+comp_10                         1       0.999975       0.999975
+move_0_1                                               0.333325
+move_0_2                                               0.333325
+move_0_3                                               0.333325
+move_1_4                                               0.166663
+move_1_5                                               0.166663
+move_2_4                                               0.166663
+move_2_5                                               0.166663
+move_3_4                                               0.166663
+move_3_5                                               0.166663
+move_4_6                                               0.124997
+move_4_7                                               0.124997
+move_4_8                                               0.124997
+move_4_9                                               0.124997
+move_5_6                                               0.124997
+move_5_7                                               0.124997
+move_5_8                                               0.124997
+move_5_9                                               0.124997
+move_6_10                                              0.249994
+move_7_10                                              0.249994
+move_8_10                                              0.249994
+move_9_10                                              0.249994
+Throughput: 0.999975
@@ -0,0 +1,14 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 0.872172   0.002481     0.872114   0.003011
+t_1      task                 0.290730   0.000824     0.097313   0.000462
+t_2      task                 0.290726   0.000828     0.097265   0.000655
+t_3      task                 0.290726   0.000823     0.096943   0.000891
+t_4      task                 0.436083   0.001236     0.217830   0.000835
+t_5      task                 0.436105   0.001240     0.218709   0.001012
+t_6      task                 0.218040   0.000619     0.054479   0.000492
+t_7      task                 0.218045   0.000620     0.054557   0.000407
+t_8      task                 0.218043   0.000621     0.054138   0.000291
+t_9      task                 0.218057   0.000621     0.054554   0.000281
+t_10     task                 0.872182   0.002493     0.870786   0.002927
+Throughput: 0.872182 +/- 0.002493
@@ -0,0 +1,3 @@
+CTMC: 95899 states, 510446 transitions.
+Steady state: 6 iterations.
+Throughput: 0.871262
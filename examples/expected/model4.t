@@ -0,0 +1,4 @@
+CTMC: 95899 states, 510446 transitions.
+Steady state: 6 iterations.
+Throughput: 0.871262
+Measures: 11 tasks, 21 moves written to model4.csv.
@@ -0,0 +1,11 @@
+Bounds: 7 subtrees in N us.
+Subtree                         Bound     Estimate  Bottleneck
+pipe(3)                      1.000000     0.823098  t_0 task
+  task                       1.000000     1.000000  t_0 task
+  farm(3)                    9.000000     9.000000  t_1 task
+    task                     3.000000     3.000000  t_1 task
+    task                     3.000000     3.000000  t_2 task
+    task                     3.000000     3.000000  t_3 task
+  task                       1.000000     1.000000  t_4 task
+Throughput bound: 1.000000
+Throughput estimate: 0.823098
@@ -0,0 +1,2 @@
+Compositional solve: 2 subtrees solved, 0 cached, 20 states in all (largest 19), Ns.
+Compositional throughput: 0.823417
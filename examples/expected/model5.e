@@ -0,0 +1,4 @@
+CTMC: 44 states, 148 transitions.
+Lumped: 44 states into 19 blocks (2.32x smaller).
+Steady state: 42 iterations.
+Throughput: 0.823417
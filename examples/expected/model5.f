@@ -0,0 +1,9 @@
+Fluid: 3 types, 7 variables, 2 channels.
+Equilibrium: t = 231.889 after 121 steps.
+Activity               Components           Each          Total
+comp_0                          1       0.999967       0.999967
+comp_1                          3       0.333322       0.999967
+comp_4                          1       0.999967       0.999967
+move_0_1                                               0.999967
+move_1_4                                               0.999967
+Throughput: 0.999967
@@ -0,0 +1,8 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 0.822696   0.001295     0.823493   0.002092
+t_1      task                 0.274600   0.000796     0.091383   0.000506
+t_2      task                 0.273614   0.000762     0.090775   0.000574
+t_3      task                 0.274485   0.000792     0.091440   0.000374
+t_4      task                 0.822701   0.001298     0.822942   0.001831
+Throughput: 0.822701 +/- 0.001298
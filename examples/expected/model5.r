@@ -0,0 +1,3 @@
+CTMC: 19 states, 41 transitions (1 symmetric group).
+Steady state: 42 iterations.
+Throughput: 0.823417
@@ -0,0 +1,3 @@
+CTMC: 44 states, 148 transitions.
+Steady state: 40 iterations.
+Throughput: 0.823417
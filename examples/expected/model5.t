@@ -0,0 +1,4 @@
+CTMC: 44 states, 148 transitions.
+Steady state: 40 iterations.
+Throughput: 0.823417
+Measures: 5 tasks, 6 moves written to model5.csv.
@@ -0,0 +1,5 @@
+Sweep: 3 points, 44 states, 150 terms.
+        task     Throughput Iterations
+           1       0.796587         27
+           2       1.593173         27
+           3       2.389760          1
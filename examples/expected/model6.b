@@ -0,0 +1,22 @@
+Bounds: 18 subtrees in N us.
+Subtree                         Bound     Estimate  Bottleneck
+pipe(6)                      1.000000     0.919192  t_0 task
+  task                       1.000000     1.000000  t_0 task
+  farm(3)                    9.000000     9.000000  t_1 task
+    task                     3.000000     3.000000  t_1 task
+    task                     3.000000     3.000000  t_2 task
+    task                     3.000000     3.000000  t_3 task
+  farm(2)                    4.000000     4.000000  t_4 task
+    task                     2.000000     2.000000  t_4 task
+    task                     2.000000     2.000000  t_5 task
+  farm(3)                    9.000000     9.000000  t_6 task
+    task                     3.000000     3.000000  t_6 task
+    task                     3.000000     3.000000  t_7 task
+    task                     3.000000     3.000000  t_8 task
+  deal(3)                    9.000000     9.000000  t_9 task
+    task                     3.000000     3.000000  t_9 task
+    task                     3.000000     3.000000  t_10 task
+    task                     3.000000     3.000000  t_11 task
+  task                       1.000000     1.000000  t_12 task
+Throughput bound: 1.000000
+Throughput estimate: 0.919192
@@ -0,0 +1,2 @@
+Compositional solve: 4 subtrees solved, 1 cached, 4125 states in all (largest 4122), Ns.
+Compositional throughput: 0.902634
@@ -0,0 +1,21 @@
+Fluid: 8 types, 32 variables, 11 channels.
+Equilibrium: t = 140.278 after 146 steps.
+Activity               Components           Each          Total
+comp_0                          1       0.999967       0.999967
+comp_1                          3       0.333322       0.999967
+comp_4                          2       0.499983       0.999967
+comp_6                          3       0.333322       0.999967
+comp_9                          1       0.333322       0.333322
+comp_10                         1       0.333322       0.333322
+comp_11                         1       0.333322       0.333322
+comp_12                         1       0.999967       0.999967
+move_0_1                                               0.999967
+move_1_4                                               0.999967
+move_4_6                                               0.999967
+move_6_9                                               0.333322
+move_6_10                                              0.333322
+move_6_11                                              0.333322
+move_9_12                                              0.333322
+move_10_12                                             0.333322
+move_11_12                                             0.333322
+Throughput: 0.999967
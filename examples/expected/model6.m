@@ -0,0 +1,16 @@
+Simulation: 11 replications, 2310000 events in Ns.
+Task     Name               Throughput        +/-  Utilisation        +/-
+t_0      task                 0.903781   0.004135     0.901670   0.002407
+t_1      task                 0.300781   0.001854     0.099799   0.000675
+t_2      task                 0.301581   0.001646     0.100828   0.000769
+t_3      task                 0.301407   0.001929     0.100893   0.000421
+t_4      task                 0.452052   0.002546     0.225376   0.000837
+t_5      task                 0.451732   0.002366     0.225386   0.001406
+t_6      task                 0.301805   0.002376     0.100536   0.001000
+t_7      task                 0.302411   0.002010     0.100921   0.001080
+t_8      task                 0.299588   0.002274     0.099550   0.001098
+t_9      task                 0.301269   0.001390     0.100378   0.000659
+t_10     task                 0.301279   0.001397     0.100340   0.001109
+t_11     task                 0.301269   0.001380     0.100285   0.000416
+t_12     task                 0.903804   0.004175     0.904230   0.001643
+Throughput: 0.903804 +/- 0.004175
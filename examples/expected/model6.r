@@ -0,0 +1,3 @@
+CTMC: 36231 states, 189575 transitions (3 symmetric groups).
+Steady state: 55 iterations.
+Throughput: 0.903075
@@ -0,0 +1,3 @@
+CTMC: 432728 states, 3203139 transitions.
+Steady state: 53 iterations.
+Throughput: 0.903075
@@ -0,0 +1,3 @@
+CTMC: 135156 states, 838722 transitions.
+Steady state: 19 iterations.
+Throughput: 0.794729
@@ -0,0 +1,550 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which analyse the PEPA model of a
+  committed skeleton hierarchy tree by fluid approximation. The
+  sequential components are the same as those used for deriving the
+  CTMC (see "ctmc.c"); but the leaves of identical farm branches are
+  counted instead of being represented individually. The resulting
+  ODEs are stiff, because moves are much faster than the tasks, so
+  they are integrated with an implicit method.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fluid.h"
+
+#define FLUID_NEWTON 20 /* Max. Newton iterations per time step. */
+
+/* Map every leaf of subtree n to its representative leaf, and record
+   the multiplicity of the representatives. The subtree stands for
+   mult identical copies of itself. */
+static int __fluid_types(__htree_node_t *n, double mult, int *rep,
+                         double *mul);
+
+/* Find the move channels between every pair of types. */
+static int __fluid_channels(fluid_t *f);
+
+/* Evaluate the derivatives at x, and their Jacobian if jac is not
+   NULL. */
+static void __fluid_deriv(fluid_t *f, double *x, double *dx, double *jac);
+
+/* Solve a x = b in place by Gaussian elimination with partial
+   pivoting. The solution is returned in b. */
+static int __fluid_lu_solve(double *a, double *b, int n);
+
+
+int __fluid_types(__htree_node_t *n, double mult, int *rep, double *mul) {
+    __htree_child_t *c;
+    __htree_node_t **cl;
+    int *cls, *reps, *cnt;
+    int i, j, k, nr = 0, fa, fb, na, e = 0;
+
+    if (n->mtype == TASK) {
+        rep[n->index] = n->index;
+        mul[n->index] = mult;
+        return 0;
+    }
+    c = n->clist;
+    if (n->mtype != FARM) {
+        for (i = 0; !e && c && i < n->nchr; i++) {
+            e = __fluid_types(c->child, mult, rep, mul);
+            c = c->next;
+        }
+        return e;
+    }
+
+    /* Branches of a farm receive their work non-deterministically,
+       so identical branches are interchangeable. Only the first one
+       of every class is analysed, on behalf of all of them. */
+    cl = (__htree_node_t **) malloc(sizeof(__htree_node_t *)*n->nchr);
+    cls = (int *) malloc(sizeof(int)*n->nchr);
+    reps = (int *) malloc(sizeof(int)*n->nchr);
+    cnt = (int *) calloc(n->nchr, sizeof(int));
+    if (!cl || !cls || !reps || !cnt) {
+        e = -1;
+        goto out;
+    }
+    for (i = 0; c && i < n->nchr; i++) {
+        cl[i] = c->child;
+        for (j = 0; j < nr; j++)
+            if (__htree_same_subtree(cl[reps[j]], cl[i]))
+                break;
+        if (j == nr)
+            reps[nr++] = i;
+        cls[i] = j;
+        cnt[j]++;
+        c = c->next;
+    }
+    for (j = 0; !e && j < nr; j++)
+        e = __fluid_types(cl[reps[j]], mult*cnt[j], rep, mul);
+    for (i = 0; !e && i < n->nchr; i++) {
+        if (reps[cls[i]] == i)
+            continue;
+        __htree_leaf_range(cl[reps[cls[i]]], &fa, &na);
+        __htree_leaf_range(cl[i], &fb, &k);
+        for (k = 0; k < na; k++)
+            rep[fb + k] = rep[fa + k];
+    }
+ out:
+    free(cl);
+    free(cls);
+    free(reps);
+    free(cnt);
+    return e;
+}
+
+/* Number of candidate partners of a step which belong to a type. */
+static int __fluid_count(fluid_t *f, __ctmc_step_t *s, int type) {
+    int i, k = 0;
+
+    for (i = 0; i < s->peers.n; i++)
+        if ((s->peers.l[i] >= 0) && (f->type[s->peers.l[i]] == type))
+            k++;
+    return k;
+}
+
+/* Add a move channel from variable a to variable b. */
+static int __fluid_add_chan(fluid_t *f, int a, int b,
+                            double alpha, double beta) {
+    __fluid_chan_t *c;
+
+    if (!(c = (__fluid_chan_t *)
+          realloc(f->chan, sizeof(__fluid_chan_t)*(f->nchan + 1))))
+        return -1;
+    f->chan = c;
+    c += f->nchan++;
+    c->a = a;
+    c->b = b;
+    c->alpha = alpha;
+    c->beta = beta;
+    return 0;
+}
+
+int __fluid_channels(fluid_t *f) {
+    __fluid_type_t *ta, *tb;
+    __ctmc_step_t *s;
+    int *cnt, *touched;
+    int i, j, k, sa, sb, nt, na, mb;
+
+    if (!(cnt = (int *) calloc(f->ntypes, sizeof(int))) ||
+        !(touched = (int *) malloc(sizeof(int)*f->ntypes))) {
+        free(cnt);
+        return -1;
+    }
+    for (i = 0; i < f->ntypes; i++) {
+        ta = &f->t[i];
+        for (sa = 0; sa < ta->def.nsteps; sa++) {
+            s = &ta->def.steps[sa];
+            if ((s->act != ACT_OUT) || (s->peers.n == 0))
+                continue;
+
+            /* The population which is ready to send is shared among
+               the receiving types in proportion to the number of
+               candidate partners of each type. */
+            nt = 0;
+            for (k = 0; k < s->peers.n; k++) {
+                if (s->peers.l[k] < 0)
+                    continue;
+                j = f->type[s->peers.l[k]];
+                if (cnt[j]++ == 0)
+                    touched[nt++] = j;
+            }
+            for (k = 0; k < nt; k++) {
+                j = touched[k];
+                tb = &f->t[j];
+
+                /* A type may send to, or receive from, another type
+                   at more than one step (e.g. deals); the shares are
+                   split evenly among those steps. */
+                for (na = 0, sb = 0; sb < ta->def.nsteps; sb++)
+                    if ((ta->def.steps[sb].act == ACT_OUT) &&
+                        __fluid_count(f, &ta->def.steps[sb], j))
+                        na++;
+                for (mb = 0, sb = 0; sb < tb->def.nsteps; sb++)
+                    if ((tb->def.steps[sb].act == ACT_IN) &&
+                        __fluid_count(f, &tb->def.steps[sb], i))
+                        mb++;
+                for (sb = 0; sb < tb->def.nsteps; sb++) {
+                    if ((tb->def.steps[sb].act != ACT_IN) ||
+                        !__fluid_count(f, &tb->def.steps[sb], i))
+                        continue;
+                    if (__fluid_add_chan
+                        (f, ta->base + sa, tb->base + sb,
+                         (double) cnt[j]/s->peers.n/mb,
+                         (double) __fluid_count(f, &tb->def.steps[sb], i)/
+                         tb->def.steps[sb].peers.n/na) < 0) {
+                        free(cnt);
+                        free(touched);
+                        return -1;
+                    }
+                }
+            }
+            for (k = 0; k < nt; k++)
+                cnt[touched[k]] = 0;
+        }
+    }
+    free(cnt);
+    free(touched);
+    return 0;
+}
+
+/* For a description of the following function, see "fluid.h". */
+fluid_t *fluid_derive(__htree_node_t *root, __htree_node_t **sstab,
+                      int nleaves) {
+    fluid_t *f;
+    __fluid_type_t *t;
+    int *rep = NULL;
+    double *mul = NULL, rmax = 0.0;
+    int i, k, e = 0;
+
+    if (!(f = (fluid_t *) calloc(1, sizeof(fluid_t))))
+        return NULL;
+    f->nleaves = nleaves;
+    if (!(f->type = (int *) malloc(sizeof(int)*nleaves)) ||
+        !(rep = (int *) malloc(sizeof(int)*nleaves)) ||
+        !(mul = (double *) malloc(sizeof(double)*nleaves)) ||
+        __fluid_types(root, 1.0, rep, mul)) {
+        e = -1;
+        goto out;
+    }
+
+    /* Representatives always precede the leaves they stand for. */
+    for (i = 0; i < nleaves; i++)
+        if (rep[i] == i)
+            f->type[i] = f->ntypes++;
+        else
+            f->type[i] = f->type[rep[i]];
+    if (!(f->t = (__fluid_type_t *)
+          calloc(f->ntypes, sizeof(__fluid_type_t)))) {
+        e = -1;
+        goto out;
+    }
+    for (i = 0; !e && i < nleaves; i++) {
+        if (rep[i] != i)
+            continue;
+        t = &f->t[f->type[i]];
+        t->leaf = i;
+        t->mult = mul[i];
+        t->base = f->nvars;
+        if (ctmc_leaf_def(sstab[i], &t->def) < 0)
+            e = -1;
+        f->nvars += t->def.nsteps;
+        if (t->def.rate > rmax)
+            rmax = t->def.rate;
+    }
+    if (e || !(f->next = (int *) malloc(sizeof(int)*f->nvars)) ||
+        !(f->owner = (int *) malloc(sizeof(int)*f->nvars)) ||
+        !(f->x = (double *) calloc(f->nvars, sizeof(double)))) {
+        e = -1;
+        goto out;
+    }
+    for (i = 0; i < f->ntypes; i++) {
+        t = &f->t[i];
+        for (k = 0; k < t->def.nsteps; k++) {
+            f->next[t->base + k] = t->base + (k + 1) % t->def.nsteps;
+            f->owner[t->base + k] = i;
+        }
+
+        /* Every component starts at its first local state. */
+        f->x[t->base] = t->mult;
+    }
+    f->kappa = FLUID_FAST*((rmax > 0.0) ? rmax : 1.0);
+    e = __fluid_channels(f);
+ out:
+    free(rep);
+    free(mul);
+    if (e) {
+        fluid_destroy(f);
+        return NULL;
+    }
+    return f;
+}
+
+void __fluid_deriv(fluid_t *f, double *x, double *dx, double *jac) {
+    __fluid_type_t *t;
+    __fluid_chan_t *c;
+    int i, k, n = f->nvars, v, w, a, b, na, nb;
+    double fl, g;
+
+    memset(dx, 0, sizeof(double)*n);
+    if (jac)
+        memset(jac, 0, sizeof(double)*n*n);
+    for (i = 0; i < f->ntypes; i++) {
+        t = &f->t[i];
+        for (k = 0; k < t->def.nsteps; k++) {
+            if (t->def.steps[k].act != ACT_COMP)
+                continue;
+            v = t->base + k;
+            w = f->next[v];
+            fl = t->def.rate*x[v];
+            dx[v] -= fl;
+            dx[w] += fl;
+            if (jac) {
+                jac[v*n + v] -= t->def.rate;
+                jac[w*n + v] += t->def.rate;
+            }
+        }
+    }
+
+    /* A move channel can only carry as much as the smaller of the
+       two populations allows. */
+    for (i = 0; i < f->nchan; i++) {
+        c = &f->chan[i];
+        a = c->a;
+        b = c->b;
+        na = f->next[a];
+        nb = f->next[b];
+        if (c->alpha*x[a] <= c->beta*x[b]) {
+            v = a;
+            g = f->kappa*c->alpha;
+        } else {
+            v = b;
+            g = f->kappa*c->beta;
+        }
+        fl = g*x[v];
+        dx[a] -= fl;
+        dx[b] -= fl;
+        dx[na] += fl;
+        dx[nb] += fl;
+        if (jac) {
+            jac[a*n + v] -= g;
+            jac[b*n + v] -= g;
+            jac[na*n + v] += g;
+            jac[nb*n + v] += g;
+        }
+    }
+}
+
+int __fluid_lu_solve(double *a, double *b, int n) {
+    int i, j, k, p;
+    double m, t;
+
+    for (k = 0; k < n; k++) {
+        p = k;
+        for (i = k + 1; i < n; i++)
+            if (fabs(a[i*n + k]) > fabs(a[p*n + k]))
+                p = i;
+        if (a[p*n + k] == 0.0)
+            return -1;
+        if (p != k) {
+            for (j = k; j < n; j++) {
+                t = a[k*n + j];
+                a[k*n + j] = a[p*n + j];
+                a[p*n + j] = t;
+            }
+            t = b[k];
+            b[k] = b[p];
+            b[p] = t;
+        }
+        for (i = k + 1; i < n; i++) {
+            if ((m = a[i*n + k]/a[k*n + k]) == 0.0)
+                continue;
+            for (j = k + 1; j < n; j++)
+                a[i*n + j] -= m*a[k*n + j];
+            b[i] -= m*b[k];
+        }
+    }
+    for (k = n - 1; k >= 0; k--) {
+        for (j = k + 1; j < n; j++)
+            b[k] -= a[k*n + j]*b[j];
+        b[k] /= a[k*n + k];
+    }
+    return 0;
+}
+
+static double __fluid_norm(double *v, int n) {
+    double m = 0.0;
+    int i;
+
+    for (i = 0; i < n; i++)
+        if (fabs(v[i]) > m)
+            m = fabs(v[i]);
+    return m;
+}
+
+/* For a description of the following function, see "fluid.h". The
+   local error of a backward Euler step is estimated from the change
+   in the derivatives over the step. */
+int fluid_solve(fluid_t *f, double tol, int maxsteps) {
+    double *a, *fx, *fy, *y, *r;
+    double h, err, scale = 0.0, pop = 0.0;
+    int i, j, it, n = f->nvars, ret = -1;
+
+    a = (double *) malloc(sizeof(double)*n*n);
+    fx = (double *) malloc(sizeof(double)*n);
+    fy = (double *) malloc(sizeof(double)*n);
+    y = (double *) malloc(sizeof(double)*n);
+    r = (double *) malloc(sizeof(double)*n);
+    if (!a || !fx || !fy || !y || !r)
+        goto out;
+    for (i = 0; i < f->ntypes; i++) {
+        if (f->t[i].mult > pop)
+            pop = f->t[i].mult;
+        if (f->t[i].mult*f->t[i].def.rate > scale)
+            scale = f->t[i].mult*f->t[i].def.rate;
+    }
+    h = 1.0/f->kappa;
+    f->time = 0.0;
+    f->nsteps = 0;
+    __fluid_deriv(f, f->x, fx, NULL);
+    while (f->nsteps < maxsteps) {
+        if (__fluid_norm(fx, n) <= tol*scale) {
+            ret = f->nsteps;
+            break;
+        }
+        if (h*f->kappa < 1e-6)
+            break;
+
+        /* Newton iterations for y = x + h f(y). */
+        memcpy(y, f->x, sizeof(double)*n);
+        for (it = 0; it < FLUID_NEWTON; it++) {
+            __fluid_deriv(f, y, fy, a);
+            for (i = 0; i < n; i++)
+                r[i] = f->x[i] + h*fy[i] - y[i];
+            if (__fluid_norm(r, n) <= 1e-12*pop)
+                break;
+            for (i = 0; i < n; i++) {
+                for (j = 0; j < n; j++)
+                    a[i*n + j] *= -h;
+                a[i*n + i] += 1.0;
+            }
+            if (__fluid_lu_solve(a, r, n) < 0) {
+                it = FLUID_NEWTON;
+                break;
+            }
+            for (i = 0; i < n; i++)
+                y[i] += r[i];
+        }
+        if (it == FLUID_NEWTON) {
+            h /= 4.0;
+            continue;
+        }
+        for (i = 0; i < n; i++)
+            r[i] = fy[i] - fx[i];
+        err = 0.5*h*__fluid_norm(r, n)/pop;
+        if (err > FLUID_LOCALERR) {
+            h *= (err > 100.0*FLUID_LOCALERR) ?
+                0.1 : 0.9*sqrt(FLUID_LOCALERR/err);
+            continue;
+        }
+        memcpy(f->x, y, sizeof(double)*n);
+        memcpy(fx, fy, sizeof(double)*n);
+        f->time += h;
+        f->nsteps++;
+        h *= (err < FLUID_LOCALERR/25.0) ?
+            5.0 : 0.9*sqrt(FLUID_LOCALERR/err);
+    }
+ out:
+    free(a);
+    free(fx);
+    free(fy);
+    free(y);
+    free(r);
+    return ret;
+}
+
+double fluid_throughput(fluid_t *f, int type) {
+    __fluid_type_t *t = &f->t[type];
+    double x = 0.0;
+    int k;
+
+    for (k = 0; k < t->def.nsteps; k++)
+        if (t->def.steps[k].act == ACT_COMP)
+            x += t->def.rate*f->x[t->base + k];
+    return x;
+}
+
+double fluid_flow(fluid_t *f, int chan) {
+    __fluid_chan_t *c = &f->chan[chan];
+    double a = c->alpha*f->x[c->a], b = c->beta*f->x[c->b];
+
+    return f->kappa*((a < b) ? a : b);
+}
+
+void fluid_destroy(fluid_t *f) {
+    int i;
+
+    if (!f)
+        return;
+    if (f->t)
+        for (i = 0; i < f->ntypes; i++)
+            ctmc_leaf_free(&f->t[i].def);
+    free(f->t);
+    free(f->type);
+    free(f->next);
+    free(f->owner);
+    free(f->x);
+    free(f->chan);
+    free(f);
+}
+
+int htree_fluid(void) {
+    fluid_t *f;
+    __fluid_type_t *t;
+    double x, y = 0.0;
+    char name[32];
+    int i, j, a, b, s;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(f = fluid_derive(__htree_rt.htree, __htree_rt.sstab,
+                           __htree_rt.nleaves))) {
+        fprintf(report_file, "Could not derive the fluid model.\n");
+        return -1;
+    }
+    fprintf(report_file, "Fluid: %d types, %d variables, %d channels.\n",
+            f->ntypes, f->nvars, f->nchan);
+    if ((s = fluid_solve(f, FLUID_TOLERANCE, FLUID_MAXSTEPS)) < 0)
+        fprintf(report_file, "Equilibrium not reached (t = %g).\n", f->time);
+    else
+        fprintf(report_file, "Equilibrium: t = %g after %d steps.\n", f->time,
+                s);
+    fprintf(report_file, "%-20s %12s %14s %14s\n", "Activity", "Components",
+            "Each", "Total");
+    for (i = 0; i < f->ntypes; i++) {
+        t = &f->t[i];
+        x = fluid_throughput(f, i);
+        sprintf(name, "comp_%d", t->leaf);
+        fprintf(report_file, "%-20s %12.0f %14f %14f\n", name, t->mult,
+                x/t->mult, x);
+        if (__htree_rt.sstab[t->leaf]->stype == UNKNOWN)
+            y += x;
+    }
+
+    /* Moves between the same two types are reported together. */
+    for (i = 0; i < f->nchan; i++) {
+        a = f->owner[f->chan[i].a];
+        b = f->owner[f->chan[i].b];
+        for (j = 0; j < i; j++)
+            if ((f->owner[f->chan[j].a] == a) &&
+                (f->owner[f->chan[j].b] == b))
+                break;
+        if (j < i)
+            continue;
+        for (x = 0.0, j = i; j < f->nchan; j++)
+            if ((f->owner[f->chan[j].a] == a) &&
+                (f->owner[f->chan[j].b] == b))
+                x += fluid_flow(f, j);
+        sprintf(name, "move_%d_%d", f->t[a].leaf, f->t[b].leaf);
+        fprintf(report_file, "%-20s %12s %14s %14f\n", name, "", "", x);
+    }
+    fprintf(report_file, "Throughput: %f\n", y);
+    fluid_destroy(f);
+    return (s < 0) ? -1 : 0;
+}
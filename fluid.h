@@ -0,0 +1,96 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to analyse the PEPA model of a committed skeleton hierarchy
+  tree by fluid approximation. Instead of exploring the state space,
+  the number of components in every local state is treated as a
+  continuous quantity, and a system of ordinary differential
+  equations (ODEs) is integrated until it reaches equilibrium. The
+  functions are defined in "fluid.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_FLUID_H
+#define __PEPA_FLUID_H
+
+#include "ctmc.h"
+
+#define FLUID_TOLERANCE 1e-9 /* Equilibrium criterion (relative). */
+#define FLUID_LOCALERR 1e-4  /* Local error allowed per time step. */
+#define FLUID_MAXSTEPS 100000 /* Max. number of time steps. */
+#define FLUID_FAST 1e4       /* Rate of moves, relative to the tasks. */
+
+/* Leaf-nodes which sit at the same position inside identical
+   branches of a farm behave alike, and are therefore represented by
+   a single sequential component (a type) whose multiplicity is the
+   number of such leaves. The ODE system has one variable for every
+   local state of every type, so that its size depends only on the
+   structure of the tree and not on the widths of the farms. */
+typedef struct {
+    int leaf;              /* Representative leaf-node. */
+    double mult;           /* Number of leaves of this type. */
+    int base;              /* Variable of the first local state. */
+    __ctmc_leaf_t def;     /* Sequential component (see "ctmc.h"). */
+} __fluid_type_t;
+
+/* Moves are passive on both sides. In the fluid model, they are
+   approximated by a fast synchronisation whose flow is bounded by
+   the share of the sender and the receiver populations that are
+   ready to engage in it. */
+typedef struct {
+    int a, b;              /* Sender and receiver variables. */
+    double alpha, beta;    /* Shares of the two populations. */
+} __fluid_chan_t;          /* Flow of moves between two types. */
+
+typedef struct {
+    int nleaves;           /* Number of leaf-nodes. */
+    int *type;             /* Type of every leaf-node. */
+    int ntypes;            /* Number of types. */
+    __fluid_type_t *t;     /* Types, indexed by first leaf. */
+    int nvars;             /* Number of ODE variables. */
+    int *next;             /* Variable which follows every variable. */
+    int *owner;            /* Type of every variable. */
+    double *x;             /* Population of every variable. */
+    int nchan;             /* Number of move channels. */
+    __fluid_chan_t *chan;  /* Move channels. */
+    double kappa;          /* Rate of moves. */
+    double time;           /* Time reached by the integrator. */
+    int nsteps;            /* Time steps taken by the integrator. */
+} fluid_t;                 /* Fluid model. */
+
+/* Derive the fluid model from the source-sink lookup table of a
+   committed skeleton hierarchy tree. Returns NULL if the model could
+   not be derived. */
+extern fluid_t *fluid_derive(__htree_node_t *root, __htree_node_t **sstab,
+                             int nleaves);
+
+/* Integrate the ODEs with an adaptive implicit (backward Euler)
+   method until the derivatives vanish. Returns the number of time
+   steps taken, or -1 if equilibrium was not reached. */
+extern int fluid_solve(fluid_t *f, double tol, int maxsteps);
+
+/* Total throughput of the comp activities of a type. */
+extern double fluid_throughput(fluid_t *f, int type);
+
+/* Flow of moves through a channel. */
+extern double fluid_flow(fluid_t *f, int chan);
+
+/* Deallocate the fluid model. */
+extern void fluid_destroy(fluid_t *f);
+
+/* Derive and solve the fluid model for the committed skeleton
+   hierarchy tree, and display the throughput of every activity. */
+extern int htree_fluid(void);
+
+#endif /* __PEPA_FLUID_H */
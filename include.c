@@ -0,0 +1,478 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which parse the included
+  description files (see "include.h"), and the cache of their
+  statements.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "include.h"
+
+#define INCLUDE_FNV_BASIS 14695981039346656037UL
+#define INCLUDE_FNV_PRIME 1099511628211UL
+
+typedef struct {
+    char *path;                /* File name, as resolved. */
+    off_t size;                /* Size of the file. */
+    struct timespec mtime;     /* Modification time of the file. */
+} __include_dep_t;             /* File which an entry depends on. */
+
+typedef struct {
+    __include_dep_t *d;        /* Files. */
+    int n;                     /* Number of files. */
+    int max;                   /* Allocated number of files. */
+} __include_deps_t;            /* Files included by an included file. */
+
+typedef struct __include_body_s {
+    const htree_body_t *from;  /* Body which was copied. */
+    htree_body_t body;         /* Copy. */
+    struct __include_body_s *next; /* Next copy. */
+} __include_body_t;            /* Copy of a body of instances. */
+
+typedef struct __include_s {
+    char *path;                /* File name, as resolved. */
+    char *dir;                 /* Directory from which the files it
+                                  includes are found. */
+    off_t size;                /* Size of the file. */
+    struct timespec mtime;     /* Modification time of the file. */
+    unsigned long hash;        /* Hash of the content (FNV-1a). */
+    __include_deps_t deps;     /* Files it includes, directly or not,
+                                  whose statements are spliced in. */
+    htree_stmt_t *stmts;       /* Statements of the file. */
+    int nstmts;                /* Number of statements. */
+    struct __htree_rt_s names; /* Owns the task names. */
+    __include_body_t *bodies;  /* Bodies of the instances. */
+    int defines;               /* Number of subtrees it defines. */
+    int refs;                  /* Number of parses which hold it. */
+    int gone;                  /* Whether it has left the cache. */
+    struct __include_s *next;  /* Next file in the cache. */
+} __include_t;                 /* Included file in the cache. */
+
+typedef struct __include_hold_s {
+    __include_t *e;            /* Entry held. */
+    struct __include_hold_s *next; /* Next entry held by the parse. */
+} __include_hold_t;            /* Entry held by a parse. */
+
+static __include_t *__include_cache = NULL; /* Most recently used
+                                               first. */
+static int __include_count = 0;             /* Entries in the cache. */
+static pthread_mutex_t __include_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Hash the content of the file path, of size bytes. */
+static int __include_hash(const char *path, off_t size,
+                          unsigned long *hash);
+
+/* Parse the file path into a cache entry. */
+static __include_t *__include_parse(htree_parse_t *p, const char *path);
+
+/* Find an entry for the file path, included from the directory dir,
+   in the cache: by name if hash is NULL, by content otherwise. The
+   files which the entry includes must be unchanged. An entry for the
+   same name which has changed is removed. The entry found is held for
+   the parse p, and becomes the most recently used. The cache must be
+   locked. */
+static __include_t *__include_find(htree_parse_t *p, const char *path,
+                                   const char *dir, struct stat *st,
+                                   unsigned long *hash);
+
+/* Hold the entry e for the parse p. The cache must be locked. */
+static int __include_hold(htree_parse_t *p, __include_t *e);
+
+/* Take the entry e, whose predecessor is prev, out of the cache; it
+   is freed if no parse holds it. The cache must be locked. */
+static void __include_remove(__include_t *e, __include_t *prev);
+
+/* Add the file path, of the given size and modification time, to the
+   files d. */
+static int __include_depend(__include_deps_t *d, const char *path,
+                            off_t size, const struct timespec *mtime);
+
+/* Copy the statements s of a file into the entry e: the names and
+   symbolic rates, and the bodies of instances, which belong to the
+   parse of the file. */
+static int __include_copy(__include_t *e, htree_stmt_t *t,
+                          const htree_stmt_t *s, int n);
+
+/* Deallocate a cache entry. */
+static void __include_free(__include_t *e);
+
+
+int __include_hash(const char *path, off_t size, unsigned long *hash) {
+    unsigned long h = INCLUDE_FNV_BASIS;
+    char buf[65536];
+    ssize_t i, n;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return -1;
+    while (size > 0) {
+        if ((n = read(fd, buf, sizeof(buf))) <= 0)
+            break;
+        for (i = 0; i < n; i++)
+            h = (h ^ (unsigned char) buf[i])*INCLUDE_FNV_PRIME;
+        size -= n;
+    }
+    close(fd);
+    *hash = h;
+    return size ? -1 : 0;
+}
+
+/* Check that the files which the entry e includes are unchanged. */
+static int __include_valid(__include_t *e) {
+    struct stat st;
+    int i;
+
+    for (i = 0; i < e->deps.n; i++)
+        if (stat(e->deps.d[i].path, &st) ||
+            (st.st_size != e->deps.d[i].size) ||
+            (st.st_mtim.tv_sec != e->deps.d[i].mtime.tv_sec) ||
+            (st.st_mtim.tv_nsec != e->deps.d[i].mtime.tv_nsec))
+            return 0;
+    return 1;
+}
+
+__include_t *__include_find(htree_parse_t *p, const char *path,
+                            const char *dir, struct stat *st,
+                            unsigned long *hash) {
+    __include_t *e, *prev = NULL, *next;
+
+    /* The same content found from another directory may include other
+       files. */
+    for (e = __include_cache; e; prev = e, e = next) {
+        next = e->next;
+        if (!hash && e->path && !strcmp(e->path, path) &&
+            ((e->size != st->st_size) ||
+             (e->mtime.tv_sec != st->st_mtim.tv_sec) ||
+             (e->mtime.tv_nsec != st->st_mtim.tv_nsec) ||
+             !__include_valid(e))) {
+            __include_remove(e, prev);
+            e = prev;
+            continue;
+        }
+        if (e->size != st->st_size)
+            continue;
+        if ((hash ? ((e->hash == *hash) && !strcmp(e->dir, dir))
+             : (e->path && !strcmp(e->path, path))) &&
+            __include_valid(e)) {
+            if (__include_hold(p, e) < 0)
+                return NULL;
+            if (prev) {
+                prev->next = e->next;
+                e->next = __include_cache;
+                __include_cache = e;
+            }
+            return e;
+        }
+    }
+    return NULL;
+}
+
+int __include_hold(htree_parse_t *p, __include_t *e) {
+    __include_hold_t *h;
+
+    if (!(h = (__include_hold_t *) malloc(sizeof(__include_hold_t))))
+        return -1;
+    h->e = e;
+    h->next = (__include_hold_t *) p->incl;
+    p->incl = h;
+    e->refs++;
+    return 0;
+}
+
+void __include_remove(__include_t *e, __include_t *prev) {
+    if (prev)
+        prev->next = e->next;
+    else
+        __include_cache = e->next;
+    __include_count--;
+    e->gone = 1;
+    if (!e->refs)
+        __include_free(e);
+}
+
+int __include_depend(__include_deps_t *d, const char *path, off_t size,
+                     const struct timespec *mtime) {
+    __include_dep_t *t;
+    int n;
+
+    if (d->n == d->max) {
+        n = d->max ? 2*d->max : 8;
+        if (!(t = (__include_dep_t *) realloc(d->d,
+                                              sizeof(__include_dep_t)*n)))
+            return -1;
+        d->d = t;
+        d->max = n;
+    }
+    if (!(d->d[d->n].path = strdup(path)))
+        return -1;
+    d->d[d->n].size = size;
+    d->d[d->n].mtime = *mtime;
+    d->n++;
+    return 0;
+}
+
+__include_t *__include_parse(htree_parse_t *p, const char *path) {
+    htree_parse_t q;
+    __include_t *e;
+    int err;
+
+    if (!(e = (__include_t *) calloc(1, sizeof(__include_t))))
+        return NULL;
+    memset(&q, 0, sizeof(htree_parse_t));
+    q.fname = path;
+    q.depth = p->depth + 1;
+    q.record = 1;
+    q.deps = &e->deps;
+    if ((err = init_lex(&q, (char *) path)) < 0) {
+        free(e);
+        return NULL;
+    }
+    if (!(err = htree_parse_scan(&q)) && q.nstmts &&
+        !(e->stmts = (htree_stmt_t *) malloc(sizeof(htree_stmt_t)*
+                                             q.nstmts)))
+        err = -1;
+
+    /* The names point into the mapping of the file, and the bodies
+       belong to the parse: they are copied into the entry. */
+    if (!err)
+        err = __include_copy(e, e->stmts, q.stmts, q.nstmts);
+    e->nstmts = q.nstmts;
+    e->defines = q.defines;
+    final_lex(&q);
+    htree_names_free(&q.rt);
+    if (err) {
+        __include_free(e);
+        return NULL;
+    }
+    return e;
+}
+
+int __include_copy(__include_t *e, htree_stmt_t *t, const htree_stmt_t *s,
+                   int n) {
+    __include_body_t *b;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        t[i] = s[i];
+        if (s[i].name &&
+            !(t[i].name = htree_intern(&e->names, s[i].name, 1)))
+            return -1;
+        if (s[i].rname &&
+            !(t[i].rname = htree_intern(&e->names, s[i].rname, 1)))
+            return -1;
+        if (!s[i].body)
+            continue;
+
+        /* A body which is shared by instances is copied once. */
+        for (b = e->bodies; b && (b->from != s[i].body); b = b->next);
+        if (!b) {
+            if (!(b = (__include_body_t *)
+                  malloc(sizeof(__include_body_t) +
+                         sizeof(htree_stmt_t)*s[i].body->nstmts)))
+                return -1;
+            b->from = s[i].body;
+            b->body.stmts = (htree_stmt_t *) (b + 1);
+            b->body.nstmts = s[i].body->nstmts;
+            b->next = e->bodies;
+            e->bodies = b;
+            if (__include_copy(e, b->body.stmts, s[i].body->stmts,
+                               s[i].body->nstmts) < 0)
+                return -1;
+        }
+        t[i].body = &b->body;
+    }
+    return 0;
+}
+
+void __include_free(__include_t *e) {
+    __include_body_t *b;
+    int i;
+
+    while ((b = e->bodies)) {
+        e->bodies = b->next;
+        free(b);
+    }
+    for (i = 0; i < e->deps.n; i++)
+        free(e->deps.d[i].path);
+    free(e->deps.d);
+    free(e->path);
+    free(e->dir);
+    free(e->stmts);
+    htree_names_free(&e->names);
+    free(e);
+}
+
+/* For a description of the following function, see "include.h". */
+int include_stmts(htree_parse_t *p, const char *name,
+                  const htree_stmt_t **stmts, int *n, char **scope) {
+    __include_t *e, *f;
+    unsigned long hash;
+    struct stat st;
+    const char *s;
+    char *path, *dir;
+    size_t k;
+    int i;
+
+    /* A relative name is found from the directory of the including
+       file. */
+    k = (p->fname && (name[0] != '/') && (s = strrchr(p->fname, '/'))) ?
+        (size_t) (s - p->fname + 1) : 0;
+    *scope = NULL;
+    if (!(path = (char *) malloc(k + strlen(name) + 1)))
+        return -1;
+    if (k)
+        memcpy(path, p->fname, k);
+    strcpy(path + k, name);
+
+    if (p->depth >= INCLUDE_DEPTH) {
+        fprintf(stderr, "[ includes nested too deeply in %s ]\n", path);
+        free(path);
+        return -1;
+    }
+    if (stat(path, &st) || !S_ISREG(st.st_mode)) {
+        fprintf(stderr, "[ cannot open %s ]\n", path);
+        free(path);
+        return -1;
+    }
+
+    /* The files which it includes are found from its own directory. */
+    k = (s = strrchr(path, '/')) ? (size_t) (s - path + 1) : 0;
+    if (!(dir = strndup(path, k))) {
+        free(path);
+        return -1;
+    }
+
+    /* A file which is unchanged since it was parsed is not read. */
+    pthread_mutex_lock(&__include_lock);
+    e = __include_find(p, path, dir, &st, NULL);
+    pthread_mutex_unlock(&__include_lock);
+    if (e)
+        goto done;
+
+    /* Otherwise, the same content may have been parsed already. */
+    if (__include_hash(path, st.st_size, &hash) < 0) {
+        fprintf(stderr, "[ cannot open %s ]\n", path);
+        goto fail;
+    }
+    pthread_mutex_lock(&__include_lock);
+    e = __include_find(p, path, dir, &st, &hash);
+    pthread_mutex_unlock(&__include_lock);
+
+    /* The file is parsed without the lock, as it may include others;
+       if another thread has parsed the same content meanwhile, its
+       entry is kept. */
+    if (!e) {
+        if (!(e = __include_parse(p, path))) {
+            fprintf(stderr, "[ cannot include %s ]\n", path);
+            goto fail;
+        }
+        e->size = st.st_size;
+        e->hash = hash;
+        e->dir = dir;
+        dir = NULL;
+        pthread_mutex_lock(&__include_lock);
+        if ((f = __include_find(p, path, e->dir, &st, &hash))) {
+            __include_free(e);
+            e = f;
+        } else if (__include_hold(p, e) < 0) {
+            pthread_mutex_unlock(&__include_lock);
+            __include_free(e);
+            goto fail;
+        } else {
+            e->next = __include_cache;
+            __include_cache = e;
+
+            /* The least recently used entry makes room. */
+            if (++__include_count > INCLUDE_MAX) {
+                for (f = e; f->next->next; f = f->next);
+                __include_remove(f->next, f);
+            }
+        }
+        pthread_mutex_unlock(&__include_lock);
+    }
+
+    /* The entry is found by this name and time from now on. */
+    if (!(s = strdup(path)))
+        goto fail;
+    pthread_mutex_lock(&__include_lock);
+    free(e->path);
+    e->path = (char *) s;
+    e->mtime = st.st_mtim;
+    pthread_mutex_unlock(&__include_lock);
+
+    /* An included file depends on this file, and on those it includes
+       in turn, which the entry holds until it is freed. */
+ done:
+    if (p->deps) {
+        if (__include_depend((__include_deps_t *) p->deps, path,
+                             st.st_size, &st.st_mtim) < 0)
+            goto fail;
+        for (i = 0; i < e->deps.n; i++)
+            if (__include_depend((__include_deps_t *) p->deps,
+                                 e->deps.d[i].path, e->deps.d[i].size,
+                                 &e->deps.d[i].mtime) < 0)
+                goto fail;
+    }
+    free(dir);
+    *n = e->nstmts;
+    if (e->defines) {
+        /* Only the statements of the tree are counted. */
+        for (i = 0; i < e->nstmts; i++)
+            if ((e->stmts[i].skel == UNKNOWN) && !e->stmts[i].body)
+                (*n)--;
+        *stmts = NULL;
+        *scope = path;
+        return 0;
+    }
+    free(path);
+    *stmts = e->stmts;
+    return 0;
+
+ fail:
+    free(path);
+    free(dir);
+    return -1;
+}
+
+void include_release(htree_parse_t *p) {
+    __include_hold_t *h;
+
+    pthread_mutex_lock(&__include_lock);
+    while ((h = (__include_hold_t *) p->incl)) {
+        p->incl = h->next;
+        if (!--h->e->refs && h->e->gone)
+            __include_free(h->e);
+        free(h);
+    }
+    pthread_mutex_unlock(&__include_lock);
+}
+
+void include_final(void) {
+    __include_t *e;
+
+    pthread_mutex_lock(&__include_lock);
+    while ((e = __include_cache)) {
+        __include_cache = e->next;
+        __include_free(e);
+    }
+    __include_count = 0;
+    pthread_mutex_unlock(&__include_lock);
+}
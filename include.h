@@ -0,0 +1,68 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes for the included
+  description files, which are defined in "include.c". A statement
+
+      include "stage.des";
+
+  splices the statements of stage.des where it appears, so that a
+  shared subtree is described in one file. Included files are parsed
+  once: their statements are kept in a cache shared by all the parses
+  of the process, and are looked up by file name, size and
+  modification time, and then by a hash of their content and the
+  directory its own includes are found from, so that a file which is
+  copied or touched is not parsed again. As the statements of the
+  files which a file includes are spliced into its own, an entry also
+  records the name, size and modification time of each of them, and
+  is not used once any of them has changed. An entry which is
+  replaced, or evicted as the cache holds more than INCLUDE_MAX files
+  (least recently used first), is freed once the last parse which
+  holds its statements is freed. Definitions of subtrees are not kept:
+  an included file which defines subtrees is parsed again, in the
+  scope of the file which includes it, whenever it is included.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_INCLUDE_H
+#define __PEPA_INCLUDE_H
+
+#include "pepa.h"
+
+/* Deepest nesting of included files (also stops include cycles). */
+#define INCLUDE_DEPTH 32
+
+/* Most files kept in the cache. */
+#define INCLUDE_MAX 256
+
+/* Get the statements of the description file name, which is included
+   by the file being parsed by p, into *s and their number into *n; a
+   relative name is found from the directory of that file. The
+   statements, and their task names, are owned by the cache, and are
+   held for p until include_release(). A file which defines subtrees
+   (or includes one which does) exports its definitions to p, and its
+   statements may use those of p: it is not shared, but *scope is set
+   to its name (to be freed) instead of *s, for it to be parsed in the
+   scope of p, and *n to the number of its statements which are not
+   named rates. Returns -1 if the file cannot be read or parsed. */
+extern int include_stmts(htree_parse_t *p, const char *name,
+                         const htree_stmt_t **s, int *n, char **scope);
+
+/* Release the included files held for the parse p (see
+   htree_parse_free()). */
+extern void include_release(htree_parse_t *p);
+
+/* Deallocate the cache of included files. */
+extern void include_final(void);
+
+#endif /* __PEPA_INCLUDE_H */
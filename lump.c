@@ -0,0 +1,364 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which aggregate a derived CTMC by
+  ordinary or exact lumpability. The coarsest lumpable partition is
+  found by partition refinement: a block is used as a splitter, the
+  states are separated by their cumulative rate into (ordinary) or
+  out of (exact) the splitter, and all but the largest of the new
+  blocks become splitters in turn. Only the states with a transition
+  to (or from) the splitter are sorted and moved, as in the algorithm
+  of Paige and Tarjan. Since a state only takes part in the splitters
+  of blocks that have at most half the size of the previous one, the
+  refinement takes O(m log^2 n) time for a CTMC with n states and m
+  transitions.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "lump.h"
+#include "store.h"
+
+#define LUMP_EPSILON 1e-9 /* Relative difference of equal rates. */
+
+typedef struct {
+    double w;             /* Sorting key. */
+    unsigned int label;   /* Secondary key. */
+    int s;                /* State index. */
+} __lump_key_t;
+
+typedef struct {
+    int n;                /* Number of states. */
+    int nblocks;          /* Number of blocks. */
+    int *elem;            /* States, grouped by block. */
+    int *pos;             /* Position of a state in elem. */
+    int *blk;             /* Block of a state. */
+    int *start;           /* Block b occupies elem[start[b]] */
+    int *end;             /* up to elem[end[b] - 1]. */
+    int *mark;            /* Number of touched states in a block. */
+    char *inq;            /* Is the block waiting as a splitter? */
+    int *queue;           /* Splitter blocks (circular). */
+    int qhead, qlen;
+} __lump_part_t;
+
+static int __lump_cmp_key(const void *a, const void *b) {
+    const __lump_key_t *x = (const __lump_key_t *) a;
+    const __lump_key_t *y = (const __lump_key_t *) b;
+
+    if (x->label != y->label)
+        return (x->label < y->label) ? -1 : 1;
+    if (x->w != y->w)
+        return (x->w < y->w) ? -1 : 1;
+    return x->s - y->s;
+}
+
+/* Two rates are considered equal if they only differ by rounding,
+   since cumulative rates are summed in different orders. */
+static int __lump_differ(double a, double b) {
+    double m = (fabs(a) > fabs(b)) ? fabs(a) : fabs(b);
+    return fabs(a - b) > LUMP_EPSILON*m;
+}
+
+static void __lump_enqueue(__lump_part_t *p, int b) {
+    if (p->inq[b])
+        return;
+    p->inq[b] = 1;
+    p->queue[(p->qhead + p->qlen++) % p->n] = b;
+}
+
+/* Return the end of the run of equal keys which starts at k[i], up
+   to k[hi - 1]. */
+static int __lump_run(__lump_key_t *k, int i, int hi) {
+    int j;
+
+    for (j = i + 1; j < hi; j++)
+        if ((k[j].label != k[i].label) || __lump_differ(k[j].w, k[i].w))
+            break;
+    return j;
+}
+
+/* Split block b, whose states elem[lo..mid-1] were touched by the
+   splitter and are sorted by key in k[lo..mid-1], and whose states
+   elem[mid..hi-1] were not (their key is zero). The untouched states
+   keep the identity of block b, or the largest run of keys if every
+   state was touched, so that only the touched states are moved: a
+   split costs time in the number of touched states, not in the size
+   of the block. The runs of touched states become new blocks and
+   splitters. If b was not waiting as a splitter, the largest part
+   is left out: the rates into it follow from the rates into b and
+   into the others. */
+static void __lump_split(__lump_part_t *p, __lump_key_t *k,
+                         int b, int lo, int mid, int hi) {
+    int i, j, r, c, big = -1, bigsize = hi - mid, keep = -1;
+    int was = p->inq[b];
+
+    /* Find the largest part. */
+    for (i = lo; i < mid; i = j) {
+        j = __lump_run(k, i, mid);
+        if (j - i > bigsize) {
+            big = i;
+            bigsize = j - i;
+        }
+    }
+    if (bigsize == hi - lo)
+        return; /* No split. */
+    if (mid == hi)
+        keep = big;
+    else {
+        p->start[b] = mid;
+        p->end[b] = hi;
+        if (!was && (big >= 0))
+            __lump_enqueue(p, b);
+    }
+
+    for (i = lo; i < mid; i = j) {
+        j = __lump_run(k, i, mid);
+        for (r = i; r < j; r++) {
+            p->elem[r] = k[r].s;
+            p->pos[k[r].s] = r;
+        }
+        if (i == keep) {
+            p->start[b] = i;
+            p->end[b] = j;
+            continue;
+        }
+        c = p->nblocks++;
+        p->start[c] = i;
+        p->end[c] = j;
+        p->mark[c] = 0;
+        p->inq[c] = 0;
+        for (r = i; r < j; r++)
+            p->blk[k[r].s] = c;
+        if (was || (i != big))
+            __lump_enqueue(p, c);
+    }
+}
+
+/* For a description of the following function, see "lump.h". */
+ctmc_t *ctmc_lump(ctmc_t *m, int kind, unsigned int *label) {
+    __lump_part_t p;
+    __lump_key_t *k = NULL;
+    ctmc_t *q = NULL;
+    int *trow = NULL, *tcol = NULL, *ncol, *touched = NULL;
+    int *blocks = NULL, *last = NULL;
+    double *tval = NULL, *nval, *w = NULL;
+    int i, j, s, t, b, c, nt, nb, lo, mid, ok = 0;
+
+    memset(&p, 0, sizeof(p));
+    p.n = m->nstates;
+    if (!(p.elem = (int *) malloc(sizeof(int)*p.n)) ||
+        !(p.pos = (int *) malloc(sizeof(int)*p.n)) ||
+        !(p.blk = (int *) malloc(sizeof(int)*p.n)) ||
+        !(p.start = (int *) malloc(sizeof(int)*p.n)) ||
+        !(p.end = (int *) malloc(sizeof(int)*p.n)) ||
+        !(p.mark = (int *) calloc(p.n, sizeof(int))) ||
+        !(p.inq = (char *) calloc(p.n, sizeof(char))) ||
+        !(p.queue = (int *) malloc(sizeof(int)*p.n)) ||
+        !(k = (__lump_key_t *) malloc(sizeof(__lump_key_t)*p.n)) ||
+        !(w = (double *) calloc(p.n, sizeof(double))) ||
+        !(touched = (int *) malloc(sizeof(int)*p.n)) ||
+        !(blocks = (int *) malloc(sizeof(int)*p.n)))
+        goto done;
+
+    /* Ordinary lumping compares the rates into a splitter, and so
+       needs the predecessors of its states. Exact lumping compares
+       the rates out of a splitter, i.e. the successors. */
+    if (kind == LUMP_ORDINARY) {
+        if (ctmc_transpose(m, &trow, &tcol, &tval) < 0)
+            goto done;
+    } else {
+        trow = m->row;
+        tcol = m->col;
+        tval = m->val;
+    }
+
+    /* Initial partition. */
+    for (s = 0; s < p.n; s++) {
+        k[s].s = s;
+        k[s].label = label ? label[s] : 0;
+        k[s].w = (kind == LUMP_EXACT) ? m->out[s] : 0.0;
+    }
+    qsort(k, p.n, sizeof(__lump_key_t), __lump_cmp_key);
+    p.nblocks = 1;
+    p.start[0] = 0;
+    p.end[0] = p.n;
+    for (s = 0; s < p.n; s++)
+        p.blk[s] = 0;
+    __lump_enqueue(&p, 0);
+    __lump_split(&p, k, 0, 0, p.n, p.n);
+
+    /* Refinement. */
+    while (p.qlen > 0) {
+        b = p.queue[p.qhead];
+        p.qhead = (p.qhead + 1) % p.n;
+        p.qlen--;
+        p.inq[b] = 0;
+
+        /* Cumulative rate of every state into the splitter. */
+        nt = 0;
+        for (i = p.start[b]; i < p.end[b]; i++) {
+            t = p.elem[i];
+            for (j = trow[t]; j < trow[t + 1]; j++) {
+                s = tcol[j];
+                if (w[s] == 0.0)
+                    touched[nt++] = s;
+                w[s] += tval[j];
+            }
+        }
+
+        /* Move the touched states to the front of their blocks. */
+        nb = 0;
+        for (i = 0; i < nt; i++) {
+            s = touched[i];
+            c = p.blk[s];
+            if (p.mark[c] == 0)
+                blocks[nb++] = c;
+            j = p.start[c] + p.mark[c]++;
+            t = p.elem[j];
+            p.elem[p.pos[s]] = t;
+            p.pos[t] = p.pos[s];
+            p.elem[j] = s;
+            p.pos[s] = j;
+        }
+
+        /* Sort the touched states of every block by their rate and
+           split the block. Untouched states have rate zero, and are
+           left where they are. */
+        for (i = 0; i < nb; i++) {
+            c = blocks[i];
+            lo = p.start[c];
+            mid = lo + p.mark[c];
+            for (j = lo; j < mid; j++) {
+                k[j].s = p.elem[j];
+                k[j].label = 0;
+                k[j].w = w[p.elem[j]];
+            }
+            p.mark[c] = 0;
+            qsort(k + lo, mid - lo, sizeof(__lump_key_t), __lump_cmp_key);
+            __lump_split(&p, k, c, lo, mid, p.end[c]);
+        }
+        for (i = 0; i < nt; i++)
+            w[touched[i]] = 0.0;
+    }
+
+    /* Renumber the blocks in the order of their first states, which
+       keeps the breadth first order that iterative solvers do well
+       with. The members of a block are kept in elem[] as before. */
+    if (!(last = (int *) malloc(sizeof(int)*p.nblocks)))
+        goto done;
+    for (b = 0; b < p.nblocks; b++)
+        last[b] = -1;
+    for (s = 0, nb = 0; s < p.n; s++)
+        if (last[p.blk[s]] < 0)
+            last[p.blk[s]] = nb++;
+    for (b = 0; b < p.nblocks; b++) {
+        p.mark[last[b]] = p.start[b];
+        blocks[last[b]] = p.end[b];
+    }
+    memcpy(p.start, p.mark, sizeof(int)*p.nblocks);
+    memcpy(p.end, blocks, sizeof(int)*p.nblocks);
+    for (s = 0; s < p.n; s++)
+        p.blk[s] = last[p.blk[s]];
+
+    /* Build the aggregated CTMC. The rate from block b to block c is
+       the total rate from b to c divided by the size of b. */
+    if (!(q = (ctmc_t *) calloc(1, sizeof(ctmc_t))) ||
+        !(q->row = (int *) malloc(sizeof(int)*(p.nblocks + 1))) ||
+        !(q->out = (double *) calloc(p.nblocks, sizeof(double))) ||
+        !(q->col = (int *) malloc(sizeof(int)*(m->ntrans + 1))) ||
+        !(q->val = (double *) malloc(sizeof(double)*(m->ntrans + 1))))
+        goto done;
+    q->nstates = p.nblocks;
+    q->maxstates = p.nblocks;
+    q->maxtrans = m->ntrans + 1;
+    for (b = 0; b < p.nblocks; b++)
+        last[b] = -1;
+    for (b = 0; b < p.nblocks; b++) {
+        q->row[b] = q->ntrans;
+        for (i = p.start[b]; i < p.end[b]; i++) {
+            s = p.elem[i];
+            for (j = m->row[s]; j < m->row[s + 1]; j++) {
+                c = p.blk[m->col[j]];
+                if (c == b)
+                    continue;
+                if (last[c] < q->row[b]) {
+                    last[c] = q->ntrans;
+                    q->col[q->ntrans] = c;
+                    q->val[q->ntrans++] = 0.0;
+                }
+                q->val[last[c]] += m->val[j];
+            }
+        }
+        for (j = q->row[b]; j < q->ntrans; j++) {
+            q->val[j] /= p.end[b] - p.start[b];
+            q->out[b] += q->val[j];
+        }
+    }
+    q->row[p.nblocks] = q->ntrans;
+    if ((ncol = (int *) realloc(q->col, sizeof(int)*(q->ntrans + 1))))
+        q->col = ncol;
+    if ((nval = (double *) realloc(q->val, sizeof(double)*(q->ntrans + 1))))
+        q->val = nval;
+
+    free(m->block);
+    m->block = p.blk;
+    m->nblocks = p.nblocks;
+    p.blk = NULL;
+    ok = 1;
+
+ done:
+    if (kind == LUMP_ORDINARY) {
+        store_free(trow);
+        store_free(tcol);
+        store_free(tval);
+    }
+    free(p.elem);
+    free(p.pos);
+    free(p.blk);
+    free(p.start);
+    free(p.end);
+    free(p.mark);
+    free(p.inq);
+    free(p.queue);
+    free(k);
+    free(w);
+    free(touched);
+    free(blocks);
+    free(last);
+    if (!ok) {
+        ctmc_destroy(q);
+        return NULL;
+    }
+    return q;
+}
+
+/* For a description of the following function, see "lump.h". */
+int ctmc_unlump(ctmc_t *m, ctmc_t *q) {
+    int *size, s;
+
+    if (!m->block || !q->pi)
+        return -1;
+    if (!m->pi && !(m->pi = (double *) malloc(sizeof(double)*m->nstates)))
+        return -1;
+    if (!(size = (int *) calloc(q->nstates, sizeof(int))))
+        return -1;
+    for (s = 0; s < m->nstates; s++)
+        size[m->block[s]]++;
+    for (s = 0; s < m->nstates; s++)
+        m->pi[s] = q->pi[m->block[s]]/size[m->block[s]];
+    free(size);
+    return 0;
+}
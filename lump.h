@@ -0,0 +1,42 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes for aggregating a
+  derived CTMC by lumpability. The functions are defined in "lump.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_LUMP_H
+#define __PEPA_LUMP_H
+
+#include "ctmc.h"
+
+#define LUMP_ORDINARY 1 /* Equal rates into every block. */
+#define LUMP_EXACT    2 /* Equal rates from every block. */
+
+/* Compute the coarsest lumpable partition of the CTMC which refines
+   the initial partition given by label (states with different labels
+   are never lumped together), and return the aggregated CTMC. The
+   block of every original state is recorded in m->block. For exact
+   lumping, states must also have equal exit rates, and the states
+   of a block are equally likely at steady state. Returns NULL if
+   the aggregation failed. */
+extern ctmc_t *ctmc_lump(ctmc_t *m, int kind, unsigned int *label);
+
+/* Map the steady state of the aggregated CTMC back to the states of
+   the original CTMC. The probability of a block is shared equally
+   by its states; this is exact for exact lumping, and preserves
+   every measure defined over the blocks for ordinary lumping. */
+extern int ctmc_unlump(ctmc_t *m, ctmc_t *q);
+
+#endif /* __PEPA_LUMP_H */
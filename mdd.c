@@ -0,0 +1,480 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which store the reachable states
+  of a CTMC as a multi-valued decision diagram, and compare the ways
+  of storing states (see "mdd.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mdd.h"
+
+static unsigned int __mdd_hash(int level, int *kid, int n) {
+    unsigned int h = 2166136261u ^ (unsigned int) level;
+    int i;
+
+    for (i = 0; i < n; i++)
+        h = (h ^ (unsigned int) kid[i])*16777619u;
+    return h;
+}
+
+static int __mdd_rehash(mdd_t *d, int size) {
+    unsigned int h;
+    int i, k, *t;
+
+    if (!(t = (int *) malloc(sizeof(int)*size)))
+        return -1;
+    for (i = 0; i < size; i++)
+        t[i] = -1;
+    for (k = 2; k < d->nnodes; k++) {
+        h = __mdd_hash(d->level[k], d->edge + d->first[k],
+                       d->size[d->level[k]]) & (size - 1);
+        while (t[h] >= 0)
+            h = (h + 1) & (size - 1);
+        t[h] = k;
+    }
+    free(d->hash);
+    d->hash = t;
+    d->hsize = size;
+    return 0;
+}
+
+/* Find the node of the given level and edges, adding it if it is
+   new. Returns the node, or -1 on failure. */
+static int __mdd_unique(mdd_t *d, int level, int *kid) {
+    int n = d->size[level], i, k, *z;
+    unsigned int h;
+    long *y;
+
+    h = __mdd_hash(level, kid, n) & (d->hsize - 1);
+    while ((k = d->hash[h]) >= 0) {
+        if ((d->level[k] == level) &&
+            !memcmp(d->edge + d->first[k], kid, sizeof(int)*n))
+            return k;
+        h = (h + 1) & (d->hsize - 1);
+    }
+
+    /* This is a new node. */
+    if (d->nnodes == d->maxnodes) {
+        d->maxnodes *= 2;
+        if (!(z = (int *) realloc(d->level, sizeof(int)*d->maxnodes)))
+            return -1;
+        d->level = z;
+        if (!(z = (int *) realloc(d->first, sizeof(int)*d->maxnodes)))
+            return -1;
+        d->first = z;
+        if (!(y = (long *) realloc(d->card, sizeof(long)*d->maxnodes)))
+            return -1;
+        d->card = y;
+    }
+    while (d->nedges + n > d->maxedges) {
+        d->maxedges *= 2;
+        if (!(z = (int *) realloc(d->edge, sizeof(int)*d->maxedges)))
+            return -1;
+        d->edge = z;
+        if (!(y = (long *) realloc(d->offset, sizeof(long)*d->maxedges)))
+            return -1;
+        d->offset = y;
+    }
+    k = d->nnodes++;
+    d->level[k] = level;
+    d->first[k] = d->nedges;
+    for (d->card[k] = 0, i = 0; i < n; i++) {
+        d->edge[d->nedges + i] = kid[i];
+        d->offset[d->nedges + i] = d->card[k];
+        d->card[k] += d->card[kid[i]];
+    }
+    d->nedges += n;
+    d->hash[h] = k;
+    if (2*d->nnodes > d->hsize)
+        if (__mdd_rehash(d, 2*d->hsize) < 0)
+            return -1;
+    return k;
+}
+
+/* Build the node of the sorted vectors v[lo..hi-1] from the given
+   level down; kid has room for the edges of every level below. */
+static int __mdd_make(mdd_t *d, __ctmc_lstate_t *v, int lo, int hi,
+                      int level, int *kid) {
+    int i, j, x, n;
+
+    if (level == d->nlevels)
+        return 1;
+    n = d->size[level];
+    memset(kid, 0, sizeof(int)*n);
+    for (i = lo; i < hi; i = j) {
+        x = v[i*d->nlevels + level];
+        for (j = i + 1; (j < hi) && (v[j*d->nlevels + level] == x); j++)
+            ;
+        if ((kid[x] = __mdd_make(d, v, i, j, level + 1, kid + n)) < 0)
+            return -1;
+    }
+    return __mdd_unique(d, level, kid);
+}
+
+/* Slot of the pair of nodes (a, b) in the memo. */
+#define __mdd_mslot(d,a,b) \
+    (((unsigned int) (a)*2654435761u ^ (unsigned int) (b)) & ((d)->msize - 1))
+
+/* Remember that r is the union of the nodes a and b. */
+static int __mdd_remember(mdd_t *d, int a, int b, int r) {
+    unsigned int h;
+    int i, *t, size;
+
+    if (2*(d->mused + 1) > d->msize) {
+        size = d->msize ? 2*d->msize : 1024;
+        if (!(t = (int *) malloc(sizeof(int)*3*size)))
+            return -1;
+        for (i = 0; i < size; i++)
+            t[3*i] = -1;
+        for (i = 0; i < d->msize; i++) {
+            if (d->memo[3*i] < 0)
+                continue;
+            h = ((unsigned int) d->memo[3*i]*2654435761u ^
+                 (unsigned int) d->memo[3*i + 1]) & (size - 1);
+            while (t[3*h] >= 0)
+                h = (h + 1) & (size - 1);
+            memcpy(t + 3*h, d->memo + 3*i, sizeof(int)*3);
+        }
+        free(d->memo);
+        d->memo = t;
+        d->msize = size;
+    }
+    h = __mdd_mslot(d, a, b);
+    while (d->memo[3*h] >= 0)
+        h = (h + 1) & (d->msize - 1);
+    d->memo[3*h] = a;
+    d->memo[3*h + 1] = b;
+    d->memo[3*h + 2] = r;
+    d->mused++;
+    return 0;
+}
+
+/* Union of the nodes a and b, which are of the same level unless one
+   of them is the terminal 0; kid has room for the edges of every
+   level below. Returns the node, or -1 on failure. */
+static int __mdd_or(mdd_t *d, int a, int b, int *kid) {
+    unsigned int h;
+    int i, n, r;
+
+    if (!a || (a == b))
+        return b;
+    if (!b)
+        return a;
+    if (a > b) {
+        r = a;
+        a = b;
+        b = r;
+    }
+    for (h = d->msize ? __mdd_mslot(d, a, b) : 0;
+         d->msize && (d->memo[3*h] >= 0); h = (h + 1) & (d->msize - 1))
+        if ((d->memo[3*h] == a) && (d->memo[3*h + 1] == b))
+            return d->memo[3*h + 2];
+
+    /* The edges are found again after every union below, which may
+       move them. */
+    n = d->size[d->level[a]];
+    for (i = 0; i < n; i++)
+        if ((kid[i] = __mdd_or(d, d->edge[d->first[a] + i],
+                               d->edge[d->first[b] + i], kid + n)) < 0)
+            return -1;
+    if (((r = __mdd_unique(d, d->level[a], kid)) < 0) ||
+        (__mdd_remember(d, a, b, r) < 0))
+        return -1;
+    return r;
+}
+
+/* Copy the node k of d, and the nodes below it, into e; map gives
+   the copy of every node of d which has one (-1 otherwise). */
+static int __mdd_copy(mdd_t *d, mdd_t *e, int k, int *map, int *kid) {
+    int i, n;
+
+    if (map[k] >= 0)
+        return map[k];
+    n = d->size[d->level[k]];
+    for (i = 0; i < n; i++)
+        if ((kid[i] = __mdd_copy(d, e, d->edge[d->first[k] + i], map,
+                                 kid + n)) < 0)
+            return -1;
+    return map[k] = __mdd_unique(e, d->level[k], kid);
+}
+
+/* Keep only the nodes below the root, by copying them into a new
+   diagram which then takes the place of the old one. */
+static int __mdd_collect(mdd_t *d) {
+    mdd_t *e, t;
+    int k, *map;
+
+    if (!(e = mdd_new(d->nlevels, d->size)))
+        return -1;
+    if (!(map = (int *) malloc(sizeof(int)*d->nnodes))) {
+        mdd_destroy(e);
+        return -1;
+    }
+    for (k = 0; k < d->nnodes; k++)
+        map[k] = (k < 2) ? k : -1;
+    e->root = __mdd_copy(d, e, d->root, map, e->kid);
+    free(map);
+    if (e->root < 0) {
+        mdd_destroy(e);
+        return -1;
+    }
+    t = *d;
+    *d = *e;
+    *e = t;
+    mdd_destroy(e);
+    d->live = d->nnodes;
+    return 0;
+}
+
+/* For a description of the following function, see "mdd.h". */
+mdd_t *mdd_new(int nlevels, const int *size) {
+    mdd_t *d;
+    int i, n = 0;
+
+    if (!(d = (mdd_t *) calloc(1, sizeof(mdd_t))))
+        return NULL;
+    d->nlevels = nlevels;
+    d->maxnodes = 1024;
+    d->maxedges = 4096;
+    for (i = 0; i < nlevels; i++)
+        n += size[i];
+    if (!(d->size = (int *) malloc(sizeof(int)*nlevels)) ||
+        !(d->level = (int *) malloc(sizeof(int)*d->maxnodes)) ||
+        !(d->first = (int *) malloc(sizeof(int)*d->maxnodes)) ||
+        !(d->card = (long *) malloc(sizeof(long)*d->maxnodes)) ||
+        !(d->edge = (int *) malloc(sizeof(int)*d->maxedges)) ||
+        !(d->offset = (long *) malloc(sizeof(long)*d->maxedges)) ||
+        !(d->kid = (int *) calloc(n, sizeof(int))) ||
+        (__mdd_rehash(d, 1024) < 0))
+        goto fail;
+    memcpy(d->size, size, sizeof(int)*nlevels);
+
+    /* The terminals, and the root of no state. */
+    for (i = 0; i < 2; i++) {
+        d->level[i] = d->nlevels;
+        d->first[i] = 0;
+        d->card[i] = i;
+    }
+    d->nnodes = 2;
+    if ((d->root = __mdd_unique(d, 0, d->kid)) < 0)
+        goto fail;
+    d->live = d->nnodes;
+    return d;
+
+ fail:
+    mdd_destroy(d);
+    return NULL;
+}
+
+int mdd_add(mdd_t *d, __ctmc_lstate_t *v, int n) {
+    int k, i;
+
+    if (!n)
+        return 0;
+    if (!d->hash || ((k = __mdd_make(d, v, 0, n, 0, d->kid)) < 0))
+        return -1;
+
+    /* The memo only holds for one union: the ranks change. */
+    for (i = 0; i < d->msize; i++)
+        d->memo[3*i] = -1;
+    d->mused = 0;
+    if ((k = __mdd_or(d, d->root, k, d->kid)) < 0)
+        return -1;
+    d->root = k;
+    return (d->nnodes >= 2*d->live) ? __mdd_collect(d) : 0;
+}
+
+void mdd_seal(mdd_t *d) {
+    int *z;
+    long *y;
+
+    if (!d->hash)
+        return;
+    if ((d->nnodes > d->live) && (__mdd_collect(d) < 0))
+        return; /* Kept as it is. */
+    free(d->hash);
+    free(d->memo);
+    d->hash = d->memo = NULL;
+    d->hsize = d->msize = d->mused = 0;
+
+    /* Give back the room for nodes and edges to come. */
+    if ((z = (int *) realloc(d->level, sizeof(int)*d->nnodes)))
+        d->level = z;
+    if ((z = (int *) realloc(d->first, sizeof(int)*d->nnodes)))
+        d->first = z;
+    if ((y = (long *) realloc(d->card, sizeof(long)*d->nnodes)))
+        d->card = y;
+    d->maxnodes = d->nnodes;
+    if ((z = (int *) realloc(d->edge, sizeof(int)*d->nedges)))
+        d->edge = z;
+    if ((y = (long *) realloc(d->offset, sizeof(long)*d->nedges)))
+        d->offset = y;
+    d->maxedges = d->nedges;
+}
+
+long mdd_index(mdd_t *d, __ctmc_lstate_t *v) {
+    long r = 0;
+    int i, e, k = d->root;
+
+    for (i = 0; i < d->nlevels; i++) {
+        if (v[i] >= d->size[i])
+            return -1;
+        e = d->first[k] + v[i];
+        if (!(k = d->edge[e]))
+            return -1;
+        r += d->offset[e];
+    }
+    return r;
+}
+
+int mdd_vector(mdd_t *d, long rank, __ctmc_lstate_t *v) {
+    int i, x, e, k = d->root;
+
+    if ((rank < 0) || (rank >= d->card[k]))
+        return -1;
+    for (i = 0; i < d->nlevels; i++) {
+        for (x = d->size[i] - 1, e = d->first[k] + x; x > 0; x--, e--)
+            if (d->edge[e] && (d->offset[e] <= rank))
+                break;
+        v[i] = x;
+        rank -= d->offset[e];
+        k = d->edge[e];
+    }
+    return 0;
+}
+
+size_t mdd_bytes(mdd_t *d) {
+    return sizeof(int)*d->nlevels +
+        (sizeof(int)*2 + sizeof(long))*d->maxnodes +
+        (sizeof(int) + sizeof(long))*d->maxedges +
+        sizeof(int)*(d->hsize + 3*d->msize);
+}
+
+void mdd_destroy(mdd_t *d) {
+    if (!d)
+        return;
+    free(d->size);
+    free(d->level);
+    free(d->first);
+    free(d->card);
+    free(d->edge);
+    free(d->offset);
+    free(d->hash);
+    free(d->memo);
+    free(d->kid);
+    free(d);
+}
+
+static double __mdd_elapsed(struct timespec *t0, struct timespec *t1) {
+    return (t1->tv_sec - t0->tv_sec) + (t1->tv_nsec - t0->tv_nsec)*1e-9;
+}
+
+/* Check that the diagram maps the states of m one to one onto their
+   ranks, and back. */
+static int __mdd_check(mdd_t *d, ctmc_t *m) {
+    __ctmc_lstate_t *v;
+    char *seen;
+    long r;
+    int s, ok = 1;
+
+    seen = (char *) calloc(m->nstates, 1);
+    v = (__ctmc_lstate_t *) malloc(sizeof(__ctmc_lstate_t)*m->nleaves);
+    if (!seen || !v || (d->card[d->root] != m->nstates))
+        ok = 0;
+    for (s = 0; ok && (s < m->nstates); s++) {
+        r = mdd_index(d, ctmc_state(m, s));
+        if ((r < 0) || (r >= m->nstates) || seen[r] ||
+            (mdd_vector(d, r, v) < 0) ||
+            memcmp(v, ctmc_state(m, s),
+                   sizeof(__ctmc_lstate_t)*m->nleaves))
+            ok = 0;
+        else
+            seen[r] = 1;
+    }
+    free(seen);
+    free(v);
+    return ok;
+}
+
+/* For a description of the following function, see "mdd.h". Only
+   the storage of the states is counted, as it was measured while
+   every chain was derived: the generator is the same for all of
+   them. */
+int htree_storage(void) {
+    struct timespec t0, t1, t2, t3;
+    ctmc_t *m, *c = NULL, *y = NULL;
+    double n, be, bc, by;
+    int ret = -1;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (!(m = ctmc_derive(__htree_rt.htree, __htree_rt.sstab,
+                          __htree_rt.nleaves, symmetry))) {
+        fprintf(report_file, "Could not derive the CTMC.\n");
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!(c = ctmc_derive_compact(__htree_rt.htree, __htree_rt.sstab,
+                                  __htree_rt.nleaves, symmetry))) {
+        fprintf(report_file,
+                "Could not derive the CTMC with hash compaction.\n");
+        goto done;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    if (!(y = ctmc_derive_mdd(__htree_rt.htree, __htree_rt.sstab,
+                              __htree_rt.nleaves, symmetry))) {
+        fprintf(report_file,
+                "Could not derive the CTMC with a decision diagram.\n");
+        goto done;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+
+    n = m->nstates;
+    be = m->bytes;
+    bc = c->bytes;
+    by = y->bytes;
+    fprintf(report_file, "Storage: %d states of %d tasks, %d transitions.\n",
+            m->nstates, m->nleaves, m->ntrans);
+    fprintf(report_file, "%-16s %10s %14s %12s %10s\n", "Storage", "States",
+            "Bytes", "Bytes/state", "Time (s)");
+    fprintf(report_file, "%-16s %10d %14.0f %12.2f %10.3f\n", "explicit",
+            m->nstates, be, be/n, __mdd_elapsed(&t0, &t1));
+    fprintf(report_file, "%-16s %10d %14.0f %12.2f %10.3f\n",
+            "hash compaction", c->nstates, bc, bc/n, __mdd_elapsed(&t1, &t2));
+    fprintf(report_file, "%-16s %10d %14.0f %12.2f %10.3f\n", "MDD",
+            y->nstates, by, by/n, __mdd_elapsed(&t2, &t3));
+    fprintf(report_file,
+            "Hash compaction: omission probability at most %.3g%s.\n",
+            ctmc_omission(c), (c->nstates == m->nstates) &&
+            (c->ntrans == m->ntrans) ? "" : " (states were omitted)");
+    fprintf(report_file, "MDD: %d nodes, %d edges (%lu bytes), %s.\n",
+            y->mdd->nnodes, y->mdd->nedges,
+            (unsigned long) mdd_bytes(y->mdd),
+            (__mdd_check(y->mdd, m) && (y->ntrans == m->ntrans)) ?
+            "one to one with the states" : "NOT one to one with the states");
+    ret = 0;
+
+ done:
+    ctmc_destroy(y);
+    ctmc_destroy(c);
+    ctmc_destroy(m);
+    return ret;
+}
@@ -0,0 +1,99 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to store the reachable states of a CTMC symbolically, as a
+  multi-valued decision diagram, and to compare the memory taken by
+  the ways of storing states. The functions are defined in "mdd.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_MDD_H
+#define __PEPA_MDD_H
+
+#include "ctmc.h"
+
+/* The diagram has a level for every leaf-node, in the order of the
+   skeleton hierarchy tree (the order of the leaf indices), so that
+   the tasks of a subtree are on consecutive levels. A node at level
+   i has an edge for every local state of task i, to a node at level
+   i + 1 or to one of the terminals: 0 (no state) and 1 (the states
+   which end there are reachable). Nodes are shared whenever they
+   have the same edges, which is where the diagram wins: the
+   branches of a farm or a deal behave alike, and the states of one
+   subtree mostly combine freely with those of the others.
+
+   Every edge also carries the number of reachable states below the
+   edges to its left (an edge-valued diagram), so that the sum along
+   the path of a state vector is its rank among the reachable states
+   in lexicographic order: the diagram replaces both the table of
+   state vectors and the hash table, mapping states to indices and
+   back. States are added a set at a time: the set is made into a
+   diagram of its own, level by level from the last level up, and
+   merged into the diagram by a union of the two (see mdd_add()). */
+typedef struct mdd_s {
+    int nlevels;           /* Number of levels (leaf-nodes). */
+    int *size;             /* Number of local states at every level. */
+    int nnodes;            /* Number of nodes (terminals included). */
+    int maxnodes;          /* Allocated number of nodes. */
+    int *level;            /* Level of every node. */
+    int *first;            /* First edge of every node. */
+    long *card;            /* Number of states below every node. */
+    int nedges;            /* Number of edges. */
+    int maxedges;          /* Allocated number of edges. */
+    int *edge;             /* Node the edge leads to. */
+    long *offset;          /* States below the edges to its left. */
+    int root;              /* Root node. */
+    int live;              /* Nodes after the last collection. */
+    int hsize;             /* Size of the unique table. */
+    int *hash;             /* Unique table of the nodes. */
+    int msize, mused;      /* Size and use of the memo of a union, */
+    int *memo;             /* as (node, node, union) triples. */
+    int *kid;              /* Edges of a node at every level. */
+} mdd_t;                   /* Edge-valued multi-valued diagram. */
+
+/* Make a diagram of no states, with nlevels levels and the given
+   number of local states at every level. Returns NULL on failure. */
+extern mdd_t *mdd_new(int nlevels, const int *size);
+
+/* Add the n state vectors v, which are sorted lexicographically and
+   distinct, to the states of the diagram (the ranks of the states
+   already there change). The nodes which are no longer used are
+   collected once they are as many as the others. Returns -1 on
+   failure. */
+extern int mdd_add(mdd_t *d, __ctmc_lstate_t *v, int n);
+
+/* Collect the nodes which are no longer used, and drop the unique
+   table and the memo: no state can be added any more. */
+extern void mdd_seal(mdd_t *d);
+
+/* Rank of the state vector v, or -1 if it is not reachable. */
+extern long mdd_index(mdd_t *d, __ctmc_lstate_t *v);
+
+/* State vector of the given rank. Returns -1 if there is none. */
+extern int mdd_vector(mdd_t *d, long rank, __ctmc_lstate_t *v);
+
+/* Number of bytes allocated for the diagram, with its unique table
+   and memo until it is sealed. */
+extern size_t mdd_bytes(mdd_t *d);
+
+/* Deallocate the diagram. */
+extern void mdd_destroy(mdd_t *d);
+
+/* Derive the CTMC of the committed skeleton hierarchy tree with
+   every way of storing its visited states (explicit vectors, hash
+   compaction and the diagram), and display the memory they took per
+   state at most. */
+extern int htree_storage(void);
+
+#endif /* __PEPA_MDD_H */
@@ -0,0 +1,550 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which choose the widths of the
+  deals and farms of a skeleton hierarchy tree under a budget on the
+  number of tasks (see "opt.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bounds.h"
+#include "comp.h"
+#include "opt.h"
+
+typedef struct {
+    opt_t *o;               /* Optimiser. */
+    opt_cand_t *c;          /* Candidates, by decreasing cap of gain. */
+    int n;                  /* Number of candidates. */
+    int next;               /* Next candidate to solve. */
+    double x;               /* Throughput of the current allocation, */
+    int cost;               /* and its number of tasks. */
+    int prune;              /* Prune candidates by their bounds? */
+    double gain;            /* Best gain per task confirmed so far. */
+    int error;              /* Set if a candidate could not be solved. */
+    pthread_mutex_t lock;   /* Protects next, gain, error and counts. */
+} __opt_work_t;
+
+/* Thread body: solves candidates until there are none left. */
+static void *__opt_worker(void *arg);
+
+/* Throughput and number of tasks of the allocation being improved,
+   against which the candidates are ranked, and the number of
+   variables. */
+static double __opt_base_x;
+static int __opt_base_cost, __opt_nvars;
+
+
+/* Find the decision variable of the node n, or -1. */
+static int __opt_var(opt_t *o, __htree_node_t *n) {
+    int v;
+
+    for (v = 0; v < o->nvars; v++)
+        if (o->var[v] == n)
+            return v;
+    return -1;
+}
+
+/* Collect the decision variables of the subtree n in pre-order. Only
+   the first branch of a variable is visited, since the others are
+   rebuilt from it. */
+static void __opt_collect(opt_t *o, __htree_node_t *n) {
+    __htree_child_t *c, *d;
+    int i, same = 1;
+
+    if (n->mtype == TASK)
+        return;
+    c = n->clist;
+    if (((n->mtype == DEAL) || (n->mtype == FARM)) && c) {
+        for (i = 1, d = c->next; i < n->nchr; i++, d = d->next)
+            if (!__htree_same_subtree(c->child, d->child))
+                same = 0;
+        if (same) {
+            o->var[o->nvars++] = n;
+            __opt_collect(o, c->child);
+            return;
+        }
+    }
+    for (i = 0; c && i < n->nchr; i++) {
+        __opt_collect(o, c->child);
+        c = c->next;
+    }
+}
+
+/* Insert the subtree n into the tree being built, with the widths of
+   the decision variables in width. */
+static void __opt_replay(opt_t *o, __htree_node_t *n, int *width) {
+    __htree_child_t *c = n->clist;
+    int i, v;
+
+    if (n->mtype == TASK) {
+        __htree_insert_node(TASK, 0, n->name, n->rate, n->rname);
+        return;
+    }
+    if ((v = __opt_var(o, n)) >= 0) {
+        __htree_insert_node(n->mtype, width[v]);
+        for (i = 0; i < width[v]; i++)
+            __opt_replay(o, c->child, width);
+        return;
+    }
+    __htree_insert_node(n->mtype, n->nchr);
+    for (i = 0; c && i < n->nchr; i++) {
+        __opt_replay(o, c->child, width);
+        c = c->next;
+    }
+}
+
+/* Build and commit the tree of the candidate c. The tree is built in
+   the runtime system, which is restored afterwards. */
+static int __opt_build(opt_t *o, opt_cand_t *c) {
+    struct __htree_rt_s rt = __htree_rt;
+    int err;
+
+    memset(&__htree_rt, 0, sizeof(struct __htree_rt_s));
+    __htree_rt.names = rt.names; /* The names are interned already. */
+    __opt_replay(o, o->root, c->width);
+    err = (__htree_generate_sstab(__htree_rt.htree, SOURCE_MEM,
+                                  SINK_MEM) < 0);
+    c->tree = __htree_rt.htree;
+    c->sstab = __htree_rt.sstab;
+    c->nleaves = __htree_rt.nleaves;
+    c->nnodes = __htree_rt.nnodes;
+    c->x = -1.0;
+    rt.names = __htree_rt.names;
+    __htree_rt = rt;
+
+    /* An uncommitted tree cannot be destroyed (its source and sink
+       lists are not set), so it is left behind. */
+    if (err) {
+        c->tree = NULL;
+        c->sstab = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static void __opt_free(opt_cand_t *c) {
+    if (c->tree)
+        __htree_destroy(c->tree);
+    free(c->sstab);
+    free(c->width);
+    memset(c, 0, sizeof(opt_cand_t));
+}
+
+static int __opt_bound(opt_cand_t *c) {
+    bounds_t *b;
+
+    if (!(b = (bounds_t *) malloc(sizeof(bounds_t)*c->nnodes)))
+        return -1;
+    if (bounds_compute(c->tree, 0, b) < 0) {
+        free(b);
+        return -1;
+    }
+    c->bound = b[0].bound;
+    free(b);
+    return 0;
+}
+
+/* Throughput of the candidate c, or a negative value on failure. */
+static double __opt_solve(opt_t *o, opt_cand_t *c) {
+    __ctmc_leaf_t *leaf;
+    comp_t *p;
+    ctmc_t *m;
+    double x = -1.0;
+    int i;
+
+    if (o->compose) {
+        if (!(leaf = (__ctmc_leaf_t *)
+              calloc(c->nleaves, sizeof(__ctmc_leaf_t))))
+            return -1.0;
+        for (i = 0; i < c->nleaves; i++)
+            if (ctmc_leaf_def(c->sstab[i], &leaf[i]) < 0)
+                break;
+        if ((i == c->nleaves) &&
+            (p = comp_create(leaf, c->nleaves, c->nnodes))) {
+            x = comp_solve(p, c->tree);
+            c->nstates = p->maxstates;
+            comp_destroy(p);
+        }
+        for (i = 0; i < c->nleaves; i++)
+            ctmc_leaf_free(&leaf[i]);
+        free(leaf);
+        return x;
+    }
+    if (!(m = ctmc_derive(c->tree, c->sstab, c->nleaves, 1)))
+        return -1.0;
+    if (ctmc_solve(m, CTMC_TOLERANCE, CTMC_MAXITER) >= 0)
+        for (x = 0.0, i = 0; i < c->nleaves; i++)
+            if (c->sstab[i]->stype == UNKNOWN)
+                x += ctmc_throughput(m, i);
+    c->nstates = m->nstates;
+    ctmc_destroy(m);
+    return x;
+}
+
+/* The most the candidate c can gain per added task. */
+static double __opt_cap(const opt_cand_t *c, double x, int cost) {
+    return (c->bound - x)/(c->nleaves - cost);
+}
+
+/* Larger caps first, then the earlier variables. */
+static int __opt_cmp(const void *a, const void *b) {
+    const opt_cand_t *c = (const opt_cand_t *) a;
+    const opt_cand_t *d = (const opt_cand_t *) b;
+    double x = __opt_cap(c, __opt_base_x, __opt_base_cost);
+    double y = __opt_cap(d, __opt_base_x, __opt_base_cost);
+    int v = 0;
+
+    if (x != y)
+        return (x < y) - (x > y);
+    while ((v < __opt_nvars - 1) && (c->width[v] == d->width[v]))
+        v++;
+    return d->width[v] - c->width[v];
+}
+
+void *__opt_worker(void *arg) {
+    __opt_work_t *w = (__opt_work_t *) arg;
+    opt_cand_t *c = NULL;
+    double x, g;
+
+    while (1) {
+        pthread_mutex_lock(&w->lock);
+        for (c = NULL; !w->error && (w->next < w->n); ) {
+            c = &w->c[w->next++];
+            if (!w->prune || (__opt_cap(c, w->x, w->cost) > w->gain))
+                break;
+            w->o->npruned++;
+            c = NULL;
+        }
+        pthread_mutex_unlock(&w->lock);
+        if (!c)
+            break;
+        x = __opt_solve(w->o, c);
+        pthread_mutex_lock(&w->lock);
+        if ((c->x = x) < 0.0)
+            w->error = 1;
+        else {
+            w->o->nsolved++;
+            g = (x - w->x)/(c->nleaves - w->cost);
+            if (w->prune && (g > w->gain))
+                w->gain = g;
+        }
+        pthread_mutex_unlock(&w->lock);
+    }
+    return NULL;
+}
+
+/* Solve the n candidates in c, using nthreads threads. If prune is
+   set, candidates whose cap does not beat the best gain over the
+   allocation of throughput x and cost tasks are skipped. */
+static int __opt_batch(opt_t *o, opt_cand_t *c, int n, double x, int cost,
+                       int prune, int nthreads) {
+    __opt_work_t w;
+    pthread_t *tid;
+    int i, k = 0;
+
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads > n)
+        nthreads = n;
+    if (nthreads < 1)
+        nthreads = 1;
+    memset(&w, 0, sizeof(__opt_work_t));
+    w.o = o;
+    w.c = c;
+    w.n = n;
+    w.x = x;
+    w.cost = cost;
+    w.prune = prune;
+    w.gain = OPT_TOLERANCE*x;
+    pthread_mutex_init(&w.lock, NULL);
+    if (!(tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads))) {
+        pthread_mutex_destroy(&w.lock);
+        return -1;
+    }
+    for (i = 1; i < nthreads; i++) {
+        if (pthread_create(&tid[i], NULL, __opt_worker, &w))
+            break;
+        k++;
+    }
+    __opt_worker(&w);
+    for (i = 1; i <= k; i++)
+        pthread_join(tid[i], NULL);
+    pthread_mutex_destroy(&w.lock);
+    free(tid);
+    return w.error ? -1 : 0;
+}
+
+/* For a description of the following function, see "opt.h". */
+opt_t *opt_create(__htree_node_t *root, int nnodes, int budget,
+                  int compose) {
+    opt_t *o;
+
+    if (!(o = (opt_t *) calloc(1, sizeof(opt_t))))
+        return NULL;
+    o->root = root;
+    o->budget = budget;
+    o->compose = compose;
+    if (!(o->var = (__htree_node_t **)
+          malloc(sizeof(__htree_node_t *)*nnodes))) {
+        free(o);
+        return NULL;
+    }
+    __opt_collect(o, root);
+    if (!o->nvars) {
+        fprintf(report_file, "No deal or farm has identical branches.\n");
+        opt_destroy(o);
+        return NULL;
+    }
+    return o;
+}
+
+int opt_run(opt_t *o, int nthreads, int verbose) {
+    static const char *skel[] = { "?", "pipe", "deal", "farm", "task" };
+    opt_cand_t init[2], *c;
+    double x, g, gain;
+    int v, n, k, best, first, count;
+
+    memset(init, 0, sizeof(init));
+    if (!(c = (opt_cand_t *) calloc(o->nvars, sizeof(opt_cand_t))) ||
+        !(init[0].width = (int *) malloc(sizeof(int)*o->nvars)) ||
+        !(init[1].width = (int *) malloc(sizeof(int)*o->nvars)))
+        goto fail;
+    for (v = 0; v < o->nvars; v++) {
+        init[0].width[v] = 1;
+        init[1].width[v] = o->var[v]->nchr;
+    }
+    if ((__opt_build(o, &init[0]) < 0) || (__opt_build(o, &init[1]) < 0))
+        goto fail;
+    if (init[0].nleaves > o->budget) {
+        fprintf(report_file,
+                "The budget is less than the %d tasks of the narrowest "
+                "tree.\n", init[0].nleaves);
+        goto fail;
+    }
+    if (__opt_batch(o, init, 2, 0.0, 0, 0, nthreads) < 0)
+        goto fail;
+    o->given = init[1].x;
+    o->ngiven = init[1].nleaves;
+    __opt_free(&init[1]);
+    o->best = init[0];
+    memset(&init[0], 0, sizeof(opt_cand_t));
+    if (verbose)
+        fprintf(report_file, "%-6s %-24s %6s %6s %12s %8s %8s\n", "Round",
+                "Variable", "Width", "Tasks", "Throughput", "Solved",
+                "Pruned");
+
+    while (1) {
+        /* One more branch for every variable, within the budget. */
+        for (n = 0, v = 0; v < o->nvars; v++) {
+            if (!(c[n].width = (int *) malloc(sizeof(int)*o->nvars)))
+                goto fail;
+            memcpy(c[n].width, o->best.width, sizeof(int)*o->nvars);
+            c[n].width[v]++;
+            if ((__opt_build(o, &c[n]) < 0) || (__opt_bound(&c[n]) < 0))
+                goto fail;
+            if (c[n].nleaves > o->budget)
+                __opt_free(&c[n]);
+            else
+                n++;
+        }
+        if (n == 0)
+            break;
+        x = o->best.x;
+        __opt_base_x = x;
+        __opt_base_cost = o->best.nleaves;
+        __opt_nvars = o->nvars;
+        qsort(c, n, sizeof(opt_cand_t), __opt_cmp);
+        if (__opt_batch(o, c, n, x, o->best.nleaves, 1, nthreads) < 0)
+            goto fail;
+        for (best = -1, gain = OPT_TOLERANCE*x, k = 0; k < n; k++) {
+            if (c[k].x < 0.0)
+                continue;
+            g = (c[k].x - x)/(c[k].nleaves - o->best.nleaves);
+            if (g > gain) {
+                gain = g;
+                best = k;
+            }
+        }
+        if (best < 0)
+            break;
+        o->nrounds++;
+        for (v = 0; o->best.width[v] == c[best].width[v]; v++)
+            ;
+        if (verbose) {
+            char label[64];
+
+            __htree_leaf_range(o->var[v], &first, &count);
+            sprintf(label, "%s(t_%d..t_%d)", skel[o->var[v]->mtype],
+                    first, first + count - 1);
+            fprintf(report_file, "%-6d %-24s %6d %6d %12f %8d %8d\n",
+                    o->nrounds, label, c[best].width[v], c[best].nleaves,
+                    c[best].x, o->nsolved, o->npruned);
+        }
+        __opt_free(&o->best);
+        o->best = c[best];
+        memset(&c[best], 0, sizeof(opt_cand_t));
+        for (k = 0; k < n; k++)
+            __opt_free(&c[k]);
+    }
+    free(c);
+    return o->nrounds;
+
+ fail:
+    for (k = 0; c && (k < o->nvars); k++)
+        __opt_free(&c[k]);
+    free(c);
+    __opt_free(&init[0]);
+    __opt_free(&init[1]);
+    return -1;
+}
+
+/* Write a rate with enough digits, as the lexer reads it (with a
+   decimal point, and without an exponent), or the expression over
+   named rates which gave it. */
+static void __opt_write_rate(FILE *f, double r, const char *rname) {
+    char s[64];
+    int n;
+
+    if (rname) {
+        fprintf(f, "%s", rname);
+        return;
+    }
+    n = sprintf(s, "%.12f", r);
+    while ((n > 2) && (s[n - 1] == '0') && (s[n - 2] != '.'))
+        s[--n] = '\0';
+    fprintf(f, "%s", s);
+}
+
+static void __opt_write(FILE *f, __htree_node_t *n, int depth) {
+    static const char *skel[] = { "?", "pipe", "deal", "farm", "task" };
+    __htree_child_t *c = n->clist;
+    int i, same = 1;
+
+    for (i = 0; i < depth; i++)
+        fprintf(f, "\t");
+    if (n->mtype == TASK) {
+        fprintf(f, "task(\"%s\", ", n->name);
+        __opt_write_rate(f, n->rate, n->rname);
+        fprintf(f, ");\n");
+        return;
+    }
+    if ((n->mtype == DEAL) || (n->mtype == FARM)) {
+        for (i = 0; c && i < n->nchr; i++, c = c->next)
+            if ((c->child->mtype != TASK) ||
+                (c->child->rate != n->clist->child->rate) ||
+                (c->child->rname != n->clist->child->rname) ||
+                strcmp(c->child->name, n->clist->child->name))
+                same = 0;
+        if (same && n->clist) {
+            fprintf(f, "%s(%d, \"%s\", ", skel[n->mtype], n->nchr,
+                    n->clist->child->name);
+            __opt_write_rate(f, n->clist->child->rate,
+                             n->clist->child->rname);
+            fprintf(f, ");\n");
+            return;
+        }
+        fprintf(f, "x");
+    }
+    fprintf(f, "%s(%d);\n", skel[n->mtype], n->nchr);
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        __opt_write(f, c->child, depth + 1);
+        c = c->next;
+    }
+}
+
+int opt_write(opt_t *o, FILE *f) {
+    __htree_rate_t *r;
+    int i;
+
+    if (!o->best.tree)
+        return -1;
+    fprintf(f, "/* Widths chosen for a budget of %d tasks: %d tasks, "
+            "throughput %f. */\n", o->budget, o->best.nleaves, o->best.x);
+    for (i = 0; i < __htree_rt.nrates; i++) {
+        r = &__htree_rt.rates[i];
+        fprintf(f, "rate %s = ", r->name);
+        __opt_write_rate(f, r->val, r->expr);
+        fprintf(f, ";\n");
+    }
+    __opt_write(f, o->best.tree, 0);
+    return 0;
+}
+
+void opt_destroy(opt_t *o) {
+    if (!o)
+        return;
+    __opt_free(&o->best);
+    free(o->var);
+    free(o);
+}
+
+/* For a description of the following function, see "opt.h". */
+int htree_optimise(int budget) {
+    static const char *skel[] = { "?", "pipe", "deal", "farm", "task" };
+    struct timespec t0, t1;
+    char temp[256];
+    opt_t *o;
+    FILE *f;
+    int v, first, count;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(o = opt_create(__htree_rt.htree, __htree_rt.nnodes, budget,
+                         compose)))
+        return -1;
+    fprintf(report_file, "Optimisation: %d variable%s, budget of %d tasks, %s "
+            "solves.\n", o->nvars, (o->nvars > 1) ? "s" : "", budget,
+            compose ? "compositional" : "exact");
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (opt_run(o, nthreads, 1) < 0) {
+        fprintf(report_file, "Optimisation failed.\n");
+        opt_destroy(o);
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    fprintf(report_file, "Given widths: %d tasks, throughput %f%s.\n",
+            o->ngiven, o->given, (o->ngiven > budget) ? " (over budget)" : "");
+    fprintf(report_file,
+            "Best widths: %d tasks, throughput %f (%d rounds, %d solved, %d "
+            "pruned, %.3fs).\n", o->best.nleaves, o->best.x, o->nrounds,
+            o->nsolved, o->npruned,
+            (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9);
+    for (v = 0; v < o->nvars; v++) {
+        __htree_leaf_range(o->var[v], &first, &count);
+        fprintf(report_file, "  %s(t_%d..t_%d): %d -> %d\n",
+                skel[o->var[v]->mtype], first, first + count - 1,
+                o->var[v]->nchr, o->best.width[v]);
+    }
+
+    strcpy(temp, fname);
+    strcat(temp, "opt.des");
+    if (!(f = fopen(temp, "w")))
+        perror("Could not create output file");
+    else {
+        opt_write(o, f);
+        fclose(f);
+        fprintf(report_file, "Best tree written to %s.\n", temp);
+    }
+    opt_destroy(o);
+    return 0;
+}
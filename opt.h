@@ -0,0 +1,95 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to choose the widths of the deals and farms of a skeleton
+  hierarchy tree which maximise its throughput, under a budget on
+  the number of tasks. The functions are defined in "opt.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_OPT_H
+#define __PEPA_OPT_H
+
+#include <stdio.h>
+#include "ctmc.h"
+
+#define OPT_TOLERANCE 1e-6 /* Smallest relative gain worth a round. */
+
+/* The decision variables are the widths of the deals and farms whose
+   branches are identical (a deal or farm of tasks, or an xdeal or
+   xfarm of copies of one subtree); a candidate tree is rebuilt with
+   every such node replicating its first branch. The deals and farms
+   inside that branch are variables too, and their width applies to
+   every copy. Every task is a worker: the cost of a tree is its
+   number of leaf-nodes, which must not exceed the budget.
+
+   The search is greedy marginal analysis: starting with every width
+   at one, every round tries one more branch for every variable, and
+   keeps the candidate of the largest gain of throughput per added
+   task. The analytic bound of a candidate (see "bounds.h") caps its
+   gain: candidates are tried in decreasing order of that cap, and
+   those whose cap does not beat the best gain confirmed so far in
+   the round are pruned without being solved. The others are solved
+   in parallel, exactly on the chain reduced by symmetry, or
+   compositionally (see "comp.h"), along with the widths of the tree
+   as it is given for comparison. The search stops when the budget
+   is spent or no candidate gains. */
+typedef struct {
+    __htree_node_t *tree;  /* Candidate skeleton hierarchy tree, */
+    __htree_node_t **sstab; /* its source-sink lookup table, */
+    int nleaves;           /* its number of tasks, */
+    int nnodes;            /* and of nodes. */
+    int *width;            /* Width of every decision variable. */
+    double bound;          /* Upper bound of the throughput. */
+    double x;              /* Throughput, or -1 if not solved. */
+    int nstates;           /* Number of states solved. */
+} opt_cand_t;              /* Candidate allocation. */
+
+typedef struct {
+    __htree_node_t *root;  /* Tree being optimised (not taken over). */
+    int nvars;             /* Number of decision variables. */
+    __htree_node_t **var;  /* Their deals and farms, in pre-order. */
+    int budget;            /* Maximum number of tasks. */
+    int compose;           /* Solve the candidates compositionally? */
+    opt_cand_t best;       /* Best allocation found. */
+    double given;          /* Throughput of the widths of root, */
+    int ngiven;            /* and its number of tasks. */
+    int nrounds;           /* Number of rounds. */
+    int nsolved;           /* Number of candidates solved. */
+    int npruned;           /* Number of candidates pruned by bounds. */
+} opt_t;                   /* Capacity optimiser. */
+
+/* Prepare the optimisation of the committed tree root, of nnodes
+   nodes, under a budget of tasks. Returns NULL on failure (with a
+   message if the tree has no decision variables). */
+extern opt_t *opt_create(__htree_node_t *root, int nnodes, int budget,
+                         int compose);
+
+/* Search for the best allocation, using nthreads threads (all
+   processors if nthreads < 1). Every round is displayed if verbose
+   is set. Returns the number of rounds, or -1 on failure. */
+extern int opt_run(opt_t *o, int nthreads, int verbose);
+
+/* Write the best allocation as a description file. */
+extern int opt_write(opt_t *o, FILE *f);
+
+/* Deallocate the optimiser (but not the tree). */
+extern void opt_destroy(opt_t *o);
+
+/* Optimise the widths of the committed skeleton hierarchy tree under
+   a budget of tasks, and write the best tree into a description
+   file. */
+extern int htree_optimise(int budget);
+
+#endif /* __PEPA_OPT_H */
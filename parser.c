@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,154 +45,256 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.2"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
-
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     TINTG = 258,
-     TDOUB = 259,
-     TSTRG = 260,
-     TPIPE = 261,
-     TDEAL = 262,
-     TXDEAL = 263,
-     TFARM = 264,
-     TXFARM = 265,
-     TTASK = 266,
-     TSEMI = 267,
-     TLPAR = 268,
-     TRPAR = 269,
-     TCOMMA = 270,
-     TPLUS = 271,
-     TMINUS = 272,
-     TDIVIDE = 273,
-     TTIMES = 274,
-     TNEG = 275,
-     TEXPO = 276
-   };
-#endif
-/* Tokens.  */
-#define TINTG 258
-#define TDOUB 259
-#define TSTRG 260
-#define TPIPE 261
-#define TDEAL 262
-#define TXDEAL 263
-#define TFARM 264
-#define TXFARM 265
-#define TTASK 266
-#define TSEMI 267
-#define TLPAR 268
-#define TRPAR 269
-#define TCOMMA 270
-#define TPLUS 271
-#define TMINUS 272
-#define TDIVIDE 273
-#define TTIMES 274
-#define TNEG 275
-#define TEXPO 276
-
-
-
-
-/* Copy the first part of user declarations.  */
-#line 21 "parser.y"
+#define YYPURE 2
 
-	#include <getopt.h>
-	#include <stdio.h>
-    #include "pepa.h"
-	void yyerror(char const *s);
+/* Push parsers.  */
+#define YYPUSH 0
 
+/* Pull parsers.  */
+#define YYPULL 1
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 28 "parser.y"
-{
-	int ival;
-	double dval;
-	char *sptr;
-}
-/* Line 193 of yacc.c.  */
-#line 151 "parser.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
+/* First part of user prologue.  */
+#line 21 "parser.y"
 
+    #include <getopt.h>
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <sys/stat.h>
+    #include "pepa.h"
+    #include "ctmc.h"
+    #include "chunk.h"
+    #include "bin.h"
+    #include "include.h"
+    #include "batch.h"
+    #include "server.h"
+    #include "cache.h"
+
+#line 87 "parser.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TINTG = 3,                      /* TINTG  */
+  YYSYMBOL_TDOUB = 4,                      /* TDOUB  */
+  YYSYMBOL_TSTRG = 5,                      /* TSTRG  */
+  YYSYMBOL_TPIPE = 6,                      /* TPIPE  */
+  YYSYMBOL_TDEAL = 7,                      /* TDEAL  */
+  YYSYMBOL_TXDEAL = 8,                     /* TXDEAL  */
+  YYSYMBOL_TFARM = 9,                      /* TFARM  */
+  YYSYMBOL_TXFARM = 10,                    /* TXFARM  */
+  YYSYMBOL_TTASK = 11,                     /* TTASK  */
+  YYSYMBOL_TINCL = 12,                     /* TINCL  */
+  YYSYMBOL_TDEFN = 13,                     /* TDEFN  */
+  YYSYMBOL_TREPT = 14,                     /* TREPT  */
+  YYSYMBOL_TRATE = 15,                     /* TRATE  */
+  YYSYMBOL_TNAME = 16,                     /* TNAME  */
+  YYSYMBOL_TSEMI = 17,                     /* TSEMI  */
+  YYSYMBOL_TLPAR = 18,                     /* TLPAR  */
+  YYSYMBOL_TRPAR = 19,                     /* TRPAR  */
+  YYSYMBOL_TCOMMA = 20,                    /* TCOMMA  */
+  YYSYMBOL_TLBRC = 21,                     /* TLBRC  */
+  YYSYMBOL_TRBRC = 22,                     /* TRBRC  */
+  YYSYMBOL_TEQUL = 23,                     /* TEQUL  */
+  YYSYMBOL_TMINUS = 24,                    /* TMINUS  */
+  YYSYMBOL_TPLUS = 25,                     /* TPLUS  */
+  YYSYMBOL_TTIMES = 26,                    /* TTIMES  */
+  YYSYMBOL_TDIVIDE = 27,                   /* TDIVIDE  */
+  YYSYMBOL_TNEG = 28,                      /* TNEG  */
+  YYSYMBOL_TEXPO = 29,                     /* TEXPO  */
+  YYSYMBOL_YYACCEPT = 30,                  /* $accept  */
+  YYSYMBOL_input = 31,                     /* input  */
+  YYSYMBOL_line = 32,                      /* line  */
+  YYSYMBOL_block = 33,                     /* block  */
+  YYSYMBOL_34_1 = 34,                      /* $@1  */
+  YYSYMBOL_35_2 = 35,                      /* $@2  */
+  YYSYMBOL_params = 36,                    /* params  */
+  YYSYMBOL_args = 37,                      /* args  */
+  YYSYMBOL_stmt = 38,                      /* stmt  */
+  YYSYMBOL_exp = 39                        /* exp  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-/* Copy the second part of user declarations.  */
+/* Second part of user prologue.  */
+#line 81 "parser.y"
 
+    #define PARSE yyget_extra(scanner)
+    #define STMT(S,N,X,R) __parse_stmt(PARSE, S, N, X, R)
+    #define INCL(X) __parse_include(PARSE, X)
+    #define DEFINE(X) __parse_define(PARSE, X)
+    #define PARAM(X) __parse_param(PARSE, X)
+    #define DEFINED() __parse_defined(PARSE)
+    #define REPEAT(N) __parse_repeat(PARSE, N)
+    #define REPEATED() __parse_repeated(PARSE)
+    #define ARG(X) __parse_arg(PARSE, X)
+    #define INSTANCE(X) __parse_instance(PARSE, X)
+    #define RATE(X,E) __parse_rate(PARSE, X, E)
+    #define CONST(X) __parse_const(X)
+    #define NAME(X) __parse_name(PARSE, X)
+    #define OP(O,A,B) __parse_op(PARSE, O, A, B)
+
+    /* A rate which refers to the parameters of a definition is kept
+       as an expression, and evaluated for every instance. A rate which
+       refers to named rates keeps its value over them as a string,
+       which the tasks are written with (see "pepa.h"). */
+    typedef struct __parse_expr_s {
+        int op;                       /* Operator, 'c' for a constant,
+                                         'p' for a parameter. */
+        double val;                   /* Value of a constant. */
+        const char *sym;              /* Its value over named rates. */
+        int param;                    /* Index of a parameter. */
+        struct __parse_expr_s *l, *r; /* Operands. */
+    } __parse_expr_t;
+    typedef struct __parse_exp_s __parse_exp_t;
+
+    extern htree_parse_t *yyget_extra(void *scanner);
+    extern int yylex(YYSTYPE *lval, void *scanner);
+    void yyerror(void *scanner, char const *s);
+    static void __parse_stmt(htree_parse_t *p, __htree_comp_t skel, int n,
+                             const char *name, __parse_exp_t rate);
+    static void __parse_include(htree_parse_t *p, const char *name);
+    static void __parse_define(htree_parse_t *p, const char *name);
+    static void __parse_param(htree_parse_t *p, const char *name);
+    static void __parse_defined(htree_parse_t *p);
+    static void __parse_repeat(htree_parse_t *p, int n);
+    static void __parse_repeated(htree_parse_t *p);
+    static void __parse_arg(htree_parse_t *p, __parse_exp_t x);
+    static void __parse_instance(htree_parse_t *p, const char *name);
+    static void __parse_rate(htree_parse_t *p, const char *name,
+                             __parse_exp_t x);
+    static __parse_exp_t __parse_const(double val);
+    static __parse_exp_t __parse_name(htree_parse_t *p, const char *name);
+    static __parse_exp_t __parse_op(htree_parse_t *p, int op,
+                                    __parse_exp_t a, __parse_exp_t b);
+
+#line 211 "parser.c"
 
-/* Line 216 of yacc.c.  */
-#line 164 "parser.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -198,55 +302,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -263,11 +418,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -275,8 +430,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -290,111 +445,117 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  2
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   75
+#define YYLAST   130
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  22
+#define YYNTOKENS  30
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  5
+#define YYNNTS  10
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  20
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  58
+#define YYNRULES  35
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  93
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   284
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   276
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -423,250 +584,212 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
-      15,    16,    17,    18,    19,    20,    21
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
-{
-       0,     0,     3,     4,     7,     9,    12,    17,    26,    31,
-      40,    45,    52,    54,    56,    60,    64,    68,    72,    75,
-      79
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      23,     0,    -1,    -1,    23,    24,    -1,    12,    -1,    25,
-      12,    -1,     6,    13,     3,    14,    -1,     7,    13,     3,
-      15,     5,    15,    26,    14,    -1,     8,    13,     3,    14,
-      -1,     9,    13,     3,    15,     5,    15,    26,    14,    -1,
-      10,    13,     3,    14,    -1,    11,    13,     5,    15,    26,
-      14,    -1,     4,    -1,     3,    -1,    26,    16,    26,    -1,
-      26,    17,    26,    -1,    26,    19,    26,    -1,    26,    18,
-      26,    -1,    17,    26,    -1,    26,    21,    26,    -1,    13,
-      26,    14,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint8 yyrline[] =
 {
-       0,    57,    57,    58,    61,    62,    65,    66,    67,    68,
-      69,    70,    73,    74,    75,    76,    77,    78,    79,    80,
-      81
+       0,   138,   138,   139,   142,   143,   144,   147,   147,   148,
+     148,   151,   152,   153,   156,   157,   158,   161,   162,   163,
+     164,   165,   166,   167,   168,   169,   172,   173,   174,   175,
+     176,   177,   178,   179,   180,   181
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "TINTG", "TDOUB", "TSTRG", "TPIPE",
-  "TDEAL", "TXDEAL", "TFARM", "TXFARM", "TTASK", "TSEMI", "TLPAR", "TRPAR",
-  "TCOMMA", "TPLUS", "TMINUS", "TDIVIDE", "TTIMES", "TNEG", "TEXPO",
-  "$accept", "input", "line", "stmt", "exp", 0
+  "\"end of file\"", "error", "\"invalid token\"", "TINTG", "TDOUB",
+  "TSTRG", "TPIPE", "TDEAL", "TXDEAL", "TFARM", "TXFARM", "TTASK", "TINCL",
+  "TDEFN", "TREPT", "TRATE", "TNAME", "TSEMI", "TLPAR", "TRPAR", "TCOMMA",
+  "TLBRC", "TRBRC", "TEQUL", "TMINUS", "TPLUS", "TTIMES", "TDIVIDE",
+  "TNEG", "TEXPO", "$accept", "input", "line", "block", "$@1", "$@2",
+  "params", "args", "stmt", "exp", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-55)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int8 yypact[] =
 {
-       0,    22,    23,    23,    24,    24,    25,    25,    25,    25,
-      25,    25,    26,    26,    26,    26,    26,    26,    26,    26,
-      26
+     -55,    36,   -55,    -8,    -6,     0,     8,    12,    16,    32,
+      22,    23,    50,    49,   -55,   -55,   -55,    51,    66,    81,
+      83,    91,    92,    80,   -55,   -55,    93,    87,    11,   -55,
+      84,    85,    97,    98,   100,   101,    86,   103,    11,   -55,
+     -55,   -55,    11,    11,   -17,    88,   -55,   115,   -55,   118,
+     -55,    11,   108,   104,    88,   -18,    99,   -55,    11,    11,
+      11,    11,    11,    11,   106,   107,    64,   -55,    13,   -55,
+     -55,    88,   -10,   -10,    99,    99,    99,    11,    11,   -55,
+     109,   113,   -55,    73,    82,   -55,   -55,    48,   -55,   -55,
+      65,   -55,   -55
 };
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
-       0,     2,     0,     2,     1,     2,     4,     8,     4,     8,
-       4,     6,     1,     1,     3,     3,     3,     3,     2,     3,
-       3
+       2,     0,     1,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     4,     3,     6,     0,     0,     0,
+       0,     0,     0,     0,    23,     7,     0,     0,    14,     5,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    27,
+      26,    28,     0,     0,     0,    15,    17,     0,    19,     0,
+      21,     0,    11,     0,    25,     0,    33,    24,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    12,     0,     9,
+      35,    16,    30,    29,    31,    32,    34,     0,     0,    22,
+       0,     0,     2,     0,     0,     2,    13,     0,    18,    20,
+       0,    10,     8
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int8 yypgoto[] =
 {
-       2,     0,     1,     0,     0,     0,     0,     0,     0,     4,
-       3,     0,     0,     0,     0,     0,     0,     0,     5,     0,
-       0,     0,     0,     0,     0,     6,     0,     8,     0,    10,
-       0,     0,     0,    13,    12,     0,     0,     0,     0,     0,
-       0,    18,    11,     0,     0,     0,     0,     0,     0,     0,
-      20,    14,    15,    17,    16,    19,     7,     9
+     -55,   -54,   -55,   -55,   -55,   -55,   -55,   -55,   -55,   -38
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     1,    10,    11,    37
+       0,     1,    15,    16,    36,    82,    68,    44,    17,    45
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -28
-static const yytype_int8 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int8 yytable[] =
 {
-     -28,    15,   -28,    -9,    -7,    -6,     0,    16,    39,   -28,
-     -28,    42,    52,    53,    54,    55,    56,    57,   -28,    46,
-      48,    47,    49,    51,    58,   -28,    61,   -28,    62,   -28,
-      -3,    59,    60,   -28,   -28,    -3,    -3,    14,    -3,    -3,
-      20,    50,   -28,    -3,    -3,    -3,    -3,    -3,    26,    32,
-     -28,   -16,   -16,    50,    50,    50,   -28,   -28
+      54,    70,    57,    58,    55,    56,    59,    60,    61,    62,
+      18,    63,    19,    66,    39,    40,    61,    62,    20,    63,
+      71,    72,    73,    74,    75,    76,    21,    41,    87,    42,
+      22,    90,    80,    81,    23,    43,     2,    24,    25,    83,
+      84,    26,     3,     4,     5,     6,     7,     8,     9,    10,
+      11,    12,    13,    14,     3,     4,     5,     6,     7,     8,
+       9,    10,    11,    12,    13,    14,    27,    28,    29,    30,
+      91,     3,     4,     5,     6,     7,     8,     9,    10,    11,
+      12,    13,    14,    79,    31,    35,    32,    92,    59,    60,
+      61,    62,    88,    63,    33,    34,    37,    59,    60,    61,
+      62,    89,    63,    46,    52,    47,    59,    60,    61,    62,
+      38,    63,    59,    60,    61,    62,    48,    63,    49,    50,
+      64,    51,    53,    65,    67,    69,    77,    78,    63,    86,
+      85
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int8 yypgoto[] =
+static const yytype_int8 yycheck[] =
 {
-     -28,   -28,   -28,   -28,   -27
+      38,    19,    19,    20,    42,    43,    24,    25,    26,    27,
+      18,    29,    18,    51,     3,     4,    26,    27,    18,    29,
+      58,    59,    60,    61,    62,    63,    18,    16,    82,    18,
+      18,    85,    19,    20,    18,    24,     0,     5,    16,    77,
+      78,    18,     6,     7,     8,     9,    10,    11,    12,    13,
+      14,    15,    16,    17,     6,     7,     8,     9,    10,    11,
+      12,    13,    14,    15,    16,    17,    16,    18,    17,     3,
+      22,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    19,     3,     5,     3,    22,    24,    25,
+      26,    27,    19,    29,     3,     3,     3,    24,    25,    26,
+      27,    19,    29,    19,    18,    20,    24,    25,    26,    27,
+      23,    29,    24,    25,    26,    27,    19,    29,    20,    19,
+       5,    20,    19,     5,    16,    21,    20,    20,    29,    16,
+      21
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint8 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      33,    34,    45,    46,    12,    47,    13,    14,    40,    41,
-      35,    48,    49,    15,    36,     2,    51,    52,    53,    54,
-      55,     3,     4,     5,     6,     7,     8,     9,    42,    16,
-      43,    44,    45,    46,    50,    47,    43,    44,    45,    46,
-      56,    47,    43,    44,    45,    46,    57,    47,    43,    44,
-      45,    46,    17,    47,    18,    19,    20,    21,    22,    23,
-      25,    27,    24,    26,    28,    29,    31,    32,     0,     0,
-       0,    47,     0,    30,    38,    39
+       0,    31,     0,     6,     7,     8,     9,    10,    11,    12,
+      13,    14,    15,    16,    17,    32,    33,    38,    18,    18,
+      18,    18,    18,    18,     5,    16,    18,    16,    18,    17,
+       3,     3,     3,     3,     3,     5,    34,     3,    23,     3,
+       4,    16,    18,    24,    37,    39,    19,    20,    19,    20,
+      19,    20,    18,    19,    39,    39,    39,    19,    20,    24,
+      25,    26,    27,    29,     5,     5,    39,    16,    36,    21,
+      19,    39,    39,    39,    39,    39,    39,    20,    20,    19,
+      19,    20,    35,    39,    39,    21,    16,    31,    19,    19,
+      31,    22,    22
 };
 
-static const yytype_int8 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       3,     4,    18,    19,    13,    21,    13,    13,    35,    36,
-      13,    38,    39,    13,    17,     0,    43,    44,    45,    46,
-      47,     6,     7,     8,     9,    10,    11,    12,    14,    13,
-      16,    17,    18,    19,    14,    21,    16,    17,    18,    19,
-      14,    21,    16,    17,    18,    19,    14,    21,    16,    17,
-      18,    19,    13,    21,    12,     3,     3,     3,     3,     3,
-      14,    14,     5,    15,    15,    14,     5,     5,    -1,    -1,
-      -1,    21,    -1,    15,    15,    15
+       0,    30,    31,    31,    32,    32,    32,    34,    33,    35,
+      33,    36,    36,    36,    37,    37,    37,    38,    38,    38,
+      38,    38,    38,    38,    38,    38,    39,    39,    39,    39,
+      39,    39,    39,    39,    39,    39
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,    23,     0,     6,     7,     8,     9,    10,    11,    12,
-      24,    25,    13,    13,    13,    13,    13,    13,    12,     3,
-       3,     3,     3,     3,     5,    14,    15,    14,    15,    14,
-      15,     5,     5,     3,     4,    13,    17,    26,    15,    15,
-      26,    26,    14,    16,    17,    18,    19,    21,    26,    26,
-      14,    26,    26,    26,    26,    26,    14,    14
+       0,     2,     0,     2,     1,     2,     1,     0,     9,     0,
+       8,     0,     1,     3,     0,     1,     3,     4,     8,     4,
+       8,     4,     6,     2,     4,     4,     1,     1,     1,     3,
+       3,     3,     3,     2,     3,     3
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
-
 /* Enable debugging if requested.  */
 #if YYDEBUG
 
@@ -675,80 +798,59 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, const YYSTYPE * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    const YYSTYPE * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (scanner);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, const YYSTYPE * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    const YYSTYPE * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, void *scanner)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, scanner);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -756,83 +858,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
 static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, 
-		   int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule
-		   )
-    YYSTYPE *yyvsp;
-    
-		   int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, void *scanner)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], scanner);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, scanner); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -847,277 +934,32 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, void *scanner)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
+  YY_USE (scanner);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
-
 
-/* The look-ahead symbol.  */
-int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
 
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 
@@ -1125,200 +967,193 @@ int yynerrs;
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void)
-#else
 int
-yyparse ()
-
-#endif
-#endif
+yyparse (void *scanner)
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+/* Lookahead token kind.  */
+int yychar;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, scanner);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1333,30 +1168,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1371,14 +1202,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1391,177 +1222,239 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 6:
-#line 65 "parser.y"
-    { pipe((yyvsp[(3) - (4)].ival)); ;}
+  case 7: /* $@1: %empty  */
+#line 147 "parser.y"
+                      { DEFINE((yyvsp[0].sptr)); }
+#line 1229 "parser.c"
     break;
 
-  case 7:
-#line 66 "parser.y"
-    { deal((yyvsp[(3) - (8)].ival), (yyvsp[(5) - (8)].sptr), (yyvsp[(7) - (8)].dval)); ;}
+  case 8: /* block: TDEFN TNAME $@1 TLPAR params TRPAR TLBRC input TRBRC  */
+#line 147 "parser.y"
+                                                                           { DEFINED(); }
+#line 1235 "parser.c"
     break;
 
-  case 8:
-#line 67 "parser.y"
-    { xdeal((yyvsp[(3) - (4)].ival)); ;}
+  case 9: /* $@2: %empty  */
+#line 148 "parser.y"
+                                        { REPEAT((yyvsp[-2].ival)); }
+#line 1241 "parser.c"
     break;
 
-  case 9:
-#line 68 "parser.y"
-    { farm((yyvsp[(3) - (8)].ival), (yyvsp[(5) - (8)].sptr), (yyvsp[(7) - (8)].dval)); ;}
+  case 10: /* block: TREPT TLPAR TINTG TRPAR TLBRC $@2 input TRBRC  */
+#line 148 "parser.y"
+                                                                    { REPEATED(); }
+#line 1247 "parser.c"
     break;
 
-  case 10:
-#line 69 "parser.y"
-    { xfarm((yyvsp[(3) - (4)].ival)); ;}
+  case 12: /* params: TNAME  */
+#line 152 "parser.y"
+                { PARAM((yyvsp[0].sptr)); }
+#line 1253 "parser.c"
     break;
 
-  case 11:
-#line 70 "parser.y"
-    { task((yyvsp[(3) - (6)].sptr), (yyvsp[(5) - (6)].dval)); ;}
+  case 13: /* params: params TCOMMA TNAME  */
+#line 153 "parser.y"
+                              { PARAM((yyvsp[0].sptr)); }
+#line 1259 "parser.c"
     break;
 
-  case 12:
-#line 73 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (1)].dval);          ;}
+  case 15: /* args: exp  */
+#line 157 "parser.y"
+              { ARG((yyvsp[0].xval)); }
+#line 1265 "parser.c"
     break;
 
-  case 13:
-#line 74 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (1)].ival);          ;}
+  case 16: /* args: args TCOMMA exp  */
+#line 158 "parser.y"
+                          { ARG((yyvsp[0].xval)); }
+#line 1271 "parser.c"
     break;
 
-  case 14:
-#line 75 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (3)].dval) + (yyvsp[(3) - (3)].dval);     ;}
+  case 17: /* stmt: TPIPE TLPAR TINTG TRPAR  */
+#line 161 "parser.y"
+                                  { STMT(PIPE, (yyvsp[-1].ival), NULL, CONST(0.0)); }
+#line 1277 "parser.c"
     break;
 
-  case 15:
-#line 76 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (3)].dval) - (yyvsp[(3) - (3)].dval);     ;}
+  case 18: /* stmt: TDEAL TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR  */
+#line 162 "parser.y"
+                                                          { STMT(DEAL, (yyvsp[-5].ival), (yyvsp[-3].sptr), (yyvsp[-1].xval)); }
+#line 1283 "parser.c"
     break;
 
-  case 16:
-#line 77 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (3)].dval) * (yyvsp[(3) - (3)].dval);     ;}
+  case 19: /* stmt: TXDEAL TLPAR TINTG TRPAR  */
+#line 163 "parser.y"
+                                   { STMT(DEAL, (yyvsp[-1].ival), NULL, CONST(0.0)); }
+#line 1289 "parser.c"
     break;
 
-  case 17:
-#line 78 "parser.y"
-    { (yyval.dval) = (yyvsp[(1) - (3)].dval) / (yyvsp[(3) - (3)].dval);     ;}
+  case 20: /* stmt: TFARM TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR  */
+#line 164 "parser.y"
+                                                          { STMT(FARM, (yyvsp[-5].ival), (yyvsp[-3].sptr), (yyvsp[-1].xval)); }
+#line 1295 "parser.c"
     break;
 
-  case 18:
-#line 79 "parser.y"
-    { (yyval.dval) = -(yyvsp[(2) - (2)].dval);         ;}
+  case 21: /* stmt: TXFARM TLPAR TINTG TRPAR  */
+#line 165 "parser.y"
+                                   { STMT(FARM, (yyvsp[-1].ival), NULL, CONST(0.0)); }
+#line 1301 "parser.c"
     break;
 
-  case 19:
-#line 80 "parser.y"
-    { (yyval.dval) = pow((yyvsp[(1) - (3)].dval), (yyvsp[(3) - (3)].dval)); ;}
+  case 22: /* stmt: TTASK TLPAR TSTRG TCOMMA exp TRPAR  */
+#line 166 "parser.y"
+                                             { STMT(TASK, 0, (yyvsp[-3].sptr), (yyvsp[-1].xval)); }
+#line 1307 "parser.c"
     break;
 
-  case 20:
-#line 81 "parser.y"
-    { (yyval.dval) = (yyvsp[(2) - (3)].dval);          ;}
+  case 23: /* stmt: TINCL TSTRG  */
+#line 167 "parser.y"
+                      { INCL((yyvsp[0].sptr)); }
+#line 1313 "parser.c"
+    break;
+
+  case 24: /* stmt: TNAME TLPAR args TRPAR  */
+#line 168 "parser.y"
+                                 { INSTANCE((yyvsp[-3].sptr)); }
+#line 1319 "parser.c"
+    break;
+
+  case 25: /* stmt: TRATE TNAME TEQUL exp  */
+#line 169 "parser.y"
+                                { RATE((yyvsp[-2].sptr), (yyvsp[0].xval)); }
+#line 1325 "parser.c"
+    break;
+
+  case 26: /* exp: TDOUB  */
+#line 172 "parser.y"
+                                { (yyval.xval) = CONST((yyvsp[0].dval));       }
+#line 1331 "parser.c"
+    break;
+
+  case 27: /* exp: TINTG  */
+#line 173 "parser.y"
+                                { (yyval.xval) = CONST((yyvsp[0].ival));       }
+#line 1337 "parser.c"
+    break;
+
+  case 28: /* exp: TNAME  */
+#line 174 "parser.y"
+                                { (yyval.xval) = NAME((yyvsp[0].sptr));        }
+#line 1343 "parser.c"
+    break;
+
+  case 29: /* exp: exp TPLUS exp  */
+#line 175 "parser.y"
+                                { (yyval.xval) = OP('+', (yyvsp[-2].xval), (yyvsp[0].xval)); }
+#line 1349 "parser.c"
+    break;
+
+  case 30: /* exp: exp TMINUS exp  */
+#line 176 "parser.y"
+                                { (yyval.xval) = OP('-', (yyvsp[-2].xval), (yyvsp[0].xval)); }
+#line 1355 "parser.c"
+    break;
+
+  case 31: /* exp: exp TTIMES exp  */
+#line 177 "parser.y"
+                                { (yyval.xval) = OP('*', (yyvsp[-2].xval), (yyvsp[0].xval)); }
+#line 1361 "parser.c"
+    break;
+
+  case 32: /* exp: exp TDIVIDE exp  */
+#line 178 "parser.y"
+                                { (yyval.xval) = OP('/', (yyvsp[-2].xval), (yyvsp[0].xval)); }
+#line 1367 "parser.c"
+    break;
+
+  case 33: /* exp: TMINUS exp  */
+#line 179 "parser.y"
+                                { (yyval.xval) = OP('n', (yyvsp[0].xval), (yyvsp[0].xval)); }
+#line 1373 "parser.c"
+    break;
+
+  case 34: /* exp: exp TEXPO exp  */
+#line 180 "parser.y"
+                                { (yyval.xval) = OP('^', (yyvsp[-2].xval), (yyvsp[0].xval)); }
+#line 1379 "parser.c"
+    break;
+
+  case 35: /* exp: TLPAR exp TRPAR  */
+#line 181 "parser.y"
+                                { (yyval.xval) = (yyvsp[-1].xval);              }
+#line 1385 "parser.c"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 1472 "parser.c"
+#line 1389 "parser.c"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
+      yyerror (scanner, YY_("syntax error"));
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, scanner);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -1570,14 +1463,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -1590,42 +1482,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, scanner);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -1636,114 +1528,992 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (scanner, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, scanner);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
 
+#line 183 "parser.y"
 
-#line 83 "parser.y"
 
-	
 /* Called by yyparse on error.  */
-void yyerror (char const *s) {
-	printf("%s\n", s);
+void yyerror (void *scanner, char const *s) {
+    htree_parse_t *p = (htree_parse_t *) yyget_extra(scanner);
+
+    p->errors++;
+    fprintf(stderr, "[ %s at line %d ]\n", s, p->line);
+}
+
+/* Definitions and repetitions are parsed into blocks of statements,
+   which are built into bodies of statements (see "pepa.h") for every
+   distinct instance: the statements of a body are inserted into the
+   tree once, as a subtree which its instances share. */
+typedef enum {
+    BODY_STMT = 0,  /* Statement. */
+    BODY_INST,      /* Instance of a definition. */
+    BODY_REPT       /* Repeated block. */
+} __parse_kind_t;   /* Kind of statement of a block. */
+
+typedef struct __parse_block_s __parse_block_t;
+typedef struct __parse_def_s __parse_def_t;
+
+typedef struct {
+    __parse_kind_t kind;      /* Kind of statement. */
+    htree_stmt_t s;           /* Statement, or instances. */
+    __parse_expr_t *rate;     /* Rate of the tasks, if not constant. */
+    __parse_def_t *def;       /* Definition of an instance. */
+    __parse_expr_t **args;    /* Arguments of an instance. */
+    __parse_block_t *block;   /* Repeated block. */
+} __parse_bstmt_t;            /* Statement of a block. */
+
+struct __parse_block_s {
+    __parse_bstmt_t *v;       /* Statements. */
+    int n;                    /* Number of statements. */
+    int max;                  /* Allocated number of statements. */
+    int count;                /* Number of repetitions. */
+};                            /* Block of statements. */
+
+typedef struct __parse_inst_s {
+    __parse_exp_t *args;      /* Arguments. */
+    htree_body_t *body;       /* Statements of the instance. */
+    struct __parse_inst_s *next; /* Next instance. */
+} __parse_inst_t;             /* Instance of a definition. */
+
+struct __parse_def_s {
+    const char *name;         /* Name (interned). */
+    const char **params;      /* Names of the parameters (interned). */
+    int nparams;              /* Number of parameters. */
+    int maxparams;            /* Allocated number of parameters. */
+    __parse_block_t *body;    /* Body. */
+    __parse_inst_t *insts;    /* Instances which were built. */
+    __parse_def_t *next;      /* Previous definition. */
+};                            /* Definition of a subtree. */
+
+typedef struct __parse_rate_s {
+    const char *name;         /* Name (interned). */
+    __parse_exp_t x;          /* Value. */
+    struct __parse_rate_s *next; /* Previous named rate. */
+} __parse_rate_t;             /* Named rate. */
+
+typedef struct __parse_link_s {
+    struct __parse_link_s *next; /* Next allocation. */
+    double align;             /* Aligns the allocation which follows. */
+} __parse_link_t;             /* Allocation of the definitions. */
+
+typedef struct {
+    __parse_link_t *pool;     /* Allocations. */
+    __parse_def_t *defs;      /* Definitions, the last first. */
+    __parse_def_t *def;       /* Definition being parsed, or NULL. */
+    __parse_rate_t *rates;    /* Named rates, the last first. */
+    __parse_link_t *scoped;   /* Included files parsed in the scope,
+                                 which only define subtrees and named
+                                 rates (their names follow the
+                                 links). */
+    __parse_block_t **blocks; /* Blocks being parsed, innermost last. */
+    int nblocks;              /* Number of blocks being parsed. */
+    int maxblocks;            /* Allocated number of blocks. */
+    __parse_exp_t *args;      /* Arguments of the instance being parsed. */
+    int nargs;                /* Number of arguments. */
+    int maxargs;              /* Allocated number of arguments. */
+} __parse_defs_t;             /* Definitions of a parse (htree_parse_t). */
+
+/* Definitions of p, which are created when first needed. */
+static __parse_defs_t *__parse_defs(htree_parse_t *p);
+
+/* Statements of the instance of the definition f with the arguments
+   args. */
+static htree_body_t *__parse_instantiate(htree_parse_t *p,
+                                         __parse_def_t *f,
+                                         __parse_exp_t *args);
+
+/* Insert the nodes of a statement into the tree of p, or record the
+   statement if p is a chunk of a parallel parse (see "chunk.c"). The
+   statement is located on the line being scanned, which for the
+   statements of an included file is that of the include. */
+static void __parse_emit(htree_parse_t *p, const htree_stmt_t *s) {
+    htree_stmt_t u = *s, *t;
+    int n;
+
+    u.line = p->line;
+    if (!p->record) {
+        if (htree_stmt(&p->rt, &u) < 0)
+            p->errors++;
+        return;
+    }
+    if (p->nstmts == p->maxstmts) {
+        n = p->maxstmts ? 2*p->maxstmts : 1024;
+        if (!(t = (htree_stmt_t *) realloc(p->stmts,
+                                           sizeof(htree_stmt_t)*n))) {
+            p->errors++;
+            return;
+        }
+        p->stmts = t;
+        p->maxstmts = n;
+    }
+    p->stmts[p->nstmts++] = u;
+}
+
+/* Allocate size bytes, cleared, which are released with the
+   definitions of p. */
+static void *__parse_alloc(htree_parse_t *p, size_t size) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_link_t *b;
+
+    if (!(b = (__parse_link_t *) calloc(1, sizeof(__parse_link_t) + size))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    b->next = d->pool;
+    d->pool = b;
+    return b + 1;
+}
+
+/* Make room for one more element in the array *v of n elements of
+   size bytes, of which *max are allocated. */
+static void __parse_room(htree_parse_t *p, void **v, int n, int *max,
+                         size_t size) {
+    void *w;
+
+    if (n < *max)
+        return;
+    *max = *max ? 2*(*max) : 8;
+    w = __parse_alloc(p, size*(*max));
+    if (n)
+        memcpy(w, *v, size*n);
+    *v = w;
+}
+
+__parse_defs_t *__parse_defs(htree_parse_t *p) {
+    if (!p->defs && !(p->defs = calloc(1, sizeof(__parse_defs_t)))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    return (__parse_defs_t *) p->defs;
+}
+
+/* Add a statement to the innermost block being parsed, or insert it
+   if there is none. */
+static void __parse_add(htree_parse_t *p, __parse_bstmt_t *t) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_block_t *b;
+
+    if (!d || !d->nblocks) {
+        __parse_emit(p, &t->s);
+        return;
+    }
+    b = d->blocks[d->nblocks - 1];
+    __parse_room(p, (void **) &b->v, b->n, &b->max, sizeof(__parse_bstmt_t));
+    b->v[b->n++] = *t;
 }
-	
+
+static void __parse_stmt(htree_parse_t *p, __htree_comp_t skel, int n,
+                         const char *name, __parse_exp_t rate) {
+    __parse_bstmt_t t;
+
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_STMT;
+    t.s.skel = skel;
+    t.s.n = n;
+    t.s.name = name;
+    t.s.rate = rate.val;
+    t.s.rname = rate.sym;
+    t.rate = rate.expr;
+    __parse_add(p, &t);
+}
+
+/* Parse the included file path, with ntree statements which are not
+   named rates, in the scope of p: its definitions and named rates are
+   added to those of p, which it sees in turn, and its statements are
+   spliced into p. A file which only defines subtrees and named rates
+   is parsed once in a scope, wherever it is included from, so that
+   they are not defined twice. */
+static void __parse_scope(htree_parse_t *p, const char *path, int ntree) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_link_t *b;
+    htree_parse_t q;
+    char *real;
+    int i;
+
+    if (!ntree && (real = realpath(path, NULL))) {
+        for (b = d->scoped; b && strcmp((char *) (b + 1), real);
+             b = b->next);
+        if (!b) {
+            b = (__parse_link_t *) __parse_alloc(p, strlen(real) + 1 +
+                                                 sizeof(__parse_link_t));
+            strcpy((char *) (b + 1), real);
+            b->next = d->scoped;
+            d->scoped = b;
+            b = NULL;
+        }
+        free(real);
+        if (b)
+            return;
+    }
+    memset(&q, 0, sizeof(htree_parse_t));
+    q.fname = path;
+    q.depth = p->depth + 1;
+    q.record = 1;
+    q.deps = p->deps;
+    q.incl = p->incl;
+    q.scope = p->scope ? p->scope : p;
+    q.defs = d;
+    if (init_lex(&q, (char *) path) < 0) {
+        p->errors++;
+        return;
+    }
+    if (htree_parse_scan(&q))
+        p->errors++;
+    for (i = 0; i < q.nstmts; i++)
+        __parse_emit(p, &q.stmts[i]);
+    p->defines += q.defines;
+
+    /* The definitions, and the included files held, are those of p. */
+    p->incl = q.incl;
+    q.incl = NULL;
+    q.defs = NULL;
+    final_lex(&q);
+}
+
+/* Splice the statements of the included file name (see "include.h").
+   Its named rates are named rates of p. */
+static void __parse_include(htree_parse_t *p, const char *name) {
+    const htree_stmt_t *s;
+    __parse_bstmt_t t;
+    __parse_exp_t x;
+    const char *r;
+    char *scope;
+    int i, n;
+
+    if (include_stmts(p, name, &s, &n, &scope) < 0) {
+        p->errors++;
+        return;
+    }
+    if (scope) {
+        __parse_scope(p, scope, n);
+        free(scope);
+        return;
+    }
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_STMT;
+    for (i = 0; i < n; i++) {
+        if ((s[i].skel == UNKNOWN) && !s[i].body) {
+            if (!(r = htree_intern(htree_parse_rt(p), s[i].name, 1))) {
+                p->errors++;
+                continue;
+            }
+            x.val = s[i].rate;
+            x.sym = s[i].rname;
+            x.expr = NULL;
+            __parse_rate(p, r, x);
+            continue;
+        }
+        t.s = s[i];
+        __parse_add(p, &t);
+    }
+}
+
+/* Open a block, of count repetitions or the body of a definition. */
+static void __parse_open(htree_parse_t *p, int count) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_block_t *b;
+
+    b = (__parse_block_t *) __parse_alloc(p, sizeof(__parse_block_t));
+    b->count = count;
+    if (d->nblocks == d->maxblocks) {
+        d->maxblocks = d->maxblocks ? 2*d->maxblocks : 8;
+        if (!(d->blocks = (__parse_block_t **)
+              realloc(d->blocks, sizeof(__parse_block_t *)*d->maxblocks))) {
+            fprintf(stderr, "[ out of memory ]\n");
+            exit(1);
+        }
+    }
+    d->blocks[d->nblocks++] = b;
+}
+
+/* Close the innermost block, which must describe one subtree: every
+   statement fills a child of a node which the previous ones left
+   open, and all of them are filled at the end. */
+static __parse_block_t *__parse_close(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_block_t *b = d->blocks[--d->nblocks];
+    int i, open = 1;
+
+    for (i = 0; (i < b->n) && (open > 0); i++) {
+        switch (b->v[i].kind) {
+        case BODY_STMT:
+            if ((b->v[i].s.skel == TASK) || (b->v[i].s.skel == UNKNOWN))
+                open -= (b->v[i].s.skel == TASK) ? 1 : b->v[i].s.n;
+            else
+                open += b->v[i].s.n - (b->v[i].s.name ? b->v[i].s.n : 0) - 1;
+            break;
+        case BODY_INST:
+            open--;
+            break;
+        case BODY_REPT:
+            open -= b->v[i].s.n;
+            break;
+        }
+    }
+    if (open || (i < b->n)) {
+        fprintf(stderr, "[ body of %s is not one subtree ]\n", name);
+        p->errors++;
+    }
+    return b;
+}
+
+/* Evaluate the expression e, with the arguments env: the operators
+   are applied to the constants they are given, and so fold them. */
+static __parse_exp_t __parse_eval(htree_parse_t *p, __parse_expr_t *e,
+                                  const __parse_exp_t *env) {
+    __parse_exp_t x;
+
+    switch (e->op) {
+    case 'c':
+        x.val = e->val;
+        x.sym = e->sym;
+        x.expr = NULL;
+        return x;
+    case 'p':
+        return env[e->param];
+    }
+    return __parse_op(p, e->op, __parse_eval(p, e->l, env),
+                      __parse_eval(p, e->r, env));
+}
+
+/* Build the statements of the block b, with the arguments env. */
+static htree_body_t *__parse_body(htree_parse_t *p, __parse_block_t *b,
+                                  const __parse_exp_t *env) {
+    htree_body_t *h;
+    __parse_bstmt_t *t;
+    __parse_exp_t *args, x;
+    int i, k;
+
+    h = (htree_body_t *) __parse_alloc(p, sizeof(htree_body_t));
+    h->stmts = (htree_stmt_t *) __parse_alloc(p, sizeof(htree_stmt_t)*b->n);
+    h->nstmts = b->n;
+    for (i = 0; i < b->n; i++) {
+        t = &b->v[i];
+        h->stmts[i] = t->s;
+        switch (t->kind) {
+        case BODY_STMT:
+            if (t->rate) {
+                x = __parse_eval(p, t->rate, env);
+                h->stmts[i].rate = x.val;
+                h->stmts[i].rname = x.sym;
+            }
+            break;
+        case BODY_INST:
+            args = (__parse_exp_t *) __parse_alloc(p, sizeof(__parse_exp_t)*
+                                                   (t->def->nparams + 1));
+            for (k = 0; k < t->def->nparams; k++)
+                args[k] = __parse_eval(p, t->args[k], env);
+            h->stmts[i].body = __parse_instantiate(p, t->def, args);
+            break;
+        case BODY_REPT:
+            h->stmts[i].body = __parse_body(p, t->block, env);
+            break;
+        }
+    }
+    return h;
+}
+
+/* Instances with the same arguments share their statements, and hence
+   their subtree. */
+htree_body_t *__parse_instantiate(htree_parse_t *p, __parse_def_t *f,
+                                  __parse_exp_t *args) {
+    __parse_inst_t *i;
+    int k;
+
+    for (i = f->insts; i; i = i->next) {
+        for (k = 0; (k < f->nparams) && (i->args[k].val == args[k].val) &&
+                 (i->args[k].sym == args[k].sym); k++);
+        if (k == f->nparams)
+            return i->body;
+    }
+    i = (__parse_inst_t *) __parse_alloc(p, sizeof(__parse_inst_t));
+    i->args = args;
+    i->body = __parse_body(p, f->body, args);
+    i->next = f->insts;
+    f->insts = i;
+    return i->body;
+}
+
+static void __parse_define(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = __parse_defs(p);
+
+    if (d->def || d->nblocks) {
+        fprintf(stderr, "[ definition of %s is not at the top ]\n", name);
+        p->errors++;
+    }
+    d->def = (__parse_def_t *) __parse_alloc(p, sizeof(__parse_def_t));
+    d->def->name = name;
+    p->defines++;
+    __parse_open(p, 0);
+}
+
+static void __parse_param(htree_parse_t *p, const char *name) {
+    __parse_def_t *f = ((__parse_defs_t *) p->defs)->def;
+    int k;
+
+    for (k = 0; k < f->nparams; k++)
+        if (f->params[k] == name) {
+            fprintf(stderr, "[ parameter %s of %s is repeated ]\n",
+                    name, f->name);
+            p->errors++;
+        }
+    __parse_room(p, (void **) &f->params, f->nparams, &f->maxparams,
+                 sizeof(const char *));
+    f->params[f->nparams++] = name;
+}
+
+static void __parse_defined(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_def_t *f = d->def, *g;
+
+    f->body = __parse_close(p, f->name);
+    for (g = d->defs; g && (g->name != f->name); g = g->next);
+    if (g) {
+        fprintf(stderr, "[ %s is defined twice ]\n", f->name);
+        p->errors++;
+    }
+    f->next = d->defs;
+    d->defs = f;
+    d->def = NULL;
+}
+
+static void __parse_repeat(htree_parse_t *p, int n) {
+    if (n < 1) {
+        fprintf(stderr, "[ repeat(%d) has no instance ]\n", n);
+        p->errors++;
+    }
+    __parse_open(p, n);
+}
+
+static void __parse_repeated(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_bstmt_t t;
+
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.block = __parse_close(p, "repeat");
+    t.kind = BODY_REPT;
+    t.s.skel = UNKNOWN;
+    t.s.n = t.block->count;
+    if (!d->nblocks)
+        t.s.body = __parse_body(p, t.block, NULL);
+    __parse_add(p, &t);
+}
+
+static void __parse_arg(htree_parse_t *p, __parse_exp_t x) {
+    __parse_defs_t *d = __parse_defs(p);
+
+    __parse_room(p, (void **) &d->args, d->nargs, &d->maxargs,
+                 sizeof(__parse_exp_t));
+    d->args[d->nargs++] = x;
+}
+
+static void __parse_instance(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_bstmt_t t;
+    __parse_def_t *f;
+    __parse_exp_t *args;
+    int k;
+
+    for (f = d->defs; f && (f->name != name); f = f->next);
+    if (!f || (f->nparams != d->nargs)) {
+        if (f)
+            fprintf(stderr, "[ %s takes %d arguments ]\n", name, f->nparams);
+        else
+            fprintf(stderr, "[ %s is not defined ]\n", name);
+        p->errors++;
+        d->nargs = 0;
+        return;
+    }
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_INST;
+    t.def = f;
+    t.s.skel = UNKNOWN;
+    t.s.n = 1;
+
+    /* An instance in a block is built with the block, as its arguments
+       may refer to parameters. */
+    if (d->nblocks) {
+        t.args = (__parse_expr_t **) __parse_alloc(p, sizeof(__parse_expr_t *)*
+                                                   (f->nparams + 1));
+        for (k = 0; k < f->nparams; k++)
+            t.args[k] = d->args[k].expr ? d->args[k].expr
+                : __parse_op(p, 'c', d->args[k], d->args[k]).expr;
+    } else {
+        args = (__parse_exp_t *) __parse_alloc(p, sizeof(__parse_exp_t)*
+                                               (f->nparams + 1));
+        for (k = 0; k < f->nparams; k++)
+            args[k] = d->args[k];
+        t.s.body = __parse_instantiate(p, f, args);
+    }
+    d->nargs = 0;
+    __parse_add(p, &t);
+}
+
+/* Whether name is one of the identifiers of the generated model: the
+   processes t_N (and t_N_M), the activities comp_N and move_N_M, and
+   infty. */
+static int __parse_reserved(const char *name) {
+    static const char *prefix[] = { "t", "comp", "move" };
+    const char *c;
+    size_t k;
+    int i;
+
+    if (!strcmp(name, "infty"))
+        return 1;
+    for (i = 0; i < 3; i++) {
+        k = strlen(prefix[i]);
+        if (strncmp(name, prefix[i], k))
+            continue;
+        for (c = name + k; (c[0] == '_') && (c[1] >= '0') && (c[1] <= '9');)
+            for (c++; (*c >= '0') && (*c <= '9'); c++);
+        if ((c != name + k) && !*c)
+            return 1;
+    }
+    return 0;
+}
+
+/* Define the named rate name, at the top of the description: it is
+   inserted into the tree as a statement (see htree_stmt()), so that
+   the rate is defined in the model, and recorded as the statements
+   of included files are. */
+static void __parse_rate(htree_parse_t *p, const char *name,
+                         __parse_exp_t x) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_rate_t *r;
+    htree_stmt_t s;
+
+    if (d->def || d->nblocks) {
+        fprintf(stderr, "[ rate %s is not at the top ]\n", name);
+        p->errors++;
+        return;
+    }
+    if (__parse_reserved(name)) {
+        fprintf(stderr, "[ rate %s is a name of the generated model ]\n",
+                name);
+        p->errors++;
+        return;
+    }
+    for (r = d->rates; r && (r->name != name); r = r->next);
+    if (r) {
+        fprintf(stderr, "[ rate %s is defined twice ]\n", name);
+        p->errors++;
+        return;
+    }
+    r = (__parse_rate_t *) __parse_alloc(p, sizeof(__parse_rate_t));
+    r->name = name;
+    r->x = x;
+    r->next = d->rates;
+    d->rates = r;
+    memset(&s, 0, sizeof(htree_stmt_t));
+    s.skel = UNKNOWN;
+    s.name = name;
+    s.rate = x.val;
+    s.rname = x.sym;
+    __parse_emit(p, &s);
+}
+
+static __parse_exp_t __parse_const(double val) {
+    __parse_exp_t x;
+
+    x.val = val;
+    x.sym = NULL;
+    x.expr = NULL;
+    return x;
+}
+
+static __parse_exp_t __parse_name(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_exp_t x = __parse_const(0.0);
+    __parse_rate_t *r;
+    int k;
+
+    if (d && d->def)
+        for (k = 0; k < d->def->nparams; k++)
+            if (d->def->params[k] == name) {
+                x.expr = (__parse_expr_t *)
+                    __parse_alloc(p, sizeof(__parse_expr_t));
+                x.expr->op = 'p';
+                x.expr->param = k;
+                return x;
+            }
+
+    /* A named rate is kept by name. */
+    for (r = d ? d->rates : NULL; r; r = r->next)
+        if (r->name == name) {
+            x.val = r->x.val;
+            x.sym = name;
+            return x;
+        }
+    fprintf(stderr, "[ %s is not defined ]\n", name);
+    p->errors++;
+    return x;
+}
+
+/* Write the operand a into the n bytes of s, in parentheses unless it
+   is a name or a constant which is not negative. Returns its length,
+   as snprintf() does. */
+static int __parse_operand(char *s, size_t n, __parse_exp_t a) {
+    if (!a.sym)
+        return snprintf(s, n, (a.val < 0.0) ? "(%f)" : "%f", a.val);
+    return snprintf(s, n, strpbrk(a.sym, "+-*/") ? "(%s)" : "%s", a.sym);
+}
+
+/* The value over named rates of a op b, of which one at least refers
+   to named rates. */
+static const char *__parse_symbol(htree_parse_t *p, int op,
+                                  __parse_exp_t a, __parse_exp_t b) {
+    const char *r;
+    char *s;
+    int k, n;
+
+    if (op == 'n')
+        n = 1 + __parse_operand(NULL, 0, a);
+    else
+        n = __parse_operand(NULL, 0, a) + 1 + __parse_operand(NULL, 0, b);
+    if (!(s = (char *) malloc(n + 1))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    if (op == 'n') {
+        s[0] = '-';
+        __parse_operand(s + 1, n, a);
+    } else {
+        k = __parse_operand(s, n + 1, a);
+        s[k] = op;
+        __parse_operand(s + k + 1, n - k, b);
+    }
+    if (!(r = htree_intern(htree_parse_rt(p), s, 1)))
+        p->errors++;
+    free(s);
+    return r;
+}
+
+/* Apply the operator op to a and b; constants are folded as they
+   were before expressions could refer to parameters, and keep their
+   value over named rates. PEPA has no powers, so a power of named
+   rates is an error. Op 'c' makes a constant expression of a. */
+static __parse_exp_t __parse_op(htree_parse_t *p, int op, __parse_exp_t a,
+                                __parse_exp_t b) {
+    __parse_exp_t x;
+
+    if ((op != 'c') && !a.expr && !b.expr) {
+        switch (op) {
+        case '+': x = __parse_const(a.val + b.val); break;
+        case '-': x = __parse_const(a.val - b.val); break;
+        case '*': x = __parse_const(a.val * b.val); break;
+        case '/': x = __parse_const(a.val / b.val); break;
+        case 'n': x = __parse_const(-a.val); break;
+        default:
+            x = __parse_const(pow(a.val, b.val));
+            if (a.sym || b.sym) {
+                fprintf(stderr, "[ %s cannot be raised to a power ]\n",
+                        a.sym ? a.sym : b.sym);
+                p->errors++;
+            }
+            return x;
+        }
+        if (a.sym || b.sym)
+            x.sym = __parse_symbol(p, op, a, b);
+        return x;
+    }
+    x.val = 0.0;
+    x.sym = NULL;
+    x.expr = (__parse_expr_t *) __parse_alloc(p, sizeof(__parse_expr_t));
+    x.expr->op = op;
+    x.expr->val = a.val;
+    x.expr->sym = a.sym;
+    if (op != 'c') {
+        x.expr->l = a.expr ? a.expr : __parse_op(p, 'c', a, a).expr;
+        x.expr->r = b.expr ? b.expr : __parse_op(p, 'c', b, b).expr;
+    }
+    return x;
+}
+
+/* For a description of the following function, see "pepa.h". */
+void htree_parse_free(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_link_t *b;
+
+    include_release(p);
+    if (!d)
+        return;
+    while ((b = d->pool)) {
+        d->pool = b->next;
+        free(b);
+    }
+    free(d->blocks);
+    free(d);
+    p->defs = NULL;
+}
+
+/* For a description of the following function, see "pepa.h". */
+int htree_parse(htree_parse_t *p, char *fname) {
+    struct stat st;
+
+    memset(p, 0, sizeof(htree_parse_t));
+    p->fname = fname;
+    if (bin_is_tree(fname)) {
+        if (bin_load(&p->rt, fname) < 0) {
+            fprintf(stderr, "[ invalid precompiled tree %s ]\n", fname);
+            return -1;
+        }
+        return 0;
+    }
+    if (!stat(fname, &st) && S_ISREG(st.st_mode) &&
+        (chunk_count(st.st_size, nthreads) > 1))
+        return chunk_parse(p, fname, nthreads);
+    if (init_lex(p, fname) < 0)
+        return -1;
+    return htree_parse_scan(p);
+}
+
+int htree_parse_scan(htree_parse_t *p) {
+    return (yyparse(p->scanner) || p->errors) ? 1 : 0;
+}
+
 int main(int argc, char *argv[]) {
-	int c;
-	
-	while(1) {
-        c = getopt(argc, argv, "aghlo");
+    htree_parse_t parse;
+    int c;
+
+    report_file = stdout;
+    while(1) {
+        c = getopt(argc, argv, "aBbC:cD:defgHhj:klMmO:oPrSsT:tU:w:xY");
         if (c == -1)
-			break;
-        
+            break;
+
         switch(c) {
-		case 'g':
-			graph = 1;
-			break;
+        case 'B':
+            binary = 1;
+            break;
+        case 'b':
+            bounds = 1;
+            break;
+        case 'C':
+            cache = optarg;
+            break;
+        case 'c':
+            compose = 1;
+            break;
+        case 'D':
+            store = optarg;
+            solve = 1;
+            break;
+        case 'd':
+            decompose = 1;
+            break;
+        case 'e':
+            lump = 2;
+            solve = 1;
+            break;
+        case 'f':
+            fluid = 1;
+            break;
+        case 'g':
+            graph = 1;
+            break;
+        case 'H':
+            compaction = CTMC_HASH;
+            solve = 1;
+            break;
         case 'h':
-			fprintf(stderr,
-					"Usage: wflow2pepa [OPTIONS] <file>\n\n"
-					"Options:\n"
-					"  -a  Generate complete (graph, latex, ps etc.).\n"
-					"  -g  Generate dot graph.\n"
-					"  -h  Show this help message.\n"
-					"  -l  Generate LaTeX source file.\n"
-					"  -o  Output into a file.\n\n"
-					"Copyright 2006 Enhance Project\n"
-					"University of Edinburgh, United Kingdom\n"
-					"Contact: Gagarine Yaikhom (g.yaikhom@inf.ed.ac.uk)\n");
-			exit(0);
+            fprintf(stderr,
+                    "Usage: wflow2pepa [OPTIONS] <file>\n\n"
+                    "Options:\n"
+                    "  -a  Generate complete (graph, latex, ps etc.).\n"
+                    "  -B  Write the committed tree into a precompiled\n"
+                    "        tree (.htree), which can be given as input.\n"
+                    "  -b  Bound the throughput of every subtree.\n"
+                    "  -C DIR[:SIZE]  Keep the generated models and their\n"
+                    "        reports in the cache DIR, of at most SIZE\n"
+                    "        bytes (k, M or G; default 256M), and reuse\n"
+                    "        them for the same tree and options.\n"
+                    "  -c  Solve the tree compositionally.\n"
+                    "  -D DIR  Keep the CTMC in memory-mapped files in\n"
+                    "        DIR, and resume its solution from there.\n"
+                    "  -d  Approximate a long pipe by decomposition.\n"
+                    "  -e  Aggregate the CTMC by exact lumpability.\n"
+                    "  -f  Solve the fluid (ODE) approximation.\n"
+                    "  -g  Generate dot graph.\n"
+                    "  -H  Derive the CTMC with hash compaction.\n"
+                    "  -h  Show this help message.\n"
+                    "  -j N  Use N threads (default: all processors).\n"
+                    "  -k  Aggregate the CTMC by ordinary lumpability.\n"
+                    "  -l  Generate LaTeX source file.\n"
+                    "  -M  Compare the memory taken per state by the ways\n"
+                    "        of storing the visited states.\n"
+                    "  -m  Estimate measures by stochastic simulation.\n"
+                    "  -O N  Choose the widths of deals and farms for the\n"
+                    "        best throughput with N tasks (-c to solve\n"
+                    "        candidates compositionally).\n"
+                    "  -o  Output into a file.\n"
+                    "  -P  End-to-end latency distribution of a job.\n"
+                    "  -r  Reduce identical farm branches by symmetry.\n"
+                    "  -S  Sensitivity of the throughput to every rate.\n"
+                    "  -s  Solve the underlying CTMC.\n"
+                    "  -t  Write throughputs and utilisations (.csv).\n"
+                    "  -T L  Transient throughput at time points L, given\n"
+                    "        as t1,t2,... or as horizon/points.\n"
+                    "  -U S  Serve models on request over the Unix domain\n"
+                    "        socket S, on -j worker threads (see\n"
+                    "        \"server.h\" for the requests).\n"
+                    "  -w S  Solve for every point of a sweep of task\n"
+                    "        rates, given as a=1:5:5,b=2:4:3 (grid),\n"
+                    "        lhs=20,a=1:5 (Latin hypercube) or @file.\n"
+                    "  -x  Process the inputs as a batch, on -j worker\n"
+                    "        threads: description files, directories\n"
+                    "        of them, or @list files (implies -o).\n"
+                    "  -Y  Derive the CTMC with its states in a decision\n"
+                    "        diagram.\n\n"
+                    "Copyright 2006 Enhance Project\n"
+                    "University of Edinburgh, United Kingdom\n"
+                    "Contact: Gagarine Yaikhom (g.yaikhom@inf.ed.ac.uk)\n");
+            exit(0);
+        case 'j':
+            nthreads = atoi(optarg);
+            break;
+        case 'k':
+            lump = 1;
+            solve = 1;
+            break;
         case 'l':
-			latex = 1;
-			break;
-		case 'o':
-			output = 1;
-			break;
-		case 'a':
-			graph = 1;
-			latex = 1;
-			output = 1;
-			complete = 1;
-			break;
-		case '?':
-			break;
-		default:
-			printf ("?? getopt returned character code 0%o ??\n", c);
+            latex = 1;
+            break;
+        case 'M':
+            storage = 1;
+            break;
+        case 'm':
+            simulate = 1;
+            break;
+        case 'O':
+            budget = atoi(optarg);
+            break;
+        case 'o':
+            output = 1;
+            break;
+        case 'P':
+            passage = 1;
+            solve = 1;
+            break;
+        case 'r':
+            symmetry = 1;
+            solve = 1;
+            break;
+        case 'S':
+            sensitivity = 1;
+            solve = 1;
+            break;
+        case 's':
+            solve = 1;
+            break;
+        case 'T':
+            transient = optarg;
+            solve = 1;
+            break;
+        case 't':
+            measures = 1;
+            solve = 1;
+            break;
+        case 'U':
+            server = optarg;
+            break;
+        case 'w':
+            sweep = optarg;
+            break;
+        case 'x':
+            batch = 1;
+            output = 1;
+            break;
+        case 'Y':
+            compaction = CTMC_MDD;
+            solve = 1;
+            break;
+        case 'a':
+            graph = 1;
+            latex = 1;
+            output = 1;
+            complete = 1;
+            break;
+        case '?':
+            break;
+        default:
+            printf ("?? getopt returned character code 0%o ??\n", c);
 
         }
-	}
-
-	if (optind >= argc) {
-		printf("ERROR: No input file.\n");
-		exit(1);
-	}
-	fname = strdup(argv[optind]);
-	*(strrchr(fname, '.') + 1) = '\0';
-	init_lex(argv[optind]);
-	yyparse();
-	final_lex();
-    generate();
-	free(fname);
-}
+    }
 
+    if (cache && (cache_open(cache) < 0))
+        exit(1);
+    if (server) {
+        c = htree_serve(server, nthreads);
+        include_final();
+        exit(c ? 1 : 0);
+    }
+    if (optind >= argc) {
+        printf("ERROR: No input file.\n");
+        exit(1);
+    }
+    if (batch) {
+        c = htree_batch(argv + optind, argc - optind, nthreads);
+        include_final();
+        exit(c ? 1 : 0);
+    }
+    fname = strdup(argv[optind]);
+    *(strrchr(fname, '.') + 1) = '\0';
+    if (htree_parse(&parse, argv[optind]))
+        exit(1);
+    __htree_rt = parse.rt;
+    c = generate();
+    final_lex(&parse);
+    include_final();
+    free(fname);
+    return c ? 1 : 0;
+}
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,72 +31,89 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_H_INCLUDED
+# define YY_YY_PARSER_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     TINTG = 258,
-     TDOUB = 259,
-     TSTRG = 260,
-     TPIPE = 261,
-     TDEAL = 262,
-     TXDEAL = 263,
-     TFARM = 264,
-     TXFARM = 265,
-     TTASK = 266,
-     TSEMI = 267,
-     TLPAR = 268,
-     TRPAR = 269,
-     TCOMMA = 270,
-     TPLUS = 271,
-     TMINUS = 272,
-     TDIVIDE = 273,
-     TTIMES = 274,
-     TNEG = 275,
-     TEXPO = 276
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TINTG = 258,                   /* TINTG  */
+    TDOUB = 259,                   /* TDOUB  */
+    TSTRG = 260,                   /* TSTRG  */
+    TPIPE = 261,                   /* TPIPE  */
+    TDEAL = 262,                   /* TDEAL  */
+    TXDEAL = 263,                  /* TXDEAL  */
+    TFARM = 264,                   /* TFARM  */
+    TXFARM = 265,                  /* TXFARM  */
+    TTASK = 266,                   /* TTASK  */
+    TINCL = 267,                   /* TINCL  */
+    TDEFN = 268,                   /* TDEFN  */
+    TREPT = 269,                   /* TREPT  */
+    TRATE = 270,                   /* TRATE  */
+    TNAME = 271,                   /* TNAME  */
+    TSEMI = 272,                   /* TSEMI  */
+    TLPAR = 273,                   /* TLPAR  */
+    TRPAR = 274,                   /* TRPAR  */
+    TCOMMA = 275,                  /* TCOMMA  */
+    TLBRC = 276,                   /* TLBRC  */
+    TRBRC = 277,                   /* TRBRC  */
+    TEQUL = 278,                   /* TEQUL  */
+    TMINUS = 279,                  /* TMINUS  */
+    TPLUS = 280,                   /* TPLUS  */
+    TTIMES = 281,                  /* TTIMES  */
+    TDIVIDE = 282,                 /* TDIVIDE  */
+    TNEG = 283,                    /* TNEG  */
+    TEXPO = 284                    /* TEXPO  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define TINTG 258
-#define TDOUB 259
-#define TSTRG 260
-#define TPIPE 261
-#define TDEAL 262
-#define TXDEAL 263
-#define TFARM 264
-#define TXFARM 265
-#define TTASK 266
-#define TSEMI 267
-#define TLPAR 268
-#define TRPAR 269
-#define TCOMMA 270
-#define TPLUS 271
-#define TMINUS 272
-#define TDIVIDE 273
-#define TTIMES 274
-#define TNEG 275
-#define TEXPO 276
 
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 43 "parser.y"
 
+    int ival;
+    double dval;
+    char *sptr;
+    struct __parse_exp_s {
+        double val;                  /* Value, when constant. */
+        const char *sym;             /* The value over named rates
+                                        (interned), or NULL. */
+        struct __parse_expr_s *expr; /* Expression over parameters,
+                                        or NULL when constant. */
+    } xval;
 
+#line 106 "parser.h"
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 28 "parser.y"
-{
-	int ival;
-	double dval;
-	char *sptr;
-}
-/* Line 1528 of yacc.c.  */
-#line 97 "parser.h"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
+
+
+int yyparse (void *scanner);
+
+
+#endif /* !YY_YY_PARSER_H_INCLUDED  */
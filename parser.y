@@ -21,14 +21,36 @@
 %{
     #include <getopt.h>
     #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <sys/stat.h>
     #include "pepa.h"
-    void yyerror(char const *s);
+    #include "ctmc.h"
+    #include "chunk.h"
+    #include "bin.h"
+    #include "include.h"
+    #include "batch.h"
+    #include "server.h"
+    #include "cache.h"
 %}
 
+/* The parser is pure: it is called with the reentrant scanner, whose
+   extra data is the parse context holding the tree being built. */
+%define api.pure full
+%parse-param {void *scanner}
+%lex-param {void *scanner}
+
 %union {
     int ival;
     double dval;
     char *sptr;
+    struct __parse_exp_s {
+        double val;                  /* Value, when constant. */
+        const char *sym;             /* The value over named rates
+                                        (interned), or NULL. */
+        struct __parse_expr_s *expr; /* Expression over parameters,
+                                        or NULL when constant. */
+    } xval;
 }
 
 /* Bison declarations. */
@@ -41,12 +63,71 @@
 %token TFARM
 %token TXFARM
 %token TTASK
+%token TINCL
+%token TDEFN
+%token TREPT
+%token TRATE
+%token <sptr> TNAME
 %token TSEMI
 %token TLPAR
 %token TRPAR
 %token TCOMMA
+%token TLBRC
+%token TRBRC
+%token TEQUL
+
+%type <xval> exp
+
+%{
+    #define PARSE yyget_extra(scanner)
+    #define STMT(S,N,X,R) __parse_stmt(PARSE, S, N, X, R)
+    #define INCL(X) __parse_include(PARSE, X)
+    #define DEFINE(X) __parse_define(PARSE, X)
+    #define PARAM(X) __parse_param(PARSE, X)
+    #define DEFINED() __parse_defined(PARSE)
+    #define REPEAT(N) __parse_repeat(PARSE, N)
+    #define REPEATED() __parse_repeated(PARSE)
+    #define ARG(X) __parse_arg(PARSE, X)
+    #define INSTANCE(X) __parse_instance(PARSE, X)
+    #define RATE(X,E) __parse_rate(PARSE, X, E)
+    #define CONST(X) __parse_const(X)
+    #define NAME(X) __parse_name(PARSE, X)
+    #define OP(O,A,B) __parse_op(PARSE, O, A, B)
 
-%type <dval> exp
+    /* A rate which refers to the parameters of a definition is kept
+       as an expression, and evaluated for every instance. A rate which
+       refers to named rates keeps its value over them as a string,
+       which the tasks are written with (see "pepa.h"). */
+    typedef struct __parse_expr_s {
+        int op;                       /* Operator, 'c' for a constant,
+                                         'p' for a parameter. */
+        double val;                   /* Value of a constant. */
+        const char *sym;              /* Its value over named rates. */
+        int param;                    /* Index of a parameter. */
+        struct __parse_expr_s *l, *r; /* Operands. */
+    } __parse_expr_t;
+    typedef struct __parse_exp_s __parse_exp_t;
+
+    extern htree_parse_t *yyget_extra(void *scanner);
+    extern int yylex(YYSTYPE *lval, void *scanner);
+    void yyerror(void *scanner, char const *s);
+    static void __parse_stmt(htree_parse_t *p, __htree_comp_t skel, int n,
+                             const char *name, __parse_exp_t rate);
+    static void __parse_include(htree_parse_t *p, const char *name);
+    static void __parse_define(htree_parse_t *p, const char *name);
+    static void __parse_param(htree_parse_t *p, const char *name);
+    static void __parse_defined(htree_parse_t *p);
+    static void __parse_repeat(htree_parse_t *p, int n);
+    static void __parse_repeated(htree_parse_t *p);
+    static void __parse_arg(htree_parse_t *p, __parse_exp_t x);
+    static void __parse_instance(htree_parse_t *p, const char *name);
+    static void __parse_rate(htree_parse_t *p, const char *name,
+                             __parse_exp_t x);
+    static __parse_exp_t __parse_const(double val);
+    static __parse_exp_t __parse_name(htree_parse_t *p, const char *name);
+    static __parse_exp_t __parse_op(htree_parse_t *p, int op,
+                                    __parse_exp_t a, __parse_exp_t b);
+%}
 
 %left TMINUS TPLUS
 %left TTIMES TDIVIDE
@@ -60,64 +141,942 @@ input:    /* empty */
 
 line:     TSEMI
         | stmt TSEMI
+        | block
     ;
 
-stmt:     TPIPE TLPAR TINTG TRPAR { pipe($3); }
-        | TDEAL TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR { deal($3, $5, $7); }
-        | TXDEAL TLPAR TINTG TRPAR { xdeal($3); }
-        | TFARM TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR { farm($3, $5, $7); }
-        | TXFARM TLPAR TINTG TRPAR { xfarm($3); }
-        | TTASK TLPAR TSTRG TCOMMA exp TRPAR { task($3, $5); }
+block:    TDEFN TNAME { DEFINE($2); } TLPAR params TRPAR TLBRC input TRBRC { DEFINED(); }
+        | TREPT TLPAR TINTG TRPAR TLBRC { REPEAT($3); } input TRBRC { REPEATED(); }
     ;
 
-exp:      TDOUB                 { $$ = $1;          } 
-        | TINTG                 { $$ = $1;          }
-        | exp TPLUS exp         { $$ = $1 + $3;     }
-        | exp TMINUS exp        { $$ = $1 - $3;     }
-        | exp TTIMES exp        { $$ = $1 * $3;     }
-        | exp TDIVIDE exp       { $$ = $1 / $3;     }
-        | TMINUS exp %prec TNEG { $$ = -$2;         }
-        | exp TEXPO exp         { $$ = pow($1, $3); }
-        | TLPAR exp TRPAR        { $$ = $2;          }
+params:   /* empty */
+        | TNAME { PARAM($1); }
+        | params TCOMMA TNAME { PARAM($3); }
+    ;
+
+args:     /* empty */
+        | exp { ARG($1); }
+        | args TCOMMA exp { ARG($3); }
+    ;
+
+stmt:     TPIPE TLPAR TINTG TRPAR { STMT(PIPE, $3, NULL, CONST(0.0)); }
+        | TDEAL TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR { STMT(DEAL, $3, $5, $7); }
+        | TXDEAL TLPAR TINTG TRPAR { STMT(DEAL, $3, NULL, CONST(0.0)); }
+        | TFARM TLPAR TINTG TCOMMA TSTRG TCOMMA exp TRPAR { STMT(FARM, $3, $5, $7); }
+        | TXFARM TLPAR TINTG TRPAR { STMT(FARM, $3, NULL, CONST(0.0)); }
+        | TTASK TLPAR TSTRG TCOMMA exp TRPAR { STMT(TASK, 0, $3, $5); }
+        | TINCL TSTRG { INCL($2); }
+        | TNAME TLPAR args TRPAR { INSTANCE($1); }
+        | TRATE TNAME TEQUL exp { RATE($2, $4); }
+    ;
+
+exp:      TDOUB                 { $$ = CONST($1);       }
+        | TINTG                 { $$ = CONST($1);       }
+        | TNAME                 { $$ = NAME($1);        }
+        | exp TPLUS exp         { $$ = OP('+', $1, $3); }
+        | exp TMINUS exp        { $$ = OP('-', $1, $3); }
+        | exp TTIMES exp        { $$ = OP('*', $1, $3); }
+        | exp TDIVIDE exp       { $$ = OP('/', $1, $3); }
+        | TMINUS exp %prec TNEG { $$ = OP('n', $2, $2); }
+        | exp TEXPO exp         { $$ = OP('^', $1, $3); }
+        | TLPAR exp TRPAR       { $$ = $2;              }
     ;
 %%
 
 /* Called by yyparse on error.  */
-void yyerror (char const *s) {
-    printf("%s\n", s);
+void yyerror (void *scanner, char const *s) {
+    htree_parse_t *p = (htree_parse_t *) yyget_extra(scanner);
+
+    p->errors++;
+    fprintf(stderr, "[ %s at line %d ]\n", s, p->line);
+}
+
+/* Definitions and repetitions are parsed into blocks of statements,
+   which are built into bodies of statements (see "pepa.h") for every
+   distinct instance: the statements of a body are inserted into the
+   tree once, as a subtree which its instances share. */
+typedef enum {
+    BODY_STMT = 0,  /* Statement. */
+    BODY_INST,      /* Instance of a definition. */
+    BODY_REPT       /* Repeated block. */
+} __parse_kind_t;   /* Kind of statement of a block. */
+
+typedef struct __parse_block_s __parse_block_t;
+typedef struct __parse_def_s __parse_def_t;
+
+typedef struct {
+    __parse_kind_t kind;      /* Kind of statement. */
+    htree_stmt_t s;           /* Statement, or instances. */
+    __parse_expr_t *rate;     /* Rate of the tasks, if not constant. */
+    __parse_def_t *def;       /* Definition of an instance. */
+    __parse_expr_t **args;    /* Arguments of an instance. */
+    __parse_block_t *block;   /* Repeated block. */
+} __parse_bstmt_t;            /* Statement of a block. */
+
+struct __parse_block_s {
+    __parse_bstmt_t *v;       /* Statements. */
+    int n;                    /* Number of statements. */
+    int max;                  /* Allocated number of statements. */
+    int count;                /* Number of repetitions. */
+};                            /* Block of statements. */
+
+typedef struct __parse_inst_s {
+    __parse_exp_t *args;      /* Arguments. */
+    htree_body_t *body;       /* Statements of the instance. */
+    struct __parse_inst_s *next; /* Next instance. */
+} __parse_inst_t;             /* Instance of a definition. */
+
+struct __parse_def_s {
+    const char *name;         /* Name (interned). */
+    const char **params;      /* Names of the parameters (interned). */
+    int nparams;              /* Number of parameters. */
+    int maxparams;            /* Allocated number of parameters. */
+    __parse_block_t *body;    /* Body. */
+    __parse_inst_t *insts;    /* Instances which were built. */
+    __parse_def_t *next;      /* Previous definition. */
+};                            /* Definition of a subtree. */
+
+typedef struct __parse_rate_s {
+    const char *name;         /* Name (interned). */
+    __parse_exp_t x;          /* Value. */
+    struct __parse_rate_s *next; /* Previous named rate. */
+} __parse_rate_t;             /* Named rate. */
+
+typedef struct __parse_link_s {
+    struct __parse_link_s *next; /* Next allocation. */
+    double align;             /* Aligns the allocation which follows. */
+} __parse_link_t;             /* Allocation of the definitions. */
+
+typedef struct {
+    __parse_link_t *pool;     /* Allocations. */
+    __parse_def_t *defs;      /* Definitions, the last first. */
+    __parse_def_t *def;       /* Definition being parsed, or NULL. */
+    __parse_rate_t *rates;    /* Named rates, the last first. */
+    __parse_link_t *scoped;   /* Included files parsed in the scope,
+                                 which only define subtrees and named
+                                 rates (their names follow the
+                                 links). */
+    __parse_block_t **blocks; /* Blocks being parsed, innermost last. */
+    int nblocks;              /* Number of blocks being parsed. */
+    int maxblocks;            /* Allocated number of blocks. */
+    __parse_exp_t *args;      /* Arguments of the instance being parsed. */
+    int nargs;                /* Number of arguments. */
+    int maxargs;              /* Allocated number of arguments. */
+} __parse_defs_t;             /* Definitions of a parse (htree_parse_t). */
+
+/* Definitions of p, which are created when first needed. */
+static __parse_defs_t *__parse_defs(htree_parse_t *p);
+
+/* Statements of the instance of the definition f with the arguments
+   args. */
+static htree_body_t *__parse_instantiate(htree_parse_t *p,
+                                         __parse_def_t *f,
+                                         __parse_exp_t *args);
+
+/* Insert the nodes of a statement into the tree of p, or record the
+   statement if p is a chunk of a parallel parse (see "chunk.c"). The
+   statement is located on the line being scanned, which for the
+   statements of an included file is that of the include. */
+static void __parse_emit(htree_parse_t *p, const htree_stmt_t *s) {
+    htree_stmt_t u = *s, *t;
+    int n;
+
+    u.line = p->line;
+    if (!p->record) {
+        if (htree_stmt(&p->rt, &u) < 0)
+            p->errors++;
+        return;
+    }
+    if (p->nstmts == p->maxstmts) {
+        n = p->maxstmts ? 2*p->maxstmts : 1024;
+        if (!(t = (htree_stmt_t *) realloc(p->stmts,
+                                           sizeof(htree_stmt_t)*n))) {
+            p->errors++;
+            return;
+        }
+        p->stmts = t;
+        p->maxstmts = n;
+    }
+    p->stmts[p->nstmts++] = u;
+}
+
+/* Allocate size bytes, cleared, which are released with the
+   definitions of p. */
+static void *__parse_alloc(htree_parse_t *p, size_t size) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_link_t *b;
+
+    if (!(b = (__parse_link_t *) calloc(1, sizeof(__parse_link_t) + size))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    b->next = d->pool;
+    d->pool = b;
+    return b + 1;
+}
+
+/* Make room for one more element in the array *v of n elements of
+   size bytes, of which *max are allocated. */
+static void __parse_room(htree_parse_t *p, void **v, int n, int *max,
+                         size_t size) {
+    void *w;
+
+    if (n < *max)
+        return;
+    *max = *max ? 2*(*max) : 8;
+    w = __parse_alloc(p, size*(*max));
+    if (n)
+        memcpy(w, *v, size*n);
+    *v = w;
+}
+
+__parse_defs_t *__parse_defs(htree_parse_t *p) {
+    if (!p->defs && !(p->defs = calloc(1, sizeof(__parse_defs_t)))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    return (__parse_defs_t *) p->defs;
+}
+
+/* Add a statement to the innermost block being parsed, or insert it
+   if there is none. */
+static void __parse_add(htree_parse_t *p, __parse_bstmt_t *t) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_block_t *b;
+
+    if (!d || !d->nblocks) {
+        __parse_emit(p, &t->s);
+        return;
+    }
+    b = d->blocks[d->nblocks - 1];
+    __parse_room(p, (void **) &b->v, b->n, &b->max, sizeof(__parse_bstmt_t));
+    b->v[b->n++] = *t;
+}
+
+static void __parse_stmt(htree_parse_t *p, __htree_comp_t skel, int n,
+                         const char *name, __parse_exp_t rate) {
+    __parse_bstmt_t t;
+
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_STMT;
+    t.s.skel = skel;
+    t.s.n = n;
+    t.s.name = name;
+    t.s.rate = rate.val;
+    t.s.rname = rate.sym;
+    t.rate = rate.expr;
+    __parse_add(p, &t);
+}
+
+/* Parse the included file path, with ntree statements which are not
+   named rates, in the scope of p: its definitions and named rates are
+   added to those of p, which it sees in turn, and its statements are
+   spliced into p. A file which only defines subtrees and named rates
+   is parsed once in a scope, wherever it is included from, so that
+   they are not defined twice. */
+static void __parse_scope(htree_parse_t *p, const char *path, int ntree) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_link_t *b;
+    htree_parse_t q;
+    char *real;
+    int i;
+
+    if (!ntree && (real = realpath(path, NULL))) {
+        for (b = d->scoped; b && strcmp((char *) (b + 1), real);
+             b = b->next);
+        if (!b) {
+            b = (__parse_link_t *) __parse_alloc(p, strlen(real) + 1 +
+                                                 sizeof(__parse_link_t));
+            strcpy((char *) (b + 1), real);
+            b->next = d->scoped;
+            d->scoped = b;
+            b = NULL;
+        }
+        free(real);
+        if (b)
+            return;
+    }
+    memset(&q, 0, sizeof(htree_parse_t));
+    q.fname = path;
+    q.depth = p->depth + 1;
+    q.record = 1;
+    q.deps = p->deps;
+    q.incl = p->incl;
+    q.scope = p->scope ? p->scope : p;
+    q.defs = d;
+    if (init_lex(&q, (char *) path) < 0) {
+        p->errors++;
+        return;
+    }
+    if (htree_parse_scan(&q))
+        p->errors++;
+    for (i = 0; i < q.nstmts; i++)
+        __parse_emit(p, &q.stmts[i]);
+    p->defines += q.defines;
+
+    /* The definitions, and the included files held, are those of p. */
+    p->incl = q.incl;
+    q.incl = NULL;
+    q.defs = NULL;
+    final_lex(&q);
+}
+
+/* Splice the statements of the included file name (see "include.h").
+   Its named rates are named rates of p. */
+static void __parse_include(htree_parse_t *p, const char *name) {
+    const htree_stmt_t *s;
+    __parse_bstmt_t t;
+    __parse_exp_t x;
+    const char *r;
+    char *scope;
+    int i, n;
+
+    if (include_stmts(p, name, &s, &n, &scope) < 0) {
+        p->errors++;
+        return;
+    }
+    if (scope) {
+        __parse_scope(p, scope, n);
+        free(scope);
+        return;
+    }
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_STMT;
+    for (i = 0; i < n; i++) {
+        if ((s[i].skel == UNKNOWN) && !s[i].body) {
+            if (!(r = htree_intern(htree_parse_rt(p), s[i].name, 1))) {
+                p->errors++;
+                continue;
+            }
+            x.val = s[i].rate;
+            x.sym = s[i].rname;
+            x.expr = NULL;
+            __parse_rate(p, r, x);
+            continue;
+        }
+        t.s = s[i];
+        __parse_add(p, &t);
+    }
+}
+
+/* Open a block, of count repetitions or the body of a definition. */
+static void __parse_open(htree_parse_t *p, int count) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_block_t *b;
+
+    b = (__parse_block_t *) __parse_alloc(p, sizeof(__parse_block_t));
+    b->count = count;
+    if (d->nblocks == d->maxblocks) {
+        d->maxblocks = d->maxblocks ? 2*d->maxblocks : 8;
+        if (!(d->blocks = (__parse_block_t **)
+              realloc(d->blocks, sizeof(__parse_block_t *)*d->maxblocks))) {
+            fprintf(stderr, "[ out of memory ]\n");
+            exit(1);
+        }
+    }
+    d->blocks[d->nblocks++] = b;
+}
+
+/* Close the innermost block, which must describe one subtree: every
+   statement fills a child of a node which the previous ones left
+   open, and all of them are filled at the end. */
+static __parse_block_t *__parse_close(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_block_t *b = d->blocks[--d->nblocks];
+    int i, open = 1;
+
+    for (i = 0; (i < b->n) && (open > 0); i++) {
+        switch (b->v[i].kind) {
+        case BODY_STMT:
+            if ((b->v[i].s.skel == TASK) || (b->v[i].s.skel == UNKNOWN))
+                open -= (b->v[i].s.skel == TASK) ? 1 : b->v[i].s.n;
+            else
+                open += b->v[i].s.n - (b->v[i].s.name ? b->v[i].s.n : 0) - 1;
+            break;
+        case BODY_INST:
+            open--;
+            break;
+        case BODY_REPT:
+            open -= b->v[i].s.n;
+            break;
+        }
+    }
+    if (open || (i < b->n)) {
+        fprintf(stderr, "[ body of %s is not one subtree ]\n", name);
+        p->errors++;
+    }
+    return b;
+}
+
+/* Evaluate the expression e, with the arguments env: the operators
+   are applied to the constants they are given, and so fold them. */
+static __parse_exp_t __parse_eval(htree_parse_t *p, __parse_expr_t *e,
+                                  const __parse_exp_t *env) {
+    __parse_exp_t x;
+
+    switch (e->op) {
+    case 'c':
+        x.val = e->val;
+        x.sym = e->sym;
+        x.expr = NULL;
+        return x;
+    case 'p':
+        return env[e->param];
+    }
+    return __parse_op(p, e->op, __parse_eval(p, e->l, env),
+                      __parse_eval(p, e->r, env));
+}
+
+/* Build the statements of the block b, with the arguments env. */
+static htree_body_t *__parse_body(htree_parse_t *p, __parse_block_t *b,
+                                  const __parse_exp_t *env) {
+    htree_body_t *h;
+    __parse_bstmt_t *t;
+    __parse_exp_t *args, x;
+    int i, k;
+
+    h = (htree_body_t *) __parse_alloc(p, sizeof(htree_body_t));
+    h->stmts = (htree_stmt_t *) __parse_alloc(p, sizeof(htree_stmt_t)*b->n);
+    h->nstmts = b->n;
+    for (i = 0; i < b->n; i++) {
+        t = &b->v[i];
+        h->stmts[i] = t->s;
+        switch (t->kind) {
+        case BODY_STMT:
+            if (t->rate) {
+                x = __parse_eval(p, t->rate, env);
+                h->stmts[i].rate = x.val;
+                h->stmts[i].rname = x.sym;
+            }
+            break;
+        case BODY_INST:
+            args = (__parse_exp_t *) __parse_alloc(p, sizeof(__parse_exp_t)*
+                                                   (t->def->nparams + 1));
+            for (k = 0; k < t->def->nparams; k++)
+                args[k] = __parse_eval(p, t->args[k], env);
+            h->stmts[i].body = __parse_instantiate(p, t->def, args);
+            break;
+        case BODY_REPT:
+            h->stmts[i].body = __parse_body(p, t->block, env);
+            break;
+        }
+    }
+    return h;
+}
+
+/* Instances with the same arguments share their statements, and hence
+   their subtree. */
+htree_body_t *__parse_instantiate(htree_parse_t *p, __parse_def_t *f,
+                                  __parse_exp_t *args) {
+    __parse_inst_t *i;
+    int k;
+
+    for (i = f->insts; i; i = i->next) {
+        for (k = 0; (k < f->nparams) && (i->args[k].val == args[k].val) &&
+                 (i->args[k].sym == args[k].sym); k++);
+        if (k == f->nparams)
+            return i->body;
+    }
+    i = (__parse_inst_t *) __parse_alloc(p, sizeof(__parse_inst_t));
+    i->args = args;
+    i->body = __parse_body(p, f->body, args);
+    i->next = f->insts;
+    f->insts = i;
+    return i->body;
+}
+
+static void __parse_define(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = __parse_defs(p);
+
+    if (d->def || d->nblocks) {
+        fprintf(stderr, "[ definition of %s is not at the top ]\n", name);
+        p->errors++;
+    }
+    d->def = (__parse_def_t *) __parse_alloc(p, sizeof(__parse_def_t));
+    d->def->name = name;
+    p->defines++;
+    __parse_open(p, 0);
+}
+
+static void __parse_param(htree_parse_t *p, const char *name) {
+    __parse_def_t *f = ((__parse_defs_t *) p->defs)->def;
+    int k;
+
+    for (k = 0; k < f->nparams; k++)
+        if (f->params[k] == name) {
+            fprintf(stderr, "[ parameter %s of %s is repeated ]\n",
+                    name, f->name);
+            p->errors++;
+        }
+    __parse_room(p, (void **) &f->params, f->nparams, &f->maxparams,
+                 sizeof(const char *));
+    f->params[f->nparams++] = name;
+}
+
+static void __parse_defined(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_def_t *f = d->def, *g;
+
+    f->body = __parse_close(p, f->name);
+    for (g = d->defs; g && (g->name != f->name); g = g->next);
+    if (g) {
+        fprintf(stderr, "[ %s is defined twice ]\n", f->name);
+        p->errors++;
+    }
+    f->next = d->defs;
+    d->defs = f;
+    d->def = NULL;
+}
+
+static void __parse_repeat(htree_parse_t *p, int n) {
+    if (n < 1) {
+        fprintf(stderr, "[ repeat(%d) has no instance ]\n", n);
+        p->errors++;
+    }
+    __parse_open(p, n);
+}
+
+static void __parse_repeated(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_bstmt_t t;
+
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.block = __parse_close(p, "repeat");
+    t.kind = BODY_REPT;
+    t.s.skel = UNKNOWN;
+    t.s.n = t.block->count;
+    if (!d->nblocks)
+        t.s.body = __parse_body(p, t.block, NULL);
+    __parse_add(p, &t);
+}
+
+static void __parse_arg(htree_parse_t *p, __parse_exp_t x) {
+    __parse_defs_t *d = __parse_defs(p);
+
+    __parse_room(p, (void **) &d->args, d->nargs, &d->maxargs,
+                 sizeof(__parse_exp_t));
+    d->args[d->nargs++] = x;
+}
+
+static void __parse_instance(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_bstmt_t t;
+    __parse_def_t *f;
+    __parse_exp_t *args;
+    int k;
+
+    for (f = d->defs; f && (f->name != name); f = f->next);
+    if (!f || (f->nparams != d->nargs)) {
+        if (f)
+            fprintf(stderr, "[ %s takes %d arguments ]\n", name, f->nparams);
+        else
+            fprintf(stderr, "[ %s is not defined ]\n", name);
+        p->errors++;
+        d->nargs = 0;
+        return;
+    }
+    memset(&t, 0, sizeof(__parse_bstmt_t));
+    t.kind = BODY_INST;
+    t.def = f;
+    t.s.skel = UNKNOWN;
+    t.s.n = 1;
+
+    /* An instance in a block is built with the block, as its arguments
+       may refer to parameters. */
+    if (d->nblocks) {
+        t.args = (__parse_expr_t **) __parse_alloc(p, sizeof(__parse_expr_t *)*
+                                                   (f->nparams + 1));
+        for (k = 0; k < f->nparams; k++)
+            t.args[k] = d->args[k].expr ? d->args[k].expr
+                : __parse_op(p, 'c', d->args[k], d->args[k]).expr;
+    } else {
+        args = (__parse_exp_t *) __parse_alloc(p, sizeof(__parse_exp_t)*
+                                               (f->nparams + 1));
+        for (k = 0; k < f->nparams; k++)
+            args[k] = d->args[k];
+        t.s.body = __parse_instantiate(p, f, args);
+    }
+    d->nargs = 0;
+    __parse_add(p, &t);
+}
+
+/* Whether name is one of the identifiers of the generated model: the
+   processes t_N (and t_N_M), the activities comp_N and move_N_M, and
+   infty. */
+static int __parse_reserved(const char *name) {
+    static const char *prefix[] = { "t", "comp", "move" };
+    const char *c;
+    size_t k;
+    int i;
+
+    if (!strcmp(name, "infty"))
+        return 1;
+    for (i = 0; i < 3; i++) {
+        k = strlen(prefix[i]);
+        if (strncmp(name, prefix[i], k))
+            continue;
+        for (c = name + k; (c[0] == '_') && (c[1] >= '0') && (c[1] <= '9');)
+            for (c++; (*c >= '0') && (*c <= '9'); c++);
+        if ((c != name + k) && !*c)
+            return 1;
+    }
+    return 0;
+}
+
+/* Define the named rate name, at the top of the description: it is
+   inserted into the tree as a statement (see htree_stmt()), so that
+   the rate is defined in the model, and recorded as the statements
+   of included files are. */
+static void __parse_rate(htree_parse_t *p, const char *name,
+                         __parse_exp_t x) {
+    __parse_defs_t *d = __parse_defs(p);
+    __parse_rate_t *r;
+    htree_stmt_t s;
+
+    if (d->def || d->nblocks) {
+        fprintf(stderr, "[ rate %s is not at the top ]\n", name);
+        p->errors++;
+        return;
+    }
+    if (__parse_reserved(name)) {
+        fprintf(stderr, "[ rate %s is a name of the generated model ]\n",
+                name);
+        p->errors++;
+        return;
+    }
+    for (r = d->rates; r && (r->name != name); r = r->next);
+    if (r) {
+        fprintf(stderr, "[ rate %s is defined twice ]\n", name);
+        p->errors++;
+        return;
+    }
+    r = (__parse_rate_t *) __parse_alloc(p, sizeof(__parse_rate_t));
+    r->name = name;
+    r->x = x;
+    r->next = d->rates;
+    d->rates = r;
+    memset(&s, 0, sizeof(htree_stmt_t));
+    s.skel = UNKNOWN;
+    s.name = name;
+    s.rate = x.val;
+    s.rname = x.sym;
+    __parse_emit(p, &s);
+}
+
+static __parse_exp_t __parse_const(double val) {
+    __parse_exp_t x;
+
+    x.val = val;
+    x.sym = NULL;
+    x.expr = NULL;
+    return x;
+}
+
+static __parse_exp_t __parse_name(htree_parse_t *p, const char *name) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_exp_t x = __parse_const(0.0);
+    __parse_rate_t *r;
+    int k;
+
+    if (d && d->def)
+        for (k = 0; k < d->def->nparams; k++)
+            if (d->def->params[k] == name) {
+                x.expr = (__parse_expr_t *)
+                    __parse_alloc(p, sizeof(__parse_expr_t));
+                x.expr->op = 'p';
+                x.expr->param = k;
+                return x;
+            }
+
+    /* A named rate is kept by name. */
+    for (r = d ? d->rates : NULL; r; r = r->next)
+        if (r->name == name) {
+            x.val = r->x.val;
+            x.sym = name;
+            return x;
+        }
+    fprintf(stderr, "[ %s is not defined ]\n", name);
+    p->errors++;
+    return x;
+}
+
+/* Write the operand a into the n bytes of s, in parentheses unless it
+   is a name or a constant which is not negative. Returns its length,
+   as snprintf() does. */
+static int __parse_operand(char *s, size_t n, __parse_exp_t a) {
+    if (!a.sym)
+        return snprintf(s, n, (a.val < 0.0) ? "(%f)" : "%f", a.val);
+    return snprintf(s, n, strpbrk(a.sym, "+-*/") ? "(%s)" : "%s", a.sym);
+}
+
+/* The value over named rates of a op b, of which one at least refers
+   to named rates. */
+static const char *__parse_symbol(htree_parse_t *p, int op,
+                                  __parse_exp_t a, __parse_exp_t b) {
+    const char *r;
+    char *s;
+    int k, n;
+
+    if (op == 'n')
+        n = 1 + __parse_operand(NULL, 0, a);
+    else
+        n = __parse_operand(NULL, 0, a) + 1 + __parse_operand(NULL, 0, b);
+    if (!(s = (char *) malloc(n + 1))) {
+        fprintf(stderr, "[ out of memory ]\n");
+        exit(1);
+    }
+    if (op == 'n') {
+        s[0] = '-';
+        __parse_operand(s + 1, n, a);
+    } else {
+        k = __parse_operand(s, n + 1, a);
+        s[k] = op;
+        __parse_operand(s + k + 1, n - k, b);
+    }
+    if (!(r = htree_intern(htree_parse_rt(p), s, 1)))
+        p->errors++;
+    free(s);
+    return r;
+}
+
+/* Apply the operator op to a and b; constants are folded as they
+   were before expressions could refer to parameters, and keep their
+   value over named rates. PEPA has no powers, so a power of named
+   rates is an error. Op 'c' makes a constant expression of a. */
+static __parse_exp_t __parse_op(htree_parse_t *p, int op, __parse_exp_t a,
+                                __parse_exp_t b) {
+    __parse_exp_t x;
+
+    if ((op != 'c') && !a.expr && !b.expr) {
+        switch (op) {
+        case '+': x = __parse_const(a.val + b.val); break;
+        case '-': x = __parse_const(a.val - b.val); break;
+        case '*': x = __parse_const(a.val * b.val); break;
+        case '/': x = __parse_const(a.val / b.val); break;
+        case 'n': x = __parse_const(-a.val); break;
+        default:
+            x = __parse_const(pow(a.val, b.val));
+            if (a.sym || b.sym) {
+                fprintf(stderr, "[ %s cannot be raised to a power ]\n",
+                        a.sym ? a.sym : b.sym);
+                p->errors++;
+            }
+            return x;
+        }
+        if (a.sym || b.sym)
+            x.sym = __parse_symbol(p, op, a, b);
+        return x;
+    }
+    x.val = 0.0;
+    x.sym = NULL;
+    x.expr = (__parse_expr_t *) __parse_alloc(p, sizeof(__parse_expr_t));
+    x.expr->op = op;
+    x.expr->val = a.val;
+    x.expr->sym = a.sym;
+    if (op != 'c') {
+        x.expr->l = a.expr ? a.expr : __parse_op(p, 'c', a, a).expr;
+        x.expr->r = b.expr ? b.expr : __parse_op(p, 'c', b, b).expr;
+    }
+    return x;
+}
+
+/* For a description of the following function, see "pepa.h". */
+void htree_parse_free(htree_parse_t *p) {
+    __parse_defs_t *d = (__parse_defs_t *) p->defs;
+    __parse_link_t *b;
+
+    include_release(p);
+    if (!d)
+        return;
+    while ((b = d->pool)) {
+        d->pool = b->next;
+        free(b);
+    }
+    free(d->blocks);
+    free(d);
+    p->defs = NULL;
+}
+
+/* For a description of the following function, see "pepa.h". */
+int htree_parse(htree_parse_t *p, char *fname) {
+    struct stat st;
+
+    memset(p, 0, sizeof(htree_parse_t));
+    p->fname = fname;
+    if (bin_is_tree(fname)) {
+        if (bin_load(&p->rt, fname) < 0) {
+            fprintf(stderr, "[ invalid precompiled tree %s ]\n", fname);
+            return -1;
+        }
+        return 0;
+    }
+    if (!stat(fname, &st) && S_ISREG(st.st_mode) &&
+        (chunk_count(st.st_size, nthreads) > 1))
+        return chunk_parse(p, fname, nthreads);
+    if (init_lex(p, fname) < 0)
+        return -1;
+    return htree_parse_scan(p);
+}
+
+int htree_parse_scan(htree_parse_t *p) {
+    return (yyparse(p->scanner) || p->errors) ? 1 : 0;
 }
 
 int main(int argc, char *argv[]) {
+    htree_parse_t parse;
     int c;
 
+    report_file = stdout;
     while(1) {
-        c = getopt(argc, argv, "aghlo");
+        c = getopt(argc, argv, "aBbC:cD:defgHhj:klMmO:oPrSsT:tU:w:xY");
         if (c == -1)
             break;
 
         switch(c) {
+        case 'B':
+            binary = 1;
+            break;
+        case 'b':
+            bounds = 1;
+            break;
+        case 'C':
+            cache = optarg;
+            break;
+        case 'c':
+            compose = 1;
+            break;
+        case 'D':
+            store = optarg;
+            solve = 1;
+            break;
+        case 'd':
+            decompose = 1;
+            break;
+        case 'e':
+            lump = 2;
+            solve = 1;
+            break;
+        case 'f':
+            fluid = 1;
+            break;
         case 'g':
             graph = 1;
             break;
+        case 'H':
+            compaction = CTMC_HASH;
+            solve = 1;
+            break;
         case 'h':
             fprintf(stderr,
                     "Usage: wflow2pepa [OPTIONS] <file>\n\n"
                     "Options:\n"
                     "  -a  Generate complete (graph, latex, ps etc.).\n"
+                    "  -B  Write the committed tree into a precompiled\n"
+                    "        tree (.htree), which can be given as input.\n"
+                    "  -b  Bound the throughput of every subtree.\n"
+                    "  -C DIR[:SIZE]  Keep the generated models and their\n"
+                    "        reports in the cache DIR, of at most SIZE\n"
+                    "        bytes (k, M or G; default 256M), and reuse\n"
+                    "        them for the same tree and options.\n"
+                    "  -c  Solve the tree compositionally.\n"
+                    "  -D DIR  Keep the CTMC in memory-mapped files in\n"
+                    "        DIR, and resume its solution from there.\n"
+                    "  -d  Approximate a long pipe by decomposition.\n"
+                    "  -e  Aggregate the CTMC by exact lumpability.\n"
+                    "  -f  Solve the fluid (ODE) approximation.\n"
                     "  -g  Generate dot graph.\n"
+                    "  -H  Derive the CTMC with hash compaction.\n"
                     "  -h  Show this help message.\n"
+                    "  -j N  Use N threads (default: all processors).\n"
+                    "  -k  Aggregate the CTMC by ordinary lumpability.\n"
                     "  -l  Generate LaTeX source file.\n"
-                    "  -o  Output into a file.\n\n"
+                    "  -M  Compare the memory taken per state by the ways\n"
+                    "        of storing the visited states.\n"
+                    "  -m  Estimate measures by stochastic simulation.\n"
+                    "  -O N  Choose the widths of deals and farms for the\n"
+                    "        best throughput with N tasks (-c to solve\n"
+                    "        candidates compositionally).\n"
+                    "  -o  Output into a file.\n"
+                    "  -P  End-to-end latency distribution of a job.\n"
+                    "  -r  Reduce identical farm branches by symmetry.\n"
+                    "  -S  Sensitivity of the throughput to every rate.\n"
+                    "  -s  Solve the underlying CTMC.\n"
+                    "  -t  Write throughputs and utilisations (.csv).\n"
+                    "  -T L  Transient throughput at time points L, given\n"
+                    "        as t1,t2,... or as horizon/points.\n"
+                    "  -U S  Serve models on request over the Unix domain\n"
+                    "        socket S, on -j worker threads (see\n"
+                    "        \"server.h\" for the requests).\n"
+                    "  -w S  Solve for every point of a sweep of task\n"
+                    "        rates, given as a=1:5:5,b=2:4:3 (grid),\n"
+                    "        lhs=20,a=1:5 (Latin hypercube) or @file.\n"
+                    "  -x  Process the inputs as a batch, on -j worker\n"
+                    "        threads: description files, directories\n"
+                    "        of them, or @list files (implies -o).\n"
+                    "  -Y  Derive the CTMC with its states in a decision\n"
+                    "        diagram.\n\n"
                     "Copyright 2006 Enhance Project\n"
                     "University of Edinburgh, United Kingdom\n"
                     "Contact: Gagarine Yaikhom (g.yaikhom@inf.ed.ac.uk)\n");
             exit(0);
+        case 'j':
+            nthreads = atoi(optarg);
+            break;
+        case 'k':
+            lump = 1;
+            solve = 1;
+            break;
         case 'l':
             latex = 1;
             break;
+        case 'M':
+            storage = 1;
+            break;
+        case 'm':
+            simulate = 1;
+            break;
+        case 'O':
+            budget = atoi(optarg);
+            break;
         case 'o':
             output = 1;
             break;
+        case 'P':
+            passage = 1;
+            solve = 1;
+            break;
+        case 'r':
+            symmetry = 1;
+            solve = 1;
+            break;
+        case 'S':
+            sensitivity = 1;
+            solve = 1;
+            break;
+        case 's':
+            solve = 1;
+            break;
+        case 'T':
+            transient = optarg;
+            solve = 1;
+            break;
+        case 't':
+            measures = 1;
+            solve = 1;
+            break;
+        case 'U':
+            server = optarg;
+            break;
+        case 'w':
+            sweep = optarg;
+            break;
+        case 'x':
+            batch = 1;
+            output = 1;
+            break;
+        case 'Y':
+            compaction = CTMC_MDD;
+            solve = 1;
+            break;
         case 'a':
             graph = 1;
             latex = 1;
@@ -132,15 +1091,30 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (cache && (cache_open(cache) < 0))
+        exit(1);
+    if (server) {
+        c = htree_serve(server, nthreads);
+        include_final();
+        exit(c ? 1 : 0);
+    }
     if (optind >= argc) {
         printf("ERROR: No input file.\n");
         exit(1);
     }
+    if (batch) {
+        c = htree_batch(argv + optind, argc - optind, nthreads);
+        include_final();
+        exit(c ? 1 : 0);
+    }
     fname = strdup(argv[optind]);
     *(strrchr(fname, '.') + 1) = '\0';
-    init_lex(argv[optind]);
-    yyparse();
-    final_lex();
-    generate();
+    if (htree_parse(&parse, argv[optind]))
+        exit(1);
+    __htree_rt = parse.rt;
+    c = generate();
+    final_lex(&parse);
+    include_final();
     free(fname);
+    return c ? 1 : 0;
 }
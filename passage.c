@@ -0,0 +1,535 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which compute the end-to-end
+  latency distribution of a job by passage time analysis. The
+  Laplace transform of the passage time density is the solution of
+  a complex linear system for every value of s; the distribution is
+  then found by numerical inversion with the Euler method of Abate
+  and Whitt, which needs the transform at a fixed set of s-points for
+  every time point. These systems are independent, so they are
+  shared among threads.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "passage.h"
+
+typedef struct {
+    passage_t *p;           /* Passage chain. */
+    double complex *s, *f;  /* Points and values of the transform. */
+    int ns;                 /* Number of points. */
+    int next;               /* Next point to solve. */
+    int error;              /* Set if a system did not converge. */
+    pthread_mutex_t lock;   /* Protects next and error. */
+} __passage_work_t;
+
+/* Find a passage state, inserting it if it is new. */
+static int __passage_index(passage_t *p, int s, int g);
+
+/* Solve for the transform at one point; h has room for 2n values. */
+static int __passage_solve(passage_t *p, double complex s,
+                           double complex *h, double complex *f);
+
+/* Thread body: solves points until there are none left. */
+static void *__passage_worker(void *arg);
+
+
+static unsigned int __passage_hash(int s, int g) {
+    return (unsigned int) s*2654435761u ^ (unsigned int) (g + 1)*40503u;
+}
+
+static int __passage_rehash(passage_t *p, int size) {
+    int *h, i, k;
+
+    if (!(h = (int *) malloc(sizeof(int)*size)))
+        return -1;
+    for (i = 0; i < size; i++)
+        h[i] = -1;
+    for (i = 0; i < p->n; i++) {
+        k = __passage_hash(p->state[i], p->tag[i]) & (size - 1);
+        while (h[k] >= 0)
+            k = (k + 1) & (size - 1);
+        h[k] = i;
+    }
+    free(p->hash);
+    p->hash = h;
+    p->hsize = size;
+    return 0;
+}
+
+int __passage_index(passage_t *p, int s, int g) {
+    unsigned int k;
+    int *x, *y, c;
+    double *a;
+
+    k = __passage_hash(s, g) & (p->hsize - 1);
+    while (p->hash[k] >= 0) {
+        if ((p->state[p->hash[k]] == s) && (p->tag[p->hash[k]] == g))
+            return p->hash[k];
+        k = (k + 1) & (p->hsize - 1);
+    }
+    if ((p->n & (p->n - 1)) == 0 && p->n >= 16) {
+        /* Capacity is kept at powers of two. */
+        c = 2*p->n;
+        if (!(x = (int *) realloc(p->state, sizeof(int)*c)))
+            return -1;
+        p->state = x;
+        if (!(y = (int *) realloc(p->tag, sizeof(int)*c)))
+            return -1;
+        p->tag = y;
+        if (!(a = (double *) realloc(p->alpha, sizeof(double)*c)))
+            return -1;
+        p->alpha = a;
+    }
+    p->state[p->n] = s;
+    p->tag[p->n] = g;
+    p->alpha[p->n] = 0.0;
+    p->hash[k] = p->n++;
+    if (2*p->n > p->hsize)
+        if (__passage_rehash(p, 2*p->hsize) < 0)
+            return -1;
+    return p->n - 1;
+}
+
+/* A sink task never sends: its jobs leave the system. */
+static int __passage_is_sink(ctmc_t *m, int i) {
+    int k;
+
+    for (k = 0; k < m->leaf[i].nsteps; k++)
+        if (m->leaf[i].steps[k].act == ACT_OUT)
+            return 0;
+    return 1;
+}
+
+/* Add a transition from passage state a to b. */
+static int __passage_trans(passage_t *p, int a, int b, double r) {
+    int k, *z;
+    double *y;
+
+    for (k = p->row[a]; k < p->ntrans; k++)
+        if (p->col[k] == b) {
+            p->val[k] += r;
+            return 0;
+        }
+    if (p->ntrans == p->maxtrans) {
+        if (!(z = (int *) realloc(p->col, sizeof(int)*2*p->maxtrans)))
+            return -1;
+        p->col = z;
+        if (!(y = (double *) realloc(p->val,
+                                     sizeof(double)*2*p->maxtrans)))
+            return -1;
+        p->val = y;
+        p->maxtrans *= 2;
+    }
+    p->col[p->ntrans] = b;
+    p->val[p->ntrans++] = r;
+    return 0;
+}
+
+/* For a description of the following function, see "passage.h". */
+passage_t *passage_derive(ctmc_t *m) {
+    passage_t *p;
+    double r, sum = 0.0, *y;
+    int s, i, j, a, b, t, cap = 0, *z;
+
+    if (!m->pi || m->ngroups)
+        return NULL;
+    if (!(p = (passage_t *) calloc(1, sizeof(passage_t))))
+        return NULL;
+    p->m = m;
+    p->maxtrans = 4096;
+    if (!(p->state = (int *) malloc(sizeof(int)*16)) ||
+        !(p->tag = (int *) malloc(sizeof(int)*16)) ||
+        !(p->alpha = (double *) malloc(sizeof(double)*16)) ||
+        !(p->col = (int *) malloc(sizeof(int)*p->maxtrans)) ||
+        !(p->val = (double *) malloc(sizeof(double)*p->maxtrans)) ||
+        (__passage_rehash(p, 1024) < 0))
+        goto fail;
+
+    /* Jobs are started whenever a source hands one over, and starts
+       the next; the flow of these events at steady state gives the
+       distribution of the passage states in which jobs start. */
+    for (s = 0; s < m->nstates; s++) {
+        if (m->pi[s] == 0.0)
+            continue;
+        for (i = 0; i < m->nleaves; i++) {
+            m->tag = CTMC_ARMED;
+            if (ctmc_fire(m, s, i, 0.0) < 0)
+                goto fail;
+            r = m->pi[s]*m->leaf[i].rate;
+            for (j = 0; j < m->nout; j++) {
+                if (m->outt[j] < 0)
+                    continue;
+                if (((t = ctmc_find(m, m->outv + j*m->nleaves)) < 0) ||
+                    ((a = __passage_index(p, t, m->outt[j])) < 0))
+                    goto fail;
+                p->alpha[a] += r*m->outp[j];
+                sum += r*m->outp[j];
+            }
+        }
+    }
+    if (sum == 0.0) {
+        fprintf(report_file, "No job reaches a source task.\n");
+        goto fail;
+    }
+    for (a = 0; a < p->n; a++)
+        p->alpha[a] /= sum;
+
+    /* Breadth first exploration of the passage states. */
+    for (a = 0; a < p->n; a++) {
+        if (cap < p->n + 1) {
+            cap = 2*p->n + 1;
+            if (!(z = (int *) realloc(p->row, sizeof(int)*(cap + 1))))
+                goto fail;
+            p->row = z;
+            if (!(y = (double *) realloc(p->out, sizeof(double)*cap)))
+                goto fail;
+            p->out = y;
+            if (!(y = (double *) realloc(p->absorb, sizeof(double)*cap)))
+                goto fail;
+            p->absorb = y;
+        }
+        p->row[a] = p->ntrans;
+        p->out[a] = p->absorb[a] = 0.0;
+        s = p->state[a];
+        for (i = 0; i < m->nleaves; i++) {
+            if (m->leaf[i].steps[m->state[s*m->nleaves + i]].act
+                != ACT_COMP)
+                continue;
+            r = m->leaf[i].rate;
+            if ((i == p->tag[a]) && __passage_is_sink(m, i)) {
+                p->absorb[a] += r;
+                p->out[a] += r;
+                continue;
+            }
+            m->tag = p->tag[a];
+            if (ctmc_fire(m, s, i, 0.0) < 0)
+                goto fail;
+            for (j = 0; j < m->nout; j++) {
+                if (((t = ctmc_find(m, m->outv + j*m->nleaves)) < 0) ||
+                    ((b = __passage_index(p, t, m->outt[j])) < 0))
+                    goto fail;
+                if (b == a)
+                    continue;
+                if (__passage_trans(p, a, b, r*m->outp[j]) < 0)
+                    goto fail;
+                p->out[a] += r*m->outp[j];
+            }
+        }
+    }
+    if (!p->row)
+        goto fail;
+    p->row[p->n] = p->ntrans;
+    m->tag = CTMC_NOTAG;
+    return p;
+
+ fail:
+    m->tag = CTMC_NOTAG;
+    passage_destroy(p);
+    return NULL;
+}
+
+/* For a description of the following function, see "passage.h". The
+   mean time to absorption x satisfies out x - Q x = 1. */
+double passage_mean(passage_t *p) {
+    double *x, y, d, mean = 0.0;
+    int i, k, it;
+
+    if (!(x = (double *) calloc(p->n, sizeof(double))))
+        return -1.0;
+    for (it = 0; it < PASSAGE_MAXITER; it++) {
+        for (d = 0.0, i = 0; i < p->n; i++) {
+            if (p->out[i] == 0.0)
+                continue;
+            for (y = 1.0, k = p->row[i]; k < p->row[i + 1]; k++)
+                y += p->val[k]*x[p->col[k]];
+            y /= p->out[i];
+            if (fabs(y - x[i]) > d*fabs(y))
+                d = fabs(y - x[i])/fabs(y);
+            x[i] = y;
+        }
+        if (d < PASSAGE_TOLERANCE)
+            break;
+    }
+    for (i = 0; i < p->n; i++)
+        mean += p->alpha[i]*x[i];
+    free(x);
+    return (it < PASSAGE_MAXITER) ? mean : -1.0;
+}
+
+/* Gauss-Seidel iterations for (s + out) h - Q h = absorb. The system
+   is diagonally dominant for Re(s) > 0. The inverse of the diagonal
+   is computed once, and the 1-norm is used for the convergence test,
+   as complex division and modulus dominate the inner loop otherwise. */
+int __passage_solve(passage_t *p, double complex s, double complex *h,
+                    double complex *f) {
+    double complex y, *inv = h + p->n;
+    double d, n, e;
+    int i, k, it;
+
+    for (i = 0; i < p->n; i++) {
+        inv[i] = 1.0/(s + p->out[i]);
+        h[i] = p->absorb[i]*inv[i];
+    }
+    for (it = 0; it < PASSAGE_MAXITER; it++) {
+        for (d = 0.0, n = 0.0, i = 0; i < p->n; i++) {
+            for (y = p->absorb[i], k = p->row[i]; k < p->row[i + 1]; k++)
+                y += p->val[k]*h[p->col[k]];
+            y *= inv[i];
+            e = fabs(creal(y - h[i])) + fabs(cimag(y - h[i]));
+            if (e > d)
+                d = e;
+            e = fabs(creal(y)) + fabs(cimag(y));
+            if (e > n)
+                n = e;
+            h[i] = y;
+        }
+        if (d <= PASSAGE_TOLERANCE*n)
+            break;
+    }
+    for (*f = 0.0, i = 0; i < p->n; i++)
+        *f += p->alpha[i]*h[i];
+    return (it < PASSAGE_MAXITER) ? it : -1;
+}
+
+void *__passage_worker(void *arg) {
+    __passage_work_t *w = (__passage_work_t *) arg;
+    double complex *h;
+    int i;
+
+    h = (double complex *) malloc(sizeof(double complex)*2*w->p->n);
+    if (!h) {
+        pthread_mutex_lock(&w->lock);
+        w->error = 1;
+        pthread_mutex_unlock(&w->lock);
+        return NULL;
+    }
+    while (1) {
+        pthread_mutex_lock(&w->lock);
+        i = (w->error || (w->next >= w->ns)) ? -1 : w->next++;
+        pthread_mutex_unlock(&w->lock);
+        if (i < 0)
+            break;
+        if (__passage_solve(w->p, w->s[i], h, &w->f[i]) < 0) {
+            pthread_mutex_lock(&w->lock);
+            w->error = 1;
+            pthread_mutex_unlock(&w->lock);
+        }
+    }
+    free(h);
+    return NULL;
+}
+
+/* For a description of the following function, see "passage.h". */
+int passage_laplace(passage_t *p, double complex *s, double complex *f,
+                    int ns, int nthreads) {
+    __passage_work_t w;
+    pthread_t *tid;
+    int i, n = 0;
+
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads > ns)
+        nthreads = ns;
+    if (nthreads < 1)
+        nthreads = 1;
+    memset(&w, 0, sizeof(__passage_work_t));
+    w.p = p;
+    w.s = s;
+    w.f = f;
+    w.ns = ns;
+    pthread_mutex_init(&w.lock, NULL);
+    if (!(tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads))) {
+        pthread_mutex_destroy(&w.lock);
+        return -1;
+    }
+    for (i = 1; i < nthreads; i++) {
+        if (pthread_create(&tid[i], NULL, __passage_worker, &w))
+            break;
+        n++;
+    }
+    __passage_worker(&w);
+    for (i = 1; i <= n; i++)
+        pthread_join(tid[i], NULL);
+    pthread_mutex_destroy(&w.lock);
+    free(tid);
+    return w.error ? -1 : 0;
+}
+
+/* For a description of the following function, see "passage.h". The
+   distribution is the inverse transform of F(s)/s; the alternating
+   series of the Bromwich integral is accelerated by averaging its
+   last M+1 partial sums with binomial weights. */
+int passage_cdf(passage_t *p, double *t, double *f, int nt, int nthreads) {
+    const int nk = PASSAGE_EULER_N + PASSAGE_EULER_M + 1;
+    double complex *s, *l;
+    double a, sum, part, c;
+    int i, k, j;
+
+    s = (double complex *) malloc(sizeof(double complex)*nt*nk);
+    l = (double complex *) malloc(sizeof(double complex)*nt*nk);
+    if (!s || !l) {
+        free(s);
+        free(l);
+        return -1;
+    }
+    for (i = 0; i < nt; i++)
+        for (k = 0; k < nk; k++)
+            s[i*nk + k] = (PASSAGE_EULER_A + 2.0*M_PI*k*I)/(2.0*t[i]);
+    if (passage_laplace(p, s, l, nt*nk, nthreads) < 0) {
+        free(s);
+        free(l);
+        return -1;
+    }
+    for (i = 0; i < nt; i++) {
+        a = exp(PASSAGE_EULER_A/2.0)/t[i];
+        for (f[i] = 0.0, part = 0.0, k = 0; k < nk; k++) {
+            sum = creal(l[i*nk + k]/s[i*nk + k]);
+            part += a*((k == 0) ? 0.5 : ((k % 2) ? -1.0 : 1.0))*sum;
+            if (k >= PASSAGE_EULER_N) {
+                /* Binomial weight C(M, j)/2^M. */
+                j = k - PASSAGE_EULER_N;
+                for (c = 1.0, sum = 0; sum < j; sum++)
+                    c *= (PASSAGE_EULER_M - sum)/(sum + 1);
+                f[i] += c*ldexp(part, -PASSAGE_EULER_M);
+            }
+        }
+        if (f[i] < 0.0)
+            f[i] = 0.0;
+        if (f[i] > 1.0)
+            f[i] = 1.0;
+    }
+    free(s);
+    free(l);
+    return 0;
+}
+
+void passage_destroy(passage_t *p) {
+    if (!p)
+        return;
+    free(p->state);
+    free(p->tag);
+    free(p->hash);
+    free(p->row);
+    free(p->col);
+    free(p->val);
+    free(p->out);
+    free(p->absorb);
+    free(p->alpha);
+    free(p);
+}
+
+int htree_passage(ctmc_t *m) {
+    static const double q[] = { 0.5, 0.99, 0.999 };
+    static const char *name[] = { "p50", "p99", "p999" };
+    const int nq = sizeof(q)/sizeof(q[0]);
+    passage_t *p = NULL;
+    ctmc_t *full = NULL;
+    double mean, tmax, t[PASSAGE_GRID], f[PASSAGE_GRID];
+    double lo[3], hi[3], flo[3], fhi[3], x[3], y[3];
+    int i, j, k, side[3];
+
+    /* A tagged job tells identical branches apart, so the chain is
+       derived again without symmetry reduction. */
+    if (m->ngroups) {
+        if (!(full = ctmc_derive(__htree_rt.htree, __htree_rt.sstab,
+                              __htree_rt.nleaves, 0)) ||
+            (ctmc_solve(full, CTMC_TOLERANCE, CTMC_MAXITER) < 0)) {
+            fprintf(report_file,
+                    "Could not solve the CTMC without symmetry.\n");
+            ctmc_destroy(full);
+            return -1;
+        }
+        m = full;
+    }
+    if (!(p = passage_derive(m))) {
+        fprintf(report_file, "Could not derive the passage chain.\n");
+        ctmc_destroy(full);
+        return -1;
+    }
+    fprintf(report_file, "Passage: %d states, %d transitions.\n", p->n,
+            p->ntrans);
+    if ((mean = passage_mean(p)) <= 0.0) {
+        fprintf(report_file, "Passage time did not converge.\n");
+        goto fail;
+    }
+    fprintf(report_file, "Latency: mean %f\n", mean);
+
+    /* Find a horizon beyond the largest percentile. */
+    for (tmax = 4.0*mean, i = 0; i < 16; i++, tmax *= 2.0) {
+        if (passage_cdf(p, &tmax, f, 1, nthreads) < 0)
+            goto fail;
+        if (f[0] > 1.0 - (1.0 - q[nq - 1])/2.0)
+            break;
+    }
+    for (i = 0; i < PASSAGE_GRID; i++)
+        t[i] = tmax*(i + 1)/PASSAGE_GRID;
+    if (passage_cdf(p, t, f, PASSAGE_GRID, nthreads) < 0)
+        goto fail;
+
+    /* Bracket every percentile in the grid, and narrow the brackets
+       by false position (Illinois variant). The percentiles are
+       refined together, so that their transforms form one batch. */
+    for (j = 0; j < nq; j++) {
+        for (i = 0; (i < PASSAGE_GRID - 1) && (f[i] < q[j]); i++)
+            ;
+        lo[j] = i ? t[i - 1] : 0.0;
+        flo[j] = i ? f[i - 1] : 0.0;
+        hi[j] = t[i];
+        fhi[j] = f[i];
+        side[j] = 0;
+    }
+    for (k = 0; k <= PASSAGE_REFINE; k++) {
+        for (j = 0; j < nq; j++)
+            x[j] = (fhi[j] > flo[j]) ?
+                lo[j] + (hi[j] - lo[j])*(q[j] - flo[j])/(fhi[j] - flo[j]) :
+                hi[j];
+        if (k == PASSAGE_REFINE)
+            break;
+        if (passage_cdf(p, x, y, nq, nthreads) < 0)
+            goto fail;
+        for (j = 0; j < nq; j++) {
+            if (y[j] < q[j]) {
+                lo[j] = x[j];
+                flo[j] = y[j];
+                if (side[j] < 0)
+                    fhi[j] = q[j] + (fhi[j] - q[j])/2.0;
+                side[j] = -1;
+            } else {
+                hi[j] = x[j];
+                fhi[j] = y[j];
+                if (side[j] > 0)
+                    flo[j] = q[j] - (q[j] - flo[j])/2.0;
+                side[j] = 1;
+            }
+        }
+    }
+    for (j = 0; j < nq; j++)
+        fprintf(report_file, "Latency: %s %f\n", name[j], x[j]);
+    passage_destroy(p);
+    ctmc_destroy(full);
+    return 0;
+
+ fail:
+    if (mean > 0.0)
+        fprintf(report_file, "Could not invert the Laplace transform.\n");
+    passage_destroy(p);
+    ctmc_destroy(full);
+    return -1;
+}
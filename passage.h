@@ -0,0 +1,80 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to compute the distribution of the end-to-end latency of a
+  job, i.e. the passage time from the moment a source task starts it
+  (the job comes from SOURCE_MEM) until a sink task completes it (the
+  job goes to SINK_MEM). The functions are defined in "passage.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_PASSAGE_H
+#define __PEPA_PASSAGE_H
+
+#include <complex.h>
+#include "ctmc.h"
+
+#define PASSAGE_TOLERANCE 1e-10 /* Convergence criterion. */
+#define PASSAGE_MAXITER 100000  /* Max. Gauss-Seidel iterations. */
+#define PASSAGE_EULER_A 18.4    /* Discretisation error e^-A. */
+#define PASSAGE_EULER_N 15      /* Terms before Euler summation. */
+#define PASSAGE_EULER_M 11      /* Terms of the Euler summation. */
+#define PASSAGE_GRID 16         /* Time points of the first pass. */
+#define PASSAGE_REFINE 4        /* False position steps. */
+
+/* A job is followed by tagging it: the state of the passage chain is
+   a state of the CTMC together with the task which holds the tagged
+   job. The job follows the moves of the task holding it, and leaves
+   the chain when the sink task which holds it completes. */
+typedef struct {
+    ctmc_t *m;              /* Underlying CTMC (solved). */
+    int n;                  /* Number of passage states. */
+    int *state;             /* CTMC state of every passage state, */
+    int *tag;               /* and the task holding the job. */
+    int hsize, *hash;       /* Hash table of the passage states. */
+    int ntrans, maxtrans;   /* Transitions between passage states, */
+    int *row, *col;         /* in compressed row format. */
+    double *val;
+    double *out;            /* Total exit rate of every state. */
+    double *absorb;         /* Rate at which the job completes. */
+    double *alpha;          /* States in which jobs are started. */
+} passage_t;                /* Passage time chain. */
+
+/* Build the passage chain of a solved CTMC, without symmetry
+   reduction. Jobs start in proportion to the steady state flow of
+   the moves by which the sources hand them over. */
+extern passage_t *passage_derive(ctmc_t *m);
+
+/* Mean passage time. Returns a negative value on failure. */
+extern double passage_mean(passage_t *p);
+
+/* Evaluate the Laplace transform of the passage time density at the
+   ns points s[], using nthreads threads (all processors if < 1).
+   Returns -1 if a linear system could not be solved. */
+extern int passage_laplace(passage_t *p, double complex *s,
+                           double complex *f, int ns, int nthreads);
+
+/* Passage time distribution at the nt times t[], by Euler inversion
+   of the Laplace transform. */
+extern int passage_cdf(passage_t *p, double *t, double *f, int nt,
+                       int nthreads);
+
+/* Deallocate the passage chain. */
+extern void passage_destroy(passage_t *p);
+
+/* Compute and display the mean and the percentiles of the end-to-end
+   latency of the committed skeleton hierarchy tree. */
+extern int htree_passage(ctmc_t *m);
+
+#endif /* __PEPA_PASSAGE_H */
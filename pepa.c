@@ -26,6 +26,18 @@
 #include <sys/wait.h>
 #include <unistd.h>
 #include "pepa.h"
+#include "ctmc.h"
+#include "fluid.h"
+#include "bounds.h"
+#include "decomp.h"
+#include "comp.h"
+#include "sweep.h"
+#include "opt.h"
+#include "store.h"
+#include "mdd.h"
+#include "ssa.h"
+#include "bin.h"
+#include "cache.h"
 
 /* This list all the skeleton or pattern names that are currently
    supported in the description file. Please check the lexical
@@ -45,10 +57,17 @@ struct __htree_rt_s __htree_rt;
 
 /* These are the flags which affect the application behaviour. */
 int graph = 0, latex = 0, output = 0, complete = 0;
+int solve = 0, symmetry = 0, lump = 0, fluid = 0;
+int simulate = 0, nthreads = 0, measures = 0, passage = 0;
+int bounds = 0, decompose = 0, compose = 0, sensitivity = 0, budget = 0;
+int compaction = 0, storage = 0;
+int binary = 0, batch = 0;
 
 /* File streams for input and output. */
-char *fname = NULL;
+char *fname = NULL, *transient = NULL, *sweep = NULL, *store = NULL;
+char *server = NULL, *cache = NULL;
 FILE *output_file = NULL;
+FILE *report_file = NULL;
 
 /* CRITICAL:
    The following data structures are fine for prototyping. However,
@@ -58,7 +77,6 @@ static char process[10240];   /* Process definitions. */
 static char set[10240];       /* Synchronisation sets. */
 static char model[10240];     /* System equation. */
 static char temp[10240];      /* Temporary buffer. */
-static char temp_sset[10240]; /* Temporary sync. set. */
 
 
 /* Used to inherit source list from the parent node. */
@@ -87,12 +105,43 @@ static void __htree_generate_sink(__htree_node_t *n);
    this set is maintained as a double linked lists. This
    function is used to insert a new node into the existing
    child list of the current skeleton node. */
-static int __htree_insert_sibling(__htree_node_t *n);
+static int __htree_insert_sibling(struct __htree_rt_s *rt,
+                                  __htree_node_t *n);
+
+/* Used to count the number of indices gathered from the children
+   of a deal or a farm, before they are merged into a single list. */
+static int __htree_count_temp(__htree_node_t *n);
+
+/* Find the shared subtree built from the body b in rt, or build it. */
+static __htree_shared_t *__htree_share(struct __htree_rt_s *rt,
+                                       const htree_body_t *b);
+
+/* Insert a node which stands for an instance of the shared subtree s
+   into the tree of rt. */
+static int __htree_insert_ref(struct __htree_rt_s *rt, __htree_shared_t *s);
+
+/* Copy the children of the subtree s, expanding its instances, under
+   the node n. */
+static int __htree_copy(__htree_node_t *n, __htree_node_t *s);
+
+/* Number the nodes of the subtree n in the order they would have
+   been inserted. */
+static void __htree_number(__htree_node_t *n, int *nodes, int *leaves);
+
+/* Deallocate the shared subtrees of rt. */
+static void __htree_shared_free(struct __htree_rt_s *rt);
+
+/* Add the named rate of the statement s to rt. */
+static int __htree_rate(struct __htree_rt_s *rt, const htree_stmt_t *s);
+
+/* Insert the nodes of the statement s into the tree of rt, as
+   htree_stmt() does, but silently. */
+static int __htree_stmt(struct __htree_rt_s *rt, htree_stmt_t *s);
 
 
 void __htree_generate_source(__htree_node_t *n) {
     __htree_child_t *c;
-    short i;
+    int i;
     __htree_inherit_source(n);
     if (n->mtype == TASK) __htree_rt.sstab[n->index] = n;
     if ((c = n->clist))
@@ -105,7 +154,7 @@ void __htree_generate_source(__htree_node_t *n) {
 }
 
 void __htree_inherit_source(__htree_node_t *n) {
-    short i;
+    int i;
     n->sol.n = n->p->sol.n;
     n->sol.l = (int *) malloc(sizeof(int)*n->sol.n);
     n->ptype = n->p->ptype;
@@ -115,7 +164,7 @@ void __htree_inherit_source(__htree_node_t *n) {
 
 void __htree_update_source(__htree_node_t *n) {
     __htree_child_t *c;
-    short i, j;
+    int i, j;
 
     n->temp.l = NULL;    
     switch (n->mtype) {
@@ -155,7 +204,7 @@ void __htree_update_source(__htree_node_t *n) {
             (n->p->mtype != FARM)) {
             free (n->p->sol.l);
             n->p->sol.n = 0;
-            n->p->sol.l = (int *) malloc(sizeof(int)*MAX_NSOURCES);
+            n->p->sol.l = (int *) malloc(sizeof(int)*__htree_count_temp(n));
             c = n->clist;
             for (i = 0; i < n->nchr; i++) {
                 for (j = 0; j < c->child->temp.n; j++) {
@@ -165,11 +214,10 @@ void __htree_update_source(__htree_node_t *n) {
                 free(c->child->temp.l);
                 c = c->next;
             }
-            realloc (n->p->sol.l, sizeof(int)*n->p->sol.n);
             n->p->ptype = n->mtype;
         } else {
             n->temp.n = 0;
-            n->temp.l = (int *) malloc(sizeof(int)*MAX_NSOURCES);
+            n->temp.l = (int *) malloc(sizeof(int)*__htree_count_temp(n));
             c = n->clist;
             for (i = 0; i < n->nchr; i++) {
                 for (j = 0; j < c->child->temp.n; j++) {
@@ -179,7 +227,6 @@ void __htree_update_source(__htree_node_t *n) {
                 free(c->child->temp.l);
                 c = c->next;
             }
-            realloc(n->temp.l, sizeof(int)*n->temp.n);
         }
         break;
 
@@ -189,9 +236,20 @@ void __htree_update_source(__htree_node_t *n) {
     }
 }
 
+int __htree_count_temp(__htree_node_t *n) {
+    __htree_child_t *c;
+    int i, k = 0;
+    c = n->clist;
+    for (i = 0; i < n->nchr; i++) {
+        k += c->child->temp.n;
+        c = c->next;
+    }
+    return k;
+}
+
 void __htree_generate_sink(__htree_node_t *n) {
     __htree_child_t *c;
-    short i;
+    int i;
 
     __htree_inherit_sink (n);
     if (n->mtype == TASK) __htree_rt.sstab[n->index] = n;
@@ -207,7 +265,7 @@ void __htree_generate_sink(__htree_node_t *n) {
 }
 
 void __htree_inherit_sink(__htree_node_t *n) {
-    short i;
+    int i;
     n->sil.n = n->p->sil.n;
     n->sil.l = (int *) malloc(sizeof(int)*n->sil.n);
     n->stype = n->p->stype;
@@ -217,7 +275,7 @@ void __htree_inherit_sink(__htree_node_t *n) {
 
 void __htree_update_sink(__htree_node_t *n) {
     __htree_child_t *c;
-    short i, j;
+    int i, j;
 
     switch (n->mtype) {
     case TASK:
@@ -256,7 +314,7 @@ void __htree_update_sink(__htree_node_t *n) {
             (n->p->mtype != FARM)) {
             free (n->p->sil.l);
             n->p->sil.n = 0;
-            n->p->sil.l = (int *) malloc(sizeof(int)*MAX_NSINKS);
+            n->p->sil.l = (int *) malloc(sizeof(int)*__htree_count_temp(n));
             c = n->clist;
             for (i = 0; i < n->nchr; i++) {
                 for (j = 0; j < c->child->temp.n; j++) {
@@ -265,11 +323,10 @@ void __htree_update_sink(__htree_node_t *n) {
                 }
                 c = c->next;
             }
-            realloc (n->p->sil.l, sizeof(int)*n->p->sil.n);
             n->p->stype = n->mtype;
         } else {
             n->temp.n = 0;
-            n->temp.l = (int *) malloc(sizeof(int)*MAX_NSINKS);
+            n->temp.l = (int *) malloc(sizeof(int)*__htree_count_temp(n));
             c = n->clist;
             for (i = 0; i < n->nchr; i++) {
                 for (j = 0; j < c->child->temp.n; j++) {
@@ -278,7 +335,6 @@ void __htree_update_sink(__htree_node_t *n) {
                 }
                 c = c->next;
             }
-            realloc (n->temp.l, sizeof(int)*n->temp.n);
         }
         break;
 
@@ -289,7 +345,7 @@ void __htree_update_sink(__htree_node_t *n) {
 }
 
 
-int __htree_insert_sibling (__htree_node_t *n) {
+int __htree_insert_sibling (struct __htree_rt_s *rt, __htree_node_t *n) {
     __htree_child_t *m;
 
     /* Create a new sibling node for the double linke dist. */
@@ -301,8 +357,8 @@ int __htree_insert_sibling (__htree_node_t *n) {
 
     /* What is my sibling rank in the double linked list? The head
        (the first sibling inserted has rank zero. */
-    n->rank = __htree_rt.curr_node->nchx;
-    if (__htree_rt.curr_node->clist) {
+    n->rank = rt->curr_node->nchx;
+    if (rt->curr_node->clist) {
         /* If there are siblings in the double linked list, append self
            at the end of the list. Remeber to update the following
            pointer.
@@ -310,21 +366,21 @@ int __htree_insert_sibling (__htree_node_t *n) {
            o The previous last should point to the new as follower.
            o The head of the double linked list (the first sibling)
            should point to the new sibling as previous. */
-        m->prev = __htree_rt.curr_node->clist->prev;
-        m->next = __htree_rt.curr_node->clist;
-        __htree_rt.curr_node->clist->prev->next = m;
-        __htree_rt.curr_node->clist->prev = m;
+        m->prev = rt->curr_node->clist->prev;
+        m->next = rt->curr_node->clist;
+        rt->curr_node->clist->prev->next = m;
+        rt->curr_node->clist->prev = m;
     } else {
         /* If this is the first child, this child self
            references until more siblings are inserted. */
         m->prev = m;
         m->next = m;
-        __htree_rt.curr_node->clist = m;                
+        rt->curr_node->clist = m;                
     }
     /* Acknowledge that a new sibling has entered. This is required to
        test if the parent node has created all the required children. */
-    __htree_rt.curr_node->nchx++;
-    __htree_rt.node_sum--;
+    rt->curr_node->nchx++;
+    rt->node_sum--;
     return 0;
 }
 
@@ -333,7 +389,7 @@ int __htree_insert_sibling (__htree_node_t *n) {
 void __htree_write_tree(FILE *f, __htree_node_t *n,
                         short ind, short l) {
     __htree_child_t *c;
-    short i, j;
+    int i, j;
 
     if (n) {
         fprintf(f, "%%");
@@ -391,11 +447,14 @@ int __htree_display_sstab(void) {
 int htree_write_graph(void) {
     int i, j, k;
     FILE *f;
-    char temp[64];
+    char temp[HTREE_NAME_MAX + 16];
 
     strcpy(temp, fname);
     strcat(temp, "dot");
-    f = fopen(temp, "w");
+    if (!(f = fopen(temp, "w"))) {
+        perror("Could not create graph file");
+        return -1;
+    }
     fprintf(f,
             "digraph \"%sdes\" {\n"
             "graph [rankdir=LR, size=\"8,8\", splines=true];\n"
@@ -443,11 +502,10 @@ int gcd(int a, int b) {
     return a;
 }
 
-/* Find the lowest common multiple. */
-#define lcm(a,b) (((a)*(b))/gcd((a),(b)))
-
 /* Generates the process definition for this leaf-node. */
 int __htree_task_def(__htree_node_t *node) {
+    char literal[512];
+    const char *rate;
     int i, j, k, l;
     if (pattern_matrix[node->ptype][node->stype] == 0) {
         printf("Error\n");
@@ -461,6 +519,14 @@ int __htree_task_def(__htree_node_t *node) {
         sprintf (temp, "t_{%d} & \\rmdef & ", node->index);
         strcat(process, temp);
     }
+    /* A symbolic rate is written as it is, and defined at the top of
+       the model; the LaTeX document shows the value. */
+    if (node->rname)
+        rate = node->rname;
+    else {
+        snprintf(literal, sizeof(literal), "%f", node->rate);
+        rate = literal;
+    }
     fprintf(output_file, "t_%d = \t", node->index);
     switch(pattern_matrix[node->ptype][node->stype]) {
     case 1:
@@ -473,8 +539,8 @@ int __htree_task_def(__htree_node_t *node) {
                         ((l > 1) && (i < l - 1)) ? "\\\\&&" : "");
                 strcat(process, temp);
             }
-            fprintf(output_file, "(comp_%d, %f).(move_%d_%d, infty).%s",
-                    node->index, node->rate, node->index, k,
+            fprintf(output_file, "(comp_%d, %s).(move_%d_%d, infty).%s",
+                    node->index, rate, node->index, k,
                     ((l > 1) && (i < l - 1)) ? "\n\t" : "");
         }
         break;
@@ -488,8 +554,8 @@ int __htree_task_def(__htree_node_t *node) {
                         ((l > 1) && (i < l - 1)) ? "\\\\&&" : "");
                 strcat(process, temp);
             }
-            fprintf(output_file, "(move_%d_%d, infty).(comp_%d, %f).%s",
-                    j, node->index, node->index, node->rate,
+            fprintf(output_file, "(move_%d_%d, infty).(comp_%d, %s).%s",
+                    j, node->index, node->index, rate,
                     ((l > 1) && (i < l - 1)) ? "\n\t" : "");
         }
         break;        
@@ -507,9 +573,9 @@ int __htree_task_def(__htree_node_t *node) {
                         ((l > 1) && (i < l - 1)) ? "\\\\&&" : "");
                 strcat(process, temp);
             } 
-            fprintf(output_file, "(move_%d_%d, infty).(comp_%d, %f)."
+            fprintf(output_file, "(move_%d_%d, infty).(comp_%d, %s)."
                     "(move_%d_%d, infty).%s",
-                    j, node->index, node->index, node->rate, node->index, k,
+                    j, node->index, node->index, rate, node->index, k,
                     ((l > 1) && (i < l - 1)) ? "\n\t" : "");
         }
         break;        
@@ -531,9 +597,9 @@ int __htree_task_def(__htree_node_t *node) {
                 }
             }
         }
-        fprintf(output_file, "(comp_%d, %f).t_%d_0;\nt_%d_0 = "
+        fprintf(output_file, "(comp_%d, %s).t_%d_0;\nt_%d_0 = "
                 "(move_%d_%d, infty).t_%d",
-                node->index, node->rate, node->index, node->index,
+                node->index, rate, node->index, node->index,
                 node->index, node->sil.l[0], node->index);
         for (i = 1; i < node->sil.n; i++) {
             fprintf(output_file, "\n\t+ (move_%d_%d, infty).",
@@ -562,8 +628,8 @@ int __htree_task_def(__htree_node_t *node) {
             fprintf(output_file, "\n\t+ (move_%d_%d, infty).t_%d_0",
                     node->sol.l[i], node->index, node->index);
         }
-        fprintf(output_file, ";\nt_%d_0 = (comp_%d, %f).",
-                node->index, node->index, node->rate);
+        fprintf(output_file, ";\nt_%d_0 = (comp_%d, %s).",
+                node->index, node->index, rate);
         break;
     case 7:
     case 11:
@@ -599,9 +665,9 @@ int __htree_task_def(__htree_node_t *node) {
         }
         for (i = 0; i < node->sol.n; i++) {
             fprintf(output_file,
-                    "(move_%d_%d, infty).(comp_%d, %f).t_%d_%d;\n"
+                    "(move_%d_%d, infty).(comp_%d, %s).t_%d_%d;\n"
                     "t_%d_%d = (move_%d_%d, infty).",
-                    node->sil.l[i], node->index, node->index, node->rate,
+                    node->sil.l[i], node->index, node->index, rate,
                     node->index, i, node->index, i, node->index, node->sil.l[0]);
             if (i < node->sol.n - 1)
                 fprintf(output_file, "t_%d_%d",    node->index, i+1);
@@ -659,8 +725,8 @@ int __htree_task_def(__htree_node_t *node) {
                         node->sol.l[j], node->index, node->index, k);
             }
             fprintf(output_file,
-                    ";\nt_%d_%d = (comp_%d, %f).(move_%d_%d, infty).",
-                    node->index, k, node->index, node->rate,
+                    ";\nt_%d_%d = (comp_%d, %s).(move_%d_%d, infty).",
+                    node->index, k, node->index, rate,
                     node->index, node->sil.l[i]);
             if (i < node->sil.n - 1) {
                 fprintf(output_file, "t_%d_%d;\nt_%d_%d = ",
@@ -695,14 +761,14 @@ int __htree_task_def(__htree_node_t *node) {
             }
         }
         fprintf(output_file,
-                "(move_%d_%d, infty).(comp_%d, %f).t_%d_0",
+                "(move_%d_%d, infty).(comp_%d, %s).t_%d_0",
                 node->sol.l[0], node->index, node->index,
-                node->rate, node->index);
+                rate, node->index);
         for (i = 1; i < node->sol.n; i++) {
             fprintf(output_file,
-                    "\n\t+ (move_%d_%d, infty).(comp_%d, %f).t_%d_0",
+                    "\n\t+ (move_%d_%d, infty).(comp_%d, %s).t_%d_0",
                     node->sol.l[i], node->index, node->index,
-                    node->rate, node->index);
+                    rate, node->index);
         }
         fprintf(output_file,
                 ";\nt_%d_0 = (move_%d_%d, infty).",
@@ -726,7 +792,7 @@ int __htree_task_def(__htree_node_t *node) {
    for all the leaf-nodes in the current subtree. */
 void __htree_subtree_def(__htree_node_t *n) {
     __htree_child_t *c;
-    short i, j;
+    int i, j;
 
     if (n) {
         if (n->mtype == TASK) __htree_task_def(n);
@@ -741,11 +807,26 @@ void __htree_subtree_def(__htree_node_t *n) {
 /* Generates process definitions for all the leaf-nodes
    in the skeleton hierarchy tree. */
 int htree_define_tasks(void) {
+    __htree_rate_t *r;
+    int i;
+
     if (!__htree_rt.htree || __htree_rt.node_sum) {
         printf ("Invalid tree.\n");
         return -1;
     }
     strcpy(process, "");
+
+    /* The named rates are defined first, so that a model which differs
+       only in their values differs only in these lines. */
+    for (i = 0; i < __htree_rt.nrates; i++) {
+        r = &__htree_rt.rates[i];
+        if (r->expr)
+            fprintf(output_file, "%s = %s;\n", r->name, r->expr);
+        else
+            fprintf(output_file, "%s = %f;\n", r->name, r->val);
+    }
+    if (__htree_rt.nrates)
+        fprintf(output_file, "\n");
     __htree_subtree_def(__htree_rt.htree);
     return 0;
 }
@@ -758,7 +839,7 @@ static int set_count = 0;
 int __htree_subtree_model(__htree_node_t *n) {
     static length = 0;
     __htree_child_t *c;
-    int i, j, x;
+    int i, j, k, x;
     if (n) {
         if (n->mtype == TASK) {
             if (latex) {
@@ -821,7 +902,6 @@ int __htree_subtree_model(__htree_node_t *n) {
                 if (n->rank < n->p->nchr - 1) {
                     if ((n->p->mtype != DEAL) &&
                         (n->p->mtype != FARM)) {
-                        strcpy(temp_sset, " <");
                         if (latex) {
                             sprintf(temp, "\\sync{L_{%d}}", set_count);
                             strcat(model, temp);
@@ -843,18 +923,17 @@ int __htree_subtree_model(__htree_node_t *n) {
                             strcat(set, temp);
                             set_count++;
                         }
-                        for (i = 0; i < n->sil.n; i++) {
+                        /* Written directly, since the set grows with
+                           the number of workers in a farm. */
+                        fprintf(output_file, " <");
+                        for (i = 0, k = 0; i < n->sil.n; i++) {
                             x = n->sil.l[i % n->sil.n];
-                            for (j = 0; j < __htree_rt.sstab[x]->sol.n; j++) {
-                                sprintf(temp, "move_%d_%d, ",
+                            for (j = 0; j < __htree_rt.sstab[x]->sol.n; j++)
+                                fprintf(output_file, "%smove_%d_%d",
+                                        (k++ > 0) ? ", " : "",
                                         __htree_rt.sstab[x]->sol.l[j], x);
-                                strcat(temp_sset, temp);
-                            }
                         }
-                        i = strlen(temp_sset);
-                        temp_sset[i - 2] = '\0';
-                        strcat(temp_sset, "> ");
-                        fprintf(output_file, "%s", temp_sset);
+                        fprintf(output_file, "> ");
                     } else {
                         if (latex) {
                             sprintf(temp, "||");
@@ -881,6 +960,7 @@ int htree_define_model(void) {
     }
     strcpy(model, "");
     strcpy(set, "");
+    set_count = 0;
     __htree_subtree_model(__htree_rt.htree);
     fprintf(output_file, "\n");
     return 0;
@@ -890,12 +970,15 @@ int htree_define_model(void) {
    for pretty printing. */
 char pepa_dot_sty[] = "\n\n\%\% Contents of pepa.sty\n\\def\\S{\\mbox{\\large $\\rhd\\!\\!\\!\\lhd$}}\\def\\Aa{\\vec{\\cal A}{\\it ct}}\\def\\cA{{\\cal A}}\\def\\cS{{\\cal S}}\\def\\cC{{\\cal C}}\\def\\cE{{\\cal E}}\\def\\cR{{\\cal R}}\\def\\Ac{{\\cal A}{\\it ct}}\\def\\bms{\\{\\!|\\,}\\def\\ems{\\,|\\!\\}}\\def\\lra{\\longrightarrow}\\def\\lera{\\leftrightarrow}\\def\\vlra{-\\hspace{-0.2cm}-\\hspace{-0.2cm}\\lra}\\def\\notsim{\\sim \\hspace{-3.5mm} /\\;}\\def\\notequiv{\\equiv \\hspace{-3.5mm} /\\;}\\def\\noapprox{\\approx \\hspace{-3.5mm} /\\;}\\def\\rmdef{\\stackrel{\\mbox{\\em {\\tiny def}}}{=}}\\def\\eq{\\mbox{\\boldmath $=$}}\\def\\Chi{\\mbox{\\Large $\\chi$}}\\def\\E{\\cC/{\\cong}}\\def\\Eup{\\cC/({\\cong} \\cR^{*} {\\cong})}\\def\\mscup{\\uplus}\\def\\mscap{\\cap}\\def\\fcomp{\\raisebox{0.6ex}{\\mbox{\\tiny $\\circ$}\\,}}\\newfont{\\cmexx}{cmex7}\\newcommand{\\smallrhd}{\\mathrel{\\raise23pt\\hbox{\\cmexx\\symbol{}}}}\\newcommand{\\smalllhd}{\\mathrel{\\raise23pt\\hbox{\\cmexx\\symbol{}}}}\\def\\smallS{\\mbox{\\tiny $\\rhd \\!\\!\\!\\lhd$}}\\newcommand{\\ssync}[1]{\\raisebox{-0.9ex}{$\\:\\stackrel{\\smallS}{\\scriptscriptstyle #1}\\,$}}  \\renewcommand{\\infty}{\\top}\\mathchardef\\infinity=\"0231\\def\\QED {{\\unskip\\nobreak\\hfil\\penalty50  \\hskip2em\\hbox{}\\nobreak\\hfil$\\Box$  \\parfillskip=0pt \\finalhyphendemerits=0 \\par}}\\def\\separate{\\begin{center} ---\\hspace{-0.12mm}---\\hspace{-0.12mm}---\\hspace{-1.5mm}$\\circ$\\hspace{-1.5mm}---\\hspace{-0.12mm}---\\hspace{-0.12mm}--- \\end{center}}  \\newcommand{\\mult}[2]{m_{#1}(#2)}\\newcommand{\\sync}[1]{\\raisebox{-1.0ex}{$\\;\\stackrel{\\S}{\\scriptscriptstyle#1}\\,$}}  \\newcommand{\\seq}[1]{\\stackrel{\\rhd}{\\scriptscriptstyle #1}}\\newcommand{\\equ}[1]{\\stackrel{#1}{\\eq}}\\newcommand{\\mat}[1]{\\mbox{\\bf #1}}\\newcommand{\\NIL}{\\mbox{{\\bf 0}}}";
 
-void htree_write_latex(void) {
+int htree_write_latex(void) {
     FILE *f;
-    char temp[64];
+    char temp[HTREE_NAME_MAX + 16];
     strcpy(temp, fname);
     strcat(temp, "tex");
-    f = fopen(temp, "w");
+    if (!(f = fopen(temp, "w"))) {
+        perror("Could not create LaTeX file");
+        return -1;
+    }
     htree_write_tree(f);
     fprintf(f, "\\documentclass[a4paper,11pt]{article}\n"
             "\\usepackage{amssymb,epsfig,fullpage}"
@@ -910,19 +993,38 @@ void htree_write_latex(void) {
     fprintf(f, "\\begin{eqnarray*}%s\\end{eqnarray*}", set);
     fprintf(f, "\n\n\\end{document}\n");
     fclose(f);
+    return 0;
 }
 
 /* Generate the performance model based on the user provided
    hierarchical description to the corresponding .dot, .tex etc.
    files depending on what the user requested. */
 int generate(void) {
-    char temp[64];
-    char command[64];
-    int status;
+    char temp[HTREE_NAME_MAX + 16];
+    char command[2*HTREE_NAME_MAX + 64];
+    int status, cached = -1, err = 0;
+    cache_t c;
+
+    /* The generated files, and the commands run on them, are named
+       after fname. */
+    if (strlen(fname) > HTREE_NAME_MAX) {
+        fprintf(stderr, "[ %s is too long a name ]\n", fname);
+        htree_final();
+        return -1;
+    }
     strcpy(temp, fname);
     strcat(temp, "pepa");
 
     htree_commit(); /* Commit skeleton hierarchy tree. */
+    if (binary && (htree_write_binary() < 0)) err = -1;
+
+    /* A tree which was generated before with the same flags is served
+       from the cache. Complete generation runs external commands,
+       which the cache does not stand for. */
+    if (cache && !complete && ((cached = cache_lookup(&c)) > 0)) {
+        htree_final();
+        return 0;
+    }
     
     /* While debugging, it is easier to check the
        source-sink lookup table. */
@@ -931,14 +1033,41 @@ int generate(void) {
     if (output) {
         if (!(output_file = fopen(temp, "w"))) {
             perror("Could not create output file");
-            return 1;
+            if (!cached) cache_abandon(&c);
+            htree_final();
+            return -1;
         }
-    } else output_file = stdout;
-    htree_define_tasks();
-    htree_define_model();
-    fclose(output_file);
-    if (latex) htree_write_latex();
-    if (graph) htree_write_graph();
+    } else output_file = report_file;
+    if (htree_define_tasks() < 0) err = -1;
+    if (htree_define_model() < 0) err = -1;
+    if (output) fclose(output_file);
+
+    /* An analysis which fails is reported, and the others go on; the
+       result is -1 if any failed. */
+    if (latex && (htree_write_latex() < 0)) err = -1;
+    if (graph && (htree_write_graph() < 0)) err = -1;
+    /* A store which cannot be opened leaves this run in memory; the
+       next run (of a batch or server) tries it again. */
+    if (store) store_open(store);
+    if (bounds && (htree_bounds() < 0)) err = -1;
+    if (decompose && (htree_decompose() < 0)) err = -1;
+    if (compose && (htree_compose() < 0)) err = -1;
+    if (sweep && (htree_sweep(sweep) < 0)) err = -1;
+    if (budget && (htree_optimise(budget) < 0)) err = -1;
+    if (storage && (htree_storage() < 0)) err = -1;
+    if (solve && (htree_solve() < 0)) err = -1;
+    if (fluid && (htree_fluid() < 0)) err = -1;
+    if (simulate && (htree_simulate() < 0)) err = -1;
+    if (store) store_close();
+
+    /* A failure is not kept in the cache, so that a hit always stands
+       for a success. */
+    if (!cached) {
+        if (err)
+            cache_abandon(&c);
+        else
+            cache_insert(&c);
+    }
     htree_final();    /* Finalise skeleton library. */
 
     /* If complete generation was requested. */
@@ -979,14 +1108,14 @@ int generate(void) {
         if (wait(&status) < 0) return -1;
         if (!WIFEXITED(status)) return -1;        
     }
-    return 0;
+    return err;
 }
 
 
 /* for a description of the following function, see "pepa.h". */
 int __htree_generate_sstab (__htree_node_t *n, int source, int sink) {
     __htree_child_t *c;
-    short i;
+    int i;
     if (!n || __htree_rt.node_sum) return -1;
     if (!(__htree_rt.sstab = (__htree_node_t **)
           malloc(sizeof (__htree_node_t *)*__htree_rt.nleaves)))
@@ -1052,21 +1181,112 @@ void __htree_destroy(__htree_node_t *n) {
     }
 }
 
-int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
+void __htree_leaf_range(__htree_node_t *n, int *first, int *count) {
+    __htree_child_t *c;
+    int i, f, k;
+
+    if (n->mtype == TASK) {
+        *first = n->index;
+        *count = 1;
+        return;
+    }
+    *first = -1;
+    *count = 0;
+    c = n->clist;
+    for (i = 0; c && i < n->nchr; i++) {
+        __htree_leaf_range(c->child, &f, &k);
+        if (*first < 0) *first = f;
+        *count += k;
+        c = c->next;
+    }
+}
+
+int __htree_same_subtree(__htree_node_t *a, __htree_node_t *b) {
+    __htree_child_t *c, *d;
+    int i;
+
+    if ((a->mtype != b->mtype) || (a->nchr != b->nchr))
+        return 0;
+    if (a->mtype == TASK)
+        return a->rate == b->rate;
+    c = a->clist;
+    d = b->clist;
+    for (i = 0; i < a->nchr; i++) {
+        if (!__htree_same_subtree(c->child, d->child))
+            return 0;
+        c = c->next;
+        d = d->next;
+    }
+    return 1;
+}
+
+static unsigned int __htree_name_hash(const char *s) {
+    unsigned int h = 2166136261u;
+
+    while (*s)
+        h = (h ^ (unsigned char) *s++)*16777619u;
+    return h;
+}
+
+/* For a description of the following function, see "pepa.h". */
+const char *htree_intern(struct __htree_rt_s *rt, const char *s, int copy) {
+    __htree_names_t *t = &rt->names;
+    const char **a, *r;
+    unsigned int h;
+    int i;
+    char *c;
+
+    if (2*(t->n + 1) > t->size) {
+        i = t->size ? 2*t->size : 256;
+        if (!(a = (const char **) calloc(i, sizeof(const char *))))
+            return NULL;
+        while (t->size--)
+            if ((r = t->tab[t->size])) {
+                for (h = __htree_name_hash(r) & (i - 1); a[h];
+                     h = (h + 1) & (i - 1))
+                    ;
+                a[h] = r;
+            }
+        free(t->tab);
+        t->tab = a;
+        t->size = i;
+    }
+    h = __htree_name_hash(s) & (t->size - 1);
+    for (; (r = t->tab[h]); h = (h + 1) & (t->size - 1))
+        if (!strcmp(r, s))
+            return r;
+    if (copy) {
+        /* The copy is chained to the others, to be freed with them. */
+        if (!(c = (char *) malloc(sizeof(char *) + strlen(s) + 1)))
+            return NULL;
+        *(char **) c = t->owned;
+        t->owned = c;
+        s = strcpy(c + sizeof(char *), s);
+    }
+    t->n++;
+    return t->tab[h] = s;
+}
+
+static int __htree_vinsert(struct __htree_rt_s *rt, __htree_comp_t skel,
+                           int nchild, va_list ap) {
     __htree_node_t *n;
-    va_list ap;
+    char *r;
 
-    if (!(n = (__htree_node_t *) malloc(sizeof(__htree_node_t))))
+    if (!(n = (__htree_node_t *) calloc(1, sizeof(__htree_node_t))))
         return -1;
     if ((n->mtype = skel) == TASK) {
-        va_start(ap, nchild);
-        strcpy(n->name, va_arg(ap, char*));
+        n->name = htree_intern(rt, va_arg(ap, char*), 1);
         n->rate = va_arg(ap, double);
-        va_end(ap);
-    } else strcpy(n->name, "unknown");
+        r = va_arg(ap, char*);
+        n->rname = r ? htree_intern(rt, r, 1) : NULL;
+        if (!n->name || (r && !n->rname)) {
+            free(n);
+            return -1;
+        }
+    } else n->name = "unknown";
 
     n->clist = NULL;            /* No children yet. */
-    if (__htree_rt.htree) {
+    if (rt->htree) {
         /* If there are existing nodes, we append the new node as a
            child node (sibling) which can bear a subtree of its
            own. If no nodes already exists, this node becomes the root
@@ -1078,7 +1298,7 @@ int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
                execution. First, we have to ensure that the data paths
                are satisfied. In order to do this, we inherit the left
                and right pointers from the parent node. */
-            n->p = __htree_rt.curr_node;
+            n->p = rt->curr_node;
 
             /* We have to note that this node is not allowed to have
                any children. */
@@ -1087,22 +1307,22 @@ int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
             /* Finally, we have to insert this node as one of the child
                nodes for the parent node. Remember, we maintain the
                children list as a doubl-linked list for easy navigation. */
-            __htree_insert_sibling(n);
-            n->index = __htree_rt.nleaves;
-            __htree_rt.nleaves++;
+            __htree_insert_sibling(rt, n);
+            n->index = rt->nleaves;
+            rt->nleaves++;
             break;
         case PIPE:
         case DEAL:
         case FARM:
-            n->p = __htree_rt.curr_node;
+            n->p = rt->curr_node;
             n->nchr = nchild;
             n->nchx = 0;
-            __htree_insert_sibling(n);
-            n->index = __htree_rt.nnodes;            
+            __htree_insert_sibling(rt, n);
+            n->index = rt->nnodes;            
             /* Now, we have to enter into this node to complete its
                subtree. Once all the required children are created,
                we return to parent. */
-            __htree_rt.curr_node = n;
+            rt->curr_node = n;
             break;
         default:
             printf ("Node type not recognized.\n");
@@ -1126,9 +1346,9 @@ int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
         
         /* At the start, the current node and the main tree is
            initialised to this single node. */
-        __htree_rt.htree = __htree_rt.curr_node = n;
+        rt->htree = rt->curr_node = n;
     }
-    __htree_rt.nnodes++;
+    rt->nnodes++;
 
     /* For every node (starting from the root), all the required
        children should be created. This is necessary for the tree to be
@@ -1138,27 +1358,306 @@ int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
        tree node, we account for the creation of nodes and siblings
        through this variable. For a valid tree, 'node_sum' equals
        zero. */
-    __htree_rt.node_sum += nchild;
+    rt->node_sum += nchild;
 
     /* Check if the required number of children have already been
        created. If this condition is satisfied, the subtree for the
        current node is complete. So, move to the next sibling. If there
        are no more siblings remaining, return to the parent. */
-    while (__htree_rt.curr_node &&
-           (__htree_rt.curr_node->nchr == __htree_rt.curr_node->nchx)) {
-        __htree_rt.curr_node = __htree_rt.curr_node->p;
+    while (rt->curr_node &&
+           (rt->curr_node->nchr == rt->curr_node->nchx)) {
+        rt->curr_node = rt->curr_node->p;
+    }
+    return 0;
+}
+
+/* For a description of the following function, see "pepa.h". */
+int htree_insert(struct __htree_rt_s *rt, __htree_comp_t skel, int nchild,
+                 ...) {
+    va_list ap;
+    int err;
+
+    va_start(ap, nchild);
+    err = __htree_vinsert(rt, skel, nchild, ap);
+    va_end(ap);
+    return err;
+}
+
+int __htree_insert_node (__htree_comp_t skel, int nchild, ...) {
+    va_list ap;
+    int err;
+
+    va_start(ap, nchild);
+    err = __htree_vinsert(&__htree_rt, skel, nchild, ap);
+    va_end(ap);
+    return err;
+}
+
+int htree_stmt(struct __htree_rt_s *rt, htree_stmt_t *s) {
+    if (!__htree_stmt(rt, s))
+        return 0;
+    if (rt->htree && !rt->curr_node)
+        fprintf(stderr, "[ statement after complete tree at line %d ]\n",
+                s->line);
+    else
+        fprintf(stderr, "[ statement does not fit in the tree at line "
+                "%d ]\n", s->line);
+    return -1;
+}
+
+int __htree_stmt(struct __htree_rt_s *rt, htree_stmt_t *s) {
+    __htree_shared_t *t;
+    int i, j;
+
+    /* A statement without a body defines a named rate. */
+    if ((s->skel == UNKNOWN) && !s->body)
+        return __htree_rate(rt, s);
+
+    /* Nothing follows a complete tree. */
+    if (rt->htree && !rt->curr_node)
+        return -1;
+
+    /* The instances of a body refer to one subtree, but for the root
+       of the tree and single tasks, which are inserted as they are. */
+    if (s->skel == UNKNOWN) {
+        if (!rt->htree || (s->body->nstmts == 1)) {
+            for (i = 0; i < s->n; i++)
+                for (j = 0; j < s->body->nstmts; j++)
+                    if (__htree_stmt(rt, &s->body->stmts[j]) < 0)
+                        return -1;
+            return 0;
+        }
+        if (!(t = __htree_share(rt, s->body)))
+            return -1;
+        for (i = 0; i < s->n; i++)
+            if (__htree_insert_ref(rt, t) < 0)
+                return -1;
+        return 0;
     }
+    if (s->skel == TASK)
+        return htree_insert(rt, TASK, 0, s->name, s->rate, s->rname);
+    if (htree_insert(rt, s->skel, s->n) < 0)
+        return -1;
+    if (s->name)
+        for (i = 0; i < s->n; i++)
+            if (htree_insert(rt, TASK, 0, s->name, s->rate, s->rname) < 0)
+                return -1;
     return 0;
 }
 
+int __htree_rate(struct __htree_rt_s *rt, const htree_stmt_t *s) {
+    __htree_rate_t *r;
+    int n;
+
+    if (rt->nrates == rt->maxrates) {
+        n = rt->maxrates ? 2*rt->maxrates : 16;
+        if (!(r = (__htree_rate_t *) realloc(rt->rates,
+                                             sizeof(__htree_rate_t)*n)))
+            return -1;
+        rt->rates = r;
+        rt->maxrates = n;
+    }
+    r = &rt->rates[rt->nrates];
+    r->name = htree_intern(rt, s->name, 1);
+    r->expr = s->rname ? htree_intern(rt, s->rname, 1) : NULL;
+    r->val = s->rate;
+    if (!r->name || (s->rname && !r->expr))
+        return -1;
+    rt->nrates++;
+    return 0;
+}
+
+__htree_shared_t *__htree_share(struct __htree_rt_s *rt,
+                                const htree_body_t *b) {
+    struct __htree_rt_s t;
+    __htree_shared_t *s;
+    int i, err = 0;
+
+    for (s = rt->shared; s; s = s->next)
+        if (s->body == b)
+            return s;
+    if (!(s = (__htree_shared_t *) malloc(sizeof(__htree_shared_t))))
+        return NULL;
+
+    /* The subtree is built as a tree of its own, which shares the
+       names and the shared subtrees of rt, and must be complete. */
+    memset(&t, 0, sizeof(struct __htree_rt_s));
+    t.names = rt->names;
+    t.shared = rt->shared;
+    for (i = 0; !err && (i < b->nstmts); i++)
+        err = __htree_stmt(&t, &b->stmts[i]);
+    rt->names = t.names;
+    rt->shared = t.shared;
+    if (err || !t.htree || t.curr_node || t.node_sum) {
+        __htree_destroy(t.htree);
+        free(s);
+        return NULL;
+    }
+    s->body = b;
+    s->root = t.htree;
+    s->nnodes = t.nnodes;
+    s->nleaves = t.nleaves;
+    s->next = rt->shared;
+    rt->shared = s;
+    return s;
+}
+
+int __htree_insert_ref(struct __htree_rt_s *rt, __htree_shared_t *s) {
+    __htree_node_t *n;
+
+    if (!(n = (__htree_node_t *) calloc(1, sizeof(__htree_node_t))))
+        return -1;
+    n->name = s->root->name;
+    n->rate = s->root->rate;
+    n->rname = s->root->rname;
+    n->mtype = s->root->mtype;
+    n->nchr = n->nchx = s->root->nchr;
+    n->ref = s->root;
+    n->p = rt->curr_node;
+    if (__htree_insert_sibling(rt, n) < 0) {
+        free(n);
+        return -1;
+    }
+
+    /* The nodes of the instance are counted as if they were inserted,
+       so that the nodes which follow are numbered alike. */
+    n->index = rt->nnodes;
+    rt->nnodes += s->nnodes;
+    rt->nleaves += s->nleaves;
+    while (rt->curr_node &&
+           (rt->curr_node->nchr == rt->curr_node->nchx)) {
+        rt->curr_node = rt->curr_node->p;
+    }
+    return 0;
+}
+
+int __htree_copy(__htree_node_t *n, __htree_node_t *s) {
+    __htree_child_t *c, *m;
+    __htree_node_t *k;
+    int i;
+
+    if (s->ref)
+        s = s->ref;
+    c = s->clist;
+    for (i = 0; c && (i < s->nchr); i++) {
+        if (!(k = (__htree_node_t *) calloc(1, sizeof(__htree_node_t))))
+            return -1;
+        if (!(m = (__htree_child_t *) malloc(sizeof(__htree_child_t)))) {
+            free(k);
+            return -1;
+        }
+        k->name = c->child->name;
+        k->rate = c->child->rate;
+        k->rname = c->child->rname;
+        k->mtype = c->child->mtype;
+        k->nchr = k->nchx = c->child->nchr;
+        k->rank = i;
+        k->p = n;
+        m->child = k;
+        if (n->clist) {
+            m->prev = n->clist->prev;
+            m->next = n->clist;
+            n->clist->prev->next = m;
+            n->clist->prev = m;
+        } else
+            n->clist = m->prev = m->next = m;
+        if (__htree_copy(k, c->child) < 0)
+            return -1;
+        c = c->next;
+    }
+    return 0;
+}
+
+void __htree_number(__htree_node_t *n, int *nodes, int *leaves) {
+    __htree_child_t *c;
+    int i;
+
+    n->index = (n->mtype == TASK) ? (*leaves)++ : *nodes;
+    (*nodes)++;
+    c = n->clist;
+    for (i = 0; c && (i < n->nchx); i++) {
+        __htree_number(c->child, nodes, leaves);
+        c = c->next;
+    }
+}
+
+void __htree_shared_free(struct __htree_rt_s *rt) {
+    __htree_shared_t *s;
+
+    while ((s = rt->shared)) {
+        rt->shared = s->next;
+        __htree_destroy(s->root);
+        free(s);
+    }
+}
+
+int htree_expand(struct __htree_rt_s *rt) {
+    __htree_node_t **q, *n;
+    __htree_child_t *c;
+    int i, j, k, nodes = 0, leaves = 0, err = 0;
+
+    if (!rt->shared)
+        return 0;
+    if (rt->htree && (q = (__htree_node_t **)
+                      malloc(sizeof(__htree_node_t *)*rt->nnodes))) {
+        /* The instances are found breadth first; their copies have
+           none. */
+        q[0] = rt->htree;
+        for (i = 0, k = 1; !err && (i < k); i++) {
+            n = q[i];
+            if (n->ref) {
+                err = __htree_copy(n, n->ref);
+                n->ref = NULL;
+                continue;
+            }
+            c = n->clist;
+            for (j = 0; c && (j < n->nchx) && (k < rt->nnodes); j++) {
+                q[k++] = c->child;
+                c = c->next;
+            }
+        }
+        free(q);
+        __htree_number(rt->htree, &nodes, &leaves);
+        rt->nnodes = nodes;
+        rt->nleaves = leaves;
+    } else
+        err = -1;
+    __htree_shared_free(rt);
+    return err;
+}
+
+void htree_names_free(struct __htree_rt_s *rt) {
+    char *c;
+
+    while ((c = rt->names.owned)) {
+        rt->names.owned = *(char **) c;
+        free(c);
+    }
+    free(rt->names.tab);
+    memset(&rt->names, 0, sizeof(__htree_names_t));
+}
+
 int htree_commit(void) {
-    /* Generate the source-sink lookup table. */
+    /* A precompiled tree is committed already. */
+    if (__htree_rt.sstab)
+        return 0;
+
+    /* Expand the shared subtrees, and generate the source-sink
+       lookup table. */
+    if (htree_expand(&__htree_rt) < 0)
+        return -1;
     __htree_generate_sstab(__htree_rt.htree, SOURCE_MEM, SINK_MEM);
     return 0;
 }
 
 int htree_final(void) {
-    __htree_destroy(__htree_rt.htree);
+    if (__htree_rt.image)
+        bin_release(&__htree_rt);
+    else
+        __htree_destroy(__htree_rt.htree);
+    __htree_shared_free(&__htree_rt);
     free(__htree_rt.sstab);
+    free(__htree_rt.rates);
+    htree_names_free(&__htree_rt);
     return 0;
 }
@@ -19,9 +19,9 @@
 #ifndef __PEPA_SKELTREE_H
 #define __PEPA_SKELTREE_H
 
+#include <stdio.h>
+
 #define MAX_SKEL_NAME 24   /* Max. length of skeleton names. */
-#define MAX_NSOURCES 50    /* Max. length of source list. */
-#define MAX_NSINKS 50      /* Max. length of sink list. */
 #define SHOW_INDEX 0x0000  /* Flag which shows node index. */
 #define SHOW_PRED  0x0001  /* Flag which shows predecessor skeleton. */
 #define SHOW_SUCC  0x0002  /* Flag which shows successor skeleton. */
@@ -62,8 +62,10 @@ typedef struct __htree_plist_s {
   a big deal because we can always group all the remaining siblings,
   except the first sibling into a single node. */
 struct __htree_node_s {
-    char name[256];         /* Name of the task. */
+    const char *name;       /* Name of the task (interned). */
     double rate;            /* Task rate. */
+    const char *rname;      /* Rate as an expression over named rates
+                               (interned), or NULL for a literal. */
     int nchr;               /* Number of children required. */
     int nchx;               /* Number of children created. */
     int index;              /* Node index in the hierarchy tree. */
@@ -76,12 +78,47 @@ struct __htree_node_s {
     __htree_plist_t sol;    /* Source index list. */
     __htree_plist_t sil;    /* Sink index list */
     __htree_plist_t temp;   /* Used for Deals and Farms. */
+    __htree_node_t *ref;    /* Shared subtree which the node stands for
+                               until the tree is committed, or NULL. */
 };
 
-/* Currently, we only support one skeleton hierarchy tree. Newer
-   versions should support multiple skeleton hierarchy trees by
-   maintating instances of the hierarchy tree data structure in the
-   following runtime system data structure. */
+/* Interned task names: every distinct name is kept once, and the
+   nodes share it (see htree_intern()). */
+typedef struct {
+    const char **tab;          /* Open addressing table. */
+    int n;                     /* Number of names. */
+    int size;                  /* Size of the table. */
+    char *owned;               /* Chain of the names which were copied. */
+} __htree_names_t;
+
+/* A named rate of a description (see "parser.y"). The tasks whose
+   rates refer to it keep the expression, so that the rates are
+   defined once at the top of the PEPA model. */
+typedef struct {
+    const char *name;          /* Name (interned). */
+    const char *expr;          /* Expression over other named rates
+                                  (interned), or NULL. */
+    double val;                /* Value. */
+} __htree_rate_t;
+
+/* A subtree which is described once, by a definition or a repetition
+   (see "parser.y"), and referred to by every node which is an
+   instance of it. The instances are expanded into subtrees of their
+   own when the tree is committed, as their source and sink lists
+   differ. */
+typedef struct __htree_shared_s {
+    const void *body;          /* Statements which the subtree is built
+                                  from (htree_body_t). */
+    __htree_node_t *root;      /* Root of the subtree. */
+    int nnodes;                /* Number of nodes in the subtree. */
+    int nleaves;               /* Number of leaf nodes. */
+    struct __htree_shared_s *next; /* Next shared subtree. */
+} __htree_shared_t;
+
+/* The runtime system holds a skeleton hierarchy tree. The global
+   instance below is the tree which is analysed; a parse builds its
+   own (see htree_parse_t), so that several descriptions can be parsed
+   at once. */
 struct __htree_rt_s {
     __htree_node_t *htree;     /* Skeleton hierarchy tree. */
     __htree_node_t *curr_node; /* Current node. */
@@ -90,18 +127,166 @@ struct __htree_rt_s {
     int nleaves;               /* Number of leaf nodes. */
     int node_sum;              /* Used to validate tree structure. */
     char **hnames;             /* Hostnames of available processes. */
+    __htree_names_t names;     /* Task names. */
+    void *image;               /* Precompiled tree which the tree was
+                                  loaded from, or NULL (see "bin.h"). */
+    __htree_shared_t *shared;  /* Shared subtrees, until commit. */
+    __htree_rate_t *rates;     /* Named rates, in order of definition. */
+    int nrates;                /* Number of named rates. */
+    int maxrates;              /* Allocated number of named rates. */
 };                             /* Runtime system. */
 extern struct __htree_rt_s __htree_rt;
 
+/* A statement of a description, as recorded by the parser. Tasks of
+   deals and farms are given with their parent (name is NULL when they
+   follow, as for pipes and the xdeal and xfarm patterns). A statement
+   whose pattern is UNKNOWN inserts n instances of the subtree which
+   its body describes or, without a body, defines the rate name. */
+typedef struct {
+    __htree_comp_t skel;       /* Pattern of the node, or UNKNOWN. */
+    int n;                     /* Number of children, or instances. */
+    const char *name;          /* Task name, or NULL. */
+    double rate;               /* Task rate. */
+    const char *rname;         /* Task rate over named rates, or NULL. */
+    const struct htree_body_s *body; /* Body of the instances. */
+    int line;                  /* Line of the description on which it
+                                  was parsed. */
+} htree_stmt_t;
+
+/* The statements of a subtree which is instantiated by statements of
+   a description. */
+typedef struct htree_body_s {
+    htree_stmt_t *stmts;       /* Statements of the subtree. */
+    int nstmts;                /* Number of statements. */
+} htree_body_t;
+
+/* A description file being parsed, with its reentrant scanner and the
+   tree which the parser builds. */
+typedef struct htree_parse_s {
+    struct __htree_rt_s rt;    /* Tree of the description. */
+    const char *fname;         /* Description file, from whose directory
+                                  included files are found. */
+    int depth;                 /* Nesting depth of included files. */
+    void *scanner;             /* Scanner (yyscan_t). */
+    void *buffer;              /* Scanner buffer over the mapping. */
+    char *map;                 /* Mapping of the file, or NULL. */
+    size_t map_size;           /* Size of the mapping. */
+    FILE *in;                  /* Stream, when the file is not mapped. */
+    char *str;                 /* Start of the string being scanned. */
+    char *copy;                /* Copy of it, when not mapped. */
+    size_t copy_len;           /* Length of the copy. */
+    size_t copy_max;           /* Allocated length of the copy. */
+    int errors;                /* Number of syntax errors. */
+    int line;                  /* Line being scanned. */
+    int record;                /* Record the statements, instead of
+                                  building the tree. */
+    htree_stmt_t *stmts;       /* Recorded statements. */
+    int nstmts;                /* Number of statements. */
+    int maxstmts;              /* Allocated number of statements. */
+    void *defs;                /* Definitions and bodies of subtrees
+                                  (see "parser.y"). */
+    void *deps;                /* Files included, which the parse of an
+                                  included file depends on (see
+                                  "include.c"), or NULL. */
+    void *incl;                /* Included files whose statements the
+                                  parse holds (see "include.c"). */
+    struct htree_parse_s *scope; /* Parse in whose scope an included
+                                  file which defines subtrees is
+                                  parsed, whose definitions, named
+                                  rates and names it shares, or NULL
+                                  (see "include.h"). */
+    int defines;               /* Number of subtrees defined, by the
+                                  file or the files it includes. */
+} htree_parse_t;
+
+/* Tree whose names the names of the parse p are interned with. */
+#define htree_parse_rt(p) ((p)->scope ? &(p)->scope->rt : &(p)->rt)
+
 /* Flags for output behaviour:
    1. If graph is set, .dot graphs are generated.
    2. If latex is set, a LaTeX file is generated.
    3. If output is set, the PEPA model is written into a file.
    4. If complete is set, everything is done (takes longer due to
    invocation of external applications such as dot, pdflatex
-   etc.). */
-extern int graph, latex, output, complete;
-extern char *fname;
+   etc.).
+   5. If solve is set, the underlying CTMC is derived and solved.
+   6. If symmetry is set, identical branches of farms are aggregated
+   while deriving the CTMC (implies solve).
+   7. If lump is set, the CTMC is aggregated by ordinary (1) or exact
+   (2) lumpability before it is solved (implies solve).
+   8. If fluid is set, the fluid approximation of the model is
+   integrated to equilibrium.
+   9. If simulate is set, the model is simulated in parallel
+   replications, using nthreads threads (all processors if 0).
+   10. If measures is set, the throughput of every activity and the
+   utilisation of every task are written into a .csv file (implies
+   solve).
+   11. If transient is set, it lists the time points at which the
+   transient throughput is computed (implies solve).
+   12. If passage is set, the distribution of the end-to-end latency
+   of a job is computed (implies solve).
+   13. If bounds is set, the throughput of every subtree is bounded
+   and estimated from the structure of the tree.
+   14. If decompose is set, the throughput of the top-level pipe is
+   approximated by decomposition into two-stage subsystems.
+   15. If compose is set, the tree is solved compositionally, every
+   subtree being replaced by a flow-equivalent server.
+   16. If sweep is set, it lists the task rates for which the model
+   is solved, on a state space derived once.
+   17. If sensitivity is set, the derivative of the throughput with
+   respect to the rate of every task is computed (implies solve).
+   18. If budget is set, the widths of the deals and farms which
+   maximise the throughput with at most budget tasks are searched
+   for, and the best tree is written into a description file.
+   19. If store is set, it is the directory in which the states,
+   transitions and probability vectors of the CTMC are kept in
+   memory-mapped files, and from which an interrupted steady state
+   solution is resumed (implies solve).
+   20. If compaction is set, the CTMC is derived with its visited
+   states stored compactly (implies solve): with hash compaction
+   (CTMC_HASH), states are told apart by fingerprints only, and the
+   state vectors are dropped once explored; in a decision diagram
+   (CTMC_MDD, see "mdd.h"), states are shared by their common parts.
+   21. If storage is set, the memory taken per state by the explicit
+   state table, hash compaction and a decision diagram is compared.
+   22. If binary is set, the committed tree is written into a
+   precompiled tree file, which is loaded instead of the description
+   when it is given as input.
+   23. If batch is set, the inputs are processed as a batch of
+   description files, on nthreads worker threads (see "batch.h").
+   24. If server is set, it is the Unix domain socket on which models
+   are generated and analysed on request, by nthreads worker threads
+   (see "server.h").
+   25. If cache is set, it is the directory (and size) of the cache
+   in which the models generated, and the reports of their analyses,
+   are kept and found again (see "cache.h"). */
+extern int graph, latex, output, complete, solve, symmetry, lump;
+extern int fluid, simulate, nthreads, measures, passage, bounds;
+extern int decompose, compose, sensitivity, budget, compaction, storage;
+extern int binary, batch;
+extern char *fname, *transient, *sweep, *store, *server, *cache;
+
+/* Longest name of a description (fname), after which the generated
+   files are named. */
+#define HTREE_NAME_MAX 1024
+
+/* Stream into which the PEPA model is written. */
+extern FILE *output_file;
+
+/* Stream into which the analyses write their reports: the standard
+   output, unless the report is being kept (see "cache.h"). */
+extern FILE *report_file;
+
+/* The source-sink skeleton/pattern matrix, which determines the
+   performance model of a task from the pattern combination of its
+   source and sink (see "pepa.c"). */
+extern int pattern_matrix[4][4];
+
+/* Find the greatest common divisor using Euclid's algorithm. */
+extern int gcd(int a, int b);
+
+/* Find the lowest common multiple. */
+#define lcm(a,b) (((a)*(b))/gcd((a),(b)))
 
 /* This function displays the stucture of the skeleton hierarchy
    tree. The flag determines which informations are displayed in the
@@ -114,15 +299,93 @@ extern int htree_display(unsigned short flags);
    which the structure of the tree cannot be changed. */
 extern int htree_commit(void);
 
+/* Generate the performance model of the tree of the runtime system,
+   into the files named after fname, and analyse it as the flags
+   request. The tree is finalised afterwards (see htree_final()).
+   Returns -1 if fname is longer than HTREE_NAME_MAX, or a file cannot
+   be written, or an analysis fails (the others are done all the
+   same), and 0 otherwise. */
+extern int generate(void);
+
+/* Deallocate the skeleton hierarchy tree of the runtime system. */
+extern int htree_final(void);
+
+/* Write the process definitions of the tasks, and the system
+   equation, of the committed tree into output_file. */
+extern int htree_define_tasks(void);
+extern int htree_define_model(void);
+
+/* Write the dot graph of the committed tree into the .dot file named
+   after fname. */
+extern int htree_write_graph(void);
+
 /* This function is used to display the source-sink lookup table.
    It is very useful while debugging. */
 extern int __htree_display_sstab(void);
 
+/* Intern the task name s in the runtime system rt: returns the one
+   copy of the name which is shared by all the nodes, or NULL if out
+   of memory. The first time a name is seen, it is copied if copy is
+   set; otherwise s itself is kept, and must stay valid as long as the
+   tree (the lexer passes names which point into the mapped
+   description file). */
+extern const char *htree_intern(struct __htree_rt_s *rt, const char *s,
+                                int copy);
+
 /* Insert a subtree node to the parent node. If the skeleton type if
-   TASK then we are required to have the function pointer to the
-   stage function as the variable argument. */
+   TASK then we are required to have the name, the rate and the
+   symbolic rate (or NULL) of the task as the variable arguments. */
 extern int __htree_insert_node(__htree_comp_t skel, int nchild, ...);
 
+/* The same, into the tree of the runtime system rt. */
+extern int htree_insert(struct __htree_rt_s *rt, __htree_comp_t skel,
+                        int nchild, ...);
+
+/* Insert the nodes of the statement s into the tree of rt. The
+   instances of a body are inserted as nodes which refer to one shared
+   subtree, which is built the first time. Returns -1, and reports the
+   line of the statement, if it does not fit in the tree (it follows
+   a complete tree, or its body overflows the pattern it completes),
+   or the body is not one subtree. */
+extern int htree_stmt(struct __htree_rt_s *rt, htree_stmt_t *s);
+
+/* Expand the shared subtrees of the tree of rt into subtrees of
+   their own, and deallocate them. */
+extern int htree_expand(struct __htree_rt_s *rt);
+
+/* Deallocate the interned names of rt. */
+extern void htree_names_free(struct __htree_rt_s *rt);
+
+/* Parse the description file fname into the tree of p, which is
+   cleared first (see "parser.y"). Large files are parsed in parallel,
+   on nthreads threads (see "chunk.h"), and a precompiled tree is
+   loaded, committed, instead of parsed (see "bin.h"). Included files
+   are spliced from a cache (see "include.h"). Returns -1 if the file cannot
+   be read, 1 on syntax errors, and 0 otherwise. Parses with different
+   contexts may run concurrently. */
+extern int htree_parse(htree_parse_t *p, char *fname);
+
+/* Parse with the scanner of p until the end of its input: the tree
+   is built, or the statements recorded if p->record is set. Returns 1
+   on syntax errors. */
+extern int htree_parse_scan(htree_parse_t *p);
+
+/* Deallocate the definitions and bodies of subtrees of p, and release
+   the included files it holds, which final_lex() does. */
+extern void htree_parse_free(htree_parse_t *p);
+
+/* Open the description file fname for the scanner of p, and release
+   them (see "lexer.l"). The task names of the tree of p point into
+   the mapped file, so final_lex() must wait until the tree is no
+   longer used. */
+extern int init_lex(htree_parse_t *p, char *fname);
+extern int final_lex(htree_parse_t *p);
+
+/* Open the scanner of p over the len bytes from offset off of the
+   file fd, which are mapped privately (fd may be closed afterwards).
+   Returns -1 if they cannot be mapped. */
+extern int init_lex_range(htree_parse_t *p, int fd, long off, size_t len);
+
 /* The function generates the source-sink lookup table.
    This table  contains, for every node, the source list,
    the sink list, and other relevant information that are
@@ -133,28 +396,36 @@ extern int __htree_generate_sstab(__htree_node_t *n, int source, int sink);
    the tree data structures.*/
 extern void __htree_destroy(__htree_node_t *n);
 
+/* Find the first leaf and the number of leaves in a subtree. Since
+   leaves are numbered in the order they are inserted, the leaves of
+   a subtree always have consecutive indices. */
+extern void __htree_leaf_range(__htree_node_t *n, int *first, int *count);
+
+/* Check if two subtrees have the same structure and rates. */
+extern int __htree_same_subtree(__htree_node_t *a, __htree_node_t *b);
+
 /* The following macros are used to insert nodes based on the
-   different patterns. As we can see, we have a generic function which
-   can be used to insert any type of node into the skeleton hierarchy
-   tree. These macros specialises this function to insert the
-   appropriate node type. */
-#define pipe(X) __htree_insert_node(PIPE, (X))
-#define deal(X,Y,R)                             \
-    {                                           \
-        short i;                                \
-        __htree_insert_node(DEAL, (X));         \
-        for (i = 0; i < (X); i++)               \
-            __htree_insert_node(TASK, 0, Y, R); \
+   different patterns into the tree of the runtime system T. As we can
+   see, we have a generic function which can be used to insert any
+   type of node into the skeleton hierarchy tree. These macros
+   specialises this function to insert the appropriate node type. */
+#define pipe(T,X) htree_insert((T), PIPE, (X))
+#define deal(T,X,Y,R)                                        \
+    {                                                        \
+        int i;                                               \
+        htree_insert((T), DEAL, (X));                        \
+        for (i = 0; i < (X); i++)                            \
+            htree_insert((T), TASK, 0, Y, R, (char *) NULL); \
     }
-#define xdeal(X) __htree_insert_node(DEAL, (X))
-#define farm(X,Y,R)                             \
-    {                                           \
-        short i;                                \
-        __htree_insert_node(FARM, (X));         \
-        for (i = 0; i < (X); i++)               \
-            __htree_insert_node(TASK, 0, Y, R); \
+#define xdeal(T,X) htree_insert((T), DEAL, (X))
+#define farm(T,X,Y,R)                                        \
+    {                                                        \
+        int i;                                               \
+        htree_insert((T), FARM, (X));                        \
+        for (i = 0; i < (X); i++)                            \
+            htree_insert((T), TASK, 0, Y, R, (char *) NULL); \
     }
-#define xfarm(X) __htree_insert_node(FARM, (X))
-#define task(X,R) __htree_insert_node(TASK, 0, X, R)
+#define xfarm(T,X) htree_insert((T), FARM, (X))
+#define task(T,X,R) htree_insert((T), TASK, 0, X, R, (char *) NULL)
 
 #endif /* __PEPA_SKELTREE_H */
@@ -0,0 +1,256 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which compute performance
+  measures from the steady state of the derived CTMC. The utilisation
+  of a task is the reward of the states in which it computes. Moves
+  are instantaneous, so their throughputs cannot be read off the
+  tangible states; instead, the moves which follow every timed
+  transition are replayed, weighted by the flow through the
+  transition. The states are split into ranges which are processed
+  by separate threads, each with its own work space and partial sums.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "reward.h"
+
+typedef struct {
+    ctmc_t *m;              /* Private copy of the CTMC. */
+    int from, to;           /* Range of states. */
+    double *u;              /* Partial utilisations. */
+    double *mx;             /* Partial move throughputs. */
+    int error;              /* Set if a replay failed. */
+} __reward_part_t;          /* Work of a thread. */
+
+/* Thread body: accumulate the rewards of a range of states. */
+static void *__reward_worker(void *arg);
+
+/* Average the measures of identical farm branches. */
+static void __reward_symmetrise(ctmc_t *m, reward_t *r);
+
+
+void *__reward_worker(void *arg) {
+    __reward_part_t *p = (__reward_part_t *) arg;
+    ctmc_t *m = p->m;
+    int s, i;
+
+    m->mflow = p->mx;
+    for (s = p->from; s < p->to; s++) {
+        if (m->pi[s] == 0.0)
+            continue;
+        for (i = 0; i < m->nleaves; i++) {
+            if (m->leaf[i].steps[m->state[s*m->nleaves + i]].act
+                != ACT_COMP)
+                continue;
+            p->u[i] += m->pi[s];
+            if (ctmc_fire(m, s, i, m->pi[s]*m->leaf[i].rate) < 0) {
+                p->error = 1;
+                return NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Branch of group g which contains task i, or -1. */
+static int __reward_branch(__ctmc_group_t *g, int i) {
+    int lo = 0, hi = g->nbranch - 1, mid;
+
+    if ((i < g->first[0]) || (i >= g->first[hi] + g->size))
+        return -1;
+    while (lo < hi) {
+        mid = (lo + hi + 1)/2;
+        if (g->first[mid] <= i)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return (i < g->first[lo] + g->size) ? lo : -1;
+}
+
+/* Under symmetry reduction, the state vectors keep the branches of a
+   group sorted, so a leaf index stands for a position rather than a
+   particular branch. Every branch is equally likely to occupy any
+   position, so the measures are averaged over the branches; groups
+   are visited innermost first, as they were built. */
+void __reward_symmetrise(ctmc_t *m, reward_t *r) {
+    __ctmc_group_t *g;
+    double *sum, y;
+    int i, j, o, b, bi, bk, q, c;
+
+    if (!(sum = (double *) malloc(sizeof(double)*(r->nmoves + 1))))
+        return;
+    for (i = 0; i < m->ngroups; i++) {
+        g = &m->group[i];
+        for (o = 0; o < g->size; o++) {
+            for (y = 0.0, b = 0; b < g->nbranch; b++)
+                y += r->u[g->first[b] + o];
+            for (b = 0; b < g->nbranch; b++)
+                r->u[g->first[b] + o] = y/g->nbranch;
+        }
+
+        /* A move is mapped onto branch 0 by shifting its endpoints
+           which lie inside the group. */
+        memset(sum, 0, sizeof(double)*(r->nmoves + 1));
+        for (j = 0; j < 2; j++)
+            for (q = 0; q < r->nmoves; q++) {
+                bi = __reward_branch(g, m->moves[2*q]);
+                bk = __reward_branch(g, m->moves[2*q + 1]);
+                if (((bi < 0) && (bk < 0)) ||
+                    ((bi >= 0) && (bk >= 0) && (bi != bk)))
+                    continue;
+                b = (bi >= 0) ? bi : bk;
+                c = ctmc_move_index
+                    (m, m->moves[2*q] - ((bi >= 0) ?
+                                         g->first[b] - g->first[0] : 0),
+                     m->moves[2*q + 1] - ((bk >= 0) ?
+                                          g->first[b] - g->first[0] : 0));
+                if (c < 0)
+                    continue;
+                if (j == 0)
+                    sum[c] += r->mx[q];
+                else
+                    r->mx[q] = sum[c]/g->nbranch;
+            }
+    }
+    free(sum);
+}
+
+/* For a description of the following function, see "reward.h". */
+reward_t *reward_compute(ctmc_t *m, int nthreads) {
+    __reward_part_t *p;
+    pthread_t *tid;
+    reward_t *r;
+    int i, j, n = 0, err = 0;
+
+    if (!m->pi || (ctmc_moves(m) < 0))
+        return NULL;
+    if (!(r = (reward_t *) calloc(1, sizeof(reward_t))))
+        return NULL;
+    r->nleaves = m->nleaves;
+    r->nmoves = m->nmoves;
+    if (!(r->u = (double *) calloc(m->nleaves, sizeof(double))) ||
+        !(r->x = (double *) calloc(m->nleaves, sizeof(double))) ||
+        !(r->mx = (double *) calloc(m->nmoves + 1, sizeof(double)))) {
+        reward_destroy(r);
+        return NULL;
+    }
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads > m->nstates)
+        nthreads = m->nstates;
+    if (nthreads < 1)
+        nthreads = 1;
+    p = (__reward_part_t *) calloc(nthreads, sizeof(__reward_part_t));
+    tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads);
+    if (!p || !tid) {
+        free(p);
+        free(tid);
+        reward_destroy(r);
+        return NULL;
+    }
+    for (i = 0; i < nthreads; i++) {
+        p[i].from = (int) ((long) m->nstates*i/nthreads);
+        p[i].to = (int) ((long) m->nstates*(i + 1)/nthreads);
+        if (!(p[i].m = ctmc_worker(m)) ||
+            !(p[i].u = (double *) calloc(m->nleaves, sizeof(double))) ||
+            !(p[i].mx = (double *) calloc(m->nmoves + 1, sizeof(double))) ||
+            pthread_create(&tid[i], NULL, __reward_worker, &p[i])) {
+            err = 1;
+            break;
+        }
+        n++;
+    }
+    for (i = 0; i < n; i++) {
+        pthread_join(tid[i], NULL);
+        err |= p[i].error;
+        for (j = 0; j < m->nleaves; j++)
+            r->u[j] += p[i].u[j];
+        for (j = 0; j < m->nmoves; j++)
+            r->mx[j] += p[i].mx[j];
+    }
+    for (i = 0; i < nthreads; i++) {
+        ctmc_worker_free(p[i].m);
+        free(p[i].u);
+        free(p[i].mx);
+    }
+    free(p);
+    free(tid);
+    if (err) {
+        reward_destroy(r);
+        return NULL;
+    }
+    if (m->ngroups)
+        __reward_symmetrise(m, r);
+    for (i = 0; i < m->nleaves; i++)
+        r->x[i] = r->u[i]*m->leaf[i].rate;
+    return r;
+}
+
+/* For a description of the following function, see "reward.h". */
+int reward_write(FILE *f, ctmc_t *m, reward_t *r, __htree_node_t **sstab) {
+    int i, k;
+
+    fprintf(f, "action,task,peer,name,rate,throughput,utilisation\n");
+    for (i = 0; i < r->nleaves; i++)
+        fprintf(f, "comp_%d,%d,,%s,%.9g,%.9g,%.9g\n", i, i,
+                sstab[i]->name, m->leaf[i].rate, r->x[i], r->u[i]);
+    for (k = 0; k < r->nmoves; k++) {
+        i = m->moves[2*k];
+        fprintf(f, "move_%d_%d,%d,%d,%s,,%.9g,\n", i, m->moves[2*k + 1],
+                i, m->moves[2*k + 1], sstab[i]->name, r->mx[k]);
+    }
+    fprintf(f, "workflow,,,,,%.9g,\n", r->w);
+    return 0;
+}
+
+void reward_destroy(reward_t *r) {
+    if (!r)
+        return;
+    free(r->u);
+    free(r->x);
+    free(r->mx);
+    free(r);
+}
+
+int htree_write_measures(ctmc_t *m) {
+    reward_t *r;
+    FILE *f;
+    char temp[256];
+    int i;
+
+    if (!(r = reward_compute(m, nthreads))) {
+        fprintf(report_file, "Could not compute the measures.\n");
+        return -1;
+    }
+    for (i = 0; i < r->nleaves; i++)
+        if (__htree_rt.sstab[i]->stype == UNKNOWN)
+            r->w += r->x[i];
+    sprintf(temp, "%scsv", fname);
+    if (!(f = fopen(temp, "w"))) {
+        perror("Could not create measures file");
+        reward_destroy(r);
+        return -1;
+    }
+    reward_write(f, m, r, __htree_rt.sstab);
+    fclose(f);
+    fprintf(report_file, "Measures: %d tasks, %d moves written to %s.\n",
+            r->nleaves, r->nmoves, temp);
+    reward_destroy(r);
+    return 0;
+}
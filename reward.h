@@ -0,0 +1,54 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to compute performance measures from the steady state of the
+  derived CTMC: the throughput of every activity and the utilisation
+  of every task. The functions are defined in "reward.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_REWARD_H
+#define __PEPA_REWARD_H
+
+#include <stdio.h>
+#include "ctmc.h"
+
+typedef struct {
+    int nleaves;            /* Number of tasks. */
+    double *u;              /* Utilisation of every task t_i. */
+    double *x;              /* Throughput of every comp_i. */
+    int nmoves;             /* Number of moves (see ctmc_moves()). */
+    double *mx;             /* Throughput of every move_i_k. */
+    double w;               /* Workflow throughput at the sink. */
+} reward_t;                 /* Steady state measures. */
+
+/* Compute the measures from the steady state probabilities of m,
+   splitting the states among nthreads threads (all processors if
+   nthreads < 1). Under symmetry reduction, the measures of identical
+   farm branches are averaged. */
+extern reward_t *reward_compute(ctmc_t *m, int nthreads);
+
+/* Write the measures as a comma separated table, with one row per
+   activity, keyed by the task indices and names of sstab. */
+extern int reward_write(FILE *f, ctmc_t *m, reward_t *r,
+                        __htree_node_t **sstab);
+
+/* Deallocate the measures. */
+extern void reward_destroy(reward_t *r);
+
+/* Compute the measures for the solved CTMC of the committed skeleton
+   hierarchy tree, and write them into a .csv file. */
+extern int htree_write_measures(ctmc_t *m);
+
+#endif /* __PEPA_REWARD_H */
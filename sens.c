@@ -0,0 +1,193 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which compute the sensitivity of
+  the workflow throughput to the task rates by a single adjoint
+  solve (see "sens.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "sens.h"
+
+/* Rate at which jobs leave the sink tasks in every state. */
+static void __sens_reward(ctmc_t *m, double *r) {
+    int s, i;
+
+    for (s = 0; s < m->nstates; s++)
+        for (r[s] = 0.0, i = 0; i < m->nleaves; i++)
+            if ((__htree_rt.sstab[i]->stype == UNKNOWN) &&
+                (m->leaf[i].steps[m->state[s*m->nleaves + i]].act
+                 == ACT_COMP))
+                r[s] += m->leaf[i].rate;
+}
+
+/* Solve Q h = X - r for h, with pi h = 0, by Gauss-Seidel sweeps over
+   the outgoing transitions. Returns the number of iterations, or -1
+   if it did not converge. */
+static int __sens_poisson(ctmc_t *m, double *r, double x, double *h,
+                          double tol, int maxiter) {
+    double y, d, a, p;
+    int s, k, it, ref = 0;
+
+    for (s = 0; s < m->nstates; s++) {
+        h[s] = 0.0;
+        if (m->pi[s] > m->pi[ref])
+            ref = s;
+    }
+
+    /* The solution is only defined up to a constant: h is pinned to
+       zero in a recurrent state (the initial states may not be),
+       whose equation follows from the others, and shifted at the
+       end. */
+    for (it = 1; it <= maxiter; it++) {
+        d = a = 0.0;
+        for (s = 0; s < m->nstates; s++) {
+            if ((s == ref) || (m->out[s] == 0.0))
+                continue; /* Pinned, or absorbing state. */
+            for (y = r[s] - x, k = m->row[s]; k < m->row[s + 1]; k++)
+                y += m->val[k]*h[m->col[k]];
+            y /= m->out[s];
+            if (fabs(y - h[s]) > d)
+                d = fabs(y - h[s]);
+            if (fabs(y) > a)
+                a = fabs(y);
+            h[s] = y;
+        }
+        if (d <= tol*a)
+            break;
+    }
+    for (p = 0.0, s = 0; s < m->nstates; s++)
+        p += m->pi[s]*h[s];
+    for (s = 0; s < m->nstates; s++)
+        h[s] -= p;
+    return (it > maxiter) ? -1 : it;
+}
+
+/* For a description of the following function, see "sens.h". */
+sens_t *sens_compute(ctmc_t *m, double tol, int maxiter) {
+    __ctmc_group_t *g;
+    sens_t *se;
+    double *r = NULL, *h = NULL, *coef = NULL, y;
+    int *trans = NULL, *leaf = NULL, n, s, k, i, o, b;
+
+    if (!m->pi)
+        return NULL;
+    if (!(se = (sens_t *) calloc(1, sizeof(sens_t))))
+        return NULL;
+    se->nleaves = m->nleaves;
+    if (!(se->d = (double *) calloc(m->nleaves, sizeof(double))) ||
+        !(se->e = (double *) calloc(m->nleaves, sizeof(double))) ||
+        !(r = (double *) malloc(sizeof(double)*m->nstates)) ||
+        !(h = (double *) malloc(sizeof(double)*m->nstates)) ||
+        ((n = ctmc_terms(m, &trans, &leaf, &coef)) < 0))
+        goto fail;
+    __sens_reward(m, r);
+    for (se->x = 0.0, s = 0; s < m->nstates; s++)
+        se->x += m->pi[s]*r[s];
+    if ((se->iter = __sens_poisson(m, r, se->x, h, tol, maxiter)) < 0)
+        goto fail;
+
+    /* pi dr/dc: the share of time a sink task computes. */
+    for (i = 0; i < m->nleaves; i++)
+        if (__htree_rt.sstab[i]->stype == UNKNOWN)
+            se->d[i] = ctmc_throughput(m, i)/m->leaf[i].rate;
+
+    /* pi (dQ/dc) h, term by term. The terms are recorded state by
+       state, so the source of a transition follows the rows. */
+    for (s = 0, k = 0; k < n; k++) {
+        while (trans[k] >= m->row[s + 1])
+            s++;
+        se->d[leaf[k]] += m->pi[s]*coef[k]*(h[m->col[trans[k]]] - h[s]);
+    }
+
+    for (i = 0; i < m->ngroups; i++) {
+        g = &m->group[i];
+        for (o = 0; o < g->size; o++) {
+            for (y = 0.0, b = 0; b < g->nbranch; b++)
+                y += se->d[g->first[b] + o];
+            for (b = 0; b < g->nbranch; b++)
+                se->d[g->first[b] + o] = y/g->nbranch;
+        }
+    }
+    for (i = 0; i < m->nleaves; i++)
+        se->e[i] = (se->x > 0.0) ? se->d[i]*m->leaf[i].rate/se->x : 0.0;
+    free(r);
+    free(h);
+    free(trans);
+    free(leaf);
+    free(coef);
+    return se;
+
+ fail:
+    free(r);
+    free(h);
+    free(trans);
+    free(leaf);
+    free(coef);
+    sens_destroy(se);
+    return NULL;
+}
+
+void sens_destroy(sens_t *s) {
+    if (!s)
+        return;
+    free(s->d);
+    free(s->e);
+    free(s);
+}
+
+/* Elasticities of the tasks being ranked. */
+static double *__sens_key;
+
+/* Larger elasticities first, then smaller indices. */
+static int __sens_cmp(const void *a, const void *b) {
+    int i = *(const int *) a, k = *(const int *) b;
+    double x = fabs(__sens_key[i]), y = fabs(__sens_key[k]);
+
+    return (x != y) ? (x < y) - (x > y) : i - k;
+}
+
+int htree_sensitivity(ctmc_t *m) {
+    sens_t *s;
+    double sum = 0.0;
+    int i, *rank;
+
+    if (!(s = sens_compute(m, SENS_TOLERANCE, SENS_MAXITER))) {
+        fprintf(report_file, "Could not compute the sensitivities.\n");
+        return -1;
+    }
+    if (!(rank = (int *) malloc(sizeof(int)*m->nleaves))) {
+        sens_destroy(s);
+        return -1;
+    }
+    for (i = 0; i < m->nleaves; i++) {
+        rank[i] = i;
+        sum += s->e[i];
+    }
+    __sens_key = s->e;
+    qsort(rank, m->nleaves, sizeof(int), __sens_cmp);
+    fprintf(report_file, "Sensitivity: %d iterations.\n", s->iter);
+    fprintf(report_file, "%-6s %-24s %12s %12s %12s\n", "Rank", "Task", "Rate",
+            "dX/dRate", "Elasticity");
+    for (i = 0; i < m->nleaves; i++)
+        fprintf(report_file, "%-6d t_%-4d %-17.17s %12f %12f %12f\n", i + 1,
+                rank[i], __htree_rt.sstab[rank[i]]->name,
+                m->leaf[rank[i]].rate, s->d[rank[i]], s->e[rank[i]]);
+    fprintf(report_file, "Sum of elasticities: %f\n", sum);
+    free(rank);
+    sens_destroy(s);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to compute the sensitivity of the workflow throughput to the
+  rate of every task, from the solved CTMC. The functions are
+  defined in "sens.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_SENS_H
+#define __PEPA_SENS_H
+
+#include "ctmc.h"
+
+#define SENS_TOLERANCE 1e-10 /* Convergence criterion. */
+#define SENS_MAXITER 100000  /* Max. Gauss-Seidel iterations. */
+
+/* The throughput is X = pi r, where r(s) is the rate at which jobs
+   leave the sink tasks in state s. Differentiating pi Q = 0 shows
+   that, for every rate c,
+
+       dX/dc = pi dr/dc + pi (dQ/dc) h
+
+   where h solves the Poisson equation Q h = X - r (with pi h = 0)
+   against the same generator. Since dQ/dc only has the terms of the
+   transitions fired by the task of rate c (see ctmc_terms()), one
+   solve for h gives the derivatives for all the tasks at once. The
+   elasticity (c/X) dX/dc is the relative gain of throughput for a
+   relative increase of rate. Because moves are instantaneous, X is
+   homogeneous of degree one in the rates, so the elasticities sum
+   to one. */
+typedef struct {
+    int nleaves;            /* Number of tasks. */
+    double x;               /* Workflow throughput. */
+    double *d;              /* Derivative dX/dc of every task t_i. */
+    double *e;              /* Elasticity of every task. */
+    int iter;               /* Iterations of the Poisson equation. */
+} sens_t;                   /* Sensitivities of the throughput. */
+
+/* Compute the sensitivities from the steady state probabilities of
+   m. Under symmetry reduction, those of identical farm branches are
+   averaged. Returns NULL on failure. */
+extern sens_t *sens_compute(ctmc_t *m, double tol, int maxiter);
+
+/* Deallocate the sensitivities. */
+extern void sens_destroy(sens_t *s);
+
+/* Compute the sensitivities for the solved CTMC of the committed
+   skeleton hierarchy tree, and display the tasks ranked by
+   elasticity. */
+extern int htree_sensitivity(ctmc_t *m);
+
+#endif /* __PEPA_SENS_H */
@@ -0,0 +1,730 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions of the server mode (see
+  "server.h"): an event loop over a Unix domain socket, which hands
+  the requests to a pool of worker threads.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "server.h"
+#include "ctmc.h"
+
+#define SERVER_CONNS 64          /* Most connections open at once. */
+#define SERVER_LINE 4096         /* Longest request line. */
+#define SERVER_TEXT (64 << 20)   /* Longest description sent as text. */
+#define SERVER_NAME 32           /* Longest name of a generated file. */
+#define SERVER_SOLVED 256        /* Solved models kept in the cache. */
+#define SERVER_FNV_BASIS 14695981039346656037UL
+#define SERVER_FNV_PRIME 1099511628211UL
+
+typedef enum {
+    REQ_PEPA = 0, /* PEPA model. */
+    REQ_DOT,      /* Dot graph. */
+    REQ_MEASURES  /* Steady state measures. */
+} __server_kind_t; /* What a request asks for. */
+
+typedef struct __server_req_s {
+    int conn;                 /* Connection of the client. */
+    int fd;                   /* Its socket. */
+    __server_kind_t kind;     /* What is asked for. */
+    char *path;               /* Description file. */
+    int temp;                 /* Set if the file holds the text of the
+                                 request, and is removed afterwards. */
+    struct timespec t0;       /* Time at which it was received. */
+    struct __server_req_s *next; /* Next request in the queue. */
+} __server_req_t;             /* Request handed to the workers. */
+
+typedef struct {
+    int fd;                   /* Socket, or -1 if the slot is free. */
+    char *buf;                /* Bytes received, not yet taken. */
+    size_t len;               /* Number of bytes received. */
+    size_t max;               /* Allocated size of buf. */
+    int busy;                 /* Set while a request is served. */
+} __server_conn_t;            /* Connection of a client. */
+
+typedef struct {
+    unsigned long hash;       /* Hash of the model (FNV-1a). */
+    char *model;              /* PEPA model, or NULL if the slot is
+                                 free. */
+    size_t mlen;              /* Length of the model. */
+    char *csv;                /* Its measures. */
+    size_t clen;              /* Length of the measures. */
+} __server_solved_t;          /* Solved model in the cache. */
+
+typedef struct {
+    char dir[32];             /* Private directory of the generated
+                                 files. */
+    int seq;                  /* Number of requests received. */
+    __server_conn_t conn[SERVER_CONNS]; /* Connections. */
+    __server_req_t *head;     /* First request in the queue. */
+    __server_req_t *tail;     /* Last request in the queue. */
+    int stop;                 /* Set when the workers are to stop. */
+    pthread_mutex_t lock;     /* Guards the queue, stop and the
+                                 response times. */
+    pthread_cond_t ready;     /* Signalled when a request is queued,
+                                 or the workers are to stop. */
+    pthread_mutex_t run;      /* Held while a model is generated from
+                                 the global runtime system; guards the
+                                 solved models. */
+    int wake[2];              /* Pipe, on which the workers tell the
+                                 event loop which connection is done. */
+    double *lat;              /* Response times, in seconds. */
+    int nlat;                 /* Number of requests answered. */
+    int maxlat;               /* Allocated number of response times. */
+    int nfailed;              /* Number of requests which failed. */
+    __server_solved_t solved[SERVER_SOLVED]; /* Solved models. */
+    int next;                 /* Slot of the next solved model. */
+    int nhits;                /* Number of models found solved. */
+} __server_t;                 /* Server. */
+
+static volatile sig_atomic_t __server_signal = 0;
+
+/* Generate the model of the request r from the runtime system into
+   out (of n bytes), which the caller deallocates. The run lock must
+   be held; the tree is finalised afterwards. */
+static int __server_generate(__server_t *s, __server_req_t *r, char **out,
+                             size_t *n);
+
+/* Serve the request r: parse it, generate what it asks for and send
+   the response. */
+static void __server_process(__server_t *s, __server_req_t *r);
+
+/* Thread body: serve the queued requests, until the server stops. */
+static void *__server_worker(void *arg);
+
+/* Take the next request of the connection i from the bytes received.
+   Returns 1 if a request was taken, 0 if it is yet incomplete (or
+   another one is being served), and -1 if the connection is to be
+   closed. */
+static int __server_request(__server_t *s, int i);
+
+
+static void __server_interrupt(int sig) {
+    __server_signal = sig;
+}
+
+static double __server_elapsed(struct timespec *t0, struct timespec *t1) {
+    return (t1->tv_sec - t0->tv_sec) + (t1->tv_nsec - t0->tv_nsec)*1e-9;
+}
+
+static int __server_cmp_double(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+static unsigned long __server_hash(const char *s, size_t n) {
+    unsigned long h = SERVER_FNV_BASIS;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        h = (h ^ (unsigned char) s[i])*SERVER_FNV_PRIME;
+    return h;
+}
+
+/* Read the whole file path into a new buffer of *n bytes. */
+static char *__server_slurp(const char *path, size_t *n) {
+    struct stat st;
+    char *b;
+    FILE *f;
+
+    if (!(f = fopen(path, "r")))
+        return NULL;
+    if (fstat(fileno(f), &st) ||
+        !(b = (char *) malloc(st.st_size + 1))) {
+        fclose(f);
+        return NULL;
+    }
+    *n = fread(b, 1, st.st_size, f);
+    fclose(f);
+    if (*n != (size_t) st.st_size) {
+        free(b);
+        return NULL;
+    }
+    return b;
+}
+
+/* Append the names of the tasks, in the order of the leaf-nodes of
+   the committed tree, to the model *p of *n bytes. */
+static int __server_names(char **p, size_t *n) {
+    const char *name;
+    size_t k, m = *n;
+    char *q;
+    int i;
+
+    for (i = 0; i < __htree_rt.nleaves; i++)
+        m += strlen(__htree_rt.sstab[i]->name ?
+                    __htree_rt.sstab[i]->name : "") + 1;
+    if (!(q = (char *) realloc(*p, m + 1)))
+        return -1;
+    for (i = 0; i < __htree_rt.nleaves; i++) {
+        name = __htree_rt.sstab[i]->name ? __htree_rt.sstab[i]->name : "";
+        k = strlen(name) + 1;
+        memcpy(q + *n, name, k);
+        *n += k;
+    }
+    *p = q;
+    return 0;
+}
+
+/* Send the response of the given status, with the n bytes of data. A
+   client which has gone away is ignored. */
+static void __server_send(int fd, const char *status, const char *data,
+                          size_t n) {
+    char head[64];
+    size_t k;
+    ssize_t w;
+
+    sprintf(head, "%s %lu\n", status, (unsigned long) n);
+    for (k = 0; k < strlen(head); k += w)
+        if ((w = send(fd, head + k, strlen(head) - k, MSG_NOSIGNAL)) <= 0)
+            return;
+    for (k = 0; k < n; k += w)
+        if ((w = send(fd, data + k, n - k, MSG_NOSIGNAL)) <= 0)
+            return;
+}
+
+static void __server_error(int fd, const char *msg) {
+    __server_send(fd, "error", msg, strlen(msg));
+}
+
+/* Summary of the response times, into buf. */
+static void __server_stats(__server_t *s, char *buf) {
+    double *t, sum = 0.0;
+    int i, n;
+
+    pthread_mutex_lock(&s->lock);
+    n = s->nlat;
+    if (n && (t = (double *) malloc(sizeof(double)*n))) {
+        memcpy(t, s->lat, sizeof(double)*n);
+        qsort(t, n, sizeof(double), __server_cmp_double);
+        for (i = 0; i < n; i++)
+            sum += t[i];
+
+        /* The p-th percentile is the smallest time which at least p%
+           of the requests took no longer than. */
+        sprintf(buf, "Server: %d requests, %d failed, %d solved models "
+                "reused; response time mean %.3fms, p50 %.3fms, p99 "
+                "%.3fms, max %.3fms.\n", n, s->nfailed, s->nhits,
+                1e3*sum/n, 1e3*t[(n - 1)/2], 1e3*t[(99*n + 99)/100 - 1],
+                1e3*t[n - 1]);
+        free(t);
+    } else
+        sprintf(buf, "Server: %d requests.\n", n);
+    pthread_mutex_unlock(&s->lock);
+}
+
+int __server_generate(__server_t *s, __server_req_t *r, char **out,
+                      size_t *n) {
+    __server_solved_t *e;
+    char temp[256], *model = NULL;
+    unsigned long h;
+    size_t m;
+    int i, saved, err = -1;
+
+    htree_commit();
+    sprintf(temp, "%spepa", fname);
+    if (!(output_file = fopen(temp, "w")))
+        goto done;
+    htree_define_tasks();
+    htree_define_model();
+    fclose(output_file);
+    output_file = NULL;
+    model = __server_slurp(temp, &m);
+    unlink(temp);
+    if (!model)
+        goto done;
+
+    switch (r->kind) {
+    case REQ_PEPA:
+        *out = model;
+        *n = m;
+        model = NULL;
+        err = 0;
+        break;
+    case REQ_DOT:
+        htree_write_graph();
+        sprintf(temp, "%sdot", fname);
+        err = (*out = __server_slurp(temp, n)) ? 0 : -1;
+        unlink(temp);
+        break;
+    case REQ_MEASURES:
+        /* A model is solved once: the same model, however it was
+           described, is answered with the measures it had. The
+           measures name the tasks, which the model does not. */
+        if (__server_names(&model, &m) < 0)
+            break;
+        h = __server_hash(model, m);
+        for (i = 0; i < SERVER_SOLVED; i++) {
+            e = &s->solved[i];
+            if (e->model && (e->hash == h) && (e->mlen == m) &&
+                !memcmp(e->model, model, m))
+                break;
+        }
+        if (i < SERVER_SOLVED) {
+            if ((*out = (char *) malloc(e->clen + 1))) {
+                memcpy(*out, e->csv, e->clen);
+                *n = e->clen;
+                s->nhits++;
+                err = 0;
+            }
+            break;
+        }
+        saved = measures;
+        measures = 1;
+        err = htree_solve();
+        measures = saved;
+        sprintf(temp, "%scsv", fname);
+        if (!err && !(*out = __server_slurp(temp, n)))
+            err = -1;
+        unlink(temp);
+        if (err)
+            break;
+
+        /* The oldest solved model makes room for the new one. */
+        e = &s->solved[s->next];
+        s->next = (s->next + 1) % SERVER_SOLVED;
+        free(e->model);
+        free(e->csv);
+        e->model = NULL;
+        if ((e->csv = (char *) malloc(*n + 1))) {
+            memcpy(e->csv, *out, *n);
+            e->clen = *n;
+            e->hash = h;
+            e->model = model;
+            e->mlen = m;
+            model = NULL;
+        }
+        break;
+    }
+
+ done:
+    free(model);
+    htree_final();
+    return err;
+}
+
+void __server_process(__server_t *s, __server_req_t *r) {
+    struct timespec t1;
+    htree_parse_t p;
+    char base[sizeof(s->dir) + SERVER_NAME + 3], msg[256], *out = NULL;
+    const char *name;
+    double *t;
+    size_t n = 0, k;
+    int err;
+
+    /* The files are generated into the private directory, named after
+       the description up to its extension, one model at a time. */
+    name = strrchr(r->path, '/') ? strrchr(r->path, '/') + 1 : r->path;
+    for (k = 0; name[k] && (name[k] != '.') && (k < SERVER_NAME); k++);
+    sprintf(base, "%s/%.*s.", s->dir, (int) k, name);
+
+    err = htree_parse(&p, r->path);
+    if (err)
+        sprintf(msg, "cannot parse %.200s", r->path);
+    else if (!p.rt.htree || p.rt.node_sum || (p.rt.nleaves < 1)) {
+        sprintf(msg, "%.200s is not a complete tree", r->path);
+        err = 1;
+    }
+
+    /* The tree of a request which failed is released all the same. */
+    pthread_mutex_lock(&s->run);
+    fname = base;
+    __htree_rt = p.rt;
+    if (!err) {
+        if ((err = __server_generate(s, r, &out, &n)))
+            sprintf(msg, "cannot generate %.200s", r->path);
+    } else
+        htree_final();
+    memset(&__htree_rt, 0, sizeof(struct __htree_rt_s));
+    fname = NULL;
+    pthread_mutex_unlock(&s->run);
+    final_lex(&p);
+    if (r->temp)
+        unlink(r->path);
+
+    /* The request is counted before it is answered, so that the
+       client finds it in the statistics it asks for next. */
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    pthread_mutex_lock(&s->lock);
+    if (s->nlat == s->maxlat) {
+        k = s->maxlat ? 2*s->maxlat : 1024;
+        if ((t = (double *) realloc(s->lat, sizeof(double)*k))) {
+            s->lat = t;
+            s->maxlat = k;
+        }
+    }
+    if (s->nlat < s->maxlat)
+        s->lat[s->nlat++] = __server_elapsed(&r->t0, &t1);
+    if (err)
+        s->nfailed++;
+    pthread_mutex_unlock(&s->lock);
+    if (err)
+        __server_error(r->fd, msg);
+    else
+        __server_send(r->fd, "ok", out, n);
+    free(out);
+}
+
+void *__server_worker(void *arg) {
+    __server_t *s = (__server_t *) arg;
+    __server_req_t *r;
+
+    while (1) {
+        pthread_mutex_lock(&s->lock);
+        while (!s->head && !s->stop)
+            pthread_cond_wait(&s->ready, &s->lock);
+        if ((r = s->head) && !(s->head = r->next))
+            s->tail = NULL;
+        pthread_mutex_unlock(&s->lock);
+        if (!r)
+            break;
+
+        /* The requests queued when the server stops are served. */
+        __server_process(s, r);
+        if (write(s->wake[1], &r->conn, sizeof(int)) < 0)
+            perror("Cannot wake the server");
+        free(r->path);
+        free(r);
+    }
+    return NULL;
+}
+
+int __server_request(__server_t *s, int i) {
+    __server_conn_t *c = &s->conn[i];
+    __server_req_t *r;
+    char line[SERVER_LINE + 1], word[16], how[16], *e;
+    size_t k, take, len = 0;
+    int fd, off = 0;
+
+    if (c->busy)
+        return 0;
+    if (!(e = (char *) memchr(c->buf, '\n', c->len))) {
+        if (c->len <= SERVER_LINE)
+            return 0;
+        __server_error(c->fd, "request too long");
+        return -1;
+    }
+    if ((k = e - c->buf) > SERVER_LINE) {
+        __server_error(c->fd, "request too long");
+        return -1;
+    }
+    memcpy(line, c->buf, k);
+    line[k] = '\0';
+    if (k && (line[k - 1] == '\r'))
+        line[k - 1] = '\0';
+    take = k + 1;
+    word[0] = how[0] = '\0';
+    sscanf(line, "%15s %15s %n", word, how, &off);
+
+    if (!strcmp(word, "stats") || !strcmp(word, "quit")) {
+        if (word[0] == 's')
+            __server_stats(s, line);
+        else {
+            line[0] = '\0';
+            pthread_mutex_lock(&s->lock);
+            s->stop = 1;
+            pthread_mutex_unlock(&s->lock);
+        }
+        __server_send(c->fd, "ok", line, strlen(line));
+    } else if (!(r = (__server_req_t *) calloc(1, sizeof(__server_req_t))))
+        return -1;
+    else {
+        r->kind = !strcmp(word, "dot") ? REQ_DOT :
+            !strcmp(word, "measures") ? REQ_MEASURES : REQ_PEPA;
+        if (strcmp(word, "pepa") && (r->kind == REQ_PEPA)) {
+            __server_error(c->fd, "unknown request");
+            free(r);
+            goto done;
+        }
+        if (!strcmp(how, "path") && off)
+            r->path = strdup(line + off);
+        else if (!strcmp(how, "text") && off) {
+            /* The text is kept in a file, as the parser maps it. */
+            if ((len = strtoul(line + off, NULL, 10)) > SERVER_TEXT) {
+                __server_error(c->fd, "description too long");
+                free(r);
+                return -1;
+            }
+            if (c->len < take + len) {
+                free(r);
+                return 0;
+            }
+            if ((r->path = (char *) malloc(sizeof(s->dir) + 16))) {
+                sprintf(r->path, "%s/r%d.des", s->dir, s->seq);
+                r->temp = 1;
+                if (((fd = open(r->path, O_WRONLY | O_CREAT | O_TRUNC,
+                                0600)) < 0) ||
+                    (write(fd, c->buf + take, len) != (ssize_t) len)) {
+                    free(r->path);
+                    r->path = NULL;
+                }
+                if (fd >= 0)
+                    close(fd);
+            }
+            take += len;
+        } else {
+            __server_error(c->fd, "expected path <file> or text <n>");
+            free(r);
+            goto done;
+        }
+        if (!r->path) {
+            __server_error(c->fd, "cannot take the description");
+            free(r);
+            goto done;
+        }
+        s->seq++;
+        r->conn = i;
+        r->fd = c->fd;
+        clock_gettime(CLOCK_MONOTONIC, &r->t0);
+        c->busy = 1;
+        pthread_mutex_lock(&s->lock);
+        if (s->tail)
+            s->tail->next = r;
+        else
+            s->head = r;
+        s->tail = r;
+        pthread_cond_signal(&s->ready);
+        pthread_mutex_unlock(&s->lock);
+    }
+
+ done:
+    memmove(c->buf, c->buf + take, c->len - take);
+    c->len -= take;
+    return 1;
+}
+
+static void __server_close(__server_t *s, int i) {
+    close(s->conn[i].fd);
+    free(s->conn[i].buf);
+    memset(&s->conn[i], 0, sizeof(__server_conn_t));
+    s->conn[i].fd = -1;
+}
+
+/* Take the requests of the connection i, as far as they go. */
+static void __server_take(__server_t *s, int i) {
+    int k = 0;
+
+    while (!s->stop && ((k = __server_request(s, i)) > 0))
+        ;
+    if (k < 0)
+        __server_close(s, i);
+}
+
+/* For a description of the following function, see "server.h". */
+int htree_serve(const char *path, int nworkers) {
+    struct pollfd fds[SERVER_CONNS + 2];
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    struct stat st;
+    sigset_t mask;
+    pthread_t *tid = NULL;
+    int *started = NULL, map[SERVER_CONNS + 2];
+    int lfd = -1, i, j, k, nfds, stop, err = -1;
+    char buf[512], *b;
+    __server_t *s;
+    ssize_t n;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "[ socket name too long: %s ]\n", path);
+        return -1;
+    }
+    if (!(s = (__server_t *) calloc(1, sizeof(__server_t))))
+        return -1;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_mutex_init(&s->run, NULL);
+    pthread_cond_init(&s->ready, NULL);
+    s->wake[0] = s->wake[1] = -1;
+    for (i = 0; i < SERVER_CONNS; i++)
+        s->conn[i].fd = -1;
+    strcpy(s->dir, "/tmp/wflow2pepa.XXXXXX");
+    if (!mkdtemp(s->dir)) {
+        perror("Cannot create the server directory");
+        s->dir[0] = '\0';
+        goto done;
+    }
+    /* The system call, and not the skeleton of "pepa.h". */
+    if ((pipe)(s->wake) < 0) {
+        perror("Cannot create the server pipe");
+        goto done;
+    }
+
+    /* A socket left behind by an earlier server is replaced. */
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (!lstat(path, &st) && S_ISSOCK(st.st_mode))
+        unlink(path);
+    if (((lfd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) ||
+        bind(lfd, (struct sockaddr *) &addr, sizeof(addr)) ||
+        listen(lfd, SERVER_CONNS)) {
+        fprintf(stderr, "[ cannot listen on %s: %s ]\n", path,
+                strerror(errno));
+        goto done;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = __server_interrupt;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    /* The signals are taken by the event loop, whose poll() they
+       interrupt, and not by the workers. */
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+    if (nworkers < 1)
+        nworkers = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nworkers < 1)
+        nworkers = 1;
+    tid = (pthread_t *) malloc(sizeof(pthread_t)*nworkers);
+    started = (int *) calloc(nworkers, sizeof(int));
+    if (!tid || !started)
+        goto done;
+    for (i = 0, k = 0; i < nworkers; i++)
+        k += (started[i] = !pthread_create(&tid[i], NULL, __server_worker,
+                                           s));
+    pthread_sigmask(SIG_UNBLOCK, &mask, NULL);
+    if (!k) {
+        fprintf(stderr, "[ cannot start the server workers ]\n");
+        goto done;
+    }
+    printf("Serving on %s with %d worker%s.\n", path, k,
+           (k > 1) ? "s" : "");
+    fflush(stdout);
+    err = 0;
+
+    /* The connections whose requests are being served are not
+       polled, so that their requests are answered in order. */
+    stop = 0;
+    while (!stop && !__server_signal) {
+        fds[0].fd = lfd;
+        fds[1].fd = s->wake[0];
+        for (nfds = 2, i = 0; i < SERVER_CONNS; i++)
+            if ((s->conn[i].fd >= 0) && !s->conn[i].busy) {
+                fds[nfds].fd = s->conn[i].fd;
+                map[nfds++] = i;
+            }
+        for (i = 0; i < nfds; i++) {
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
+        }
+        if (poll(fds, nfds, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("Cannot poll the server socket");
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            if ((n = read(s->wake[0], buf, sizeof(buf))) > 0)
+                for (j = 0; j + (int) sizeof(int) <= n; j += sizeof(int)) {
+                    memcpy(&i, buf + j, sizeof(int));
+                    s->conn[i].busy = 0;
+                    __server_take(s, i);
+                }
+        }
+        if (fds[0].revents & POLLIN) {
+            if ((k = accept(lfd, NULL, NULL)) >= 0) {
+                for (i = 0; (i < SERVER_CONNS) && (s->conn[i].fd >= 0);
+                     i++);
+                if (i < SERVER_CONNS)
+                    s->conn[i].fd = k;
+                else {
+                    __server_error(k, "too many connections");
+                    close(k);
+                }
+            }
+        }
+        for (j = 2; j < nfds; j++) {
+            i = map[j];
+            if (!fds[j].revents || (s->conn[i].fd != fds[j].fd) ||
+                s->conn[i].busy)
+                continue;
+            if (s->conn[i].max - s->conn[i].len < 65536) {
+                if (!(b = (char *) realloc(s->conn[i].buf,
+                                           s->conn[i].max + 65536))) {
+                    __server_close(s, i);
+                    continue;
+                }
+                s->conn[i].buf = b;
+                s->conn[i].max += 65536;
+            }
+            if ((n = read(s->conn[i].fd, s->conn[i].buf + s->conn[i].len,
+                          s->conn[i].max - s->conn[i].len)) <= 0) {
+                __server_close(s, i);
+                continue;
+            }
+            s->conn[i].len += n;
+            __server_take(s, i);
+        }
+        pthread_mutex_lock(&s->lock);
+        stop = s->stop;
+        pthread_mutex_unlock(&s->lock);
+    }
+
+ done:
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->ready);
+    pthread_mutex_unlock(&s->lock);
+    for (i = 0; tid && started && (i < nworkers); i++)
+        if (started[i])
+            pthread_join(tid[i], NULL);
+    if (!err) {
+        __server_stats(s, buf);
+        printf("%s", buf);
+    }
+    for (i = 0; i < SERVER_CONNS; i++)
+        if (s->conn[i].fd >= 0)
+            __server_close(s, i);
+    for (i = 0; i < SERVER_SOLVED; i++) {
+        free(s->solved[i].model);
+        free(s->solved[i].csv);
+    }
+    if (lfd >= 0) {
+        close(lfd);
+        unlink(path);
+    }
+    if (s->wake[0] >= 0) {
+        close(s->wake[0]);
+        close(s->wake[1]);
+    }
+    if (s->dir[0])
+        rmdir(s->dir);
+    free(s->lat);
+    free(tid);
+    free(started);
+    pthread_mutex_destroy(&s->lock);
+    pthread_mutex_destroy(&s->run);
+    pthread_cond_destroy(&s->ready);
+    free(s);
+    return err;
+}
@@ -0,0 +1,64 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes of the server mode, in
+  which one long-running process generates and analyses models on
+  request, over a Unix domain socket. The functions are defined in
+  "server.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_SERVER_H
+#define __PEPA_SERVER_H
+
+#include "pepa.h"
+
+/* A client sends requests over a connection, which it may keep open
+   for as many requests as it likes; they are answered in order. A
+   request is a line, which names what is asked for and the
+   description it is asked of:
+
+       pepa path <file>        the PEPA model (.pepa),
+       dot path <file>         the dot graph (.dot),
+       measures path <file>    the steady state measures (.csv, as
+                               with -t),
+
+   where <file> is a description file (or a precompiled tree) which
+   the server can read, or "text <n>" instead of "path <file>",
+   followed by the n bytes of the description itself (whose included
+   files are then best named by absolute paths). Besides, "stats"
+   asks for the number of requests served and their response times,
+   and "quit" stops the server. Every request is answered by
+
+       ok <n>                  followed by the n bytes asked for, or
+       error <n>               followed by a message of n bytes.
+
+   The main thread waits for the connections and reads the requests;
+   complete requests are handed to a pool of worker threads, which
+   parse them concurrently. The models are generated from the global
+   runtime system one at a time, under a lock, as in the batch mode
+   (see "batch.h"), and are analysed as the options the server was
+   started with request. The server keeps warm, from one request to
+   the next, the cache of the statements of included files (but not
+   of the files which define subtrees, which are parsed again every
+   time, see "include.h"), and the solved models: a model which was
+   solved before is answered without being solved again. */
+
+/* Serve requests on the Unix domain socket path, with nworkers worker
+   threads (all processors if nworkers < 1), until the server is
+   interrupted or asked to quit. The response times are reported
+   when it stops. Returns 0 on success, or -1 if the socket cannot be
+   set up. */
+extern int htree_serve(const char *path, int nworkers);
+
+#endif /* __PEPA_SERVER_H */
@@ -0,0 +1,629 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which simulate the PEPA model of
+  a committed skeleton hierarchy tree. The next comp activity is
+  chosen with a binary tree of propensity sums, so that only the
+  components whose local state changed are updated after an event.
+  The components affected by an event are found through the peer
+  lists of the moves, which correspond to the synchronisation sets of
+  the PEPA model. Replications run in parallel, each drawing random
+  numbers from its own counter-based stream, so that the result of a
+  replication does not depend on the thread that runs it.
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "ssa.h"
+
+typedef struct {
+    int j;                   /* Leaf waiting at a narrow step, */
+    unsigned int ep;         /* as long as it has not moved since. */
+} __ssa_wait_t;
+
+typedef struct {
+    ssa_t *s;                /* Model being simulated. */
+    unsigned long long key;  /* Random number stream of the run. */
+    unsigned long long ctr;  /* Position in the stream. */
+    __ctmc_lstate_t *v;      /* Local state of every leaf. */
+    unsigned int *ep;        /* Number of moves of every leaf. */
+    __ssa_wait_t **w;        /* Leaves registered with wide leaves. */
+    int *wn, *wmax;          /* Number and capacity of registrations. */
+    int size;                /* Leaves of the propensity tree. */
+    double *prop;            /* Binary tree of propensity sums. */
+    char *dirty;             /* Leaves which changed since the */
+    int *dl, nd;             /* last tangible state. */
+    int *mv, mtop, mmax;     /* Enabled moves (sender, receiver). */
+    double t, t0;            /* Current time, end of warm-up. */
+    double *since;           /* Time a leaf entered its comp step. */
+    double *busy;            /* Time spent in comp. */
+    long *count;             /* Number of comp completions. */
+    double *x, *u;           /* Estimates of the replication. */
+} __ssa_run_t;               /* Work space of a thread. */
+
+/* Run replication number rep. Returns -1 if the model deadlocks. */
+static int __ssa_replicate(__ssa_run_t *r, int rep);
+
+/* Resolve the moves enabled by the leaves which changed. */
+static int __ssa_settle(__ssa_run_t *r);
+
+/* Thread body: runs replications until the estimates are precise. */
+static void *__ssa_worker(void *arg);
+
+
+static int __ssa_cmp_int(const void *a, const void *b) {
+    return *(const int *) a - *(const int *) b;
+}
+
+/* SplitMix64 finaliser. Applied to a key and a counter it gives a
+   counter-based generator: the n-th number of a stream is a pure
+   function of the stream key and n. */
+static unsigned long long __ssa_mix(unsigned long long z) {
+    z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/* Uniform random number in (0, 1). */
+static double __ssa_uniform(__ssa_run_t *r) {
+    unsigned long long z;
+
+    z = __ssa_mix(r->key + (++r->ctr)*0x9e3779b97f4a7c15ULL);
+    return ((double) (z >> 11) + 0.5)*(1.0/9007199254740992.0);
+}
+
+/* Set the propensity of leaf i, and update the sums above it. */
+static void __ssa_set(__ssa_run_t *r, int i, double p) {
+    int k = r->size + i;
+
+    r->prop[k] = p;
+    for (k /= 2; k >= 1; k /= 2)
+        r->prop[k] = r->prop[2*k] + r->prop[2*k + 1];
+}
+
+/* Choose a leaf with probability proportional to its propensity. */
+static int __ssa_pick(__ssa_run_t *r) {
+    double x = __ssa_uniform(r)*r->prop[1];
+    int k = 1;
+
+    while (k < r->size) {
+        k *= 2;
+        if ((x >= r->prop[k]) && (r->prop[k + 1] > 0.0)) {
+            x -= r->prop[k];
+            k++;
+        }
+    }
+    return k - r->size;
+}
+
+/* Register leaf i with the wide peers of its current step. Stale
+   registrations are dropped before a list is grown. */
+static int __ssa_register(__ssa_run_t *r, int i) {
+    __ctmc_step_t *st = &r->s->leaf[i].steps[r->v[i]];
+    __ssa_wait_t *t;
+    int k, p, n;
+
+    if ((st->act == ACT_COMP) || (st->peers.n > SSA_WIDE))
+        return 0;
+    for (k = 0; k < st->peers.n; k++) {
+        p = st->peers.l[k];
+        if ((p < 0) || !r->s->wide[p])
+            continue;
+        if (r->wn[p] == r->wmax[p]) {
+            for (t = r->w[p], n = 0; n < r->wn[p]; )
+                if (t[n].ep != r->ep[t[n].j])
+                    t[n] = t[--r->wn[p]];
+                else
+                    n++;
+        }
+        if (r->wn[p] == r->wmax[p]) {
+            n = r->wmax[p] ? 2*r->wmax[p] : 8;
+            if (!(t = (__ssa_wait_t *)
+                  realloc(r->w[p], sizeof(__ssa_wait_t)*n)))
+                return -1;
+            r->w[p] = t;
+            r->wmax[p] = n;
+        }
+        r->w[p][r->wn[p]].j = i;
+        r->w[p][r->wn[p]++].ep = r->ep[i];
+    }
+    return 0;
+}
+
+/* Move leaf i to its next local state. */
+static int __ssa_advance(__ssa_run_t *r, int i) {
+    __ctmc_leaf_t *l = &r->s->leaf[i];
+
+    if (l->steps[r->v[i]].act == ACT_COMP) {
+        r->busy[i] += r->t - r->since[i];
+        r->count[i]++;
+    }
+    r->v[i] = (r->v[i] + 1) % l->nsteps;
+    r->ep[i]++;
+    if (l->steps[r->v[i]].act == ACT_COMP) {
+        r->since[i] = r->t;
+        __ssa_set(r, i, l->rate);
+    } else
+        __ssa_set(r, i, 0.0);
+    if (!r->dirty[i]) {
+        r->dirty[i] = 1;
+        r->dl[r->nd++] = i;
+    }
+    return __ssa_register(r, i);
+}
+
+/* Check if task i is ready to send to task k, and k to receive. */
+static int __ssa_enabled(__ssa_run_t *r, int i, int k) {
+    __ctmc_step_t *a = &r->s->leaf[i].steps[r->v[i]];
+    __ctmc_step_t *b = &r->s->leaf[k].steps[r->v[k]];
+
+    return (a->act == ACT_OUT) && (b->act == ACT_IN) &&
+        bsearch(&k, a->peers.l, a->peers.n, sizeof(int), __ssa_cmp_int) &&
+        bsearch(&i, b->peers.l, b->peers.n, sizeof(int), __ssa_cmp_int);
+}
+
+static int __ssa_push(__ssa_run_t *r, int i, int k) {
+    int *t;
+
+    if (r->mtop + 2 > r->mmax) {
+        if (!(t = (int *) realloc(r->mv, sizeof(int)*2*r->mmax)))
+            return -1;
+        r->mv = t;
+        r->mmax *= 2;
+    }
+    r->mv[r->mtop++] = i;
+    r->mv[r->mtop++] = k;
+    return 0;
+}
+
+/* Collect the enabled moves between leaf l and leaf k. A move
+   between two changed leaves is collected from the sender side only. */
+static int __ssa_candidate(__ssa_run_t *r, __ctmc_step_t *s, int l, int k) {
+    if (s->act == ACT_OUT)
+        return __ssa_enabled(r, l, k) ? __ssa_push(r, l, k) : 0;
+    if (!r->dirty[k] && __ssa_enabled(r, k, l))
+        return __ssa_push(r, k, l);
+    return 0;
+}
+
+/* Collect the moves with the leaves registered with wide leaf l. */
+static int __ssa_waiting(__ssa_run_t *r, int l) {
+    __ctmc_step_t *s = &r->s->leaf[l].steps[r->v[l]];
+    __ssa_wait_t *t = r->w[l];
+    int j = 0;
+
+    while (j < r->wn[l]) {
+        if (t[j].ep != r->ep[t[j].j]) {
+            t[j] = t[--r->wn[l]];
+            continue;
+        }
+        if (__ssa_candidate(r, s, l, t[j++].j))
+            return -1;
+    }
+    return 0;
+}
+
+/* When the leaves registered with a single wide leaf l are the only
+   candidates, one of them is chosen by rejection instead of
+   collecting all of them: every valid registration is equally
+   likely, so the move is still chosen uniformly. Returns 0 if the
+   attempts failed, and the caller must collect the moves. */
+static int __ssa_sample(__ssa_run_t *r, int l) {
+    __ctmc_step_t *s = &r->s->leaf[l].steps[r->v[l]];
+    __ssa_wait_t *t = r->w[l];
+    int j, n;
+
+    for (n = 0; (n < SSA_WIDE) && (r->wn[l] > 0); ) {
+        j = (int) (__ssa_uniform(r)*r->wn[l]);
+        if (j >= r->wn[l])
+            j = r->wn[l] - 1;
+        if (t[j].ep != r->ep[t[j].j]) {
+            t[j] = t[--r->wn[l]];
+            continue;
+        }
+        if (__ssa_candidate(r, s, l, t[j].j))
+            return -1;
+        if (r->mtop)
+            return 1;
+        n++;
+    }
+    return r->wn[l] ? 0 : 1;
+}
+
+/* Only moves involving a leaf which changed can have become enabled,
+   since the previous state was tangible. */
+static int __ssa_moves(__ssa_run_t *r) {
+    __ctmc_step_t *s;
+    __htree_plist_t *d;
+    int i, j, k, l, nw = 0, wl = -1, wide;
+
+    r->mtop = 0;
+    for (i = 0; i < r->nd; i++) {
+        l = r->dl[i];
+        s = &r->s->leaf[l].steps[r->v[l]];
+        if (s->act == ACT_COMP)
+            continue;
+        d = &r->s->direct[l][r->v[l]];
+        wide = (s->peers.n > SSA_WIDE);
+        for (j = 0; j < d->n; j++) {
+            k = d->l[j];
+            if ((k < 0) || (wide && (r->s->leaf[k].steps[r->v[k]].peers.n
+                                     <= SSA_WIDE)))
+                continue;
+            if (__ssa_candidate(r, s, l, k))
+                return -1;
+        }
+        if (wide) {
+            nw++;
+            wl = l;
+        }
+    }
+    if ((nw == 1) && (r->mtop == 0) &&
+        ((k = __ssa_sample(r, wl)) != 0))
+        return (k < 0) ? -1 : r->mtop/2;
+    for (i = 0; nw && i < r->nd; i++) {
+        l = r->dl[i];
+        s = &r->s->leaf[l].steps[r->v[l]];
+        if ((s->act != ACT_COMP) && (s->peers.n > SSA_WIDE) &&
+            __ssa_waiting(r, l))
+            return -1;
+    }
+    return r->mtop/2;
+}
+
+int __ssa_settle(__ssa_run_t *r) {
+    int i, k, n = 0;
+
+    while ((k = __ssa_moves(r)) > 0) {
+        if (++n > 64*r->s->nleaves + 1024) {
+            fprintf(report_file, "Instantaneous moves do not terminate.\n");
+            return -1;
+        }
+        i = (int) (__ssa_uniform(r)*k);
+        if (i >= k)
+            i = k - 1;
+        if (__ssa_advance(r, r->mv[2*i]) ||
+            __ssa_advance(r, r->mv[2*i + 1]))
+            return -1;
+    }
+    for (i = 0; i < r->nd; i++)
+        r->dirty[r->dl[i]] = 0;
+    r->nd = 0;
+    return k;
+}
+
+int __ssa_replicate(__ssa_run_t *r, int rep) {
+    ssa_t *s = r->s;
+    int i, n = s->nleaves;
+    long e;
+
+    r->key = __ssa_mix(SSA_SEED + (unsigned long long) rep*
+                       0x9e3779b97f4a7c15ULL);
+    r->ctr = 0;
+    r->t = 0.0;
+    memset(r->prop, 0, sizeof(double)*2*r->size);
+    memset(r->wn, 0, sizeof(int)*n);
+    for (i = 0; i < n; i++) {
+        r->v[i] = 0;
+        r->ep[i] = 0;
+        r->since[i] = 0.0;
+        if (s->leaf[i].steps[0].act == ACT_COMP)
+            __ssa_set(r, i, s->leaf[i].rate);
+        r->dirty[i] = 1;
+        r->dl[i] = i;
+    }
+    r->nd = n;
+    for (i = 0; i < n; i++)
+        if (__ssa_register(r, i))
+            return -1;
+    if (__ssa_settle(r) < 0)
+        return -1;
+    for (e = 0; e < SSA_WARMUP + SSA_EVENTS; e++) {
+        if (e == SSA_WARMUP) {
+            r->t0 = r->t;
+            for (i = 0; i < n; i++) {
+                r->since[i] = r->t;
+                r->busy[i] = 0.0;
+                r->count[i] = 0;
+            }
+        }
+        if (r->prop[1] <= 0.0) {
+            fprintf(report_file, "Simulation reached a deadlock.\n");
+            return -1;
+        }
+        r->t -= log(__ssa_uniform(r))/r->prop[1];
+        if (__ssa_advance(r, __ssa_pick(r)) || (__ssa_settle(r) < 0))
+            return -1;
+    }
+    for (i = 0; i < n; i++) {
+        if (s->leaf[i].steps[r->v[i]].act == ACT_COMP)
+            r->busy[i] += r->t - r->since[i];
+        r->x[i] = r->count[i]/(r->t - r->t0);
+        r->u[i] = r->busy[i]/(r->t - r->t0);
+    }
+    return 0;
+}
+
+void *__ssa_worker(void *arg) {
+    __ssa_run_t *r = (__ssa_run_t *) arg;
+    ssa_t *s = r->s;
+    double w;
+    int i, rep;
+
+    while (1) {
+        pthread_mutex_lock(&s->lock);
+        if (s->done || (s->next >= s->maxreps)) {
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        rep = s->next++;
+        pthread_mutex_unlock(&s->lock);
+
+        if (__ssa_replicate(r, rep) < 0) {
+            pthread_mutex_lock(&s->lock);
+            s->error = s->done = 1;
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        for (w = 0.0, i = 0; i < s->nleaves; i++)
+            if (s->sink[i])
+                w += r->x[i];
+
+        pthread_mutex_lock(&s->lock);
+        for (i = 0; i < s->nleaves; i++) {
+            s->sx[i] += r->x[i];
+            s->sxx[i] += r->x[i]*r->x[i];
+            s->su[i] += r->u[i];
+            s->suu[i] += r->u[i]*r->u[i];
+        }
+        s->sw += w;
+        s->sww += w*w;
+        s->events += SSA_WARMUP + SSA_EVENTS;
+        if ((++s->nreps >= SSA_MINREPS) &&
+            (ssa_halfwidth(s->sw, s->sww, s->nreps) <=
+             s->precision*s->sw/s->nreps))
+            s->done = 1;
+        pthread_mutex_unlock(&s->lock);
+    }
+    return NULL;
+}
+
+/* Two-sided 97.5% quantiles of Student's t distribution. */
+static const double __ssa_t975[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+    2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+    2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+    2.048, 2.045, 2.042
+};
+
+double ssa_halfwidth(double sum, double sumsq, int n) {
+    double var;
+
+    if (n < 2)
+        return HUGE_VAL;
+    if ((var = (sumsq - sum*sum/n)/(n - 1)) < 0.0)
+        var = 0.0;
+    return ((n - 1 <= 30) ? __ssa_t975[n - 2] : 1.96)*sqrt(var/n);
+}
+
+/* For a description of the following function, see "ssa.h". */
+ssa_t *ssa_create(__htree_node_t **sstab, int nleaves) {
+    ssa_t *s;
+    __ctmc_step_t *st;
+    __htree_plist_t *d;
+    int i, j, k;
+
+    if (!(s = (ssa_t *) calloc(1, sizeof(ssa_t))))
+        return NULL;
+    s->nleaves = nleaves;
+    pthread_mutex_init(&s->lock, NULL);
+    if (!(s->leaf = (__ctmc_leaf_t *)
+          calloc(nleaves, sizeof(__ctmc_leaf_t))) ||
+        !(s->sink = (int *) calloc(nleaves, sizeof(int))) ||
+        !(s->direct = (__htree_plist_t **)
+          calloc(nleaves, sizeof(__htree_plist_t *))) ||
+        !(s->wide = (char *) calloc(nleaves, sizeof(char))) ||
+        !(s->sx = (double *) calloc(nleaves, sizeof(double))) ||
+        !(s->sxx = (double *) calloc(nleaves, sizeof(double))) ||
+        !(s->su = (double *) calloc(nleaves, sizeof(double))) ||
+        !(s->suu = (double *) calloc(nleaves, sizeof(double)))) {
+        ssa_destroy(s);
+        return NULL;
+    }
+    for (i = 0; i < nleaves; i++) {
+        if (ctmc_leaf_def(sstab[i], &s->leaf[i]) < 0) {
+            ssa_destroy(s);
+            return NULL;
+        }
+        s->sink[i] = (sstab[i]->stype == UNKNOWN);
+        for (k = 0; k < s->leaf[i].nsteps; k++)
+            if (s->leaf[i].steps[k].peers.n > SSA_WIDE)
+                s->wide[i] = 1;
+    }
+
+    /* The peers of a narrow step are always checked. The peers of a
+       wide step are checked only if they are wide themselves; the
+       others register when they are ready. */
+    for (i = 0; i < nleaves; i++) {
+        if (!(s->direct[i] = (__htree_plist_t *)
+              calloc(s->leaf[i].nsteps, sizeof(__htree_plist_t)))) {
+            ssa_destroy(s);
+            return NULL;
+        }
+        for (k = 0; k < s->leaf[i].nsteps; k++) {
+            st = &s->leaf[i].steps[k];
+            d = &s->direct[i][k];
+            if (!(d->l = (int *) malloc(sizeof(int)*(st->peers.n + 1)))) {
+                ssa_destroy(s);
+                return NULL;
+            }
+            for (j = 0; j < st->peers.n; j++)
+                if ((st->peers.n <= SSA_WIDE) ||
+                    ((st->peers.l[j] >= 0) && s->wide[st->peers.l[j]]))
+                    d->l[d->n++] = st->peers.l[j];
+        }
+    }
+    return s;
+}
+
+static void __ssa_run_free(__ssa_run_t *r) {
+    int i;
+
+    if (r->w)
+        for (i = 0; i < r->s->nleaves; i++)
+            free(r->w[i]);
+    free(r->w);
+    free(r->wn);
+    free(r->wmax);
+    free(r->ep);
+    free(r->v);
+    free(r->prop);
+    free(r->dirty);
+    free(r->dl);
+    free(r->mv);
+    free(r->since);
+    free(r->busy);
+    free(r->count);
+    free(r->x);
+    free(r->u);
+}
+
+static int __ssa_run_init(__ssa_run_t *r, ssa_t *s) {
+    int n = s->nleaves;
+
+    memset(r, 0, sizeof(__ssa_run_t));
+    r->s = s;
+    for (r->size = 1; r->size < n; r->size *= 2);
+    r->mmax = 64;
+    if (!(r->v = (__ctmc_lstate_t *) malloc(sizeof(__ctmc_lstate_t)*n)) ||
+        !(r->ep = (unsigned int *) malloc(sizeof(unsigned int)*n)) ||
+        !(r->w = (__ssa_wait_t **) calloc(n, sizeof(__ssa_wait_t *))) ||
+        !(r->wn = (int *) calloc(n, sizeof(int))) ||
+        !(r->wmax = (int *) calloc(n, sizeof(int))) ||
+        !(r->prop = (double *) malloc(sizeof(double)*2*r->size)) ||
+        !(r->dirty = (char *) calloc(n, sizeof(char))) ||
+        !(r->dl = (int *) malloc(sizeof(int)*n)) ||
+        !(r->mv = (int *) malloc(sizeof(int)*r->mmax)) ||
+        !(r->since = (double *) malloc(sizeof(double)*n)) ||
+        !(r->busy = (double *) malloc(sizeof(double)*n)) ||
+        !(r->count = (long *) malloc(sizeof(long)*n)) ||
+        !(r->x = (double *) malloc(sizeof(double)*n)) ||
+        !(r->u = (double *) malloc(sizeof(double)*n))) {
+        __ssa_run_free(r);
+        return -1;
+    }
+    return 0;
+}
+
+/* For a description of the following function, see "ssa.h". */
+int ssa_run(ssa_t *s, int nthreads, double precision, int maxreps) {
+    __ssa_run_t *r;
+    pthread_t *tid;
+    int i, n = 0;
+
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads < 1)
+        nthreads = 1;
+    s->precision = precision;
+    s->maxreps = maxreps;
+    if (!(r = (__ssa_run_t *) calloc(nthreads, sizeof(__ssa_run_t))) ||
+        !(tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads))) {
+        free(r);
+        return -1;
+    }
+    for (i = 0; i < nthreads; i++) {
+        if (__ssa_run_init(&r[i], s) ||
+            pthread_create(&tid[i], NULL, __ssa_worker, &r[i]))
+            break;
+        n++;
+    }
+    for (i = 0; i < n; i++)
+        pthread_join(tid[i], NULL);
+    for (i = 0; i < nthreads; i++)
+        __ssa_run_free(&r[i]);
+    free(r);
+    free(tid);
+    return ((n == 0) || s->error) ? -1 : s->nreps;
+}
+
+void ssa_destroy(ssa_t *s) {
+    int i, k;
+
+    if (!s)
+        return;
+    if (s->direct)
+        for (i = 0; i < s->nleaves; i++) {
+            if (s->direct[i])
+                for (k = 0; k < s->leaf[i].nsteps; k++)
+                    free(s->direct[i][k].l);
+            free(s->direct[i]);
+        }
+    if (s->leaf)
+        for (i = 0; i < s->nleaves; i++)
+            ctmc_leaf_free(&s->leaf[i]);
+    pthread_mutex_destroy(&s->lock);
+    free(s->leaf);
+    free(s->sink);
+    free(s->direct);
+    free(s->wide);
+    free(s->sx);
+    free(s->sxx);
+    free(s->su);
+    free(s->suu);
+    free(s);
+}
+
+int htree_simulate(void) {
+    ssa_t *s;
+    struct timespec t0, t1;
+    double el;
+    int i, n;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    if (!(s = ssa_create(__htree_rt.sstab, __htree_rt.nleaves))) {
+        fprintf(report_file, "Could not build the simulation model.\n");
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    n = ssa_run(s, nthreads, SSA_PRECISION, SSA_MAXREPS);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (n < 1) {
+        fprintf(report_file, "Simulation failed.\n");
+        ssa_destroy(s);
+        return -1;
+    }
+    el = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec)*1e-9;
+    fprintf(report_file, "Simulation: %d replications, %ld events in %.2fs "
+            "(%.0f events/s).\n", n, s->events, el,
+            (el > 0.0) ? s->events/el : 0.0);
+    fprintf(report_file, "%-8s %-16s %12s %10s %12s %10s\n", "Task", "Name",
+            "Throughput", "+/-", "Utilisation", "+/-");
+    for (i = 0; i < s->nleaves; i++)
+        fprintf(report_file, "t_%-6d %-16s %12f %10f %12f %10f\n", i,
+                __htree_rt.sstab[i]->name, s->sx[i]/n,
+                ssa_halfwidth(s->sx[i], s->sxx[i], n), s->su[i]/n,
+                ssa_halfwidth(s->su[i], s->suu[i], n));
+    fprintf(report_file, "Throughput: %f +/- %f\n", s->sw/n,
+            ssa_halfwidth(s->sw, s->sww, n));
+    ssa_destroy(s);
+    return 0;
+}
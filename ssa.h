@@ -0,0 +1,89 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to estimate the performance of a committed skeleton hierarchy
+  tree by stochastic simulation (Gillespie's direct method), for
+  models whose state space is too large to be solved numerically.
+  The functions are defined in "ssa.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_SSA_H
+#define __PEPA_SSA_H
+
+#include <pthread.h>
+#include "ctmc.h"
+
+#define SSA_SEED 0x5eed2006ULL /* Seed of the random number streams. */
+#define SSA_WARMUP 10000       /* Events discarded per replication. */
+#define SSA_EVENTS 200000      /* Events measured per replication. */
+#define SSA_MINREPS 10         /* Min. number of replications. */
+#define SSA_MAXREPS 1000       /* Max. number of replications. */
+#define SSA_PRECISION 0.01     /* Relative half-width of the 95% CI. */
+#define SSA_WIDE 16            /* Peer lists longer than this are wide. */
+
+/* Every replication is an independent run of the model, starting
+   from the initial state. Only timed comp activities are events;
+   the moves they enable are resolved instantaneously, choosing among
+   simultaneously enabled moves with equal probability, exactly as
+   when the CTMC is derived (see "ctmc.c").
+
+   Scanning every peer of a wide step (such as the emitter of a farm)
+   after every event would make the cost of an event grow with the
+   width of the farm. Instead, a leaf which enters a narrow step
+   registers itself with those of its peers that have wide steps, and
+   a leaf at a wide step only checks the leaves registered with it,
+   plus the peers which may themselves be at a wide step (direct). */
+typedef struct {
+    int nleaves;           /* Number of sequential components. */
+    __ctmc_leaf_t *leaf;   /* Components, indexed as in sstab. */
+    int *sink;             /* Non-zero for leaves at the sink. */
+    __htree_plist_t **direct; /* Peers to check at every step. */
+    char *wide;            /* Non-zero for leaves with wide steps. */
+    double precision;      /* Required relative precision. */
+    int maxreps;           /* Max. number of replications. */
+
+    pthread_mutex_t lock;  /* Protects everything below. */
+    int next;              /* Next replication to start. */
+    int done;              /* Set when the estimates are precise. */
+    int error;             /* Set if a replication failed. */
+    int nreps;             /* Number of completed replications. */
+    long events;           /* Total number of events simulated. */
+    double *sx, *sxx;      /* Sums of throughputs (and squares). */
+    double *su, *suu;      /* Sums of utilisations (and squares). */
+    double sw, sww;        /* Sums of workflow throughputs. */
+} ssa_t;                   /* Simulation model and its estimates. */
+
+/* Build the simulation model from the source-sink lookup table of a
+   committed skeleton hierarchy tree. */
+extern ssa_t *ssa_create(__htree_node_t **sstab, int nleaves);
+
+/* Run independent replications on nthreads threads (all processors
+   if nthreads < 1) until the 95% confidence interval of the workflow
+   throughput is within the given relative precision, or maxreps
+   replications are done. Returns the number of replications. */
+extern int ssa_run(ssa_t *s, int nthreads, double precision, int maxreps);
+
+/* Half-width of the 95% confidence interval of an estimate, from the
+   sum and sum of squares of n observations. */
+extern double ssa_halfwidth(double sum, double sumsq, int n);
+
+/* Deallocate the simulation model. */
+extern void ssa_destroy(ssa_t *s);
+
+/* Simulate the committed skeleton hierarchy tree, and display the
+   throughput and utilisation of every task. */
+extern int htree_simulate(void);
+
+#endif /* __PEPA_SSA_H */
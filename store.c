@@ -0,0 +1,261 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions of the out-of-core store, which
+  keeps arrays in memory-mapped files (see "store.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "store.h"
+#include "pepa.h"
+
+typedef struct __store_map_s {
+    char *base;                 /* Start of the mapping. */
+    size_t size;                /* Its size in bytes. */
+    int fd;                     /* File descriptor of the file. */
+    struct __store_map_s *next; /* Next mapping. */
+} __store_map_t;                /* Mapped array. */
+
+static char *__store_dir = NULL;         /* Directory of the store. */
+static __store_map_t *__store_maps = NULL; /* Mapped arrays. */
+static size_t __store_now = 0, __store_peak = 0; /* Mapped bytes. */
+static pthread_mutex_t __store_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+/* Find the mapping which contains p; the lock must be held. */
+static __store_map_t *__store_find(void *p) {
+    __store_map_t *r;
+
+    for (r = __store_maps; r; r = r->next)
+        if (((char *) p >= r->base) && ((char *) p < r->base + r->size))
+            return r;
+    return NULL;
+}
+
+/* Size the file fd to size bytes (at least one), reserving the disk
+   space so that running out of it fails here, instead of raising
+   SIGBUS when a page is written. */
+static int __store_resize(int fd, size_t size) {
+    if (ftruncate(fd, size ? size : 1) < 0)
+        return -1;
+    return posix_fallocate(fd, 0, size ? size : 1) ? -1 : 0;
+}
+
+/* Map the file fd, of size bytes, and record it. */
+static void *__store_add(int fd, size_t size) {
+    __store_map_t *r;
+    void *p;
+
+    if (!(r = (__store_map_t *) malloc(sizeof(__store_map_t))))
+        return NULL;
+    p = mmap(NULL, size ? size : 1, PROT_READ | PROT_WRITE, MAP_SHARED,
+             fd, 0);
+    if (p == MAP_FAILED) {
+        free(r);
+        return NULL;
+    }
+    r->base = (char *) p;
+    r->size = size ? size : 1;
+    r->fd = fd;
+    r->next = __store_maps;
+    __store_maps = r;
+    if ((__store_now += r->size) > __store_peak)
+        __store_peak = __store_now;
+    return p;
+}
+
+/* For a description of the following function, see "store.h". */
+int store_open(const char *dir) {
+    struct stat st;
+
+    if ((stat(dir, &st) < 0) || !S_ISDIR(st.st_mode) ||
+        (access(dir, W_OK) < 0)) {
+        fprintf(report_file, "Store %s is not a writable directory.\n",
+                dir);
+        return -1;
+    }
+    pthread_mutex_lock(&__store_lock);
+    free(__store_dir);
+    __store_dir = strdup(dir);
+    pthread_mutex_unlock(&__store_lock);
+    return __store_dir ? 0 : -1;
+}
+
+const char *store_dir(void) {
+    return __store_dir;
+}
+
+void store_close(void) {
+    pthread_mutex_lock(&__store_lock);
+    free(__store_dir);
+    __store_dir = NULL;
+    pthread_mutex_unlock(&__store_lock);
+}
+
+void *store_alloc(size_t size) {
+    char *path;
+    void *p = NULL;
+    int fd;
+
+    pthread_mutex_lock(&__store_lock);
+    if (!__store_dir) {
+        pthread_mutex_unlock(&__store_lock);
+        return malloc(size);
+    }
+    if (!(path = (char *) malloc(strlen(__store_dir) + 32))) {
+        pthread_mutex_unlock(&__store_lock);
+        return NULL;
+    }
+    sprintf(path, "%s/wflow2pepa-XXXXXX", __store_dir);
+    if ((fd = mkstemp(path)) >= 0) {
+        unlink(path);
+        if ((__store_resize(fd, size) < 0) || !(p = __store_add(fd, size)))
+            close(fd);
+    }
+    pthread_mutex_unlock(&__store_lock);
+    free(path);
+    return p;
+}
+
+void *store_realloc(void *p, size_t size) {
+    __store_map_t *r;
+    void *q;
+
+    if (!p)
+        return store_alloc(size);
+    pthread_mutex_lock(&__store_lock);
+    if (!(r = __store_find(p))) {
+        pthread_mutex_unlock(&__store_lock);
+        return realloc(p, size);
+    }
+    if (!size)
+        size = 1;
+    if (__store_resize(r->fd, size) < 0) {
+        pthread_mutex_unlock(&__store_lock);
+        return NULL;
+    }
+    /* The file holds the content, so it can be mapped again anywhere
+       (mremap() would do the same without the system calls, but it
+       is specific to Linux). */
+    munmap(r->base, r->size);
+    q = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, 0);
+    if (q == MAP_FAILED) {
+        /* Map the array back as it was, as realloc() leaves it. */
+        ftruncate(r->fd, r->size);
+        r->base = (char *) mmap(NULL, r->size, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, r->fd, 0);
+        pthread_mutex_unlock(&__store_lock);
+        return NULL;
+    }
+    __store_now -= r->size;
+    r->base = (char *) q;
+    r->size = size;
+    if ((__store_now += size) > __store_peak)
+        __store_peak = __store_now;
+    pthread_mutex_unlock(&__store_lock);
+    return q;
+}
+
+void store_free(void *p) {
+    __store_map_t *r, **l;
+
+    if (!p)
+        return;
+    pthread_mutex_lock(&__store_lock);
+    for (l = &__store_maps; (r = *l); l = &r->next)
+        if (((char *) p >= r->base) && ((char *) p < r->base + r->size))
+            break;
+    if (!r) {
+        pthread_mutex_unlock(&__store_lock);
+        free(p);
+        return;
+    }
+    *l = r->next;
+    munmap(r->base, r->size);
+    close(r->fd);
+    __store_now -= r->size;
+    pthread_mutex_unlock(&__store_lock);
+    free(r);
+}
+
+void *store_map(const char *name, size_t size, int *found) {
+    struct stat st;
+    char *path;
+    void *p = NULL;
+    int fd;
+
+    *found = 0;
+    pthread_mutex_lock(&__store_lock);
+    if (!__store_dir ||
+        !(path = (char *) malloc(strlen(__store_dir) + strlen(name) + 2))) {
+        pthread_mutex_unlock(&__store_lock);
+        return NULL;
+    }
+    sprintf(path, "%s/%s", __store_dir, name);
+    if ((fd = open(path, O_RDWR | O_CREAT, 0644)) >= 0) {
+        if (!fstat(fd, &st))
+            *found = ((size_t) st.st_size == size);
+        if ((__store_resize(fd, size) < 0) || !(p = __store_add(fd, size)))
+            close(fd);
+    }
+    pthread_mutex_unlock(&__store_lock);
+    free(path);
+    return p;
+}
+
+void store_advise(void *p, size_t len, int advice) {
+    static const int how[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM,
+                               MADV_DONTNEED };
+    size_t page = (size_t) sysconf(_SC_PAGESIZE), off;
+    __store_map_t *r;
+    char *a;
+
+    if (!p || !len)
+        return;
+    pthread_mutex_lock(&__store_lock);
+    if ((r = __store_find(p))) {
+        /* madvise() wants an address aligned to a page. */
+        off = ((char *) p - r->base) % page;
+        a = (char *) p - off;
+        if (a + off + len > r->base + r->size)
+            len = r->base + r->size - (char *) p;
+        madvise(a, len + off, how[advice]);
+    }
+    pthread_mutex_unlock(&__store_lock);
+}
+
+int store_sync(void *p) {
+    __store_map_t *r;
+    int err = 0;
+
+    pthread_mutex_lock(&__store_lock);
+    if ((r = __store_find(p)))
+        err = msync(r->base, r->size, MS_SYNC);
+    pthread_mutex_unlock(&__store_lock);
+    return err;
+}
+
+void store_usage(size_t *now, size_t *peak) {
+    pthread_mutex_lock(&__store_lock);
+    *now = __store_now;
+    *peak = __store_peak;
+    pthread_mutex_unlock(&__store_lock);
+}
@@ -0,0 +1,80 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes of the out-of-core
+  store, in which the large arrays of a chain are kept in
+  memory-mapped files instead of memory. The functions are defined
+  in "store.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_STORE_H
+#define __PEPA_STORE_H
+
+#include <stddef.h>
+
+/* Access patterns, passed on to madvise(). */
+#define STORE_NORMAL 0     /* No particular order. */
+#define STORE_SEQUENTIAL 1 /* Streamed from start to end. */
+#define STORE_RANDOM 2     /* Random access (no read-ahead). */
+#define STORE_DONE 3       /* Not needed for a while: drop it from
+                              memory (the file keeps it). */
+
+/* Once a store is open, every array allocated with store_alloc() is
+   a file of the store directory, mapped shared into memory, so that
+   the kernel pages it in and out as it is used and the size of the
+   chain is limited by disk space instead of memory. These files are
+   unlinked as soon as they are created, and vanish with the process.
+   store_map() maps a named file instead, which persists: it is used
+   to resume a solution across runs. Without an open store, the
+   functions fall back to malloc(), realloc() and free(), and the
+   functions which free or resize also accept arrays which were not
+   allocated by the store, so that they can be used throughout. All
+   the functions are thread safe. */
+
+/* Open the store in the directory dir. Returns -1 if dir is not a
+   writable directory, which is reported (see report_file in
+   "pepa.h"). */
+extern int store_open(const char *dir);
+
+/* Directory of the open store, or NULL if none is open. */
+extern const char *store_dir(void);
+
+/* Close the store. Arrays which are still mapped stay valid. */
+extern void store_close(void);
+
+/* Allocate size bytes, in a temporary file if a store is open. */
+extern void *store_alloc(size_t size);
+
+/* Resize an array, as realloc(). */
+extern void *store_realloc(void *p, size_t size);
+
+/* Deallocate an array, given any address inside it. */
+extern void store_free(void *p);
+
+/* Map the file name of the store, of size bytes. The content of an
+   existing file is kept, and found is set if it had this size.
+   Returns NULL if no store is open. */
+extern void *store_map(const char *name, size_t size, int *found);
+
+/* Advise the kernel how the len bytes from p will be accessed (see
+   STORE_ above). Does nothing for an array which is not mapped. */
+extern void store_advise(void *p, size_t len, int advice);
+
+/* Write the changes of a mapped array back to its file. */
+extern int store_sync(void *p);
+
+/* Number of bytes which are mapped now, and at most. */
+extern void store_usage(size_t *now, size_t *peak);
+
+#endif /* __PEPA_STORE_H */
@@ -0,0 +1,475 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which solve a model for many
+  values of its task rates, on a state space derived once (see
+  "sweep.h").
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "sweep.h"
+
+typedef struct {
+    sweep_t *w;            /* Sweep being run. */
+    int from, to;          /* Points of this thread. */
+    double *rate;          /* Rates of the leaf-nodes. */
+    double *val, *tval;    /* Transition rates, and transposed. */
+    double *out;           /* Exit rates. */
+    double *pi;            /* Solution of the previous point. */
+    long iter;             /* Number of iterations. */
+    int error;             /* Set if a point did not converge. */
+} __sweep_part_t;          /* Points solved by a thread. */
+
+/* Variable named name, which is added if it is new. Returns -1 if
+   no task has this name. */
+static int __sweep_var(sweep_t *w, char *name) {
+    int i, k, t = -1, c = 0, found = 0;
+
+    for (k = 0; k < w->nvars; k++)
+        if (!strcmp(w->name[k], name))
+            return k;
+    if (k == SWEEP_MAXVARS)
+        return -1;
+    if ((sscanf(name, "t_%d%n", &t, &c) < 1) || name[c])
+        t = -1;
+    for (i = 0; i < w->m->nleaves; i++)
+        if ((i == t) || !strcmp(__htree_rt.sstab[i]->name, name)) {
+            w->var[i] = k;
+            found = 1;
+        }
+    if (!found || !(w->name[k] = strdup(name)))
+        return -1;
+    return w->nvars++;
+}
+
+/* Read the points from a file: the names of the variables on the
+   first line, then one point per line ('#' starts a comment). */
+static int __sweep_file(sweep_t *w, char *path) {
+    char line[4096], *c, *e;
+    double *v;
+    int k, max = 0;
+    FILE *f;
+
+    if (!(f = fopen(path, "r"))) {
+        perror("Could not open the sweep points");
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if ((c = strchr(line, '#')))
+            *c = '\0';
+        if (!w->nvars) {
+            for (c = strtok(line, " \t\r\n,"); c;
+                 c = strtok(NULL, " \t\r\n,"))
+                if (__sweep_var(w, c) < 0) {
+                    fprintf(report_file, "No task named %s.\n", c);
+                    fclose(f);
+                    return -1;
+                }
+            continue;
+        }
+        for (c = line; *c && strchr(" \t\r\n", *c); c++)
+            ;
+        if (!*c)
+            continue;
+        if (w->npoints == max) {
+            max = max ? 2*max : 64;
+            if (!(v = (double *)
+                  realloc(w->value, sizeof(double)*max*w->nvars))) {
+                fclose(f);
+                return -1;
+            }
+            w->value = v;
+        }
+        v = w->value + w->npoints*w->nvars;
+        for (k = 0; k < w->nvars; k++) {
+            v[k] = strtod(c, &e);
+            if ((e == c) || (v[k] <= 0.0)) {
+                fprintf(report_file, "Invalid point on line %d of %s.\n",
+                        w->npoints + 2, path);
+                fclose(f);
+                return -1;
+            }
+            for (c = e; *c && strchr(" \t,", *c); c++)
+                ;
+        }
+        w->npoints++;
+    }
+    fclose(f);
+    return 0;
+}
+
+/* Generate the points of a grid (lhs is 0) or of a Latin hypercube
+   of lhs points, from the ranges of the variables. */
+static int __sweep_points(sweep_t *w, double *lo, double *hi, int *n,
+                          int lhs) {
+    unsigned long long z, key = SWEEP_SEED;
+    double *v;
+    int i, j, k, t, *perm;
+
+    w->npoints = 1;
+    for (k = 0; k < w->nvars; k++)
+        w->npoints = lhs ? lhs : w->npoints*n[k];
+    if (!(w->value = (double *)
+          malloc(sizeof(double)*w->npoints*w->nvars)) ||
+        !(perm = (int *) malloc(sizeof(int)*w->npoints)))
+        return -1;
+    for (k = 0; k < w->nvars; k++) {
+        /* A stratum of every variable for every point; the first
+           variable keeps them in order. */
+        for (i = 0; i < w->npoints; i++)
+            perm[i] = i;
+        for (i = w->npoints - 1; lhs && (k > 0) && (i > 0); i--) {
+            z = (key += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+            j = (int) ((z ^ (z >> 31)) % (unsigned long long) (i + 1));
+            t = perm[i];
+            perm[i] = perm[j];
+            perm[j] = t;
+        }
+        for (i = 0; i < w->npoints; i++) {
+            v = &w->value[i*w->nvars + k];
+            if (lhs)
+                *v = lo[k] + (hi[k] - lo[k])*(perm[i] + 0.5)/lhs;
+            else {
+                /* The last variable varies fastest. */
+                for (t = 1, j = k + 1; j < w->nvars; j++)
+                    t *= n[j];
+                j = (i/t) % n[k];
+                *v = (n[k] > 1) ? lo[k] + (hi[k] - lo[k])*j/(n[k] - 1)
+                    : lo[k];
+            }
+        }
+    }
+    free(perm);
+    return 0;
+}
+
+/* Parse the points of the sweep (see "sweep.h"). */
+static int __sweep_parse(sweep_t *w, char *spec) {
+    double lo[SWEEP_MAXVARS], hi[SWEEP_MAXVARS];
+    int n[SWEEP_MAXVARS], k, lhs = 0, e = 0;
+    char *s, *c, *t;
+
+    if (spec[0] == '@')
+        return __sweep_file(w, spec + 1);
+    if (!(s = strdup(spec)))
+        return -1;
+    for (c = strtok(s, ","); !e && c; c = strtok(NULL, ",")) {
+        if (!(t = strchr(c, '='))) {
+            e = 1;
+            break;
+        }
+        *t++ = '\0';
+        if (!strcmp(c, "lhs")) {
+            e = (lhs = atoi(t)) < 1;
+            continue;
+        }
+        if ((k = __sweep_var(w, c)) < 0) {
+            fprintf(report_file, "No task named %s.\n", c);
+            free(s);
+            return -1;
+        }
+        n[k] = 0;
+        if ((sscanf(t, "%lf:%lf:%d", &lo[k], &hi[k], &n[k]) < 2) ||
+            (lo[k] <= 0.0) || (hi[k] < lo[k]))
+            e = 1;
+    }
+    free(s);
+    for (k = 0; !e && (k < w->nvars); k++)
+        e = !lhs && (n[k] < 1);
+    if (e || !w->nvars) {
+        fprintf(report_file, "Invalid sweep: %s\n", spec);
+        return -1;
+    }
+    return __sweep_points(w, lo, hi, n, lhs);
+}
+
+/* Under symmetry reduction, the branches of a group must keep equal
+   rates: a variable must cover all of them or none. */
+static int __sweep_symmetric(sweep_t *w) {
+    __ctmc_group_t *g;
+    int i, b, j;
+
+    for (i = 0; i < w->m->ngroups; i++) {
+        g = &w->m->group[i];
+        for (b = 1; b < g->nbranch; b++)
+            for (j = 0; j < g->size; j++)
+                if (w->var[g->first[0] + j] != w->var[g->first[b] + j])
+                    return 0;
+    }
+    return 1;
+}
+
+/* Record the terms of the transition rates, and transpose the
+   structure of the matrix for Gauss-Seidel. */
+static int __sweep_terms(sweep_t *w) {
+    ctmc_t *m = w->m;
+    int s, k;
+
+    if ((w->nterms = ctmc_terms(m, &w->trans, &w->leaf, &w->coef)) < 0)
+        return -1;
+    if (!(w->trow = (int *) calloc(m->nstates + 1, sizeof(int))) ||
+        !(w->tcol = (int *) malloc(sizeof(int)*m->ntrans)) ||
+        !(w->tpos = (int *) malloc(sizeof(int)*m->ntrans)))
+        return -1;
+    for (k = 0; k < m->ntrans; k++)
+        w->trow[m->col[k] + 1]++;
+    for (s = 0; s < m->nstates; s++)
+        w->trow[s + 1] += w->trow[s];
+    for (s = 0; s < m->nstates; s++)
+        for (k = m->row[s]; k < m->row[s + 1]; k++) {
+            w->tpos[k] = w->trow[m->col[k]]++;
+            w->tcol[w->tpos[k]] = s;
+        }
+    for (s = m->nstates; s > 0; s--)
+        w->trow[s] = w->trow[s - 1];
+    w->trow[0] = 0;
+    return 0;
+}
+
+/* For a description of the following function, see "sweep.h". */
+sweep_t *sweep_create(ctmc_t *m, char *spec) {
+    sweep_t *w;
+    int i;
+
+    if (!(w = (sweep_t *) calloc(1, sizeof(sweep_t))))
+        return NULL;
+    w->m = m;
+    if (!(w->var = (int *) malloc(sizeof(int)*m->nleaves)) ||
+        !(w->sink = (int *) malloc(sizeof(int)*m->nleaves))) {
+        sweep_destroy(w);
+        return NULL;
+    }
+    for (i = 0; i < m->nleaves; i++) {
+        w->var[i] = -1;
+        w->sink[i] = __htree_rt.sstab[i]->stype == UNKNOWN;
+    }
+    if (__sweep_parse(w, spec) < 0) {
+        sweep_destroy(w);
+        return NULL;
+    }
+    if (!__sweep_symmetric(w)) {
+        fprintf(report_file, "The sweep varies part of a symmetric group; "
+                "run it without -r.\n");
+        sweep_destroy(w);
+        return NULL;
+    }
+    if (!(w->x = (double *) calloc(w->npoints, sizeof(double))) ||
+        !(w->iter = (int *) calloc(w->npoints, sizeof(int))) ||
+        (__sweep_terms(w) < 0)) {
+        sweep_destroy(w);
+        return NULL;
+    }
+    return w;
+}
+
+/* Solve the points of a thread, each by Gauss-Seidel (as in
+   ctmc_solve()) from the solution of the point before it. */
+static void *__sweep_worker(void *arg) {
+    __sweep_part_t *p = (__sweep_part_t *) arg;
+    sweep_t *w = p->w;
+    ctmc_t *m = w->m;
+    double x, s, d, *v;
+    int i, k, j, it;
+
+    for (i = 0; i < m->nstates; i++)
+        p->pi[i] = 1.0/m->nstates;
+    for (j = p->from; j < p->to; j++) {
+        v = w->value + j*w->nvars;
+        for (i = 0; i < m->nleaves; i++)
+            p->rate[i] = (w->var[i] < 0) ? m->leaf[i].rate : v[w->var[i]];
+        memset(p->val, 0, sizeof(double)*m->ntrans);
+        for (k = 0; k < w->nterms; k++)
+            p->val[w->trans[k]] += w->coef[k]*p->rate[w->leaf[k]];
+        for (i = 0; i < m->nstates; i++)
+            for (p->out[i] = 0.0, k = m->row[i]; k < m->row[i + 1]; k++) {
+                p->out[i] += p->val[k];
+                p->tval[w->tpos[k]] = p->val[k];
+            }
+        for (it = 1; it <= CTMC_MAXITER; it++) {
+            d = 0.0;
+            s = 0.0;
+            for (i = 0; i < m->nstates; i++) {
+                if (p->out[i] == 0.0) {
+                    s += p->pi[i];
+                    continue;
+                }
+                for (x = 0.0, k = w->trow[i]; k < w->trow[i + 1]; k++)
+                    x += p->pi[w->tcol[k]]*p->tval[k];
+                x /= p->out[i];
+                if (fabs(x - p->pi[i]) > d)
+                    d = fabs(x - p->pi[i]);
+                p->pi[i] = x;
+                s += x;
+            }
+            for (i = 0; i < m->nstates; i++)
+                p->pi[i] /= s;
+            if (d/s < CTMC_TOLERANCE)
+                break;
+        }
+        if (it > CTMC_MAXITER)
+            p->error = 1;
+        w->iter[j] = it;
+        p->iter += it;
+        for (w->x[j] = 0.0, i = 0; i < m->nleaves; i++)
+            if (w->sink[i])
+                for (k = 0; k < m->nstates; k++)
+                    if (m->leaf[i].steps[m->state[k*m->nleaves + i]].act
+                        == ACT_COMP)
+                        w->x[j] += p->pi[k]*p->rate[i];
+    }
+    return NULL;
+}
+
+long sweep_run(sweep_t *w, int nthreads) {
+    __sweep_part_t *p;
+    pthread_t *tid;
+    ctmc_t *m = w->m;
+    long iter = 0;
+    int i, n = 0, err = 0;
+
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads > w->npoints)
+        nthreads = w->npoints;
+    if (nthreads < 1)
+        nthreads = 1;
+    p = (__sweep_part_t *) calloc(nthreads, sizeof(__sweep_part_t));
+    tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads);
+    if (!p || !tid) {
+        free(p);
+        free(tid);
+        return -1;
+    }
+    for (i = 0; i < nthreads; i++) {
+        p[i].w = w;
+        p[i].from = (int) ((long) w->npoints*i/nthreads);
+        p[i].to = (int) ((long) w->npoints*(i + 1)/nthreads);
+        if (!(p[i].rate = (double *) malloc(sizeof(double)*m->nleaves)) ||
+            !(p[i].val = (double *) malloc(sizeof(double)*m->ntrans)) ||
+            !(p[i].tval = (double *) malloc(sizeof(double)*m->ntrans)) ||
+            !(p[i].out = (double *) malloc(sizeof(double)*m->nstates)) ||
+            !(p[i].pi = (double *) malloc(sizeof(double)*m->nstates)) ||
+            pthread_create(&tid[i], NULL, __sweep_worker, &p[i])) {
+            err = 1;
+            break;
+        }
+        n++;
+    }
+    for (i = 0; i < n; i++) {
+        pthread_join(tid[i], NULL);
+        err |= p[i].error;
+        iter += p[i].iter;
+    }
+    for (i = 0; i < nthreads; i++) {
+        free(p[i].rate);
+        free(p[i].val);
+        free(p[i].tval);
+        free(p[i].out);
+        free(p[i].pi);
+    }
+    free(p);
+    free(tid);
+    return err ? -1 : iter;
+}
+
+void sweep_destroy(sweep_t *w) {
+    int k;
+
+    if (!w)
+        return;
+    for (k = 0; k < w->nvars; k++)
+        free(w->name[k]);
+    free(w->var);
+    free(w->sink);
+    free(w->value);
+    free(w->trans);
+    free(w->leaf);
+    free(w->coef);
+    free(w->trow);
+    free(w->tcol);
+    free(w->tpos);
+    free(w->x);
+    free(w->iter);
+    free(w);
+}
+
+static double __sweep_elapsed(struct timespec *t0, struct timespec *t1) {
+    return (t1->tv_sec - t0->tv_sec) + (t1->tv_nsec - t0->tv_nsec)*1e-9;
+}
+
+/* For a description of the following function, see "sweep.h". The
+   cost of an independent run is that of deriving the chain and
+   solving it from the uniform distribution, which is measured once
+   at the rates of the tree. */
+int htree_sweep(char *spec) {
+    struct timespec t0, t1, t2, t3;
+    double td, ts, tw;
+    sweep_t *w;
+    ctmc_t *m;
+    long iter;
+    int i, k, it;
+
+    if (!__htree_rt.htree || __htree_rt.node_sum) {
+        fprintf(report_file, "Invalid tree.\n");
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (!(m = ctmc_derive(__htree_rt.htree, __htree_rt.sstab,
+                          __htree_rt.nleaves, symmetry))) {
+        fprintf(report_file, "Could not derive the CTMC.\n");
+        return -1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    it = ctmc_solve(m, CTMC_TOLERANCE, CTMC_MAXITER);
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    if (!(w = sweep_create(m, spec))) {
+        ctmc_destroy(m);
+        return -1;
+    }
+    iter = sweep_run(w, nthreads);
+    clock_gettime(CLOCK_MONOTONIC, &t3);
+    td = __sweep_elapsed(&t0, &t1);
+    ts = __sweep_elapsed(&t1, &t2);
+    tw = __sweep_elapsed(&t2, &t3);
+
+    fprintf(report_file, "Sweep: %d points, %d states, %d terms.\n",
+            w->npoints, m->nstates, w->nterms);
+    for (k = 0; k < w->nvars; k++)
+        fprintf(report_file, "%12.12s ", w->name[k]);
+    fprintf(report_file, "%14s %10s\n", "Throughput", "Iterations");
+    for (i = 0; i < w->npoints; i++) {
+        for (k = 0; k < w->nvars; k++)
+            fprintf(report_file, "%12g ", w->value[i*w->nvars + k]);
+        fprintf(report_file, "%14f %10d\n", w->x[i], w->iter[i]);
+    }
+    if (iter < 0)
+        fprintf(report_file, "Some points did not converge.\n");
+    else
+        fprintf(report_file,
+                "Sweep time: %.3fs (derive %.3fs once, %ld iterations); "
+                "independent runs: about %.3fs (%d iterations each from "
+                "cold), %.1fx.\n", td + tw, td, iter, w->npoints*(td + ts), it,
+                (td + tw > 0.0) ? w->npoints*(td + ts)/(td + tw) : 0.0);
+    sweep_destroy(w);
+    ctmc_destroy(m);
+    return (iter < 0) ? -1 : 0;
+}
@@ -0,0 +1,86 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the data structures and function prototypes
+  used to solve a model for many values of its task rates. The state
+  space is derived once; only the values of the generator matrix are
+  rewritten for every point of the sweep. The functions are defined
+  in "sweep.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_SWEEP_H
+#define __PEPA_SWEEP_H
+
+#include "ctmc.h"
+
+#define SWEEP_MAXVARS 16        /* Max. number of rate variables. */
+#define SWEEP_SEED 0x5eedUL     /* Seed of the Latin hypercube. */
+
+/* A rate variable is the name of a task: every task of that name
+   takes the value of the variable, so that the branches of a farm
+   are varied together. A single task is named t_i after its index
+   (as in the output of -b). The points of the sweep are given by
+   spec:
+
+       a=1:5:5,b=2:4:3     grid of 5 x 3 points, from lo to hi
+       lhs=20,a=1:5,b=2:4  Latin hypercube of 20 points
+       @points.txt         file: the names on the first line, then
+                           one point per line
+
+   Moving between points only changes the rates of the transitions,
+   which are sums of terms rate(leaf)*coefficient, the coefficients
+   being fixed by the structure (the probabilities of the outcomes of
+   instantaneous moves, and the multiplicities of symmetric
+   branches). These terms are recorded once (see ctmc_terms()). Points are split into
+   contiguous runs, one per thread, and every solve starts from the
+   solution of the point before it, which is close when the points
+   are ordered as above (the last variable of a grid varies fastest,
+   and the Latin hypercube is sorted on its first variable). */
+typedef struct {
+    ctmc_t *m;             /* Chain derived once. */
+    int nvars;             /* Number of rate variables. */
+    char *name[SWEEP_MAXVARS]; /* Their names. */
+    int *var;              /* Variable of every leaf-node, or -1. */
+    int *sink;             /* Is the leaf-node a sink task? */
+    int npoints;           /* Number of points. */
+    double *value;         /* Values of the variables (by point). */
+
+    int nterms;            /* Terms of the transition rates: */
+    int *trans;            /* transition, */
+    int *leaf;             /* leaf-node whose rate it is, */
+    double *coef;          /* and coefficient. */
+    int *trow, *tcol;      /* Incoming transitions of every state, */
+    int *tpos;             /* and position of every transition there. */
+
+    double *x;             /* Throughput at every point. */
+    int *iter;             /* Number of iterations at every point. */
+} sweep_t;                 /* Rate sweep. */
+
+/* Prepare the sweep over the points in spec of the chain m, derived
+   from the committed skeleton hierarchy tree. Returns NULL on failure
+   (with a message if spec is not valid). */
+extern sweep_t *sweep_create(ctmc_t *m, char *spec);
+
+/* Solve every point, using nthreads threads (all processors if
+   nthreads < 1). Returns the total number of iterations, or -1. */
+extern long sweep_run(sweep_t *w, int nthreads);
+
+/* Deallocate the sweep (but not the chain). */
+extern void sweep_destroy(sweep_t *w);
+
+/* Sweep the committed skeleton hierarchy tree over the points in
+   spec, and display the throughput at every point. */
+extern int htree_sweep(char *spec);
+
+#endif /* __PEPA_SWEEP_H */
@@ -0,0 +1,347 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the functions which compute the transient
+  probabilities of the derived CTMC by uniformisation. The CTMC with
+  generator Q is replaced by the discrete time chain P = I + Q/q,
+  where q is at least the largest exit rate, and the probabilities at
+  time t are the Poisson (qt) weighted sum of the powers of P applied
+  to the initial distribution. All the time points share the same
+  powers of P, so they are accumulated during one sweep whose length
+  is set by the largest time point. The sweep stops early once the
+  powers of P no longer change (steady state detection).
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "transient.h"
+#include "store.h"
+
+typedef struct {
+    ctmc_t *m;              /* CTMC being solved. */
+    int *trow, *tcol;       /* Incoming transitions of every state */
+    double *tval;           /* (transpose of the CTMC). */
+    double q;               /* Uniformisation rate. */
+    double *v, *y;          /* Current and next vector. */
+    int ntimes;             /* Number of time points. */
+    double *p;              /* Transient vectors of the time points. */
+    int *left, *right;      /* Truncation points of every time point. */
+    double **w;             /* Poisson weights of every time point. */
+    double *rest;           /* Weights left when steady state is found. */
+    int kmax;               /* Largest right truncation point. */
+    int k;                  /* Number of products computed. */
+    int steady;             /* Set when steady state is detected. */
+    int nthreads;           /* Number of threads. */
+    double *diff;           /* Largest change seen by every thread. */
+    pthread_barrier_t bar;  /* Synchronises the threads. */
+} __transient_t;
+
+typedef struct {
+    __transient_t *t;       /* Shared state of the sweep. */
+    int id;                 /* Thread number. */
+    int from, to;           /* Range of states of the thread. */
+} __transient_part_t;
+
+/* Thread body: computes a range of every vector of the sweep. */
+static void *__transient_worker(void *arg);
+
+
+/* For a description of the following function, see "transient.h".
+   Following Fox and Glynn, the weights are computed outwards from the
+   mode, starting from 1 so that they can neither overflow nor lose
+   precision, and are normalised at the end. A side is truncated once
+   the geometric bound on the rest of its tail drops below eps/2 of
+   the mass found so far. */
+double *fox_glynn(double lambda, double eps, int *left, int *right) {
+    double *w, *t, r, sum = 1.0;
+    int mode, max, n, i, l, k;
+
+    mode = (int) floor(lambda);
+    max = 64 + (int) (16.0*sqrt(lambda));
+    if (!(w = (double *) malloc(sizeof(double)*max)))
+        return NULL;
+
+    /* The right tail is kept in w[0..n-1], starting with the mode. */
+    w[0] = 1.0;
+    n = 1;
+    for (k = mode; lambda > 0.0; k++) {
+        r = lambda/(k + 1);
+        if ((k + 1 > lambda) && (r < 1.0) &&
+            (w[n - 1]*r/(1.0 - r) < 0.5*eps*sum))
+            break;
+        if (n == max) {
+            if (!(t = (double *) realloc(w, sizeof(double)*2*max))) {
+                free(w);
+                return NULL;
+            }
+            w = t;
+            max *= 2;
+        }
+        w[n] = w[n - 1]*lambda/(k + 1);
+        sum += w[n++];
+    }
+
+    /* The left tail is found next, and the array shifted. */
+    for (l = mode, r = 1.0; l > 0; l--) {
+        r *= l/lambda;
+        if ((l < lambda) && (l/lambda < 1.0) &&
+            (r*(l/lambda)/(1.0 - l/lambda) < 0.5*eps*sum))
+            break;
+        sum += r;
+    }
+    if (!(t = (double *) malloc(sizeof(double)*(n + mode - l)))) {
+        free(w);
+        return NULL;
+    }
+    for (r = 1.0, i = mode - l - 1; i >= 0; i--) {
+        r *= (l + i + 1)/lambda;
+        t[i] = r;
+    }
+    memcpy(t + mode - l, w, sizeof(double)*n);
+    free(w);
+    for (i = 0; i < n + mode - l; i++)
+        t[i] /= sum;
+    *left = l;
+    *right = mode + n - 1;
+    return t;
+}
+
+/* Add weight c times vector x, over a range of states, to the
+   transient vector of time point j. */
+static void __transient_add(__transient_t *t, int j, double c,
+                            double *x, int from, int to) {
+    double *p = t->p + (long) j*t->m->nstates;
+    int s;
+
+    for (s = from; s < to; s++)
+        p[s] += c*x[s];
+}
+
+void *__transient_worker(void *arg) {
+    __transient_part_t *a = (__transient_part_t *) arg;
+    __transient_t *t = a->t;
+    ctmc_t *m = t->m;
+    double *v, *y, d, x, iq = 1.0/t->q;
+    int s, i, j, k;
+
+    for (j = 0; j < t->ntimes; j++)
+        if (t->left[j] == 0)
+            __transient_add(t, j, t->w[j][0], t->v, a->from, a->to);
+    for (k = 1; k <= t->kmax; k++) {
+        v = t->v;
+        y = t->y;
+        d = 0.0;
+        for (s = a->from; s < a->to; s++) {
+            x = v[s]*(1.0 - m->out[s]*iq);
+            for (i = t->trow[s]; i < t->trow[s + 1]; i++)
+                x += v[t->tcol[i]]*t->tval[i]*iq;
+            y[s] = x;
+            if (fabs(x - v[s]) > d)
+                d = fabs(x - v[s]);
+        }
+        for (j = 0; j < t->ntimes; j++)
+            if ((k >= t->left[j]) && (k <= t->right[j]))
+                __transient_add(t, j, t->w[j][k - t->left[j]], y,
+                                a->from, a->to);
+        t->diff[a->id] = d;
+        if (pthread_barrier_wait(&t->bar) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            t->v = y;
+            t->y = v;
+            t->k = k;
+            for (d = 0.0, i = 0; i < t->nthreads; i++)
+                if (t->diff[i] > d)
+                    d = t->diff[i];
+            if (d < TRANSIENT_STEADY) {
+                /* The remaining powers of P are all the same. */
+                t->steady = 1;
+                for (j = 0; j < t->ntimes; j++)
+                    for (t->rest[j] = 0.0, i = k + 1; i <= t->right[j]; i++)
+                        if (i >= t->left[j])
+                            t->rest[j] += t->w[j][i - t->left[j]];
+            }
+        }
+        pthread_barrier_wait(&t->bar);
+        if (t->steady) {
+            for (j = 0; j < t->ntimes; j++)
+                if (t->rest[j] > 0.0)
+                    __transient_add(t, j, t->rest[j], t->v,
+                                    a->from, a->to);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* For a description of the following function, see "transient.h". */
+int ctmc_transient(ctmc_t *m, double *times, int ntimes, double *p,
+                   int nthreads) {
+    __transient_t t;
+    __transient_part_t *a = NULL;
+    pthread_t *tid = NULL;
+    int i, n = 0, ret = -1;
+
+    memset(&t, 0, sizeof(__transient_t));
+    t.m = m;
+    t.ntimes = ntimes;
+    t.p = p;
+    for (i = 0; i < m->nstates; i++)
+        if (m->out[i] > t.q)
+            t.q = m->out[i];
+    t.q = (t.q > 0.0) ? 1.02*t.q : 1.0; /* Keep P aperiodic. */
+    memset(p, 0, sizeof(double)*ntimes*m->nstates);
+    if ((ctmc_transpose(m, &t.trow, &t.tcol, &t.tval) < 0) ||
+        !(t.v = (double *) calloc(m->nstates, sizeof(double))) ||
+        !(t.y = (double *) calloc(m->nstates, sizeof(double))) ||
+        !(t.left = (int *) malloc(sizeof(int)*ntimes)) ||
+        !(t.right = (int *) malloc(sizeof(int)*ntimes)) ||
+        !(t.rest = (double *) calloc(ntimes, sizeof(double))) ||
+        !(t.w = (double **) calloc(ntimes, sizeof(double *))))
+        goto out;
+    for (i = 0; i < ntimes; i++) {
+        if (!(t.w[i] = fox_glynn(t.q*times[i], TRANSIENT_EPSILON,
+                                 &t.left[i], &t.right[i])))
+            goto out;
+        if (t.right[i] > t.kmax)
+            t.kmax = t.right[i];
+    }
+    for (i = 0; i < m->ninit; i++)
+        t.v[i] = m->init[i];
+
+    /* Small chains are not worth the synchronisation. */
+    if (nthreads < 1)
+        nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads > m->nstates/4096 + 1)
+        nthreads = m->nstates/4096 + 1;
+    if (nthreads < 1)
+        nthreads = 1;
+    t.nthreads = nthreads;
+    if (!(t.diff = (double *) calloc(nthreads, sizeof(double))) ||
+        !(a = (__transient_part_t *)
+          malloc(sizeof(__transient_part_t)*nthreads)) ||
+        !(tid = (pthread_t *) malloc(sizeof(pthread_t)*nthreads)) ||
+        pthread_barrier_init(&t.bar, NULL, nthreads))
+        goto out;
+    for (i = 0; i < nthreads; i++) {
+        a[i].t = &t;
+        a[i].id = i;
+        a[i].from = (int) ((long) m->nstates*i/nthreads);
+        a[i].to = (int) ((long) m->nstates*(i + 1)/nthreads);
+    }
+    for (i = 1; i < nthreads; i++) {
+        if (pthread_create(&tid[i], NULL, __transient_worker, &a[i]))
+            break;
+        n++;
+    }
+    if (n == nthreads - 1) {
+        __transient_worker(&a[0]);
+        ret = t.k;
+    } else
+        fprintf(report_file,
+                "Could not start the transient solver threads.\n");
+    for (i = 1; i <= n; i++)
+        pthread_join(tid[i], NULL);
+    pthread_barrier_destroy(&t.bar);
+ out:
+    if (t.w)
+        for (i = 0; i < ntimes; i++)
+            free(t.w[i]);
+    free(t.w);
+    free(t.left);
+    free(t.right);
+    free(t.rest);
+    free(t.diff);
+    free(t.v);
+    free(t.y);
+    store_free(t.trow);
+    store_free(t.tcol);
+    store_free(t.tval);
+    free(a);
+    free(tid);
+    return ret;
+}
+
+/* Workflow throughput of a probability vector. */
+static double __transient_throughput(ctmc_t *m, double *p) {
+    int i, s;
+    double x = 0.0;
+
+    for (s = 0; s < m->nstates; s++)
+        for (i = 0; i < m->nleaves; i++)
+            if ((__htree_rt.sstab[i]->stype == UNKNOWN) &&
+                (m->leaf[i].steps[m->state[s*m->nleaves + i]].act
+                 == ACT_COMP))
+                x += p[s]*m->leaf[i].rate;
+    return x;
+}
+
+int htree_transient(ctmc_t *m, char *spec) {
+    double *times, *p, h = 0.0, x, ss;
+    char *c, *e;
+    int i, n, k;
+
+    /* Either a list of time points, or a horizon and a number of
+       equally spaced points. */
+    for (n = 1, c = spec; *c; c++)
+        if (*c == ',')
+            n++;
+    if ((c = strchr(spec, '/')) || (n == 1)) {
+        h = strtod(spec, &e);
+        n = c ? atoi(c + 1) : TRANSIENT_POINTS;
+        if ((h <= 0.0) || (n < 1)) {
+            fprintf(report_file, "Invalid time points: %s\n", spec);
+            return -1;
+        }
+    }
+    if (!(times = (double *) malloc(sizeof(double)*n)))
+        return -1;
+    for (i = 0, c = spec; i < n; i++) {
+        if (strchr(spec, ',')) {
+            times[i] = strtod(c, &e);
+            c = e + 1;
+        } else
+            times[i] = h*(i + 1)/n;
+        if ((times[i] < 0.0) || ((i > 0) && (times[i] <= times[i - 1]))) {
+            fprintf(report_file, "Time points must be increasing: %s\n", spec);
+            free(times);
+            return -1;
+        }
+    }
+    if (!(p = (double *) malloc(sizeof(double)*n*m->nstates))) {
+        fprintf(report_file, "Not enough memory for %d time points.\n", n);
+        free(times);
+        return -1;
+    }
+    if ((k = ctmc_transient(m, times, n, p, nthreads)) < 0) {
+        fprintf(report_file,
+                "Could not compute the transient probabilities.\n");
+        free(times);
+        free(p);
+        return -1;
+    }
+    fprintf(report_file, "Transient: %d time points, %d products.\n", n, k);
+    ss = m->pi ? __transient_throughput(m, m->pi) : 0.0;
+    fprintf(report_file, "%-14s %14s %10s\n", "Time", "Throughput", "Steady");
+    for (i = 0; i < n; i++) {
+        x = __transient_throughput(m, p + (long) i*m->nstates);
+        fprintf(report_file, "%-14g %14f %9.2f%%\n", times[i], x,
+                (ss > 0.0) ? 100.0*x/ss : 0.0);
+    }
+    free(times);
+    free(p);
+    return 0;
+}
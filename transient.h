@@ -0,0 +1,51 @@
+/*********************************************************************
+
+  THE ENHANCE PROJECT
+  School of Informatics,
+  University of Edinburgh,
+  Edinburgh - EH9 3JZ
+  United Kingdom
+
+
+  DESCRIPTION:
+
+  This file contains the function prototypes used to compute the
+  transient probabilities of the derived CTMC by uniformisation, for
+  instance to find how quickly a workflow reaches its steady
+  throughput after a cold start. The functions are defined in
+  "transient.c".
+
+  Written by: Gagarine Yaikhom
+
+*********************************************************************/
+
+#ifndef __PEPA_TRANSIENT_H
+#define __PEPA_TRANSIENT_H
+
+#include "ctmc.h"
+
+#define TRANSIENT_EPSILON 1e-8 /* Truncation error of the Poisson sums. */
+#define TRANSIENT_STEADY 1e-12 /* Steady state detection criterion. */
+#define TRANSIENT_POINTS 20    /* Default number of time points. */
+
+/* Compute the Poisson probabilities of rate lambda, truncated on both
+   sides so that the mass left out is below eps (Fox-Glynn). The
+   weights of left..right are returned in a new array, and sum to 1.
+   Returns NULL on failure. */
+extern double *fox_glynn(double lambda, double eps, int *left,
+                         int *right);
+
+/* Compute the transient probabilities of m at the ntimes time points
+   (in increasing order) in a single uniformisation sweep, using
+   nthreads threads (all processors if nthreads < 1). The vector of
+   time point j is stored at p + j*m->nstates. Returns the number of
+   matrix-vector products, or -1 on failure. */
+extern int ctmc_transient(ctmc_t *m, double *times, int ntimes,
+                          double *p, int nthreads);
+
+/* Parse the time points in spec ("t1,t2,..." or "horizon/points"),
+   compute the transient workflow throughput of the solved CTMC of
+   the committed skeleton hierarchy tree, and display it. */
+extern int htree_transient(ctmc_t *m, char *spec);
+
+#endif /* __PEPA_TRANSIENT_H */